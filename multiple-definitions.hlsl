@@ -0,0 +1,11 @@
+#pragma pack_matrix(column_major)
+
+#line 21 "tests/bugs/multiple-definitions.slang"
+[numthreads(1, 1, 1)]
+void main()
+{
+
+#line 22
+    return;
+}
+
@@ -313,4 +313,58 @@ struct ISlangUnknown
 #   define SLANG_UNROLL
 #endif
 
+// Auto-vectorization hints, used when a vectorize width is set for the threads of a compute group (see
+// `-cpu-vectorize-width`). SLANG_VECTORIZE_THREAD_LOOP is placed before the loop over a gang of threads, which always
+// runs `laneCount` times. The threads don't depend on each other (there are no barriers in the loop), so the compiler can vectorize it
+// without checking for dependencies between iterations. The body of the entry point is forced inline into the loop so
+// that it can be vectorized. gcc has no pragma for the vector width, so the loop isn't unrolled, which would otherwise
+// let gcc vectorize the loop over the gangs instead, at a width of its own choosing.
+#ifndef SLANG_VECTORIZE_THREAD_LOOP
+#   if defined(__clang__)
+#       define SLANG_VECTORIZE_PRAGMA(x) _Pragma(#x)
+#       define SLANG_VECTORIZE_THREAD_LOOP(laneCount) SLANG_VECTORIZE_PRAGMA(clang loop vectorize(assume_safety) vectorize_width(laneCount))
+#   elif defined(__GNUC__)
+#       define SLANG_VECTORIZE_THREAD_LOOP(laneCount) _Pragma("GCC ivdep") _Pragma("GCC unroll 1")
+#   elif defined(_MSC_VER)
+#       define SLANG_VECTORIZE_THREAD_LOOP(laneCount) __pragma(loop(ivdep))
+#   else
+#       define SLANG_VECTORIZE_THREAD_LOOP(laneCount)
+#   endif
+#endif
+
+#ifndef SLANG_VECTORIZE_THREAD_INLINE
+#   if defined(__GNUC__)
+#       define SLANG_VECTORIZE_THREAD_INLINE __attribute__((always_inline)) inline
+#   elif defined(_MSC_VER)
+#       define SLANG_VECTORIZE_THREAD_INLINE __forceinline
+#   else
+#       define SLANG_VECTORIZE_THREAD_INLINE inline
+#   endif
+#endif
+
+// The state kept across group barriers by each thread of a group, when the group is run in phases split at its
+// barriers. The states of all of the threads are held at once, so if they are larger than
+// SLANG_GROUP_THREAD_STATES_MAX_STACK_SIZE bytes they are held on the heap.
+#ifndef SLANG_GROUP_THREAD_STATES_MAX_STACK_SIZE
+#   define SLANG_GROUP_THREAD_STATES_MAX_STACK_SIZE (16 * 1024)
+#endif
+
+template <typename T, int COUNT>
+struct GroupThreadStates
+{
+    enum { kIsOnStack = sizeof(T) * COUNT <= SLANG_GROUP_THREAD_STATES_MAX_STACK_SIZE };
+
+    T& operator[](size_t index) { SLANG_BOUND_CHECK_FIXED_ARRAY(index, COUNT); return m_states[index]; }
+
+    GroupThreadStates() : m_states(kIsOnStack ? m_stackStates : new T[COUNT]) {}
+    ~GroupThreadStates() { if (!kIsOnStack) delete[] m_states; }
+
+    T* m_states;
+    T m_stackStates[kIsOnStack ? COUNT : 1];
+
+private:
+    GroupThreadStates(const GroupThreadStates&) = delete;
+    GroupThreadStates& operator=(const GroupThreadStates&) = delete;
+};
+
 #endif
@@ -932,6 +932,14 @@ struct ComputeVaryingInput
     uint3 endGroupID;       ///< Non inclusive end groupID
 };
 
+/* Group barriers. A compute entry point is split at its group barriers, so the threads of a group
+(which all run on the calling host thread) are run in phases between them. A barrier that remains
+(such as in a thread run on its own) has nothing to wait for. */
+
+SLANG_FORCE_INLINE void GroupMemoryBarrierWithGroupSync() {}
+SLANG_FORCE_INLINE void AllMemoryBarrierWithGroupSync() {}
+SLANG_FORCE_INLINE void DeviceMemoryBarrierWithGroupSync() {}
+
 // The uniformEntryPointParams and uniformState must be set to structures that match layout that the kernel expects.
 // This can be determined via reflection for example.
 
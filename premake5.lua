@@ -1290,7 +1290,7 @@ tool "platform"
 standardProject("slangc", "source/slangc")
     uuid "D56CBCEB-1EB5-4CA8-AEC4-48EA35ED61C7"
     kind "ConsoleApp"
-    links { "core", "slang" }
+    links { "core", "compiler-core", "slang" }
     if not targetInfo.isWindows then
         links { "pthread" }
     end
@@ -1784,7 +1784,7 @@ if enableProfile then
         -- gprof needs symbols
         symbols "On"
 
-        dependson { "slang" }
+        dependson { "slang", "gfx" }
 
         includedirs { "external/spirv-headers/include" }
 
@@ -1816,7 +1816,7 @@ if enableProfile then
         addSourceDir "source/slang"
 
         includedirs { "." }
-        links { "core", "compiler-core", "miniz", "lz4"}
+        links { "core", "compiler-core", "miniz", "lz4", "gfx" }
 
         filter { "system:linux" }
             linkoptions{  "-pg" }
@@ -56,7 +56,7 @@ const uint64_t kTimeoutInfinite = 0xFFFFFFFFFFFFFFFF;
 
 enum class StructType
 {
-    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc
+    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc, CPUDeviceExtendedDesc, PipelineSpecializationDesc
 };
 
 // TODO: Rename to Stage
@@ -129,6 +129,7 @@ enum class AccessFlag
 const GfxCount kMaxRenderTargetCount = 8;
 
 class ITransientResourceHeap;
+class IPipelineState;
 
 enum class ShaderModuleSourceType
 {
@@ -1339,12 +1340,20 @@ struct GraphicsPipelineStateDesc
     DepthStencilDesc    depthStencil;
     RasterizerDesc      rasterizer;
     BlendDesc           blend;
+    // A pipeline to use in place of a specialization of this pipeline that is still being
+    // created in the background (see `PipelineSpecializationMode`). It must not need
+    // specialization itself.
+    IPipelineState*     fallbackPipeline = nullptr;
 };
 
 struct ComputePipelineStateDesc
 {
     IShaderProgram*  program = nullptr;
     void* d3d12RootSignatureOverride = nullptr;
+    // A pipeline to use in place of a specialization of this pipeline that is still being
+    // created in the background (see `PipelineSpecializationMode`). It must not need
+    // specialization itself.
+    IPipelineState* fallbackPipeline = nullptr;
 };
 
 struct RayTracingPipelineFlags
@@ -1419,6 +1428,24 @@ public:
         0xca7e57d, 0x8a90, 0x44f3, { 0xbd, 0xb1, 0xfe, 0x9b, 0x35, 0x3f, 0x5a, 0x72 } \
     }
 
+// Tracks the creation of a specialized pipeline on the device's background thread.
+class IPipelineSpecializationTask : public ISlangUnknown
+{
+public:
+    /// Returns true once the specialized pipeline has been created, or creating it has failed.
+    virtual SLANG_NO_THROW bool SLANG_MCALL isComplete() = 0;
+
+    /// Wait on the host for the specialized pipeline to be created.
+    /// `timeout` is in nanoseconds, can be set to `kTimeoutInfinite`.
+    /// Returns SLANG_E_TIME_OUT if the task did not complete in time, otherwise the result
+    /// of creating the pipeline.
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait(uint64_t timeout) = 0;
+};
+#define SLANG_UUID_IPipelineSpecializationTask                                         \
+    {                                                                                 \
+        0x5d3a1c7e, 0x2b94, 0x4f61, { 0x9e, 0x0d, 0x87, 0x3c, 0x41, 0xa6, 0xd2, 0x5b } \
+    }
+
 
 struct ScissorRect
 {
@@ -2267,6 +2294,10 @@ public:
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getFormatSupportedResourceStates(Format format, ResourceStateSet* outStates) = 0;
 
+        /// Returns the Slang session used by the device. If the device specializes pipelines
+        /// asynchronously (see `PipelineSpecializationMode`), the session is also used by a
+        /// background thread, so the session and the objects created from it must only be used
+        /// between `lockSlangSession` and `unlockSlangSession`.
     virtual SLANG_NO_THROW Result SLANG_MCALL getSlangSession(slang::ISession** outSlangSession) = 0;
 
     inline ComPtr<slang::ISession> getSlangSession()
@@ -2580,6 +2611,23 @@ public:
         const ITextureResource::Desc& desc, Size* outSize, Size* outAlignment) = 0;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(Size* outAlignment) = 0;
+
+    /// Start creating the specialization of `pipeline` needed by the shader objects bound to
+    /// `rootObject` on a background thread, unless it has already been created or is being
+    /// created. `rootObject` is the root shader object returned by binding `pipeline` to an
+    /// encoder. Draws and dispatches with the same bindings use the specialized pipeline once
+    /// the returned task has completed.
+    virtual SLANG_NO_THROW Result SLANG_MCALL specializePipelineAsync(
+        IPipelineState* pipeline,
+        IShaderObject* rootObject,
+        IPipelineSpecializationTask** outTask) = 0;
+
+    /// Stop the device from using its Slang session until `unlockSlangSession` is called.
+    /// Must be held whilst the application uses the session, or any object created from it
+    /// (including releasing references to them), if the device specializes pipelines
+    /// asynchronously. Can be locked recursively.
+    virtual SLANG_NO_THROW void SLANG_MCALL lockSlangSession() = 0;
+    virtual SLANG_NO_THROW void SLANG_MCALL unlockSlangSession() = 0;
 };
 
 #define SLANG_UUID_IDevice                                                               \
@@ -2702,4 +2750,29 @@ struct D3D12DeviceExtendedDesc
     uint32_t highestShaderModel = 0;
 };
 
+enum class PipelineSpecializationMode
+{
+    // A draw or dispatch that needs a specialization that hasn't been created yet creates it
+    // before returning.
+    Synchronous,
+    // New specializations are created on a background thread. Until one is ready, draws and
+    // dispatches that need it use the pipeline's `fallbackPipeline`, or wait for it if the
+    // pipeline has none.
+    Asynchronous,
+};
+
+struct PipelineSpecializationDesc
+{
+    StructType structType = StructType::PipelineSpecializationDesc;
+    PipelineSpecializationMode mode = PipelineSpecializationMode::Asynchronous;
+};
+
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// The maximum number of threads used to execute a compute dispatch, including the
+    /// thread of the queue that executes it. 0 means use all available hardware threads.
+    uint32_t maxThreadCount = 0;
+};
+
 }
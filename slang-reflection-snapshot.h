@@ -0,0 +1,328 @@
+#ifndef SLANG_REFLECTION_SNAPSHOT_H
+#define SLANG_REFLECTION_SNAPSHOT_H
+
+#include "slang.h"
+
+/* A reflection snapshot is a flat copy of the reflection information of a `slang::ProgramLayout`, made by
+`slang::ShaderReflection::getSnapshot` (or `spReflection_getSnapshot`).
+
+Walking the reflection API does work on every call (such as finding the fields of a type). A snapshot is made
+of tables of fixed size records, that refer to each other by index and hold no pointers. Accessing any part of
+it is O(1), and it can be stored alongside compiled code and read back with `ReflectionSnapshot` - which
+only needs this header, and not a Slang session or the Slang library.
+
+The snapshot holds the information needed to bind parameters: the layouts of types and their fields, the
+offsets (bindings) of variables for each parameter category, and the entry points. Numbers are stored in the
+byte order of the machine that made the snapshot. */
+
+namespace slang
+{
+    enum : uint32_t
+    {
+        kReflectionSnapshotMagic = 0x4e535253,      ///< "SRSN"
+        kReflectionSnapshotVersion = 1,
+
+        kReflectionSnapshotNone = 0xffffffff,       ///< An index that doesn't refer to anything
+    };
+
+        /// The value of a size or offset that is unbounded (`SLANG_UNBOUNDED_SIZE`)
+    static const uint64_t kReflectionSnapshotUnboundedSize = ~uint64_t(0);
+
+        /// A range of records in a table
+    struct ReflectionSnapshotRange
+    {
+        uint32_t start;
+        uint32_t count;
+    };
+
+        /// The location and size of a table in a snapshot
+    struct ReflectionSnapshotTable
+    {
+        uint32_t offset;                            ///< In bytes from the start of the snapshot
+        uint32_t count;                             ///< The number of records
+    };
+
+        /// The size of a type layout for one parameter category
+    struct ReflectionSnapshotSize
+    {
+        uint32_t category;                          ///< SlangParameterCategory
+        int32_t alignment;
+        uint64_t size;
+        uint64_t stride;
+    };
+
+        /// The offset of a variable for one parameter category
+    struct ReflectionSnapshotOffset
+    {
+        uint32_t category;                          ///< SlangParameterCategory
+        uint32_t space;                             ///< The register space or descriptor set
+        uint64_t offset;                            ///< The binding index or register, or bytes for uniform data
+    };
+
+    struct ReflectionSnapshotTypeLayout
+    {
+        uint32_t kind;                              ///< SlangTypeKind
+        uint32_t name;                              ///< A string
+        uint32_t scalarType;                        ///< SlangScalarType
+        uint32_t rowCount;
+        uint32_t columnCount;
+        uint32_t resourceShape;                     ///< SlangResourceShape
+        uint32_t resourceAccess;                    ///< SlangResourceAccess
+        uint32_t parameterCategory;                 ///< SlangParameterCategory, which may be 'mixed'
+        uint32_t matrixLayoutMode;                  ///< SlangMatrixLayoutMode
+        uint32_t elementTypeLayout;                 ///< For arrays, parameter groups and resources, or kReflectionSnapshotNone
+        uint32_t elementVarLayout;                  ///< For parameter groups, or kReflectionSnapshotNone
+        uint32_t containerVarLayout;                ///< For parameter groups, or kReflectionSnapshotNone
+        uint64_t elementCount;                      ///< For arrays and vectors
+        ReflectionSnapshotRange fields;             ///< Variable layouts, for structs
+        ReflectionSnapshotRange sizes;              ///< A size for each category the type uses
+    };
+
+    struct ReflectionSnapshotVarLayout
+    {
+        uint32_t name;                              ///< A string
+        uint32_t typeLayout;                        ///< kReflectionSnapshotNone if there isn't one
+        uint32_t semanticName;                      ///< A string, empty if there isn't a semantic
+        uint32_t semanticIndex;
+        uint32_t stage;                             ///< SlangStage
+        uint32_t reserved;
+        ReflectionSnapshotRange offsets;            ///< An offset for each category the variable uses
+    };
+
+    struct ReflectionSnapshotEntryPoint
+    {
+        uint32_t name;                              ///< A string
+        uint32_t nameOverride;                      ///< A string
+        uint32_t stage;                             ///< SlangStage
+        uint32_t varLayout;                         ///< The offsets and type of all of the parameters, or kReflectionSnapshotNone
+        uint32_t resultVarLayout;                   ///< kReflectionSnapshotNone if there is no result
+        uint32_t usesAnySampleRateInput;
+        uint32_t hasDefaultConstantBuffer;
+        uint32_t threadGroupSize[3];
+        ReflectionSnapshotRange parameters;         ///< Variable layouts
+    };
+
+    struct ReflectionSnapshotHeader
+    {
+        uint32_t magic;                             ///< kReflectionSnapshotMagic
+        uint32_t version;                           ///< kReflectionSnapshotVersion
+        uint32_t size;                              ///< The size of the snapshot in bytes
+
+        uint32_t globalParamsVarLayout;             ///< kReflectionSnapshotNone if there isn't one
+        ReflectionSnapshotRange parameters;         ///< The global parameters, as variable layouts
+
+        ReflectionSnapshotTable strings;            ///< Chars of zero terminated strings. A string is an offset in the table.
+        ReflectionSnapshotTable typeLayouts;
+        ReflectionSnapshotTable varLayouts;
+        ReflectionSnapshotTable sizes;
+        ReflectionSnapshotTable offsets;
+        ReflectionSnapshotTable entryPoints;
+    };
+
+        /// Reads a reflection snapshot, in memory owned by the caller.
+        ///
+        /// All of the indices in a snapshot are checked by `init`, so once it has succeeded,
+        /// any index read from the snapshot can be used without checking it.
+    class ReflectionSnapshot
+    {
+    public:
+            /// Returns false if `data` isn't a snapshot with this version of the format
+        bool init(const void* data, size_t size)
+        {
+            m_data = nullptr;
+            if (!data || size < sizeof(ReflectionSnapshotHeader) || (size_t(data) & 7) != 0)
+            {
+                return false;
+            }
+            m_data = (const uint8_t*)data;
+            const ReflectionSnapshotHeader* header = getHeader();
+            if (header->magic != kReflectionSnapshotMagic ||
+                header->version != kReflectionSnapshotVersion ||
+                header->size > size ||
+                !_isValid())
+            {
+                m_data = nullptr;
+                return false;
+            }
+            return true;
+        }
+
+        bool isValid() const { return m_data != nullptr; }
+
+        const ReflectionSnapshotHeader* getHeader() const { return (const ReflectionSnapshotHeader*)m_data; }
+
+        const char* getString(uint32_t string) const { return _getTable<char>(getHeader()->strings) + string; }
+
+        uint32_t getTypeLayoutCount() const { return getHeader()->typeLayouts.count; }
+        const ReflectionSnapshotTypeLayout& getTypeLayout(uint32_t index) const { return _getTable<ReflectionSnapshotTypeLayout>(getHeader()->typeLayouts)[index]; }
+
+        uint32_t getVarLayoutCount() const { return getHeader()->varLayouts.count; }
+        const ReflectionSnapshotVarLayout& getVarLayout(uint32_t index) const { return _getTable<ReflectionSnapshotVarLayout>(getHeader()->varLayouts)[index]; }
+
+        uint32_t getEntryPointCount() const { return getHeader()->entryPoints.count; }
+        const ReflectionSnapshotEntryPoint& getEntryPoint(uint32_t index) const { return _getTable<ReflectionSnapshotEntryPoint>(getHeader()->entryPoints)[index]; }
+
+        const ReflectionSnapshotSize& getSize(uint32_t index) const { return _getTable<ReflectionSnapshotSize>(getHeader()->sizes)[index]; }
+        const ReflectionSnapshotOffset& getOffset(uint32_t index) const { return _getTable<ReflectionSnapshotOffset>(getHeader()->offsets)[index]; }
+
+            /// The global parameters
+        uint32_t getParameterCount() const { return getHeader()->parameters.count; }
+        const ReflectionSnapshotVarLayout& getParameter(uint32_t index) const { return getVarLayout(getHeader()->parameters.start + index); }
+
+        const ReflectionSnapshotVarLayout& getField(const ReflectionSnapshotTypeLayout& typeLayout, uint32_t index) const { return getVarLayout(typeLayout.fields.start + index); }
+
+        const ReflectionSnapshotVarLayout& getEntryPointParameter(const ReflectionSnapshotEntryPoint& entryPoint, uint32_t index) const { return getVarLayout(entryPoint.parameters.start + index); }
+
+            /// Find the entry point called `name`, or returns nullptr
+        const ReflectionSnapshotEntryPoint* findEntryPointByName(const char* name) const
+        {
+            for (uint32_t i = 0; i < getEntryPointCount(); ++i)
+            {
+                const ReflectionSnapshotEntryPoint& entryPoint = getEntryPoint(i);
+                if (_isEqual(getString(entryPoint.name), name))
+                {
+                    return &entryPoint;
+                }
+            }
+            return nullptr;
+        }
+
+            /// Get the size of `typeLayout` for `category`. Returns 0 if the type doesn't use the category.
+        uint64_t getSize(const ReflectionSnapshotTypeLayout& typeLayout, SlangParameterCategory category) const
+        {
+            for (uint32_t i = 0; i < typeLayout.sizes.count; ++i)
+            {
+                const ReflectionSnapshotSize& size = getSize(typeLayout.sizes.start + i);
+                if (size.category == uint32_t(category))
+                {
+                    return size.size;
+                }
+            }
+            return 0;
+        }
+
+            /// Find the offset of `varLayout` for `category`, or returns nullptr if the variable doesn't use the category
+        const ReflectionSnapshotOffset* findOffset(const ReflectionSnapshotVarLayout& varLayout, SlangParameterCategory category) const
+        {
+            for (uint32_t i = 0; i < varLayout.offsets.count; ++i)
+            {
+                const ReflectionSnapshotOffset& offset = getOffset(varLayout.offsets.start + i);
+                if (offset.category == uint32_t(category))
+                {
+                    return &offset;
+                }
+            }
+            return nullptr;
+        }
+
+    protected:
+        template <typename T>
+        const T* _getTable(const ReflectionSnapshotTable& table) const { return (const T*)(m_data + table.offset); }
+
+        template <typename T>
+        bool _isValidTable(const ReflectionSnapshotTable& table) const
+        {
+            const uint32_t size = getHeader()->size;
+            return (table.offset % alignof(T)) == 0 &&
+                table.offset <= size &&
+                table.count <= (size - table.offset) / sizeof(T);
+        }
+
+        static bool _isValidRange(const ReflectionSnapshotRange& range, uint32_t count)
+        {
+            return range.start <= count && range.count <= count - range.start;
+        }
+
+        static bool _isValidIndex(uint32_t index, uint32_t count, bool allowNone)
+        {
+            return index < count || (allowNone && index == kReflectionSnapshotNone);
+        }
+
+        bool _isValidString(uint32_t string) const { return string < getHeader()->strings.count; }
+
+        static bool _isEqual(const char* a, const char* b)
+        {
+            for (; *a == *b; ++a, ++b)
+            {
+                if (*a == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool _isValid() const
+        {
+            const ReflectionSnapshotHeader* header = getHeader();
+            if (!_isValidTable<char>(header->strings) ||
+                !_isValidTable<ReflectionSnapshotTypeLayout>(header->typeLayouts) ||
+                !_isValidTable<ReflectionSnapshotVarLayout>(header->varLayouts) ||
+                !_isValidTable<ReflectionSnapshotSize>(header->sizes) ||
+                !_isValidTable<ReflectionSnapshotOffset>(header->offsets) ||
+                !_isValidTable<ReflectionSnapshotEntryPoint>(header->entryPoints))
+            {
+                return false;
+            }
+
+            // Every string must be terminated
+            if (header->strings.count == 0 || getString(0)[header->strings.count - 1] != 0)
+            {
+                return false;
+            }
+
+            const uint32_t typeLayoutCount = header->typeLayouts.count;
+            const uint32_t varLayoutCount = header->varLayouts.count;
+
+            if (!_isValidIndex(header->globalParamsVarLayout, varLayoutCount, true) ||
+                !_isValidRange(header->parameters, varLayoutCount))
+            {
+                return false;
+            }
+
+            for (uint32_t i = 0; i < typeLayoutCount; ++i)
+            {
+                const ReflectionSnapshotTypeLayout& typeLayout = getTypeLayout(i);
+                if (!_isValidString(typeLayout.name) ||
+                    !_isValidIndex(typeLayout.elementTypeLayout, typeLayoutCount, true) ||
+                    !_isValidIndex(typeLayout.elementVarLayout, varLayoutCount, true) ||
+                    !_isValidIndex(typeLayout.containerVarLayout, varLayoutCount, true) ||
+                    !_isValidRange(typeLayout.fields, varLayoutCount) ||
+                    !_isValidRange(typeLayout.sizes, header->sizes.count))
+                {
+                    return false;
+                }
+            }
+
+            for (uint32_t i = 0; i < varLayoutCount; ++i)
+            {
+                const ReflectionSnapshotVarLayout& varLayout = getVarLayout(i);
+                if (!_isValidString(varLayout.name) ||
+                    !_isValidString(varLayout.semanticName) ||
+                    !_isValidIndex(varLayout.typeLayout, typeLayoutCount, true) ||
+                    !_isValidRange(varLayout.offsets, header->offsets.count))
+                {
+                    return false;
+                }
+            }
+
+            for (uint32_t i = 0; i < header->entryPoints.count; ++i)
+            {
+                const ReflectionSnapshotEntryPoint& entryPoint = getEntryPoint(i);
+                if (!_isValidString(entryPoint.name) ||
+                    !_isValidString(entryPoint.nameOverride) ||
+                    !_isValidIndex(entryPoint.varLayout, varLayoutCount, true) ||
+                    !_isValidIndex(entryPoint.resultVarLayout, varLayoutCount, true) ||
+                    !_isValidRange(entryPoint.parameters, varLayoutCount))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const uint8_t* m_data = nullptr;
+    };
+}
+
+#endif
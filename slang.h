@@ -671,6 +671,11 @@ extern "C"
         /* Obfuscate shader names on release products */
         SLANG_COMPILE_FLAG_OBFUSCATE = 1 << 5,
 
+        /* Run the downstream compiles of the targets and entry points (such as with dxc or glslang)
+        in parallel. Linking and emitting the code that is passed to them is still serial.
+        Output and diagnostics are the same as for a serial compile. */
+        SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE = 1 << 6,
+
         /* Deprecated flags: kept around to allow existing applications to
         compile. Note that the relevant features will still be left in
         their default state. */
@@ -2433,6 +2438,12 @@ extern "C"
     SLANG_API SlangReflectionVariableLayout* spReflection_getGlobalParamsVarLayout(
         SlangReflection* reflection);
 
+        /// Get a snapshot of the reflection information, as a blob that holds no pointers.
+        /// The snapshot is made on the first call, and can be read with `slang-reflection-snapshot.h`.
+    SLANG_API SlangResult spReflection_getSnapshot(
+        SlangReflection* reflection,
+        ISlangBlob** outBlob);
+
 #ifdef __cplusplus
 }
 
@@ -3333,6 +3344,11 @@ namespace slang
         {
             return (VariableLayoutReflection*) spReflection_getGlobalParamsVarLayout((SlangReflection*) this);
         }
+
+        SlangResult getSnapshot(ISlangBlob** outBlob)
+        {
+            return spReflection_getSnapshot((SlangReflection*) this, outBlob);
+        }
     };
 
     typedef uint32_t CompileStdLibFlags;
@@ -3356,6 +3372,51 @@ namespace slang
     struct SpecializationArg;
     struct TargetDesc;
 
+        /** Stores the code generated for entry points, so compiling the same entry point again can be skipped.
+
+        Keys are the hashes computed by `IComponentType::getEntryPointHash`, which cover the source of every
+        module the entry point depends on, the session options and the target. An application can implement
+        this interface to store results in its own way, or use one created by
+        `IGlobalSession::createCompileResultCache`.
+
+        Implementations must allow calls from multiple threads at the same time.
+        */
+    struct ICompileResultCache : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(0x3c2d0a51, 0x6b7e, 0x4f0a, { 0x9d, 0x41, 0x58, 0xe2, 0x1f, 0x7a, 0xc3, 0x06 })
+
+            /** Find the code stored for `key`.
+            @param key The entry point hash
+            @param outCode Holds the code if found
+            @return SLANG_OK if found, SLANG_E_NOT_FOUND otherwise
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL readEntry(ISlangBlob* key, ISlangBlob** outCode) = 0;
+
+            /** Store the code for `key`. The cache may discard entries at any time.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeEntry(ISlangBlob* key, ISlangBlob* code) = 0;
+    };
+    #define SLANG_UUID_ICompileResultCache ICompileResultCache::getTypeGuid()
+
+        /** Describes a compile result cache created by `IGlobalSession::createCompileResultCache`.
+        */
+    struct CompileResultCacheDesc
+    {
+            /** The size of this structure, in bytes.
+             */
+        size_t structureSize = sizeof(CompileResultCacheDesc);
+
+            /** If set, entries are stored in files in this directory, and can be shared with
+            other processes. Otherwise entries are only held in memory.
+            */
+        char const* directory = nullptr;
+
+            /** The most entries held. When full, the least recently used entries are discarded.
+            0 means there is no limit.
+            */
+        SlangInt maxEntryCount = 0;
+    };
+
         /** A global session for interaction with the Slang library.
 
         An application may create and re-use a single global session across
@@ -3564,6 +3625,52 @@ namespace slang
              */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL setSPIRVCoreGrammar(
             char const* jsonPath) = 0;
+
+            /** Enable or disable recording of the time spent in each part of the compiler.
+            The profiler is shared by all sessions in the process, and is disabled by default.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setPerformanceProfilingEnabled(bool enable) = 0;
+
+            /** Get all of the events recorded by the profiler, in the Chrome trace event JSON format.
+            The result can be viewed with chrome://tracing or https://ui.perfetto.dev
+            Can be called whilst other threads are compiling.
+            @param outTrace Holds the JSON text
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceTrace(ISlangBlob** outTrace) = 0;
+
+            /** Discard all of the events recorded by the profiler so far.
+            Should only be called when no compilation is in progress.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL clearPerformanceTrace() = 0;
+
+            /** Create a cache of entry point code, held in memory or in a directory.
+            @param desc Describes the cache
+            @param outCache Holds the cache, which can be passed to `setCompileResultCache`
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL createCompileResultCache(
+            CompileResultCacheDesc const&   desc,
+            ICompileResultCache**           outCache) = 0;
+
+            /** Set the cache consulted by `IComponentType::getEntryPointCode` for every session
+            created from this global session. When the code for an entry point is found in the
+            cache, linking and code generation are skipped. Pass nullptr to stop caching (the default).
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setCompileResultCache(ICompileResultCache* cache) = 0;
+
+            /** Get how often overload resolution for calls to stdlib functions and operators was
+            satisfied by a cached result, over all sessions created from this global session.
+            Results are cached for calls whose arguments are scalars, vectors or matrices.
+            @param outHitCount Holds the number of calls resolved from the cache
+            @param outMissCount Holds the number of calls resolved in full, and added to the cache
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL getOverloadResolutionCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount) = 0;
+
+            /** Get how often imported modules were loaded from a module cache (see
+            `SessionDesc::moduleCacheDirectory`), over all sessions created from this global session.
+            @param outHitCount Holds the number of modules loaded from a cache
+            @param outMissCount Holds the number of modules compiled from source, and added to a cache
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL getModuleCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount) = 0;
     };
 
     #define SLANG_UUID_IGlobalSession IGlobalSession::getTypeGuid()
@@ -4268,6 +4375,12 @@ namespace slang
 
         bool enableEffectAnnotations = false;
         bool allowGLSLSyntax = false;
+
+            /** If set, the serialized AST and IR of `import`ed modules are cached in this
+            directory, and reused by later sessions if the module's source files, imports
+            and the session options that affect checking are unchanged.
+            */
+        char const* moduleCacheDirectory = nullptr;
     };
 
     enum class ContainerType
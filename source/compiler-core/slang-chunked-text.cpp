@@ -0,0 +1,214 @@
+#include "slang-chunked-text.h"
+
+#include "../core/slang-math.h"
+
+#include <algorithm>
+
+namespace Slang
+{
+
+// Get the offsets of the starts of the lines in `text`. Lines end with "\n", "\r", "\r\n" or "\n\r", as
+// with `StringUtil::calcLines`.
+static void _calcLineStarts(UnownedStringSlice text, List<Index>& outLineStarts)
+{
+    outLineStarts.clear();
+    outLineStarts.add(0);
+    const Index length = text.getLength();
+    for (Index i = 0; i < length;)
+    {
+        const char c = text[i++];
+        if (c == '\r' || c == '\n')
+        {
+            if (i < length && (c ^ text[i]) == ('\r' ^ '\n'))
+                i++;
+            outLineStarts.add(i);
+        }
+    }
+}
+
+/* static */void ChunkedText::_appendChunks(UnownedStringSlice text, bool isLast, List<Chunk>& outChunks)
+{
+    List<Index> lineStarts;
+    _calcLineStarts(text, lineStarts);
+
+    // A line starting at the very end belongs to the next chunk, unless this is the end of the text.
+    if (!isLast && lineStarts.getCount() > 1 && lineStarts.getLast() == text.getLength())
+        lineStarts.removeLast();
+
+    Index lineIndex = 0;
+    while (lineIndex < lineStarts.getCount())
+    {
+        const Index chunkStart = lineStarts[lineIndex];
+        Index endLineIndex = lineIndex + 1;
+        while (endLineIndex < lineStarts.getCount() && lineStarts[endLineIndex] - chunkStart < kChunkSize)
+            endLineIndex++;
+        const Index chunkEnd = endLineIndex < lineStarts.getCount() ? lineStarts[endLineIndex] : text.getLength();
+
+        Chunk chunk;
+        chunk.text = text.subString(chunkStart, chunkEnd - chunkStart);
+        for (Index i = lineIndex; i < endLineIndex; i++)
+            chunk.lineStarts.add(lineStarts[i] - chunkStart);
+        outChunks.add(_Move(chunk));
+
+        lineIndex = endLineIndex;
+    }
+}
+
+void ChunkedText::_ensureChunkIndex()
+{
+    if (m_chunks.getCount() == 0)
+    {
+        Chunk chunk;
+        chunk.lineStarts.add(0);
+        m_chunks.add(chunk);
+        m_validChunkIndexCount = 0;
+    }
+
+    const Index count = m_chunks.getCount();
+    if (m_validChunkIndexCount == count)
+        return;
+
+    m_chunkOffsets.setCount(count);
+    m_chunkLines.setCount(count);
+    if (m_validChunkIndexCount == 0)
+    {
+        m_chunkOffsets[0] = 0;
+        m_chunkLines[0] = 0;
+        m_validChunkIndexCount = 1;
+    }
+    for (Index i = m_validChunkIndexCount; i < count; i++)
+    {
+        m_chunkOffsets[i] = m_chunkOffsets[i - 1] + m_chunks[i - 1].text.getLength();
+        m_chunkLines[i] = m_chunkLines[i - 1] + m_chunks[i - 1].lineStarts.getCount();
+    }
+    m_validChunkIndexCount = count;
+}
+
+Index ChunkedText::_getChunkIndexForOffset(Index offset)
+{
+    _ensureChunkIndex();
+    const Index index = Index(std::upper_bound(m_chunkOffsets.begin(), m_chunkOffsets.end(), offset) - m_chunkOffsets.begin()) - 1;
+    return Math::Clamp(index, Index(0), m_chunks.getCount() - 1);
+}
+
+Index ChunkedText::_getChunkIndexForLine(Index line)
+{
+    _ensureChunkIndex();
+    const Index index = Index(std::upper_bound(m_chunkLines.begin(), m_chunkLines.end(), line) - m_chunkLines.begin()) - 1;
+    return Math::Clamp(index, Index(0), m_chunks.getCount() - 1);
+}
+
+Index ChunkedText::getLineCount()
+{
+    _ensureChunkIndex();
+    return m_chunkLines.getLast() + m_chunks.getLast().lineStarts.getCount();
+}
+
+Index ChunkedText::getLength()
+{
+    _ensureChunkIndex();
+    return m_chunkOffsets.getLast() + m_chunks.getLast().text.getLength();
+}
+
+const String& ChunkedText::getText()
+{
+    if (!m_isTextValid)
+    {
+        StringBuilder sb;
+        for (const auto& chunk : m_chunks)
+            sb << chunk.text;
+        m_text = sb.produceString();
+        m_isTextValid = true;
+    }
+    return m_text;
+}
+
+void ChunkedText::setText(const String& text)
+{
+    m_chunks.clear();
+    _appendChunks(text.getUnownedSlice(), true, m_chunks);
+    m_validChunkIndexCount = 0;
+    m_text = text;
+    m_isTextValid = true;
+}
+
+ChunkedText::LineChange ChunkedText::replaceText(Index startOffset, Index endOffset, UnownedStringSlice newText)
+{
+    const Index length = getLength();
+    startOffset = startOffset == -1 ? 0 : Math::Clamp(startOffset, Index(0), length);
+    endOffset = endOffset == -1 ? length : Math::Clamp(endOffset, startOffset, length);
+
+    // Only the chunks holding the replaced range are rebuilt. The range is within the chunk holding
+    // `endOffset`, so the rebuilt text still ends with the line break that ended that chunk.
+    Index firstChunk = _getChunkIndexForOffset(startOffset);
+    const Index lastChunk = _getChunkIndexForOffset(endOffset);
+
+    StringBuilder originalBuilder;
+    for (Index i = firstChunk; i <= lastChunk; i++)
+        originalBuilder << m_chunks[i].text;
+    auto original = originalBuilder.getUnownedSlice();
+    const Index regionStart = m_chunkOffsets[firstChunk];
+
+    StringBuilder regionBuilder;
+    regionBuilder << original.head(startOffset - regionStart) << newText << original.tail(endOffset - regionStart);
+    String region = regionBuilder.produceString();
+
+    // A line break at the start may now pair with the one ending the previous chunk.
+    if (firstChunk > 0 && region.getLength() > 0 && (region[0] == '\r' || region[0] == '\n'))
+    {
+        firstChunk--;
+        region = m_chunks[firstChunk].text + region;
+    }
+
+    List<Chunk> newChunks;
+    _appendChunks(region.getUnownedSlice(), lastChunk == m_chunks.getCount() - 1, newChunks);
+
+    LineChange change;
+    change.firstLine = m_chunkLines[firstChunk];
+    for (Index i = firstChunk; i <= lastChunk; i++)
+        change.oldLineCount += m_chunks[i].lineStarts.getCount();
+    for (const auto& chunk : newChunks)
+        change.newLineCount += chunk.lineStarts.getCount();
+
+    m_chunks.removeRange(firstChunk, lastChunk - firstChunk + 1);
+    m_chunks.insertRange(firstChunk, newChunks);
+    m_validChunkIndexCount = Math::Min(m_validChunkIndexCount, firstChunk);
+    m_text = String();
+    m_isTextValid = false;
+    return change;
+}
+
+Index ChunkedText::getLineStart(Index line)
+{
+    const Index chunkIndex = _getChunkIndexForLine(line);
+    return m_chunkOffsets[chunkIndex] + m_chunks[chunkIndex].lineStarts[line - m_chunkLines[chunkIndex]];
+}
+
+Index ChunkedText::getLineForOffset(Index offset, Index& outLineStart)
+{
+    const Index chunkIndex = _getChunkIndexForOffset(offset);
+    const auto& lineStarts = m_chunks[chunkIndex].lineStarts;
+    const Index chunkOffset = m_chunkOffsets[chunkIndex];
+    const Index lineInChunk = Index(std::upper_bound(lineStarts.begin(), lineStarts.end(), offset - chunkOffset) - lineStarts.begin()) - 1;
+    outLineStart = chunkOffset + lineStarts[lineInChunk];
+    return m_chunkLines[chunkIndex] + lineInChunk;
+}
+
+UnownedStringSlice ChunkedText::getLineWithEnd(Index line)
+{
+    const Index chunkIndex = _getChunkIndexForLine(line);
+    const auto& chunk = m_chunks[chunkIndex];
+    const Index lineInChunk = line - m_chunkLines[chunkIndex];
+    const Index start = chunk.lineStarts[lineInChunk];
+    const Index end = lineInChunk + 1 < chunk.lineStarts.getCount() ? chunk.lineStarts[lineInChunk + 1] : chunk.text.getLength();
+    return chunk.text.getUnownedSlice().subString(start, end - start);
+}
+
+UnownedStringSlice ChunkedText::getChunkText(Index offset, Index& outChunkStart)
+{
+    const Index chunkIndex = _getChunkIndexForOffset(offset);
+    outChunkStart = m_chunkOffsets[chunkIndex];
+    return m_chunks[chunkIndex].text.getUnownedSlice();
+}
+
+}
@@ -0,0 +1,81 @@
+#ifndef SLANG_COMPILER_CORE_CHUNKED_TEXT_H
+#define SLANG_COMPILER_CORE_CHUNKED_TEXT_H
+
+#include "../core/slang-string.h"
+#include "../core/slang-list.h"
+
+namespace Slang
+{
+
+/* Text that is edited in place, such as a document open in the language server.
+
+The text is held as a list of chunks of whole lines, so an edit only rebuilds the chunks it touches, rather
+than the whole text. Lines end with "\n", "\r", "\r\n" or "\n\r", as with `StringUtil::calcLines`, and
+lines and offsets are 0-based. */
+class ChunkedText
+{
+public:
+        /// The lines an edit replaced
+    struct LineChange
+    {
+        Index firstLine = 0;        ///< The first line that changed
+        Index oldLineCount = 0;     ///< The number of lines from `firstLine` that were replaced
+        Index newLineCount = 0;     ///< The number of lines that replaced them
+    };
+
+        /// Get the whole text. This makes a contiguous copy the first time it is called after an edit.
+    const String& getText();
+        /// Replace all of the text
+    void setText(const String& text);
+        /// Replace the text between the offsets `startOffset` and `endOffset`. An offset of -1 means
+        /// the start or end of the text respectively.
+    LineChange replaceText(Index startOffset, Index endOffset, UnownedStringSlice newText);
+
+        /// Get the number of lines. Text that is empty, or ends with a line break, ends with an empty line.
+    Index getLineCount();
+        /// Get the length of the text
+    Index getLength();
+
+        /// Get the offset of the start of `line`, which must be less than the line count
+    Index getLineStart(Index line);
+        /// Get the line holding `offset`, and the offset of its start
+    Index getLineForOffset(Index offset, Index& outLineStart);
+        /// Get `line` including its line break, if it has one. Valid until the text is next changed.
+    UnownedStringSlice getLineWithEnd(Index line);
+
+        /// Get the text of the chunk holding `offset`, and the offset of its start. Chunks hold whole lines,
+        /// so anything that doesn't span lines (such as an identifier) is within one chunk. Valid until the
+        /// text is next changed.
+    UnownedStringSlice getChunkText(Index offset, Index& outChunkStart);
+
+protected:
+    struct Chunk
+    {
+        String text;
+            /// The offset within `text` of the start of each line that starts in the chunk
+        List<Index> lineStarts;
+    };
+
+        /// Chunks are split at the first line start after they reach this size
+    static const Index kChunkSize = 4096;
+
+    void _ensureChunkIndex();
+    Index _getChunkIndexForOffset(Index offset);
+    Index _getChunkIndexForLine(Index line);
+    static void _appendChunks(UnownedStringSlice text, bool isLast, List<Chunk>& outChunks);
+
+    List<Chunk> m_chunks;
+        /// The offset and line of the start of each chunk. Only the first `m_validChunkIndexCount`
+        /// entries are up to date.
+    List<Index> m_chunkOffsets;
+    List<Index> m_chunkLines;
+    Index m_validChunkIndexCount = 0;
+
+        /// A contiguous copy of the text, made when first asked for after an edit
+    String m_text;
+    bool m_isTextValid = false;
+};
+
+}
+
+#endif
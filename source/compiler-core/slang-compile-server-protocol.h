@@ -0,0 +1,42 @@
+#ifndef SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+#define SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+
+#include "../../slang.h"
+
+#include "../core/slang-rtti-info.h"
+#include "slang-json-value.h"
+
+/* The protocol used between slangc and a slangc compile server (`slangc -compile-server <path>`).
+Messages are JSON-RPC, sent over a local socket with HTTP style framing (ie through JSONRPCConnection). */
+
+namespace CompileServerProtocol {
+
+using namespace Slang;
+
+struct CompileArgs
+{
+    String workingDirectory;                    ///< The working directory of the client. Relative paths in args are relative to this.
+    List<String> args;                          ///< The slangc command line arguments, not including the executable name
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct QuitArgs
+{
+    static const UnownedStringSlice g_methodName;
+};
+
+struct CompileResult
+{
+    String stdOut;
+    String stdError;                            ///< Holds diagnostics as well as anything written to std error
+    int32_t result = SLANG_OK;
+    int32_t returnCode = 0;                     ///< As returned if invoked as command line
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+} // namespace CompileServerProtocol
+
+#endif // SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
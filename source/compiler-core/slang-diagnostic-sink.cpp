@@ -601,17 +601,53 @@ Severity DiagnosticSink::getEffectiveMessageSeverity(DiagnosticInfo const& info)
 
 bool DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int argCount, DiagnosticArg const* args)
 {
+    StringBuilder sb;
+    formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
+
+    // Record before overriding, as the overrides may be different when it is reported again
+    bool isOutput = true;
+    if (auto recording = m_recording)
+    {
+        RecordedDiagnostic recordedDiagnostic;
+        recordedDiagnostic.loc = pos;
+        recordedDiagnostic.id = info.id;
+        recordedDiagnostic.severity = info.severity;
+        recordedDiagnostic.message = sb;
+        recording->m_diagnostics.add(recordedDiagnostic);
+
+        isOutput = recording->m_isOutput;
+        for (auto parent = recording->m_parent; isOutput && parent; parent = parent->m_parent)
+        {
+            if (!parent->m_isOutput)
+            {
+                parent->m_diagnostics.add(recordedDiagnostic);
+                isOutput = false;
+            }
+        }
+    }
+
     // Override the severity in the 'info' structure to pass it further into formatDiagnostics
     info.severity = getEffectiveMessageSeverity(info);
 
     if (info.severity == Severity::Disable)
         return false;
 
-    StringBuilder messageBuilder;
+    if (!isOutput)
     {
-        StringBuilder sb;
-        formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
+        // Errors are still counted, as callers use the count to detect failure
+        if (info.severity >= Severity::Error)
+        {
+            m_errorCount++;
+        }
+        if (info.severity >= Severity::Fatal)
+        {
+            SLANG_ABORT_COMPILATION("");
+        }
+        return true;
+    }
 
+    StringBuilder messageBuilder;
+    {
         Diagnostic diagnostic;
         diagnostic.ErrorID = info.id;
         diagnostic.Message = sb.produceString();
@@ -625,6 +661,39 @@ bool DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int
     return diagnoseImpl(info, messageBuilder.getUnownedSlice());
 }
 
+bool DiagnosticSink::diagnoseRecorded(const RecordedDiagnostic& diagnostic)
+{
+    // The message already has the arguments substituted
+    DiagnosticInfo info;
+    info.id = diagnostic.id;
+    info.severity = diagnostic.severity;
+    info.name = "recorded";
+    info.messageFormat = "$0";
+
+    DiagnosticArg arg(diagnostic.message);
+    return diagnoseImpl(diagnostic.loc, info, 1, &arg);
+}
+
+DiagnosticSink::Recording::Recording(DiagnosticSink* sink, bool isOutput)
+    : m_sink(sink)
+    , m_parent(sink->m_recording)
+    , m_isOutput(isOutput)
+    , m_errorCountAtStart(sink->m_errorCount)
+{
+    sink->m_recording = this;
+}
+
+DiagnosticSink::Recording::~Recording()
+{
+    SLANG_ASSERT(m_sink->m_recording == this);
+    m_sink->m_recording = m_parent;
+
+    if (!m_isOutput)
+    {
+        m_sink->m_errorCount = m_errorCountAtStart;
+    }
+}
+
 void DiagnosticSink::diagnoseRaw(
     Severity    severity,
     char const* message)
@@ -162,6 +162,44 @@ public:
         /// will only display a caret at the SourceLoc
     typedef UnownedStringSlice(*SourceLocationLexer)(const UnownedStringSlice& text);
 
+        /// A diagnostic as it was reported, before any severity override was applied, so that it can be reported again
+    struct RecordedDiagnostic
+    {
+        SourceLoc loc;
+        int id = -1;
+        Severity severity = Severity::Note;
+        String message;                         ///< The message, with the arguments substituted
+    };
+
+        /// Records the diagnostics reported to a sink whilst it is alive. Recordings nest, and the innermost one
+        /// gets every diagnostic.
+        ///
+        /// If `isOutput` is set, the diagnostics are also output as usual, unless there is an enclosing recording
+        /// that doesn't output, in which case the nearest such recording gets them instead. Otherwise they are
+        /// not output, and the error count is restored when the recording ends, so they can be discarded or
+        /// reported again with `diagnoseRecorded`.
+    class Recording
+    {
+    public:
+        const List<RecordedDiagnostic>& getDiagnostics() const { return m_diagnostics; }
+        void clear() { m_diagnostics.clear(); }
+
+        Recording(DiagnosticSink* sink, bool isOutput);
+        ~Recording();
+
+    private:
+        friend class DiagnosticSink;
+
+        Recording(const Recording&) = delete;
+        void operator=(const Recording&) = delete;
+
+        DiagnosticSink* m_sink;
+        Recording* m_parent;
+        bool m_isOutput;
+        int m_errorCountAtStart;
+        List<RecordedDiagnostic> m_diagnostics;
+    };
+
         /// Get the total amount of errors that have taken place on this DiagnosticSink
     SLANG_FORCE_INLINE int getErrorCount() { return m_errorCount; }
 
@@ -193,6 +231,9 @@ public:
         return result;
     }
 
+        /// Report a recorded diagnostic again, with the severity overrides of this sink
+    bool diagnoseRecorded(const RecordedDiagnostic& diagnostic);
+
         // Add a diagnostic with raw text
         // (used when we get errors from a downstream compiler)
     void diagnoseRaw(Severity severity, char const* message);
@@ -288,6 +329,9 @@ protected:
     
     // Configuration that allows the user to control the severity of certain diagnostic messages
     Dictionary<int, Severity> m_severityOverrides;
+
+        /// The innermost active recording, or nullptr
+    Recording* m_recording = nullptr;
 };
 
     /// An `ISlangWriter` that writes directly to a diagnostic sink.
@@ -257,6 +257,14 @@ struct DownstreamCompileOptions
 
     // The debug info format to use. 
     SlangDebugInfoFormat m_debugInfoFormat = SLANG_DEBUG_INFO_FORMAT_DEFAULT;
+
+    /// Text that is compiled as if it was included at the start of each source, such as the C++ prelude.
+    /// The compiler may precompile it, and keep the result in `precompiledHeaderDirectory` to be used by later compiles.
+    /// Can only be set if the compiler supports it (see `DownstreamCompilerPrefixHeaderFeature`), and requires
+    /// `precompiledHeaderDirectory` to be set.
+    TerminatedCharSlice prefixHeader;
+    /// The directory where prefix headers, and their precompiled forms, are stored.
+    TerminatedCharSlice precompiledHeaderDirectory;
 };
 static_assert(std::is_trivially_copyable_v<DownstreamCompileOptions>);
 
@@ -314,6 +322,13 @@ public:
     virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() = 0;
 };
 
+/* Downstream compilers that use `DownstreamCompileOptions::prefixHeader` return non null from `castAs` with this guid.
+Compilers built before the option was added ignore it, so it must only be set if they do. */
+struct DownstreamCompilerPrefixHeaderFeature
+{
+    SLANG_COM_INTERFACE(0x3c5b2a6e, 0x7d1f, 0x4e8b, { 0x9a, 0x42, 0x61, 0x0d, 0xc3, 0x58, 0xe7, 0x2f })
+};
+
 class DownstreamCompilerBase : public ComBaseObject, public IDownstreamCompiler
 {
 public:
@@ -14,6 +14,7 @@
 #include "slang-artifact-diagnostic-util.h"
 #include "slang-artifact-util.h"
 #include "slang-artifact-representation-impl.h"
+#include "slang-prefix-header-util.h"
 
 namespace Slang
 {
@@ -454,13 +455,9 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
-/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+/* static */SlangResult GCCDownstreamCompilerUtil::calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine)
 {
-    SLANG_ASSERT(options.modulePath.count);
-
     PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
-        
-    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
     if (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP)
     {
@@ -520,11 +517,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         cmdLine.addArg("-g");
     }
 
-    if (options.flags & CompileOptions::Flag::Verbose)
-    {
-        cmdLine.addArg("-v");
-    }
-
     switch (options.floatingPointMode)
     {
         case FloatingPointMode::Default: break;
@@ -542,6 +534,110 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         }
     }
 
+    if (options.targetType == SLANG_SHADER_SHARED_LIBRARY &&
+        PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
+    {
+        // Position independent
+        cmdLine.addArg("-fPIC");
+    }
+
+    // Add defines
+    for (const auto& define : options.defines)
+    {
+        StringBuilder builder;
+
+        builder << "-D";
+        builder << define.nameWithSig;
+        if (define.value.count)
+        {
+            builder << "=" << asStringSlice(define.value);
+        }
+
+        cmdLine.addArg(builder);
+    }
+
+    // Add includes
+    for (const auto& include : options.includePaths)
+    {
+        cmdLine.addArg("-I");
+        cmdLine.addArg(asString(include));
+    }
+
+    return SLANG_OK;
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcPrefixHeaderArgs(const DownstreamCompilerDesc& desc, const CommandLine& compilerCmdLine, const CompileOptions& options, CommandLine& ioCmdLine)
+{
+    if (options.precompiledHeaderDirectory.count == 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // The command line to precompile the header, without the header and output paths
+    CommandLine pchCmdLine(compilerCmdLine);
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, pchCmdLine));
+    pchCmdLine.addArg("-x");
+    pchCmdLine.addArg((options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C) ? "c-header" : "c++-header");
+
+    // The key identifies the compiler, the arguments and the contents of the header
+    SHA1::Digest key;
+    {
+        StringBuilder buf;
+        buf << int(desc.type) << " ";
+        desc.version.append(buf);
+        buf << " ";
+        pchCmdLine.append(buf);
+
+        DigestBuilder<SHA1> builder;
+        builder.append(buf);
+        PrefixHeaderUtil::appendContents(options, builder);
+        key = builder.finalize();
+    }
+
+    // When a header is included with -include, gcc looks for a precompiled version with `.gch` appended.
+    // Clang also looks for `.pch`, which is the extension it uses.
+    const auto paths = PrefixHeaderUtil::calcPaths(options, key, (desc.type == SLANG_PASS_THROUGH_CLANG) ? "pch" : "gch");
+    SLANG_RETURN_ON_FAIL(PrefixHeaderUtil::requireHeader(options, paths));
+
+    if (!File::exists(paths.precompiledPath))
+    {
+        const String tempPath = PrefixHeaderUtil::calcTemporaryPath(paths.precompiledPath);
+
+        pchCmdLine.addArg(paths.headerPath);
+        pchCmdLine.addArg("-o");
+        pchCmdLine.addArg(tempPath);
+
+        // If the header can't be precompiled, the compile parses the header instead, and will report any errors in it.
+        ExecuteResult exeRes;
+        if (SLANG_FAILED(ProcessUtil::execute(pchCmdLine, exeRes)) ||
+            exeRes.resultCode != 0 ||
+            SLANG_FAILED(File::rename(tempPath, paths.precompiledPath)))
+        {
+            File::remove(tempPath);
+        }
+    }
+
+    // The precompiled header is used if it's valid for the compile, otherwise the header is parsed.
+    ioCmdLine.addArg("-include");
+    ioCmdLine.addArg(paths.headerPath);
+    return SLANG_OK;
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.modulePath.count);
+
+    PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
+        
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, cmdLine));
+
+    if (options.flags & CompileOptions::Flag::Verbose)
+    {
+        cmdLine.addArg("-v");
+    }
+
     StringBuilder moduleFilePath; 
     SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(targetDesc, asStringSlice(options.modulePath), moduleFilePath));
     
@@ -554,12 +650,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         {
             // Shared library
             cmdLine.addArg("-shared");
-
-            if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
-            {
-                // Position independent
-                cmdLine.addArg("-fPIC");
-            }
             break;
         }
         case SLANG_HOST_EXECUTABLE:
@@ -576,28 +666,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         default: break;
     }
 
-    // Add defines
-    for (const auto& define : options.defines)
-    {
-        StringBuilder builder;
-
-        builder << "-D";
-        builder << define.nameWithSig;
-        if (define.value.count)
-        {
-            builder << "=" << asStringSlice(define.value);
-        }
-
-        cmdLine.addArg(builder);
-    }
-
-    // Add includes
-    for (const auto& include : options.includePaths)
-    {
-        cmdLine.addArg("-I");
-        cmdLine.addArg(asString(include));
-    }
-
     // Link options
     if (0) // && options.targetType != TargetType::Object)
     {
@@ -614,6 +682,12 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
 
             // Linker flag to report any undefined symbols as a link error
             cmdLine.addArg("-Wl,--no-undefined");
+
+            // SharedLibrary loads with RTLD_GLOBAL, and libraries compiled from Slang often export
+            // the same names (every compute kernel has `computeMain_Group` for example). Bind the
+            // calls a library makes to its own exported functions to its own definitions, rather
+            // than to those of whichever library with the same names was loaded first.
+            cmdLine.addArg("-Wl,-Bsymbolic");
         }
     }
 
@@ -734,4 +808,26 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!*/
+
+void* GCCDownstreamCompiler::castAs(const Guid& guid)
+{
+    if (guid == DownstreamCompilerPrefixHeaderFeature::getTypeGuid())
+    {
+        return static_cast<IDownstreamCompiler*>(this);
+    }
+    return Super::castAs(guid);
+}
+
+SlangResult GCCDownstreamCompiler::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+{
+    SLANG_RETURN_ON_FAIL(Util::calcArgs(options, cmdLine));
+
+    if (options.prefixHeader.count)
+    {
+        SLANG_RETURN_ON_FAIL(Util::calcPrefixHeaderArgs(m_desc, m_cmdLine, options, cmdLine));
+    }
+    return SLANG_OK;
+}
+
 }
@@ -18,6 +18,14 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
         /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+        /// Calculate the arguments that control how source is compiled (as opposed to the inputs and products of the
+        /// compilation). Precompiled headers are built with the same arguments.
+    static SlangResult calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine);
+
+        /// Add the arguments to include the options prefix header. The header is precompiled by the compiler
+        /// `compilerCmdLine`, if it isn't already in the options cache directory.
+    static SlangResult calcPrefixHeaderArgs(const DownstreamCompilerDesc& desc, const CommandLine& compilerCmdLine, const CompileOptions& options, CommandLine& ioCmdLine);
+
         /// Parse ExecuteResult into diagnostics 
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
 
@@ -41,8 +49,11 @@ public:
     typedef CommandLineDownstreamCompiler Super;
     typedef GCCDownstreamCompilerUtil Util;
 
+    // ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
+
     // CommandLineCPPCompiler impl  - just forwards to the Util
-    virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) SLANG_OVERRIDE { return Util::calcArgs(options, cmdLine); }
+    virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) SLANG_OVERRIDE;
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, IArtifactDiagnostics* diagnostics) SLANG_OVERRIDE { return Util::parseOutput(exeResult, diagnostics); }
     virtual SlangResult calcCompileProducts(const CompileOptions& options, DownstreamProductFlags flags, IOSFileArtifactRepresentation* lockFile, List<ComPtr<IArtifact>>& outArtifacts) SLANG_OVERRIDE { return Util::calcCompileProducts(options, flags, lockFile, outArtifacts); }
 
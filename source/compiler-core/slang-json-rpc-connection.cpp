@@ -60,6 +60,10 @@ void JSONRPCConnection::clearBuffers()
 
 bool JSONRPCConnection::isActive()
 {
+    if (m_heldMessages.getCount() > 0)
+    {
+        return true;
+    }
     return m_connection->isActive() && (m_process == nullptr || !m_process->isTerminated());
 }
 
@@ -225,14 +229,52 @@ SlangResult JSONRPCConnection::sendCall(CallStyle callStyle, const UnownedString
 
 SlangResult JSONRPCConnection::waitForResult(Int timeOutInMs)
 {
-    SLANG_RETURN_ON_FAIL(m_connection->waitForResult(timeOutInMs));
+    // If there are held messages there is no need to wait
+    if (m_heldMessages.getCount() == 0)
+    {
+        SLANG_RETURN_ON_FAIL(m_connection->waitForResult(timeOutInMs));
+    }
     return tryReadMessage();
 }
 
+SlangResult JSONRPCConnection::_parseMessage(const UnownedStringSlice& text)
+{
+    clearBuffers();
+
+    const SlangResult res = JSONRPCUtil::parseJSON(text, &m_container, &m_diagnosticSink, m_jsonRoot);
+    if (SLANG_FAILED(res))
+    {
+        m_jsonRoot.reset();
+    }
+    return res;
+}
+
+JSONValue JSONRPCConnection::_getResponseId()
+{
+    const JSONRPCMessageType msgType = getMessageType();
+    if (msgType != JSONRPCMessageType::Result && msgType != JSONRPCMessageType::Error)
+    {
+        return JSONValue();
+    }
+    return getCurrentMessageId();
+}
+
 SlangResult JSONRPCConnection::tryReadMessage()
 {
     m_jsonRoot.reset();
 
+    // Messages held whilst waiting for a response are read first
+    if (m_heldMessages.getCount() > 0)
+    {
+        const String text = m_heldMessages[0].text;
+        m_heldMessages.removeAt(0);
+        if (SLANG_FAILED(_parseMessage(text.getUnownedSlice())))
+        {
+            return sendError(JSONRPC::ErrorCode::ParseError, JSONValue::makeNull());
+        }
+        return SLANG_OK;
+    }
+
     SLANG_RETURN_ON_FAIL(m_connection->update());
     if (!m_connection->hasContent())
     {
@@ -242,10 +284,8 @@ SlangResult JSONRPCConnection::tryReadMessage()
     auto content = m_connection->getContent();
     UnownedStringSlice slice((const char*)content.begin(), content.getCount());
 
-    clearBuffers();
-
     {
-        const SlangResult res = JSONRPCUtil::parseJSON(slice, &m_container, &m_diagnosticSink, m_jsonRoot);
+        const SlangResult res = _parseMessage(slice);
 
         // Consume that content/packet
         m_connection->consumeContent();
@@ -259,6 +299,68 @@ SlangResult JSONRPCConnection::tryReadMessage()
     return SLANG_OK;
 }
 
+SlangResult JSONRPCConnection::waitForResponse(const JSONValue& id, Int timeOutInMs)
+{
+    m_jsonRoot.reset();
+
+    // The response may have arrived whilst waiting for another
+    for (Index i = 0; i < m_heldMessages.getCount(); ++i)
+    {
+        if (m_container.areEqual(m_heldMessages[i].responseId, id))
+        {
+            const String text = m_heldMessages[i].text;
+            m_heldMessages.removeAt(i);
+            return _parseMessage(text.getUnownedSlice());
+        }
+    }
+
+    const int64_t clockFrequency = int64_t(Process::getClockFrequency());
+    const int64_t startTick = Process::getClockTick();
+
+    while (m_connection->isActive())
+    {
+        Int waitInMs = -1;
+        if (timeOutInMs >= 0)
+        {
+            const int64_t elapsedInMs = (int64_t(Process::getClockTick()) - startTick) * 1000 / clockFrequency;
+            if (elapsedInMs >= timeOutInMs)
+            {
+                break;
+            }
+            waitInMs = timeOutInMs - Int(elapsedInMs);
+        }
+
+        SLANG_RETURN_ON_FAIL(m_connection->waitForResult(waitInMs));
+        if (!m_connection->hasContent())
+        {
+            continue;
+        }
+
+        auto content = m_connection->getContent();
+        UnownedStringSlice slice((const char*)content.begin(), content.getCount());
+
+        HeldMessage heldMessage;
+        if (SLANG_SUCCEEDED(_parseMessage(slice)))
+        {
+            const JSONValue responseId = _getResponseId();
+            if (m_container.areEqual(responseId, id))
+            {
+                m_connection->consumeContent();
+                return SLANG_OK;
+            }
+            heldMessage.responseId = getPersistentValue(responseId);
+        }
+
+        // Hold onto it for a later read (which will also report if it couldn't be parsed)
+        heldMessage.text = slice;
+        m_heldMessages.add(heldMessage);
+        m_connection->consumeContent();
+        m_jsonRoot.reset();
+    }
+
+    return SLANG_OK;
+}
+
 JSONRPCMessageType JSONRPCConnection::getMessageType()
 {
     return JSONRPCUtil::getMessageType(&m_container, m_jsonRoot);
@@ -101,6 +101,11 @@ public:
         /// Will block for message/result up to time
     SlangResult waitForResult(Int timeOutInMs = -1);
 
+        /// Block until the response (result or error) to the call with `id` has been read, waiting at most `timeOutInMs`.
+        /// Messages that arrive before it are held, and returned in order by later reads. This allows several calls to be in flight.
+        /// `id` must not reference the connection's container (an integer id, or a persistent value, can be used).
+    SlangResult waitForResponse(const JSONValue& id, Int timeOutInMs = -1);
+
         /// If we have an JSON-RPC message m_jsonRoot the root.
     bool hasMessage() const { return m_jsonRoot.isValid(); }
 
@@ -132,7 +137,7 @@ public:
         /// Happens automatically on tryReadMessage/readMessage
     void clearBuffers();
 
-        /// True if this connection is active
+        /// True if this connection is active, or there are held messages to read
     bool isActive();
 
         /// Get the id of the current message
@@ -159,6 +164,11 @@ public:
 protected:
     CallStyle _getCallStyle(CallStyle callStyle) const { return (callStyle == CallStyle::Default) ? m_defaultCallStyle : callStyle; }
 
+        /// Parse `text` into m_jsonRoot
+    SlangResult _parseMessage(const UnownedStringSlice& text);
+        /// If the current message is a response returns its id, else an invalid value
+    JSONValue _getResponseId();
+
     RefPtr<Process> m_process;                       ///< Backing process (optional)
     RefPtr<HTTPPacketConnection> m_connection;       ///< The underlying 'transport' connection, whilst HTTP currently doesn't have to be 
 
@@ -169,6 +179,13 @@ protected:
 
     JSONValue m_jsonRoot;                           ///< The root JSON value for the currently read message. 
 
+    struct HeldMessage
+    {
+        String text;
+        PersistentJSONValue responseId;             ///< The id if the message is a response, else invalid
+    };
+    List<HeldMessage> m_heldMessages;               ///< Messages read while waiting for a response to another call, in order of arrival
+
     CallStyle m_defaultCallStyle = CallStyle::Array;    ///< The default calling style
     
     RttiTypeFuncsMap m_typeMap;
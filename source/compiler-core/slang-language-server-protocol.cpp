@@ -303,6 +303,7 @@ static const StructRttiInfo _makeInitializeParamsRtti()
     InitializeParams obj;
     StructRttiBuilder builder(&obj, "LanguageServerProtocol::InitializeParams", nullptr);
     builder.addField("workspaceFolders", &obj.workspaceFolders, StructRttiInfo::Flag::Optional);
+    builder.addField("trace", &obj.trace, StructRttiInfo::Flag::Optional);
     builder.ignoreUnknownFields();
     return builder.make();
 }
@@ -0,0 +1,369 @@
+// slang-local-socket.cpp
+#include "slang-local-socket.h"
+
+#include "../core/slang-io.h"
+
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <afunix.h>
+#   pragma comment(lib, "ws2_32")
+#else
+#   include <errno.h>
+#   include <poll.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+#include <string.h>
+
+namespace Slang
+{
+
+#ifdef _WIN32
+
+typedef SOCKET NativeSocket;
+typedef WSAPOLLFD NativePollFd;
+static const NativeSocket kInvalidSocket = INVALID_SOCKET;
+
+static int _poll(NativePollFd* fds, int count, int timeOutInMs) { return ::WSAPoll(fds, ULONG(count), timeOutInMs); }
+static void _closeSocket(NativeSocket socket) { ::closesocket(socket); }
+static bool _isWouldBlock() { return ::WSAGetLastError() == WSAEWOULDBLOCK; }
+
+static SlangResult _initSockets()
+{
+    // Winsock reference counts initialization, and is cleaned up on exit, so it's only initialized once.
+    static const int result = []()
+    {
+        WSADATA data;
+        return ::WSAStartup(MAKEWORD(2, 2), &data);
+    }();
+    return result == 0 ? SLANG_OK : SLANG_FAIL;
+}
+
+// Access to the socket is controlled by the ACL of the directory it is in
+static bool _isPeerSameUser(NativeSocket socket) { SLANG_UNUSED(socket); return true; }
+static SlangResult _restrictToUser(const String& path) { SLANG_UNUSED(path); return SLANG_OK; }
+static SlangResult _removeStaleSocket(const String& path) { File::remove(path); return SLANG_OK; }
+
+#else
+
+typedef int NativeSocket;
+typedef pollfd NativePollFd;
+static const NativeSocket kInvalidSocket = -1;
+
+static int _poll(NativePollFd* fds, int count, int timeOutInMs) { return ::poll(fds, nfds_t(count), timeOutInMs); }
+static void _closeSocket(NativeSocket socket) { ::close(socket); }
+static bool _isWouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+static SlangResult _initSockets() { return SLANG_OK; }
+
+// Only processes of the same user are allowed to talk to each other, as a compile server runs
+// arbitrary command lines, and a client trusts the files a server writes.
+static bool _isPeerSameUser(NativeSocket socket)
+{
+#if defined(SO_PEERCRED)
+    struct ucred credentials;
+    socklen_t size = sizeof(credentials);
+    if (::getsockopt(socket, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0)
+    {
+        return false;
+    }
+    return credentials.uid == ::geteuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (::getpeereid(socket, &uid, &gid) != 0)
+    {
+        return false;
+    }
+    return uid == ::geteuid();
+#endif
+}
+
+static SlangResult _restrictToUser(const String& path)
+{
+    return ::chmod(path.getBuffer(), S_IRUSR | S_IWUSR) == 0 ? SLANG_OK : SLANG_FAIL;
+}
+
+static SlangResult _removeStaleSocket(const String& path)
+{
+    struct stat info;
+    if (::lstat(path.getBuffer(), &info) != 0)
+    {
+        return SLANG_OK;
+    }
+    // Don't replace anything that isn't a socket
+    if (!S_ISSOCK(info.st_mode))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    File::remove(path);
+    return SLANG_OK;
+}
+
+#endif
+
+static NativeSocket _getNative(LocalSocketStream::Handle handle) { return NativeSocket(handle); }
+
+static SlangResult _makeAddress(const String& path, sockaddr_un& outAddress)
+{
+    ::memset(&outAddress, 0, sizeof(outAddress));
+    outAddress.sun_family = AF_UNIX;
+
+    // The path must fit, including the terminating zero
+    if (size_t(path.getLength()) >= sizeof(outAddress.sun_path))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    ::memcpy(outAddress.sun_path, path.getBuffer(), path.getLength());
+    return SLANG_OK;
+}
+
+static SlangResult _createSocket(NativeSocket& outSocket)
+{
+    SLANG_RETURN_ON_FAIL(_initSockets());
+
+    outSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (outSocket == kInvalidSocket)
+    {
+        return SLANG_FAIL;
+    }
+
+#ifdef SO_NOSIGPIPE
+    // Writing to a closed connection should fail, rather than raise SIGPIPE
+    int value = 1;
+    ::setsockopt(outSocket, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+#endif
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! LocalSocketStream !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+LocalSocketStream::LocalSocketStream(Handle handle) :
+    m_handle(handle)
+{
+}
+
+LocalSocketStream::~LocalSocketStream()
+{
+    close();
+}
+
+void LocalSocketStream::close()
+{
+    if (!m_isClosed)
+    {
+        _closeSocket(_getNative(m_handle));
+        m_isClosed = true;
+    }
+}
+
+SlangResult LocalSocketStream::read(void* buffer, size_t length, size_t& outReadBytes)
+{
+    outReadBytes = 0;
+    if (m_isClosed || length == 0)
+    {
+        return SLANG_OK;
+    }
+
+    // Only read if there is something to read (or the connection has closed), so as not to block
+    NativePollFd pollInfo;
+    pollInfo.fd = _getNative(m_handle);
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+
+    const int pollResult = _poll(&pollInfo, 1, 0);
+    if (pollResult < 0)
+    {
+        return SLANG_FAIL;
+    }
+    if (pollResult == 0)
+    {
+        return SLANG_OK;
+    }
+
+    const auto count = ::recv(_getNative(m_handle), (char*)buffer, int(length), 0);
+    if (count < 0)
+    {
+        return _isWouldBlock() ? SLANG_OK : SLANG_FAIL;
+    }
+
+    // Zero bytes means the other end has closed the connection
+    if (count == 0)
+    {
+        close();
+        return SLANG_OK;
+    }
+
+    outReadBytes = size_t(count);
+    return SLANG_OK;
+}
+
+SlangResult LocalSocketStream::waitForRead(Int timeOutInMs)
+{
+    if (m_isClosed)
+    {
+        return SLANG_OK;
+    }
+
+    NativePollFd pollInfo;
+    pollInfo.fd = _getNative(m_handle);
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+
+    const int pollResult = _poll(&pollInfo, 1, int(timeOutInMs));
+    if (pollResult < 0)
+    {
+        return _isWouldBlock() ? SLANG_OK : SLANG_FAIL;
+    }
+    return (pollResult == 0) ? SLANG_E_TIME_OUT : SLANG_OK;
+}
+
+SlangResult LocalSocketStream::write(const void* buffer, size_t length)
+{
+    if (m_isClosed)
+    {
+        return SLANG_FAIL;
+    }
+
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+
+    const char* cur = (const char*)buffer;
+    while (length > 0)
+    {
+        const auto count = ::send(_getNative(m_handle), cur, int(length), flags);
+        if (count < 0)
+        {
+            if (_isWouldBlock())
+            {
+                continue;
+            }
+            close();
+            return SLANG_FAIL;
+        }
+        cur += count;
+        length -= size_t(count);
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult LocalSocketStream::connect(const String& path, RefPtr<LocalSocketStream>& outStream)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_makeAddress(path, address));
+
+    NativeSocket socket;
+    SLANG_RETURN_ON_FAIL(_createSocket(socket));
+
+    if (::connect(socket, (const sockaddr*)&address, sizeof(address)) != 0)
+    {
+        _closeSocket(socket);
+        return SLANG_E_NOT_FOUND;
+    }
+    if (!_isPeerSameUser(socket))
+    {
+        _closeSocket(socket);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    outStream = new LocalSocketStream(Handle(socket));
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! LocalSocketServer !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+LocalSocketServer::LocalSocketServer(Handle handle, const String& path) :
+    m_handle(handle),
+    m_path(path)
+{
+}
+
+void LocalSocketServer::close()
+{
+    if (!m_isClosed)
+    {
+        _closeSocket(_getNative(m_handle));
+        File::remove(m_path);
+        m_isClosed = true;
+    }
+}
+
+SlangResult LocalSocketServer::accept(Int timeOutInMs, RefPtr<LocalSocketStream>& outStream)
+{
+    outStream.setNull();
+    if (m_isClosed)
+    {
+        return SLANG_FAIL;
+    }
+
+    NativePollFd pollInfo;
+    pollInfo.fd = _getNative(m_handle);
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+
+    const int pollResult = _poll(&pollInfo, 1, int(timeOutInMs));
+    if (pollResult < 0)
+    {
+        return _isWouldBlock() ? SLANG_OK : SLANG_FAIL;
+    }
+    if (pollResult == 0)
+    {
+        return SLANG_OK;
+    }
+
+    const NativeSocket socket = ::accept(_getNative(m_handle), nullptr, nullptr);
+    if (socket == kInvalidSocket)
+    {
+        // The client may have given up before the connection was accepted
+        return SLANG_OK;
+    }
+    if (!_isPeerSameUser(socket))
+    {
+        _closeSocket(socket);
+        return SLANG_OK;
+    }
+
+    outStream = new LocalSocketStream(Handle(socket));
+    return SLANG_OK;
+}
+
+/* static */SlangResult LocalSocketServer::create(const String& path, RefPtr<LocalSocketServer>& outServer)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_makeAddress(path, address));
+
+    NativeSocket socket;
+    SLANG_RETURN_ON_FAIL(_createSocket(socket));
+
+    // A socket left behind by a server that didn't exit cleanly would stop the bind
+    if (SLANG_FAILED(_removeStaleSocket(path)))
+    {
+        _closeSocket(socket);
+        return SLANG_E_INVALID_ARG;
+    }
+
+    if (::bind(socket, (const sockaddr*)&address, sizeof(address)) != 0)
+    {
+        _closeSocket(socket);
+        return SLANG_FAIL;
+    }
+
+    // Connections are refused until `listen`, so no one else can connect before access is restricted
+    if (SLANG_FAILED(_restrictToUser(path)) ||
+        ::listen(socket, SOMAXCONN) != 0)
+    {
+        _closeSocket(socket);
+        File::remove(path);
+        return SLANG_FAIL;
+    }
+
+    outServer = new LocalSocketServer(Handle(socket), path);
+    return SLANG_OK;
+}
+
+} // namespace Slang
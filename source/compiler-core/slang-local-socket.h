@@ -0,0 +1,79 @@
+#ifndef SLANG_COMPILER_CORE_LOCAL_SOCKET_H
+#define SLANG_COMPILER_CORE_LOCAL_SOCKET_H
+
+#include "../core/slang-basic.h"
+#include "../core/slang-stream.h"
+
+namespace Slang
+{
+
+/* Local sockets connect processes on the same machine through a path in the file system.
+They are Unix domain sockets, which Windows supports from Windows 10 version 1803.
+
+Only processes run by the same user can connect. On Unix the socket is only accessible to its owner,
+and both ends check the user of the other. On Windows access is controlled by the directory's ACL. */
+
+    /// A connection over a local socket.
+    /// Reads don't block, and return no bytes if none are available, so the stream can be used with
+    /// `BufferedReadStream` and `HTTPPacketConnection` in the same way as a process pipe.
+class LocalSocketStream : public Stream
+{
+public:
+    typedef intptr_t Handle;
+
+    // Stream
+    virtual Int64 getPosition() SLANG_OVERRIDE { return 0; }
+    virtual SlangResult seek(SeekOrigin origin, Int64 offset) SLANG_OVERRIDE { SLANG_UNUSED(origin); SLANG_UNUSED(offset); return SLANG_E_NOT_AVAILABLE; }
+    virtual SlangResult read(void* buffer, size_t length, size_t& outReadBytes) SLANG_OVERRIDE;
+    virtual SlangResult write(const void* buffer, size_t length) SLANG_OVERRIDE;
+    virtual bool isEnd() SLANG_OVERRIDE { return m_isClosed; }
+    virtual bool canRead() SLANG_OVERRIDE { return !m_isClosed; }
+    virtual bool canWrite() SLANG_OVERRIDE { return !m_isClosed; }
+    virtual void close() SLANG_OVERRIDE;
+    virtual SlangResult flush() SLANG_OVERRIDE { return m_isClosed ? SLANG_FAIL : SLANG_OK; }
+    virtual SlangResult waitForRead(Int timeOutInMs) SLANG_OVERRIDE;
+
+        /// Connect to the server listening at `path`. Fails with SLANG_E_NOT_AVAILABLE if the server is run by another user.
+    static SlangResult connect(const String& path, RefPtr<LocalSocketStream>& outStream);
+
+    ~LocalSocketStream();
+
+protected:
+    friend class LocalSocketServer;
+
+    LocalSocketStream(Handle handle);
+
+    Handle m_handle;
+    bool m_isClosed = false;
+};
+
+    /// Listens for connections on a local socket
+class LocalSocketServer : public RefObject
+{
+public:
+    typedef LocalSocketStream::Handle Handle;
+
+        /// Wait up to `timeOutInMs` for a connection. If there isn't one in that time `outStream` is set to nullptr.
+        /// A time out of -1 waits indefinitely.
+    SlangResult accept(Int timeOutInMs, RefPtr<LocalSocketStream>& outStream);
+
+        /// Stop listening, and remove the socket's path
+    void close();
+
+        /// Listen for connections at `path`. A socket already at `path` is replaced, but any other kind of file is an error.
+        /// Connections from other users are dropped by `accept`.
+    static SlangResult create(const String& path, RefPtr<LocalSocketServer>& outServer);
+
+    ~LocalSocketServer() { close(); }
+
+protected:
+    LocalSocketServer(Handle handle, const String& path);
+
+    Handle m_handle;
+    String m_path;
+    bool m_isClosed = false;
+};
+
+} // namespace Slang
+
+#endif // SLANG_COMPILER_CORE_LOCAL_SOCKET_H
@@ -0,0 +1,294 @@
+// slang-prefix-header-util.cpp
+#include "slang-prefix-header-util.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-process.h"
+#include "../core/slang-string-util.h"
+
+#include <atomic>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <errno.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace Slang
+{
+
+static void _appendString(DigestBuilder<SHA1>& ioBuilder, const UnownedStringSlice& slice)
+{
+    // Prefix with the length, so the boundaries between strings are part of the hash
+    ioBuilder.append(uint32_t(slice.getLength()));
+    ioBuilder.append(slice);
+}
+
+    // If the line is a quoted #include, outputs the name between the quotes
+static bool _findQuotedInclude(const UnownedStringSlice& line, UnownedStringSlice& outName)
+{
+    UnownedStringSlice rest = line.trim();
+    if (!rest.startsWith("#"))
+    {
+        return false;
+    }
+    rest = rest.tail(1).trimStart();
+    if (!rest.startsWith("include"))
+    {
+        return false;
+    }
+    rest = rest.tail(7).trimStart();
+    if (!rest.startsWith("\""))
+    {
+        return false;
+    }
+    rest = rest.tail(1);
+
+    const Index endIndex = rest.indexOf('"');
+    if (endIndex <= 0)
+    {
+        return false;
+    }
+    outName = rest.head(endIndex);
+    return true;
+}
+
+static bool _findIncludedFile(const UnownedStringSlice& name, const String& directory, const DownstreamCompileOptions& options, String& outPath)
+{
+    const String nameString(name);
+    if (Path::isAbsolute(name))
+    {
+        outPath = nameString;
+        return File::exists(outPath);
+    }
+
+    if (directory.getLength())
+    {
+        outPath = Path::combine(directory, nameString);
+        if (File::exists(outPath))
+        {
+            return true;
+        }
+    }
+
+    for (const auto& includePath : options.includePaths)
+    {
+        outPath = Path::combine(asString(includePath), nameString);
+        if (File::exists(outPath))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _appendContents(const UnownedStringSlice& text, const String& directory, const DownstreamCompileOptions& options, HashSet<String>& ioVisited, DigestBuilder<SHA1>& ioBuilder)
+{
+    _appendString(ioBuilder, text);
+
+    for (auto line : LineParser(text))
+    {
+        UnownedStringSlice name;
+        String path;
+        if (!_findQuotedInclude(line, name) ||
+            !_findIncludedFile(name, directory, options, path))
+        {
+            // Includes we can't find are either system headers, or can't be used.
+            continue;
+        }
+
+        path = Path::simplify(path);
+        if (!ioVisited.add(path))
+        {
+            continue;
+        }
+
+        String contents;
+        if (SLANG_SUCCEEDED(File::readAllText(path, contents)))
+        {
+            _appendString(ioBuilder, path.getUnownedSlice());
+            _appendContents(contents.getUnownedSlice(), Path::getParentDirectory(path), options, ioVisited, ioBuilder);
+        }
+    }
+}
+
+/* static */void PrefixHeaderUtil::appendContents(const CompileOptions& options, DigestBuilder<SHA1>& ioBuilder)
+{
+    HashSet<String> visited;
+    _appendContents(asStringSlice(options.prefixHeader), String(), options, visited, ioBuilder);
+}
+
+/* static */PrefixHeaderUtil::Paths PrefixHeaderUtil::calcPaths(const CompileOptions& options, const SHA1::Digest& key, const char* precompiledExtension)
+{
+    StringBuilder fileName;
+    fileName << "slang-prefix-" << key.toString() << ".h";
+
+    Paths paths;
+    paths.headerPath = Path::combine(asString(options.precompiledHeaderDirectory), fileName);
+
+    StringBuilder precompiledPath;
+    precompiledPath << paths.headerPath << "." << precompiledExtension;
+    paths.precompiledPath = precompiledPath;
+    return paths;
+}
+
+#ifdef _WIN32
+
+// The temporary directory is per user, and a directory created in it inherits its ACL
+static SlangResult _requirePrivateDirectory(const String& directory)
+{
+    if (!File::exists(directory))
+    {
+        // Another compile may create the directory first
+        Path::createDirectory(directory);
+    }
+    return File::exists(directory) ? SLANG_OK : SLANG_FAIL;
+}
+
+static String _getUserSuffix() { return String(); }
+
+// MoveFileEx without MOVEFILE_REPLACE_EXISTING fails if the destination exists
+static SlangResult _renameNoReplace(const String& fromPath, const String& toPath)
+{
+    return ::MoveFileExW(fromPath.toWString(), toPath.toWString(), 0) ? SLANG_OK : SLANG_FAIL;
+}
+
+#else
+
+// Anyone who can write to the cache can replace a precompiled header with one that injects code into compiles,
+// so only a directory that is owned by the user, and that no one else can write to, is used.
+static SlangResult _requirePrivateDirectory(const String& directory)
+{
+    // Another compile may create the directory first
+    if (::mkdir(directory.getBuffer(), S_IRWXU) != 0 && errno != EEXIST)
+    {
+        return SLANG_FAIL;
+    }
+
+    struct stat info;
+    if (::lstat(directory.getBuffer(), &info) != 0 ||
+        !S_ISDIR(info.st_mode) ||
+        info.st_uid != ::geteuid() ||
+        (info.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    return SLANG_OK;
+}
+
+static String _getUserSuffix()
+{
+    StringBuilder builder;
+    builder << "-" << uint32_t(::geteuid());
+    return builder;
+}
+
+// A hard link can't replace an existing file
+static SlangResult _renameNoReplace(const String& fromPath, const String& toPath)
+{
+    if (::link(fromPath.getBuffer(), toPath.getBuffer()) != 0)
+    {
+        return SLANG_FAIL;
+    }
+    File::remove(fromPath);
+    return SLANG_OK;
+}
+
+#endif
+
+/* static */SlangResult PrefixHeaderUtil::requireHeader(const CompileOptions& options, const Paths& paths)
+{
+    if (SLANG_FAILED(_requirePrivateDirectory(asString(options.precompiledHeaderDirectory))))
+    {
+        return kCacheUnavailableResult;
+    }
+
+    if (File::exists(paths.headerPath))
+    {
+        return SLANG_OK;
+    }
+
+    // A precompiled header without its header was built from a header that has since been removed. Clang records the
+    // time the header was modified, and won't use the precompiled header with the header written below.
+    File::remove(paths.precompiledPath);
+
+    // The header is never replaced once it exists, for the same reason.
+    const String tempPath = calcTemporaryPath(paths.headerPath);
+    SlangResult res = File::writeAllText(tempPath, asString(options.prefixHeader));
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = _renameNoReplace(tempPath, paths.headerPath);
+    }
+    if (SLANG_FAILED(res))
+    {
+        File::remove(tempPath);
+
+        // If the rename failed because another compile wrote the header first, the header is usable
+        return File::exists(paths.headerPath) ? SLANG_OK : kCacheUnavailableResult;
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult PrefixHeaderUtil::calcDefaultDirectory(const char* name, String& outDirectory)
+{
+    String tempDirectory;
+    SLANG_RETURN_ON_FAIL(File::getTemporaryDirectory(tempDirectory));
+
+    StringBuilder directoryName;
+    directoryName << name << _getUserSuffix();
+    outDirectory = Path::combine(tempDirectory, directoryName);
+    return SLANG_OK;
+}
+
+/* static */bool PrefixHeaderUtil::isCacheFailure(const CompileOptions& options, SlangResult result, IArtifact* artifact)
+{
+    if (result == kCacheUnavailableResult)
+    {
+        return true;
+    }
+
+    auto diagnostics = artifact ? findAssociatedRepresentation<IArtifactDiagnostics>(artifact) : nullptr;
+    if (!diagnostics || options.precompiledHeaderDirectory.count == 0)
+    {
+        return false;
+    }
+
+    // The errors for a precompiled header that can't be used name it (and the header it was built from) in their
+    // text, whereas errors in the source, or in the prefix header itself, only give the file as their location.
+    const UnownedStringSlice directory = asStringSlice(options.precompiledHeaderDirectory);
+    const Count count = diagnostics->getCount();
+    for (Index i = 0; i < count; ++i)
+    {
+        const auto diagnostic = diagnostics->getAt(i);
+        if (diagnostic->severity == ArtifactDiagnostic::Severity::Error &&
+            asStringSlice(diagnostic->text).indexOf(directory) >= 0)
+        {
+            return true;
+        }
+    }
+
+    // Not every error line is parsed into a diagnostic (clang's errors for a precompiled header can have no location,
+    // and more ':' in the text than a diagnostic line), so the raw output is checked as well.
+    for (auto line : LineParser(asStringSlice(diagnostics->getRaw())))
+    {
+        const Index errorIndex = line.indexOf(toSlice("error:"));
+        if (errorIndex >= 0 && line.tail(errorIndex).indexOf(directory) >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* static */String PrefixHeaderUtil::calcTemporaryPath(const String& path)
+{
+    // The name has to be unique between threads as well as processes
+    static std::atomic<uint32_t> counter;
+
+    StringBuilder builder;
+    builder << path << "." << Process::getId() << "-" << counter++ << ".tmp";
+    return builder;
+}
+
+}
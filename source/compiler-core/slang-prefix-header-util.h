@@ -0,0 +1,67 @@
+#ifndef SLANG_PREFIX_HEADER_UTIL_H
+#define SLANG_PREFIX_HEADER_UTIL_H
+
+#include "../core/slang-crypto.h"
+
+#include "slang-artifact-associated.h"
+#include "slang-downstream-compiler.h"
+#include "slang-slice-allocator.h"
+
+namespace Slang
+{
+
+/* A prefix header is text that is compiled as if it was included at the start of a source, such as the C++ prelude
+(see `DownstreamCompileOptions::prefixHeader`). Parsing it can take most of the time spent compiling a small kernel,
+so compilers that can precompile headers keep the precompiled prefix header in a cache directory.
+
+Files in the cache are named by a key, that identifies everything a precompiled header depends on - the contents
+of the header, the compiler and the options used. Files are only given their final name by renaming, so a file
+in the cache is always complete, and can be used by compiles in other threads or processes.
+
+The cache directory is only used if no other user can write to it. If the cache can't be used, or the compiler
+rejects a file in it, the compile fails, and the caller is expected to compile again with the prefix header as part
+of the source (see `isCacheFailure`). */
+struct PrefixHeaderUtil
+{
+    typedef DownstreamCompileOptions CompileOptions;
+
+        /// Returned by a compile that couldn't use the cache directory, such as because other users can write to it
+    static const SlangResult kCacheUnavailableResult = SLANG_MAKE_ERROR(SLANG_FACILITY_INTERNAL, 1);
+
+        /// The paths of the files for a prefix header in the cache
+    struct Paths
+    {
+        String headerPath;              ///< Holds the prefix header text
+        String precompiledPath;         ///< The precompiled header. Only exists once it has been built.
+    };
+
+        /// Append the contents of the prefix header to `ioBuilder`. This includes the contents of files it includes
+        /// with a quoted `#include` (recursively), such that a change to any of them changes the key.
+        /// Relative includes are looked for relative to the including file, and then in the options include paths.
+    static void appendContents(const CompileOptions& options, DigestBuilder<SHA1>& ioBuilder);
+
+        /// Get the paths in the options cache directory, for the prefix header identified by `key`.
+        /// `precompiledExtension` is the extension the compiler uses for precompiled headers.
+    static Paths calcPaths(const CompileOptions& options, const SHA1::Digest& key, const char* precompiledExtension);
+
+        /// Make sure the header file for the options prefix header is in the cache, creating the cache directory
+        /// if necessary. Returns kCacheUnavailableResult if the directory can't be used, such as because other users
+        /// can write to it.
+    static SlangResult requireHeader(const CompileOptions& options, const Paths& paths);
+
+        /// Get the path of a cache directory called `name` in the temporary directory, that is only used by the
+        /// current user.
+    static SlangResult calcDefaultDirectory(const char* name, String& outDirectory);
+
+        /// True if a compile with the options prefix header failed because of the cache, rather than because of an
+        /// error in the source. That is if `result` is kCacheUnavailableResult, or if the compiler reported an error
+        /// that names a file in the cache directory, such as clang's errors for a stale or corrupt precompiled header.
+    static bool isCacheFailure(const CompileOptions& options, SlangResult result, IArtifact* artifact);
+
+        /// Get a unique path to write a file to, before it's moved to `path` with `File::rename`
+    static String calcTemporaryPath(const String& path);
+};
+
+}
+
+#endif
@@ -28,7 +28,7 @@ struct SliceUtil
     static TerminatedCharSlice toTerminatedCharSlice(StringBuilder& storage, ISlangBlob* blob);
 
         /// The slice will only be in scope whilst the string is
-    static TerminatedCharSlice asTerminatedCharSlice(const String& in) { auto unowned = in.getUnownedSlice(); return TerminatedCharSlice(unowned.begin(), unowned.getLength()); }
+    static TerminatedCharSlice asTerminatedCharSlice(const String& in) { return TerminatedCharSlice(in.getBuffer(), in.getLength()); }
 
         /// Get string as a char slice
     static CharSlice asCharSlice(const String& in) { auto unowned = in.getUnownedSlice(); return CharSlice(unowned.begin(), unowned.getLength()); }
@@ -100,6 +100,10 @@ struct SliceAllocator
         m_arena(2097152)
     {
     }
+    explicit SliceAllocator(size_t blockPayloadSize):
+        m_arena(blockPayloadSize)
+    {
+    }
 protected:
     
     MemoryArena m_arena;
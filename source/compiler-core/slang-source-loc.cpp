@@ -926,6 +926,22 @@ void SourceManager::addSourceFileIfNotExist(const String& uniqueIdentity, Source
     m_sourceFileMap.addIfNotExists(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::removeSourceFile(SourceFile* sourceFile)
+{
+    List<String> uniqueIdentities;
+    for (const auto& [uniqueIdentity, mappedSourceFile] : m_sourceFileMap)
+    {
+        if (mappedSourceFile == sourceFile)
+        {
+            uniqueIdentities.add(uniqueIdentity);
+        }
+    }
+    for (const auto& uniqueIdentity : uniqueIdentities)
+    {
+        m_sourceFileMap.remove(uniqueIdentity);
+    }
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
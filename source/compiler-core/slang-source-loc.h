@@ -483,6 +483,9 @@ struct SourceManager
         /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
     void addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
+        /// Stop `sourceFile` being found by its unique identity, so a later load of the same file creates a new
+        /// `SourceFile`. The file is kept, as there may still be locations within it.
+    void removeSourceFile(SourceFile* sourceFile);
 
         /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
@@ -40,4 +40,6 @@ static const StructRttiInfo _makeExecutionResultRtti()
 
 /* static */const UnownedStringSlice QuitArgs::g_methodName = UnownedStringSlice::fromLiteral("quit");
 
+/* static */const UnownedStringSlice PingArgs::g_methodName = UnownedStringSlice::fromLiteral("ping");
+
 } // namespace TestServerProtocol
@@ -32,6 +32,12 @@ struct ExecuteToolTestArgs
 };
 
 struct QuitArgs
+{
+    static const UnownedStringSlice g_methodName;
+};
+
+    /// Replies with an empty ExecutionResult. Used to measure round trip time.
+struct PingArgs
 {
     static const UnownedStringSlice g_methodName;
 };
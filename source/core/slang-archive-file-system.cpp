@@ -52,6 +52,26 @@ SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComP
     outFileSystem = fileSystem;
     return SLANG_OK;
 }
+
+SlangResult loadArchiveFileSystemFromFile(const String& path, ComPtr<ISlangFileSystemExt>& outFileSystem)
+{
+    RefPtr<MemoryMappedFile> file;
+    SLANG_RETURN_ON_FAIL(MemoryMappedFile::create(path, file));
+
+    if (RiffFileSystem::isArchive(file->getData(), file->getSize()))
+    {
+        // The file system's contents reference the mapping
+        RiffFileSystem* riffFileSystem = new RiffFileSystem(nullptr);
+        ComPtr<ISlangFileSystemExt> fileSystem(riffFileSystem);
+        SLANG_RETURN_ON_FAIL(riffFileSystem->loadArchiveBlob(MemoryMappedFileBlob::create(file)));
+
+        outFileSystem = fileSystem;
+        return SLANG_OK;
+    }
+
+    // Other archive types copy what they need, so the mapping is only used whilst loading
+    return loadArchiveFileSystem(file->getData(), file->getSize(), outFileSystem);
+}
     
 SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem)
 {
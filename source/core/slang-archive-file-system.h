@@ -24,6 +24,8 @@ class IArchiveFileSystem : public ISlangCastable
 };
 
 SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComPtr<ISlangFileSystemExt>& outFileSystem);
+    /// Load the archive in the file at `path`. RIFF archives are memory mapped and loaded read-only, without copying.
+SlangResult loadArchiveFileSystemFromFile(const String& path, ComPtr<ISlangFileSystemExt>& outFileSystem);
 SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem);
 
 }
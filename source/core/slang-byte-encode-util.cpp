@@ -1,5 +1,33 @@
 #include "slang-byte-encode-util.h"
 
+#include <string.h>
+
+// The stream decoding uses SSSE3 (for pshufb) on x86 if the CPU has it, and NEON on ARM64, where it's always available
+#if SLANG_PROCESSOR_X86 || SLANG_PROCESSOR_X86_64
+#   define SLANG_BYTE_ENCODE_STREAM_SSSE3 1
+#   include <immintrin.h>
+#   if SLANG_VC
+#       include <intrin.h>
+#   endif
+#elif SLANG_PROCESSOR_ARM_64
+#   define SLANG_BYTE_ENCODE_STREAM_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#ifndef SLANG_BYTE_ENCODE_STREAM_SSSE3
+#   define SLANG_BYTE_ENCODE_STREAM_SSSE3 0
+#endif
+#ifndef SLANG_BYTE_ENCODE_STREAM_NEON
+#   define SLANG_BYTE_ENCODE_STREAM_NEON 0
+#endif
+
+// Allows SSSE3 instructions in a function, without requiring them for the whole file
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3 && SLANG_GCC_FAMILY
+#   define SLANG_BYTE_ENCODE_SSSE3_FUNCTION __attribute__((target("ssse3")))
+#else
+#   define SLANG_BYTE_ENCODE_SSSE3_FUNCTION
+#endif
+
 namespace Slang {
 
 // Descriptions of algorithms here...
@@ -288,4 +316,201 @@ SLANG_FORCE_INLINE static uint32_t _decodeLiteCut2UInt32(const uint8_t* in, int
     return size_t(encodeIn - encodeStart);
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Stream encoding !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+namespace { // anonymous
+
+// For each control byte, the shuffle that moves the bytes of its 4 values into place, and the total size of the values.
+// A shuffle index of 0x80 gives a zero byte.
+struct StreamDecodeTables
+{
+    constexpr StreamDecodeTables() :
+        shuffles(),
+        sizes()
+    {
+        for (int control = 0; control < 256; ++control)
+        {
+            int offset = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int length = ((control >> (i * 2)) & 3) + 1;
+                for (int j = 0; j < 4; ++j)
+                {
+                    shuffles[control][i * 4 + j] = uint8_t(j < length ? offset + j : 0x80);
+                }
+                offset += length;
+            }
+            sizes[control] = uint8_t(offset);
+        }
+    }
+
+    alignas(16) uint8_t shuffles[256][16];
+    uint8_t sizes[256];
+};
+
+} // anonymous
+
+static constexpr StreamDecodeTables s_streamDecodeTables;
+
+SLANG_FORCE_INLINE static int _calcStreamLength(uint32_t v)
+{
+    return (v & 0xffff0000) ? ((v & 0xff000000) ? 4 : 3) : ((v & 0x0000ff00) ? 2 : 1);
+}
+
+SLANG_FORCE_INLINE static size_t _getStreamControlSize(size_t numValues)
+{
+    return (numValues + 3) >> 2;
+}
+
+SLANG_FORCE_INLINE static uint32_t _decodeStreamValue(const uint8_t* in, int length)
+{
+    uint32_t value = in[0];
+    switch (length)
+    {
+        case 4: value |= uint32_t(in[3]) << 24;         /* fall thru */
+        case 3: value |= uint32_t(in[2]) << 16;         /* fall thru */
+        case 2: value |= uint32_t(in[1]) << 8;          /* fall thru */
+        default: break;
+    }
+    return value;
+}
+
+/* static */size_t ByteEncodeUtil::calcEncodeStreamSizeUInt32(const uint32_t* in, size_t num)
+{
+    size_t totalNumEncodeBytes = _getStreamControlSize(num);
+    for (size_t i = 0; i < num; i++)
+    {
+        totalNumEncodeBytes += _calcStreamLength(in[i]);
+    }
+    return totalNumEncodeBytes;
+}
+
+/* static */size_t ByteEncodeUtil::encodeStreamUInt32(const uint32_t* in, size_t num, uint8_t* encodeOut)
+{
+    uint8_t* controls = encodeOut;
+    uint8_t* out = encodeOut + _getStreamControlSize(num);
+
+    ::memset(controls, 0, _getStreamControlSize(num));
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        uint32_t v = in[i];
+        const int length = _calcStreamLength(v);
+
+        controls[i >> 2] |= uint8_t((length - 1) << ((i & 3) * 2));
+        for (int j = 0; j < length; ++j)
+        {
+            *out++ = uint8_t(v);
+            v >>= 8;
+        }
+    }
+
+    return size_t(out - encodeOut);
+}
+
+/* static */void ByteEncodeUtil::encodeStreamUInt32(const uint32_t* in, size_t num, List<uint8_t>& encodeOut)
+{
+    encodeOut.setCount(Index(calcEncodeStreamSizeUInt32(in, num)));
+    const size_t size = encodeStreamUInt32(in, num, encodeOut.getBuffer());
+    SLANG_UNUSED(size);
+    SLANG_ASSERT(size == size_t(encodeOut.getCount()));
+}
+
+/* static */size_t ByteEncodeUtil::decodeStreamUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* controls = encodeIn;
+    const uint8_t* in = encodeIn + _getStreamControlSize(numValues);
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const int length = ((controls[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+        valuesOut[i] = _decodeStreamValue(in, length);
+        in += length;
+    }
+
+    return size_t(in - encodeIn);
+}
+
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3
+
+static bool _hasSSSE3()
+{
+#   if SLANG_VC
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#   elif SLANG_GCC_FAMILY
+    return __builtin_cpu_supports("ssse3") != 0;
+#   else
+    return false;
+#   endif
+}
+
+#endif
+
+/* static */bool ByteEncodeUtil::canDecodeStreamSimd()
+{
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3
+    static const bool hasSSSE3 = _hasSSSE3();
+    return hasSSSE3;
+#elif SLANG_BYTE_ENCODE_STREAM_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3 || SLANG_BYTE_ENCODE_STREAM_NEON
+
+// Decodes 4 values per control byte with a shuffle. Each shuffle reads 16 bytes of values, so the last values are
+// decoded one at a time, so as not to read past the end of the encoding.
+SLANG_BYTE_ENCODE_SSSE3_FUNCTION static size_t _decodeStreamUInt32Simd(const uint8_t* encodeIn, size_t encodeInSize, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* controls = encodeIn;
+    const uint8_t* in = encodeIn + _getStreamControlSize(numValues);
+    const uint8_t* encodeEnd = encodeIn + encodeInSize;
+
+    size_t i = 0;
+    for (; i + 4 <= numValues && in <= encodeEnd && encodeEnd - in >= 16; i += 4)
+    {
+        const uint8_t control = controls[i >> 2];
+
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3
+        const __m128i data = _mm_loadu_si128((const __m128i*)in);
+        const __m128i shuffle = _mm_load_si128((const __m128i*)s_streamDecodeTables.shuffles[control]);
+        _mm_storeu_si128((__m128i*)(valuesOut + i), _mm_shuffle_epi8(data, shuffle));
+#else
+        // Out of range indices (0x80) give 0
+        const uint8x16_t data = vld1q_u8(in);
+        const uint8x16_t shuffle = vld1q_u8(s_streamDecodeTables.shuffles[control]);
+        vst1q_u8((uint8_t*)(valuesOut + i), vqtbl1q_u8(data, shuffle));
+#endif
+
+        in += s_streamDecodeTables.sizes[control];
+    }
+
+    for (; i < numValues; ++i)
+    {
+        const int length = ((controls[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+        valuesOut[i] = _decodeStreamValue(in, length);
+        in += length;
+    }
+
+    return size_t(in - encodeIn);
+}
+
+#endif
+
+/* static */size_t ByteEncodeUtil::decodeStreamUInt32(const uint8_t* encodeIn, size_t encodeInSize, size_t numValues, uint32_t* valuesOut)
+{
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3 || SLANG_BYTE_ENCODE_STREAM_NEON
+    if (canDecodeStreamSimd())
+    {
+        return _decodeStreamUInt32Simd(encodeIn, encodeInSize, numValues, valuesOut);
+    }
+#endif
+    SLANG_UNUSED(encodeInSize);
+    return decodeStreamUInt32Scalar(encodeIn, numValues, valuesOut);
+}
+
 } // namespace Slang
@@ -80,6 +80,46 @@ struct ByteEncodeUtil
         */
     static size_t decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut); 
 
+        /** Calculate the size of the 'stream' encoding of values.
+        The stream encoding (as in 'Stream VByte') starts with a control byte for each 4 values, holding the byte length
+        (1-4) of each value in 2 bits. The value bytes, in little endian order, follow all of the control bytes. As the
+        lengths of 4 values are known from a single byte, it can be decoded a control byte at a time with a SIMD shuffle.
+        @param in The values to encode
+        @param num The amount of values
+        @return The size of the encoding in bytes
+        */
+    static size_t calcEncodeStreamSizeUInt32(const uint32_t* in, size_t num);
+
+        /** Stream encode an array of uint32_t
+        @param in The values to encode
+        @param num The amount of values to encode
+        @param encodeOut The buffer to hold the encoding. MUST be large enough to hold the encoding
+        @return The size of the encoding in bytes
+        */
+    static size_t encodeStreamUInt32(const uint32_t* in, size_t num, uint8_t* encodeOut);
+
+        /** Stream encode an array of uint32_t
+        @param in The values to encode
+        @param num The amount of values to encode
+        @param encodeOut The buffer to hold the encoding
+        */
+    static void encodeStreamUInt32(const uint32_t* in, size_t num, List<uint8_t>& encodeOut);
+
+        /** Decode a stream encoding. Uses SIMD if the CPU supports it.
+        @param encodeIn The encoded values
+        @param encodeInSize The size of the encoded values in bytes. Nothing past the end is read.
+        @param numValues The amount of values to be decoded
+        @param valuesOut The buffer to hold the decoded values
+        @return The amount of bytes decoded
+        */
+    static size_t decodeStreamUInt32(const uint8_t* encodeIn, size_t encodeInSize, size_t numValues, uint32_t* valuesOut);
+
+        /// Decode a stream encoding a value at a time, without SIMD. Only reads the bytes that are decoded.
+    static size_t decodeStreamUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
+
+        /// True if decodeStreamUInt32 can use SIMD on this CPU
+    static bool canDecodeStreamSimd();
+
         /// Table that maps 8 bits to it's most significant bit. If 0 returns -1.
     static const int8_t s_msb8[256];
 };
@@ -45,7 +45,16 @@ void HTTPHeader::reset()
             return SLANG_FAIL;
         }
 
-        Process::sleepCurrentThread(0);
+        // Wait for more of the header, or yield if the stream can't wait
+        const SlangResult waitRes = stream->waitForUpdate(-1);
+        if (waitRes == SLANG_E_NOT_IMPLEMENTED)
+        {
+            Process::sleepCurrentThread(0);
+        }
+        else
+        {
+            SLANG_RETURN_ON_FAIL(waitRes);
+        }
     }
 }
 
@@ -331,15 +340,18 @@ SlangResult HTTPPacketConnection::waitForResult(Int timeOutInMs)
 {
     m_readResult = SLANG_OK;
 
+    const int64_t clockFrequency = int64_t(Process::getClockFrequency());
+
     int64_t startTick = 0;
     int64_t timeOutInTicks = -1;
 
     if (timeOutInMs >= 0)
     {
-        timeOutInTicks = timeOutInMs * (Process::getClockFrequency() / 1000);
+        timeOutInTicks = timeOutInMs * (clockFrequency / 1000);
         startTick = Process::getClockTick();
     }
 
+    // Only used if the stream can't wait for input
     SleepState sleepState;
 
     while (m_readState == ReadState::Header ||
@@ -354,19 +366,35 @@ SlangResult HTTPPacketConnection::waitForResult(Int timeOutInMs)
             break;
         }
 
-        // We timed out
-        if (timeOutInTicks >= 0 && int64_t(Process::getClockTick()) - startTick >= timeOutInTicks)
+        // Work out how much longer we can wait
+        Int waitInMs = -1;
+        if (timeOutInTicks >= 0)
         {
-            break;
+            const int64_t remainingTicks = timeOutInTicks - (int64_t(Process::getClockTick()) - startTick);
+            // We timed out
+            if (remainingTicks <= 0)
+            {
+                break;
+            }
+            // Round up, so we don't spin when less than a millisecond remains
+            waitInMs = Int((remainingTicks * 1000 + clockFrequency - 1) / clockFrequency);
+        }
+
+        // If the update read something, there may be more to handle before waiting
+        if (prevCount != m_readStream->getCount())
+        {
+            sleepState.reset();
+            continue;
         }
 
-        if (prevCount == m_readStream->getCount())
+        const SlangResult waitRes = m_readStream->waitForUpdate(waitInMs);
+        if (waitRes == SLANG_E_NOT_IMPLEMENTED)
         {
             sleepState.sleep();
         }
-        else
+        else if (waitRes != SLANG_E_TIME_OUT)
         {
-            sleepState.reset();
+            SLANG_RETURN_ON_FAIL(_updateReadResult(waitRes));
         }
     }
 
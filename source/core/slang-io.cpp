@@ -27,6 +27,7 @@
 #   include <dirent.h>
 #   include <sys/stat.h>
 #   include <sys/file.h>
+#   include <sys/mman.h>
 #endif
 
 #if SLANG_APPLE_FAMILY
@@ -59,9 +60,28 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult File::rename(const String& fromFileName, const String& toFileName)
+    {
+#ifdef _WIN32
+        // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+        if (MoveFileExW(fromFileName.toWString(), toFileName.toWString(), MOVEFILE_REPLACE_EXISTING))
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#else
+        // https://man7.org/linux/man-pages/man2/rename.2.html
+        if (::rename(fromFileName.getBuffer(), toFileName.getBuffer()) == 0)
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#endif
+    }
+
 
 #ifdef _WIN32
-    /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
+    /* static */SlangResult File::getTemporaryDirectory(String& outPath)
     {
         // https://docs.microsoft.com/en-us/windows/win32/fileio/creating-and-using-a-temporary-file
 
@@ -93,6 +113,15 @@ namespace Slang
             return SLANG_FAIL;
         }
 
+        outPath = tempPath;
+        return SLANG_OK;
+    }
+
+    /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
+    {
+        String tempPath;
+        SLANG_RETURN_ON_FAIL(getTemporaryDirectory(tempPath));
+
         const String prefix(inPrefix);
         String tempFileName;
 
@@ -118,6 +147,13 @@ namespace Slang
         return SLANG_OK;
     }
 #else
+    /* static */SlangResult File::getTemporaryDirectory(String& outPath)
+    {
+        // Temporary files are always created in /tmp, see `generateTemporary`
+        outPath = "/tmp";
+        return SLANG_OK;
+    }
+
     /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
     {
         StringBuilder builder;
@@ -1250,4 +1286,95 @@ namespace Slang
     {
         close();
     }
+
+    /* static */SlangResult MemoryMappedFile::create(const String& fileName, RefPtr<MemoryMappedFile>& outFile)
+    {
+        RefPtr<MemoryMappedFile> file = new MemoryMappedFile;
+
+#if SLANG_WINDOWS_FAMILY
+        // Allow the file to be deleted whilst it is mapped, as it would be on POSIX systems.
+        HANDLE fileHandle = ::CreateFileW(
+            fileName.toWString(),
+            GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!::GetFileSizeEx(fileHandle, &fileSize))
+        {
+            ::CloseHandle(fileHandle);
+            return SLANG_FAIL;
+        }
+
+        // Empty files can't be mapped.
+        if (fileSize.QuadPart > 0)
+        {
+            // The view holds references to the mapping and the file, so the handles can be closed
+            // once it's been created.
+            HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mappingHandle)
+            {
+                file->m_data = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mappingHandle);
+            }
+            if (!file->m_data)
+            {
+                ::CloseHandle(fileHandle);
+                return SLANG_FAIL;
+            }
+            file->m_size = size_t(fileSize.QuadPart);
+        }
+        ::CloseHandle(fileHandle);
+#else
+        int fileHandle = ::open(fileName.getBuffer(), O_RDONLY);
+        if (fileHandle == -1)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        struct stat fileStat;
+        if (::fstat(fileHandle, &fileStat) != 0)
+        {
+            ::close(fileHandle);
+            return SLANG_FAIL;
+        }
+
+        // Empty files can't be mapped.
+        if (fileStat.st_size > 0)
+        {
+            // The mapping holds a reference to the file, so it can be closed once it's been created.
+            void* data = ::mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileHandle, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fileHandle);
+                return SLANG_FAIL;
+            }
+            file->m_data = data;
+            file->m_size = size_t(fileStat.st_size);
+        }
+        ::close(fileHandle);
+#endif
+
+        outFile = file;
+        return SLANG_OK;
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (!m_data)
+            return;
+
+#if SLANG_WINDOWS_FAMILY
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<void*>(m_data), m_size);
+#endif
+    }
 }
@@ -30,12 +30,19 @@ namespace Slang
 
         static SlangResult remove(const String& fileName);
 
+            /// Rename the file `fromFileName` to `toFileName`, replacing `toFileName` if it exists.
+            /// On POSIX systems the replacement is atomic, so readers see either the old or the new file.
+        static SlangResult rename(const String& fromFileName, const String& toFileName);
+
         static SlangResult makeExecutable(const String& fileName);
 
             /// Creates a temporary file typically in some way based on the prefix
             /// The file will be *created* with the outFileName, on success.
             /// It's creation in necessary to lock that particular name.
         static SlangResult generateTemporary(const UnownedStringSlice& prefix, String& outFileName);
+
+            /// Get the directory that temporary files are created in
+        static SlangResult getTemporaryDirectory(String& outPath);
     };
 
     class Path
@@ -308,6 +315,46 @@ namespace Slang
         LockFile& m_lockFile;
     };
 
+        /// A read-only view of the whole of a file, mapped into memory.
+        /// The view stays valid if the file is removed or replaced whilst it is mapped.
+    class MemoryMappedFile : public RefObject
+    {
+    public:
+            /// Map the file at `fileName`. An empty file gives a view with no data.
+            /// @return SLANG_OK on success, SLANG_E_CANNOT_OPEN if the file could not be opened.
+        static SlangResult create(const String& fileName, RefPtr<MemoryMappedFile>& outFile);
+
+        const void* getData() const { return m_data; }
+        size_t getSize() const { return m_size; }
+
+        ~MemoryMappedFile();
+
+    protected:
+        MemoryMappedFile() = default;
+
+        const void* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+        /// A blob referencing the contents of a memory mapped file, which is kept mapped while the blob is alive.
+    class MemoryMappedFileBlob : public UnownedRawBlob
+    {
+    public:
+        static inline ComPtr<ISlangBlob> create(MemoryMappedFile* file)
+        {
+            return ComPtr<ISlangBlob>(new MemoryMappedFileBlob(file));
+        }
+
+    protected:
+        MemoryMappedFileBlob(MemoryMappedFile* file)
+            : UnownedRawBlob(file->getData(), file->getSize())
+            , m_file(file)
+        {
+        }
+
+        RefPtr<MemoryMappedFile> m_file;
+    };
+
 }
 
 #endif
@@ -1,52 +1,302 @@
 #include "slang-performance-profiler.h"
-#include "slang-dictionary.h"
+#include "slang-string-escape-util.h"
 
 namespace Slang
 {
-    struct FuncProfileInfo
+
+std::atomic<int> PerformanceProfiler::s_enableCount{0};
+
+namespace { // anonymous
+
+    // The buffer for the current thread. Buffers are never freed, only cleared, so this
+    // pointer stays valid for the life time of the (singleton) profiler.
+thread_local PerformanceProfiler::ThreadBuffer* t_threadBuffer = nullptr;
+
+    // A node in the summary tree. Sections with the same name entered from the same
+    // parent node are merged, across all threads.
+struct SummaryNode
+{
+    const char* name = nullptr;
+    Index invocationCount = 0;
+    uint64_t duration = 0;
+    List<Index> children;
+};
+
+static Index _findOrAddChild(List<SummaryNode>& nodes, Index parentIndex, const char* name)
+{
+    for (auto childIndex : nodes[parentIndex].children)
+    {
+        if (UnownedStringSlice(nodes[childIndex].name) == UnownedStringSlice(name))
+        {
+            return childIndex;
+        }
+    }
+
+    const Index childIndex = nodes.getCount();
+    SummaryNode node;
+    node.name = name;
+    nodes.add(node);
+    nodes[parentIndex].children.add(childIndex);
+    return childIndex;
+}
+
+static void _appendSummary(const List<SummaryNode>& nodes, Index nodeIndex, Index depth, StringBuilder& out)
+{
+    const auto& node = nodes[nodeIndex];
+
+    for (Index i = 0; i < depth; ++i)
     {
-        int invocationCount = 0;
-        std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
-    };
-    class PerformanceProfilerImpl : public PerformanceProfiler
+        out << "  ";
+    }
+    out << node.name << ": \t" << node.invocationCount << "\t" << String(double(node.duration) / 1000000.0, "%.2f") << "\n";
+
+    for (auto childIndex : node.children)
+    {
+        _appendSummary(nodes, childIndex, depth + 1, out);
+    }
+}
+
+    // Append a time in nanoseconds as microseconds, which is the unit chrome trace uses.
+static void _appendMicroseconds(uint64_t time, StringBuilder& out)
+{
+    out << time / 1000;
+    const uint64_t fraction = time % 1000;
+    if (fraction)
     {
-    public:
-        OrderedDictionary<const char*, FuncProfileInfo> data;
+        out << ".";
+        if (fraction < 100) out << "0";
+        if (fraction < 10) out << "0";
+        out << fraction;
+    }
+}
+
+} // anonymous
+
+PerformanceProfiler::PerformanceProfiler()
+{
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+uint64_t PerformanceProfiler::_getTime()
+{
+    const auto duration = std::chrono::steady_clock::now() - m_startTime;
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+void PerformanceProfiler::setEnabled(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (enable != m_isEnabledBySetEnabled)
+    {
+        m_isEnabledBySetEnabled = enable;
+        s_enableCount.fetch_add(enable ? 1 : -1, std::memory_order_relaxed);
+    }
+}
+
+PerformanceProfiler::ThreadBuffer* PerformanceProfiler::_getThreadBuffer()
+{
+    if (!t_threadBuffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->threadIndex = m_threadBuffers.getCount();
+
+        t_threadBuffer = buffer.get();
+        m_threadBuffers.add(std::move(buffer));
+    }
+    return t_threadBuffer;
+}
+
+PerformanceProfiler::SectionContext PerformanceProfiler::enterSection(const char* name)
+{
+    ThreadBuffer* buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    return _enterSection(buffer, name);
+}
+
+PerformanceProfiler::SectionContext PerformanceProfiler::_enterSection(ThreadBuffer* buffer, const char* name)
+{
+    Event event;
+    event.name = name;
+    event.parentIndex = buffer->currentIndex;
+
+    SectionContext context;
+    context.buffer = buffer;
+    context.eventIndex = buffer->events.getCount();
+    context.generation = buffer->generation;
+
+    buffer->currentIndex = context.eventIndex;
+    buffer->events.add(event);
+
+    // Take the time last, so the cost of recording isn't included in the section
+    buffer->events[context.eventIndex].startTime = _getTime();
+    return context;
+}
+
+PerformanceProfiler::SectionContext PerformanceProfiler::enterSection(const char* name, const UnownedStringSlice& label)
+{
+    ThreadBuffer* buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
 
-        virtual FuncProfileContext enterFunction(const char* funcName) override
+    const Index labelIndex = buffer->labels.getCount();
+    buffer->labels.add(label);
+
+    SectionContext context = _enterSection(buffer, name);
+    buffer->events[context.eventIndex].labelIndex = labelIndex;
+    return context;
+}
+
+void PerformanceProfiler::exitSection(const SectionContext& context)
+{
+    const uint64_t endTime = _getTime();
+
+    ThreadBuffer* buffer = context.buffer;
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+
+    // The events may have been cleared whilst the section was entered, in which case
+    // the index may refer to an event entered since
+    if (context.generation != buffer->generation)
+    {
+        return;
+    }
+
+    auto& event = buffer->events[context.eventIndex];
+    event.endTime = endTime;
+    buffer->currentIndex = event.parentIndex;
+}
+
+void PerformanceProfiler::recordCounter(const char* name, int64_t value)
+{
+    ThreadBuffer* buffer = _getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+
+    CounterSample sample;
+    sample.name = name;
+    sample.parentIndex = buffer->currentIndex;
+    sample.time = _getTime();
+    sample.value = value;
+    buffer->counters.add(sample);
+}
+
+void PerformanceProfiler::getResult(StringBuilder& out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Node 0 is the root, and isn't output
+    List<SummaryNode> nodes;
+    nodes.add(SummaryNode());
+
+    List<Index> eventNodes;
+    for (const auto& buffer : m_threadBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        const auto& events = buffer->events;
+
+        eventNodes.setCount(events.getCount());
+        for (Index i = 0; i < events.getCount(); ++i)
         {
-            auto entry = data.tryGetValue(funcName);
-            if (!entry)
+            const auto& event = events[i];
+
+            // Parents are always recorded before their children
+            const Index parentNode = event.parentIndex >= 0 ? eventNodes[event.parentIndex] : 0;
+            const Index nodeIndex = _findOrAddChild(nodes, parentNode, event.name);
+            eventNodes[i] = nodeIndex;
+
+            auto& node = nodes[nodeIndex];
+            node.invocationCount++;
+            if (event.endTime >= event.startTime)
             {
-                data.add(funcName, FuncProfileInfo());
-                entry = data.tryGetValue(funcName);
+                node.duration += event.endTime - event.startTime;
             }
-            entry->invocationCount++;
-            FuncProfileContext ctx;
-            ctx.funcName = funcName;
-            ctx.startTime = std::chrono::high_resolution_clock::now();
-            return ctx;
-        }
-        virtual void exitFunction(FuncProfileContext ctx) override
-        {
-            auto endTime = std::chrono::high_resolution_clock::now();
-            auto duration = endTime - ctx.startTime;
-            auto entry = data.tryGetValue(ctx.funcName);
-            entry->duration += duration;
         }
-        virtual void getResult(StringBuilder& out) override
+    }
+
+    for (auto childIndex : nodes[0].children)
+    {
+        _appendSummary(nodes, childIndex, 0, out);
+    }
+}
+
+void PerformanceProfiler::writeChromeTrace(StringBuilder& out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\"traceEvents\":[";
+
+    bool isFirst = true;
+    for (const auto& buffer : m_threadBuffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        for (const auto& event : buffer->events)
         {
-            for (auto func : data)
+            // Skip sections that haven't been exited
+            if (event.endTime < event.startTime)
             {
-                out << func.key << ": \t";
-                out << func.value.invocationCount << "\t" << func.value.duration.count()/1000000 << "\n";
+                continue;
             }
+
+            out << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+
+            // A "complete" event, which has a start time and a duration
+            out << "{\"name\":";
+            StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(event.name), out);
+            out << ",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadIndex;
+            out << ",\"ts\":";
+            _appendMicroseconds(event.startTime, out);
+            out << ",\"dur\":";
+            _appendMicroseconds(event.endTime - event.startTime, out);
+
+            if (event.labelIndex >= 0)
+            {
+                out << ",\"args\":{\"label\":";
+                StringEscapeUtil::appendQuoted(handler, buffer->labels[event.labelIndex].getUnownedSlice(), out);
+                out << "}";
+            }
+            out << "}";
         }
-    };
 
-    PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
+        for (const auto& sample : buffer->counters)
+        {
+            out << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+
+            // A "counter" event, which has a single value
+            out << "{\"name\":";
+            StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(sample.name), out);
+            out << ",\"cat\":\"slang\",\"ph\":\"C\",\"pid\":0,\"tid\":" << buffer->threadIndex;
+            out << ",\"ts\":";
+            _appendMicroseconds(sample.time, out);
+            out << ",\"args\":{\"value\":" << sample.value << "}}";
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void PerformanceProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Buffers are kept, as threads hold pointers to them
+    for (const auto& buffer : m_threadBuffers)
     {
-        static PerformanceProfilerImpl profiler = PerformanceProfilerImpl();
-        return &profiler;
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->labels.clear();
+        buffer->counters.clear();
+        buffer->currentIndex = -1;
+        buffer->generation++;
     }
 }
+
+PerformanceProfiler* PerformanceProfiler::getProfiler()
+{
+    static PerformanceProfiler profiler;
+    return &profiler;
+}
+
+}
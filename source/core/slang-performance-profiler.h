@@ -2,41 +2,169 @@
 #define SLANG_CORE_PERFORMANCE_PROFILER_H
 
 #include "slang-string.h"
+#include "slang-list.h"
+
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace Slang
 {
 
-struct FuncProfileContext
-{
-    const char* funcName = nullptr;
-    std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
-};
-
+    /// Records nested, timed sections of work, from any number of threads.
+    ///
+    /// Every thread appends its events to its own buffer, guarded by a lock that is only
+    /// contended whilst the results are being read or cleared, so results can be read
+    /// whilst other threads are recording.
+    ///
+    /// Recording is disabled by default, in which case entering a section just costs
+    /// a relaxed atomic load. It is enabled whilst it is enabled by `setEnabled`, or
+    /// any `ScopedEnable` is alive.
 class PerformanceProfiler
 {
 public:
-    virtual FuncProfileContext enterFunction(const char* funcName) = 0;
-    virtual void exitFunction(FuncProfileContext context) = 0;
-    virtual void getResult(StringBuilder& out) = 0;
-public:
+        /// A single timed section. Times are in nanoseconds since the profiler was created.
+    struct Event
+    {
+        const char* name = nullptr;     ///< Name of the section. Must have static lifetime.
+        Index labelIndex = -1;          ///< Index into the thread's labels, or -1 if there is no label
+        Index parentIndex = -1;         ///< Index of the enclosing event on the same thread, or -1
+        uint64_t startTime = 0;
+        uint64_t endTime = 0;
+    };
+
+        /// A value measured at a point in time, such as the size of the IR after a pass.
+    struct CounterSample
+    {
+        const char* name = nullptr;     ///< Name of the counter. Must have static lifetime.
+        Index parentIndex = -1;         ///< Index of the enclosing event on the same thread, or -1
+        uint64_t time = 0;
+        int64_t value = 0;
+    };
+
+        /// The events recorded by a single thread
+    struct ThreadBuffer
+    {
+        std::mutex mutex;               ///< Guards the members below
+        Index threadIndex = 0;
+        Index currentIndex = -1;        ///< The innermost event that has been entered but not exited
+        uint32_t generation = 0;        ///< Incremented by each `clear`, so sections entered before it can be ignored
+        List<Event> events;
+        List<String> labels;
+        List<CounterSample> counters;
+    };
+
+        /// Identifies an entered section, so it can be exited
+    struct SectionContext
+    {
+        ThreadBuffer* buffer = nullptr;
+        Index eventIndex = -1;
+        uint32_t generation = 0;        ///< The `generation` of `buffer` when the section was entered
+    };
+
+        /// If `enable` is set, enables recording for its life time, and then restores the
+        /// previous state, even if other scopes (or `setEnabled`) have changed it in between.
+    struct ScopedEnable
+    {
+        ScopedEnable(bool enable) : m_enable(enable) { if (m_enable) s_enableCount.fetch_add(1, std::memory_order_relaxed); }
+        ~ScopedEnable() { if (m_enable) s_enableCount.fetch_sub(1, std::memory_order_relaxed); }
+
+        ScopedEnable(const ScopedEnable&) = delete;
+        void operator=(const ScopedEnable&) = delete;
+
+        const bool m_enable;
+    };
+
+    static bool isEnabled() { return s_enableCount.load(std::memory_order_relaxed) > 0; }
+    void setEnabled(bool enable);
+
+    SectionContext enterSection(const char* name);
+    SectionContext enterSection(const char* name, const UnownedStringSlice& label);
+    void exitSection(const SectionContext& context);
+
+        /// Record the value of the counter `name`, within the section the current thread is in.
+    void recordCounter(const char* name, int64_t value);
+
+        /// Append a summary of the time spent in each section, nested by how sections were entered.
+    void getResult(StringBuilder& out);
+
+        /// Append all recorded events in the Chrome trace event JSON format.
+        /// The output can be loaded by chrome://tracing or https://ui.perfetto.dev
+    void writeChromeTrace(StringBuilder& out);
+
+        /// Discard all recorded events
+    void clear();
+
     static PerformanceProfiler* getProfiler();
+
+private:
+    PerformanceProfiler();
+
+    ThreadBuffer* _getThreadBuffer();
+        /// Enter a section, with `buffer`'s lock held
+    SectionContext _enterSection(ThreadBuffer* buffer, const char* name);
+    uint64_t _getTime();
+
+        /// The number of `ScopedEnable`s alive, plus one if enabled by `setEnabled`
+    static std::atomic<int> s_enableCount;
+
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::mutex m_mutex;                                 ///< Guards m_threadBuffers and m_isEnabledBySetEnabled
+    List<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+    bool m_isEnabledBySetEnabled = false;
 };
 
-struct PerformanceProfilerFuncRAIIContext
+struct PerformanceProfilerSectionRAII
 {
-    FuncProfileContext context;
-    PerformanceProfilerFuncRAIIContext(const char* funcName)
+    PerformanceProfilerSectionRAII(const char* name)
+    {
+        if (PerformanceProfiler::isEnabled())
+        {
+            m_context = PerformanceProfiler::getProfiler()->enterSection(name);
+        }
+    }
+        /// `getLabel` is only called if the profiler is enabled
+    template <typename GetLabelFunc>
+    PerformanceProfilerSectionRAII(const char* name, const GetLabelFunc& getLabel)
     {
-        context = PerformanceProfiler::getProfiler()->enterFunction(funcName);
+        if (PerformanceProfiler::isEnabled())
+        {
+            const String label = getLabel();
+            m_context = PerformanceProfiler::getProfiler()->enterSection(name, label.getUnownedSlice());
+        }
     }
-    ~PerformanceProfilerFuncRAIIContext()
+    ~PerformanceProfilerSectionRAII()
     {
-        PerformanceProfiler::getProfiler()->exitFunction(context);
+        if (m_context.buffer)
+        {
+            PerformanceProfiler::getProfiler()->exitSection(m_context);
+        }
     }
+
+    PerformanceProfiler::SectionContext m_context;
 };
 
-#define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
+    /// Profile the rest of the enclosing function
+#define SLANG_PROFILE PerformanceProfilerSectionRAII _profileContext(__func__)
+
+    /// Profile the rest of the enclosing scope as a section called `name`
+#define SLANG_PROFILE_SECTION(name) PerformanceProfilerSectionRAII SLANG_CONCAT(_profileSection, __LINE__)(name)
+
+    /// Profile the rest of the enclosing scope as a section called `name`, labelled with `labelExpr`.
+    /// The label is only evaluated if the profiler is enabled.
+#define SLANG_PROFILE_SECTION_WITH_LABEL(name, labelExpr) \
+    PerformanceProfilerSectionRAII SLANG_CONCAT(_profileSection, __LINE__)(name, [&]() -> String { return labelExpr; })
+
+    /// Record the value of the counter `name`. `valueExpr` is only evaluated if the profiler is enabled.
+#define SLANG_PROFILE_COUNTER(name, valueExpr) \
+    do { if (PerformanceProfiler::isEnabled()) PerformanceProfiler::getProfiler()->recordCounter(name, int64_t(valueExpr)); } while (0)
+
+    /// Profile a call to `pass(...)` as a section named after the pass, and return its result.
+#define SLANG_PROFILE_PASS(pass, ...) \
+    ([&]() { PerformanceProfilerSectionRAII _profilePass(#pass); return pass(__VA_ARGS__); }())
+
 }
 
 #endif
@@ -5,19 +5,152 @@
 #include "../core/slang-string-util.h"
 #include "../core/slang-blob.h"
 
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
 namespace Slang
 {
 
+// Helpers for acquiring locks, which count how often a lock was already held and had to be waited for.
+
+template<typename Mutex>
+static void _lockMutex(Mutex& mutex, std::atomic<Count>& ioContentionCount)
+{
+    if (!mutex.try_lock())
+    {
+        ++ioContentionCount;
+        mutex.lock();
+    }
+}
+
+static void _lockFile(LockFile& lockFile, LockFile::LockType lockType, std::atomic<Count>& ioContentionCount)
+{
+    if (lockFile.tryLock(lockType) == SLANG_E_TIME_OUT)
+    {
+        ++ioContentionCount;
+        lockFile.lock(lockType);
+    }
+}
+
+namespace { // anonymous
+
+// Records the time from construction to destruction in a latency histogram.
+struct ScopedLatency
+{
+    ScopedLatency(std::atomic<Count>* histogram)
+        : m_histogram(histogram)
+        , m_startTime(std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedLatency()
+    {
+        auto duration = std::chrono::steady_clock::now() - m_startTime;
+        auto micros = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+        Index bucket = 0;
+        while (bucket < PersistentCache::kLatencyBucketCount - 1 && micros >= (uint64_t(1) << bucket))
+        {
+            ++bucket;
+        }
+        ++m_histogram[bucket];
+    }
+
+    std::atomic<Count>* m_histogram;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+} // anonymous
+
+// Held by writers and when clearing the cache, before any shard is locked.
+struct PersistentCache::WriteLock
+{
+    WriteLock(PersistentCache* cache)
+        : m_cache(cache)
+    {
+        _lockMutex(cache->m_mutex, cache->m_lockContentionCount);
+        _lockFile(cache->m_lockFile, LockFile::LockType::Exclusive, cache->m_lockContentionCount);
+    }
+
+    ~WriteLock()
+    {
+        m_cache->m_lockFile.unlock();
+        m_cache->m_mutex.unlock();
+    }
+
+    PersistentCache* m_cache;
+};
+
+// Holds a shard for reading. Other readers, in this and other processes, can hold it at the same time.
+struct PersistentCache::SharedShardLock
+{
+    SharedShardLock(PersistentCache* cache, Shard& shard)
+        : m_shard(shard)
+    {
+        if (!shard.mutex.try_lock_shared())
+        {
+            ++cache->m_lockContentionCount;
+            shard.mutex.lock_shared();
+        }
+
+        // The first reader of this process takes the shared file lock for all of them.
+        std::lock_guard<std::mutex> lock(shard.readerCountMutex);
+        if (shard.readerCount++ == 0)
+        {
+            _lockFile(shard.lockFile, LockFile::LockType::Shared, cache->m_lockContentionCount);
+        }
+    }
+
+    ~SharedShardLock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_shard.readerCountMutex);
+            if (--m_shard.readerCount == 0)
+            {
+                m_shard.lockFile.unlock();
+            }
+        }
+        m_shard.mutex.unlock_shared();
+    }
+
+    Shard& m_shard;
+};
+
+// Holds a shard for changing its index.
+struct PersistentCache::ExclusiveShardLock
+{
+    ExclusiveShardLock(PersistentCache* cache, Shard& shard)
+        : m_shard(shard)
+    {
+        _lockMutex(shard.mutex, cache->m_lockContentionCount);
+        _lockFile(shard.lockFile, LockFile::LockType::Exclusive, cache->m_lockContentionCount);
+    }
+
+    ~ExclusiveShardLock()
+    {
+        m_shard.lockFile.unlock();
+        m_shard.mutex.unlock();
+    }
+
+    Shard& m_shard;
+};
+
 PersistentCache::PersistentCache(const Desc& desc)
 {
     m_cacheDirectory = Path::simplify(desc.directory);
     Path::createDirectory(m_cacheDirectory);
 
     m_lockFileName = Path::simplify(m_cacheDirectory + "/lock");
-    m_indexFileName = Path::simplify(m_cacheDirectory + "/index");
-
     m_lockFile.open(m_lockFileName);
 
+    for (Index shardIndex = 0; shardIndex < kShardCount; ++shardIndex)
+    {
+        Shard& shard = m_shards[shardIndex];
+        shard.indexFileName = Path::simplify(m_cacheDirectory + "/index-" + String(shardIndex));
+        shard.lockFileName = Path::simplify(m_cacheDirectory + "/lock-" + String(shardIndex));
+        shard.lockFile.open(shard.lockFileName);
+    }
+
     m_maxEntryCount = desc.maxEntryCount;
 
     resetStats();
@@ -27,6 +160,11 @@ PersistentCache::PersistentCache(const Desc& desc)
 
 PersistentCache::~PersistentCache()
 {
+    // Write the LRU order of the entries read since their index was last written.
+    for (auto& shard : m_shards)
+    {
+        flushPendingTouches(shard);
+    }
 }
 
 SlangResult PersistentCache::clear()
@@ -36,197 +174,472 @@ SlangResult PersistentCache::clear()
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    // Acquire the write lock and all the shard locks, in order.
+    WriteLock writeLock(this);
+    std::optional<ExclusiveShardLock> shardLocks[kShardCount];
+    List<String> lockFileNames;
+    lockFileNames.add(m_lockFileName);
+    for (Index shardIndex = 0; shardIndex < kShardCount; ++shardIndex)
+    {
+        Shard& shard = m_shards[shardIndex];
+        if (!shard.lockFile.isOpen())
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+        shardLocks[shardIndex].emplace(this, shard);
+        lockFileNames.add(shard.lockFileName);
+    }
 
     struct Visitor : Path::Visitor
     {
         const String& directory;
-        const String& lockFileName;
+        const List<String>& lockFileNames;
 
-        Visitor(const String& directory, const String& lockFileName)
+        Visitor(const String& directory, const List<String>& lockFileNames)
             : directory(directory)
-            , lockFileName(lockFileName)
+            , lockFileNames(lockFileNames)
         {}
 
         void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
         {
-            String fullPath = Path::simplify(directory + "/" + fileName);;
-            if (type == Path::Type::File && lockFileName != fullPath)
+            String fullPath = Path::simplify(directory + "/" + fileName);
+            if (type == Path::Type::File && !lockFileNames.contains(fullPath))
             {
                 Path::remove(fullPath);
             }
         }
     };
 
-    Visitor visitor(m_cacheDirectory, m_lockFileName);
+    Visitor visitor(m_cacheDirectory, lockFileNames);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
-    m_stats.entryCount = 0;
+    for (auto& shard : m_shards)
+    {
+        shard.index.clear();
+        shard.entryIndices.clear();
+        shard.generation = 0;
+        shard.isIndexValid = false;
+        shard.entryCount = 0;
+
+        std::lock_guard<std::mutex> lock(shard.pendingTouchesMutex);
+        shard.pendingTouches.clear();
+    }
 
     return SLANG_OK;
 }
 
+PersistentCache::Stats PersistentCache::getStats() const
+{
+    Stats stats;
+    stats.hitCount = m_hitCount;
+    stats.missCount = m_missCount;
+    stats.entryCount = 0;
+    for (const auto& shard : m_shards)
+    {
+        stats.entryCount += shard.entryCount;
+    }
+    for (Index bucket = 0; bucket < kLatencyBucketCount; ++bucket)
+    {
+        stats.readLatencyHistogram[bucket] = m_readLatencyHistogram[bucket];
+        stats.writeLatencyHistogram[bucket] = m_writeLatencyHistogram[bucket];
+    }
+    stats.lockContentionCount = m_lockContentionCount;
+    stats.indexReloadCount = m_indexReloadCount;
+    return stats;
+}
+
 void PersistentCache::resetStats()
 {
-    m_stats.entryCount = 0;
-    m_stats.hitCount = 0;
-    m_stats.missCount = 0;
+    m_hitCount = 0;
+    m_missCount = 0;
+    for (Index bucket = 0; bucket < kLatencyBucketCount; ++bucket)
+    {
+        m_readLatencyHistogram[bucket] = 0;
+        m_writeLatencyHistogram[bucket] = 0;
+    }
+    m_lockContentionCount = 0;
+    m_indexReloadCount = 0;
 }
 
 SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
 {
+    ScopedLatency latency(m_readLatencyHistogram);
+
     // Be pessimistic and assume we have a cache miss.
-    ++m_stats.missCount;
+    ++m_missCount;
 
-    if (!m_lockFile.isOpen())
+    Shard& shard = getShard(key);
+    if (!shard.lockFile.isOpen())
     {
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    RefPtr<MemoryMappedFile> file;
+    auto mapEntry = [&]() -> SlangResult
+    {
+        if (!shard.entryIndices.containsKey(key))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+        return MemoryMappedFile::create(getEntryFileName(key), file);
+    };
 
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
+    // Look up the entry in the in memory index if it's current, which only needs the shared lock.
+    SlangResult result = SLANG_OK;
+    bool isIndexCurrent = false;
     {
-        return SLANG_E_NOT_FOUND;
-    }
+        SharedShardLock lock(this, shard);
 
-    // Read the cache index.
-    CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
+        uint64_t generation = 0;
+        SLANG_RETURN_ON_FAIL(readIndexGeneration(shard.indexFileName, generation));
 
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
-    {
-        ++entry.age;
+        isIndexCurrent = shard.isIndexValid && shard.generation == generation;
+        if (isIndexCurrent)
+        {
+            result = mapEntry();
+        }
     }
 
-    // Find the entry.
-    Index entryIndex = cacheIndex.findFirstIndex([&key] (const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
+    // If the index was changed by another cache, or the entry file is gone, the in memory index
+    // has to be updated, which needs the exclusive lock.
+    if (!isIndexCurrent || result == SLANG_E_CANNOT_OPEN)
     {
-        return SLANG_E_NOT_FOUND;
+        ExclusiveShardLock lock(this, shard);
+
+        SLANG_RETURN_ON_FAIL(refreshIndex(shard));
+
+        result = mapEntry();
+        if (result == SLANG_E_CANNOT_OPEN)
+        {
+            removeEntry(shard, *shard.entryIndices.tryGetValue(key));
+            flushIndex(shard);
+        }
     }
 
-    // Read the entry.
-    String entryFileName = getEntryFileName(key);
-    ScopedAllocation data;
-    SlangResult result = File::readAllBytes(entryFileName, data);
-    if (result == SLANG_OK)
+    SLANG_RETURN_ON_FAIL(result);
+
+    --m_missCount;
+    ++m_hitCount;
+
+    // Record the use of the entry, to be written to the index with others later.
+    bool shouldFlush = false;
     {
-        --m_stats.missCount;
-        ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
-        auto blob = RawBlob::moveCreate(data);
-        *outData = blob.detach();
+        std::lock_guard<std::mutex> lock(shard.pendingTouchesMutex);
+        shard.pendingTouches.add(CacheEntry{ key, 0, nextTick() });
+        shouldFlush = shard.pendingTouches.getCount() >= kMaxPendingTouchCount;
     }
-    else
+    if (shouldFlush)
     {
-        cacheIndex.removeAt(entryIndex);
+        flushPendingTouches(shard);
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    auto blob = MemoryMappedFileBlob::create(file);
+    *outData = blob.detach();
 
-    return result;
+    return SLANG_OK;
 }
 
 SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
 {
     SLANG_ASSERT(data);
 
-    if (!m_lockFile.isOpen())
+    ScopedLatency latency(m_writeLatencyHistogram);
+
+    Shard& shard = getShard(key);
+    if (!m_lockFile.isOpen() || !shard.lockFile.isOpen())
     {
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    WriteLock writeLock(this);
+    {
+        ExclusiveShardLock lock(this, shard);
+
+        // We ignore any errors when reading the index and just write a new one.
+        refreshIndex(shard);
+
+        String entryFileName = getEntryFileName(key);
+        CacheEntry entry = { key, 0, nextTick() };
+
+        if (auto entryIndex = shard.entryIndices.tryGetValue(key))
+        {
+            // Only the use needs recording, unless the entry file is gone.
+            if (File::exists(entryFileName))
+            {
+                shard.index[*entryIndex].lastUsed = entry.lastUsed;
+                return flushIndex(shard);
+            }
+            removeEntry(shard, *entryIndex);
+        }
+
+        // Write the cache entry. It's written to a temporary file first, so readers of the
+        // entry file only ever map a complete file. Only one writer holds the write lock, so
+        // the temporary file name doesn't need to be unique.
+        String tempFileName = entryFileName + ".tmp";
+        SlangResult result = File::writeAllBytes(tempFileName, data->getBufferPointer(), data->getBufferSize());
+        if (SLANG_SUCCEEDED(result))
+        {
+            result = File::rename(tempFileName, entryFileName);
+        }
+        if (SLANG_FAILED(result))
+        {
+            File::remove(tempFileName);
+            return result;
+        }
+
+        // Update and write the cache index.
+        addEntry(shard, entry);
+        result = flushIndex(shard);
+        if (SLANG_FAILED(result))
+        {
+            // If writing the index failed, remove the entry file to avoid growing the cache.
+            Path::remove(entryFileName);
+            return result;
+        }
+    }
+
+    if (m_maxEntryCount > 0)
+    {
+        evictEntries();
+    }
+
+    return SLANG_OK;
+}
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
+SlangResult PersistentCache::initialize()
+{
+    if (!m_lockFile.isOpen())
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
 
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
+    for (auto& shard : m_shards)
     {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
+        if (!shard.lockFile.isOpen())
         {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
+            return SLANG_E_CANNOT_OPEN;
         }
+
+        ExclusiveShardLock lock(this, shard);
+        refreshIndex(shard);
+    }
+
+    // Loading the indices isn't a reload.
+    m_indexReloadCount = 0;
+
+    return SLANG_OK;
+}
+
+String PersistentCache::getEntryFileName(const Key& key)
+{
+    StringBuilder str;
+    str << m_cacheDirectory << "/" << key.toString();
+    return str;
+}
+
+uint64_t PersistentCache::nextTick()
+{
+    // Ticks are based on the time, so they can be compared with the ticks of other caches using
+    // the same directory, but always increase within a cache.
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    uint64_t nowTick = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+
+    uint64_t lastTick = m_lastTick.load();
+    uint64_t tick;
+    do
+    {
+        tick = std::max(nowTick, lastTick + 1);
     }
+    while (!m_lastTick.compare_exchange_weak(lastTick, tick));
 
-    // Write the cache entry.
-    String entryFileName = getEntryFileName(key);
-    SLANG_RETURN_ON_FAIL(File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
+    return tick;
+}
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+SlangResult PersistentCache::refreshIndex(Shard& shard)
+{
+    uint64_t generation = 0;
+    SlangResult result = readIndexGeneration(shard.indexFileName, generation);
+    if (SLANG_SUCCEEDED(result) && shard.isIndexValid && shard.generation == generation)
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{ key, 0 };
+        return SLANG_OK;
     }
-    else
+
+    CacheIndex index;
+    if (SLANG_SUCCEEDED(result))
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{ key, 0 });
+        result = readIndex(shard.indexFileName, index, generation);
+        ++m_indexReloadCount;
     }
 
-    // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
-    if (result == SLANG_OK)
+    if (SLANG_FAILED(result))
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        // The touches were for entries of an index that is gone.
+        index.clear();
+        generation = 0;
+
+        std::lock_guard<std::mutex> lock(shard.pendingTouchesMutex);
+        shard.pendingTouches.clear();
     }
-    else
+
+    shard.index.swapWith(index);
+    shard.entryIndices.clear();
+    for (Index entryIndex = 0; entryIndex < shard.index.getCount(); ++entryIndex)
     {
-        // If writing the index failed, remove the entry file to avoid growing the cache.
-        Path::remove(entryFileName);
+        shard.entryIndices.set(shard.index[entryIndex].key, entryIndex);
     }
+    shard.generation = generation;
+    shard.isIndexValid = SLANG_SUCCEEDED(result);
+    shard.entryCount = shard.index.getCount();
 
     return result;
 }
 
-SlangResult PersistentCache::initialize()
+SlangResult PersistentCache::flushIndex(Shard& shard)
 {
-    if (!m_lockFile.isOpen())
+    applyPendingTouches(shard);
+
+    uint64_t generation = nextTick();
+    SlangResult result = writeIndex(shard.indexFileName, shard.index, generation);
+
+    // If writing failed the file no longer matches, so it will be read again.
+    shard.generation = generation;
+    shard.isIndexValid = SLANG_SUCCEEDED(result);
+
+    return result;
+}
+
+bool PersistentCache::applyPendingTouches(Shard& shard)
+{
+    List<CacheEntry> touches;
     {
-        return SLANG_E_CANNOT_OPEN;
+        std::lock_guard<std::mutex> lock(shard.pendingTouchesMutex);
+        touches.swapWith(shard.pendingTouches);
+    }
+
+    for (const auto& touch : touches)
+    {
+        if (auto entryIndex = shard.entryIndices.tryGetValue(touch.key))
+        {
+            auto& entry = shard.index[*entryIndex];
+            entry.lastUsed = std::max(entry.lastUsed, touch.lastUsed);
+        }
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    return touches.getCount() > 0;
+}
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
+void PersistentCache::flushPendingTouches(Shard& shard)
+{
+    if (!shard.lockFile.isOpen())
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        return;
     }
 
-    return SLANG_OK;
+    {
+        std::lock_guard<std::mutex> lock(shard.pendingTouchesMutex);
+        if (shard.pendingTouches.getCount() == 0)
+        {
+            return;
+        }
+    }
+
+    ExclusiveShardLock lock(this, shard);
+    if (SLANG_SUCCEEDED(refreshIndex(shard)) && applyPendingTouches(shard))
+    {
+        flushIndex(shard);
+    }
 }
 
-String PersistentCache::getEntryFileName(const Key& key)
+void PersistentCache::evictEntries()
 {
-    StringBuilder str;
-    str << m_cacheDirectory << "/" << key.toString();
-    return str;
+    struct Candidate
+    {
+        uint64_t lastUsed;
+        Index shardIndex;
+        Key key;
+    };
+
+    // Find the entries of all the shards. Their LRU order depends on the pending touches, so
+    // these are written first.
+    List<Candidate> candidates;
+    for (Index shardIndex = 0; shardIndex < kShardCount; ++shardIndex)
+    {
+        Shard& shard = m_shards[shardIndex];
+        ExclusiveShardLock lock(this, shard);
+
+        refreshIndex(shard);
+        if (applyPendingTouches(shard))
+        {
+            flushIndex(shard);
+        }
+
+        for (const auto& entry : shard.index)
+        {
+            candidates.add(Candidate{ entry.lastUsed, shardIndex, entry.key });
+        }
+    }
+
+    Count evictCount = candidates.getCount() - m_maxEntryCount;
+    if (evictCount <= 0)
+    {
+        return;
+    }
+
+    candidates.sort([](const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+
+    // Remove the least recently used entries, a shard at a time.
+    for (Index shardIndex = 0; shardIndex < kShardCount; ++shardIndex)
+    {
+        Shard& shard = m_shards[shardIndex];
+        ExclusiveShardLock lock(this, shard);
+
+        if (SLANG_FAILED(refreshIndex(shard)))
+        {
+            continue;
+        }
+
+        bool isChanged = false;
+        for (Index candidateIndex = 0; candidateIndex < evictCount; ++candidateIndex)
+        {
+            const auto& candidate = candidates[candidateIndex];
+            if (candidate.shardIndex != shardIndex)
+            {
+                continue;
+            }
+            if (auto entryIndex = shard.entryIndices.tryGetValue(candidate.key))
+            {
+                File::remove(getEntryFileName(candidate.key));
+                removeEntry(shard, *entryIndex);
+                isChanged = true;
+            }
+        }
+
+        if (isChanged)
+        {
+            flushIndex(shard);
+        }
+    }
+}
+
+void PersistentCache::addEntry(Shard& shard, const CacheEntry& entry)
+{
+    shard.entryIndices.set(entry.key, shard.index.getCount());
+    shard.index.add(entry);
+    shard.entryCount = shard.index.getCount();
+}
+
+void PersistentCache::removeEntry(Shard& shard, Index entryIndex)
+{
+    // Move the last entry into the gap, so no other entry changes index.
+    shard.entryIndices.remove(shard.index[entryIndex].key);
+    const Index lastIndex = shard.index.getCount() - 1;
+    if (entryIndex != lastIndex)
+    {
+        shard.index[entryIndex] = shard.index[lastIndex];
+        shard.entryIndices.set(shard.index[entryIndex].key, entryIndex);
+    }
+    shard.index.removeLast();
+    shard.entryCount = shard.index.getCount();
 }
 
 struct CacheIndexHeader
@@ -235,41 +648,70 @@ struct CacheIndexHeader
     uint32_t version;
     uint32_t count;
     uint32_t reserved;
+    // Changed every time the index is written.
+    uint64_t generation;
 };
 
 static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+static const uint32_t kVersion = 2;
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+// Read and validate the header of an index, leaving the stream at the first entry.
+static SlangResult _readIndexHeader(FileStream& fs, size_t entrySize, CacheIndexHeader& outHeader)
 {
-    FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
-
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
     size_t fileSize = (size_t)fs.getPosition();
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
-    CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    SLANG_RETURN_ON_FAIL(fs.readExactly(&outHeader, sizeof(outHeader)));
+    if (::memcmp(outHeader.magic, kMagic, 4) != 0 || outHeader.version != kVersion)
     {
         return SLANG_E_INTERNAL_FAIL;
     }
 
     // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    if (outHeader.count * entrySize != fileSize - sizeof(outHeader))
     {
         return SLANG_E_INTERNAL_FAIL;
     }
 
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::readIndexGeneration(const String& fileName, uint64_t& outGeneration)
+{
+    // Return if index does not exist.
+    if (!File::exists(fileName))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+
+    CacheIndexHeader header;
+    SLANG_RETURN_ON_FAIL(_readIndexHeader(fs, sizeof(CacheEntry), header));
+
+    outGeneration = header.generation;
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex, uint64_t& outGeneration)
+{
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+
+    CacheIndexHeader header;
+    SLANG_RETURN_ON_FAIL(_readIndexHeader(fs, sizeof(CacheEntry), header));
+
     outIndex.setCount(header.count);
     SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
-    
+    outGeneration = header.generation;
+
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index, uint64_t generation)
 {
     FileStream fs;
     SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
@@ -279,6 +721,7 @@ SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex
     header.version = kVersion;
     header.count = (uint32_t)index.getCount();
     header.reserved = 0;
+    header.generation = generation;
     SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
 
     SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
@@ -1,10 +1,13 @@
 #pragma once
 #include "../../slang.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
 
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
 
 namespace Slang
 {
@@ -12,19 +15,27 @@ namespace Slang
 /// Implements a simple persistent cache on the filesystem for storing key/value pairs.
 /// Keys are SHA1 hashes and values are arbitrary blobs of data.
 /// The cache is save for concurrent access from multiple threads/processes by using
-/// a lock file within the cache directory. Furthermore, the cache implements a LRU
+/// lock files within the cache directory. Furthermore, the cache implements a LRU
 /// eviction policy.
+///
+/// The index of entries is split into shards by key, each with its own index and lock file,
+/// so lookups of different keys don't contend. Lookups only take shared locks, and entries are
+/// read by mapping their files into memory. Reads update the LRU order in batches, rather than
+/// rewriting the index on every hit.
 class PersistentCache : public RefObject
 {
 public:
     struct Desc
-    {   
+    {
         // The root directory for the cache.
         const char* directory = nullptr;
         // The maximum number of entries stored in the cache. By default, there is no limit.
         Count maxEntryCount = 0;
     };
 
+    // Number of buckets in the latency histograms.
+    static const Index kLatencyBucketCount = 16;
+
     struct Stats
     {
         // Number of cache hits since last resetting the stats.
@@ -33,6 +44,14 @@ public:
         Count missCount;
         // Current number of entries in the cache.
         Count entryCount;
+        // Number of reads/writes by how long they took. Bucket i counts calls that took less than
+        // 2^i microseconds (and at least 2^(i-1)), the last bucket counts all the slower calls.
+        Count readLatencyHistogram[kLatencyBucketCount];
+        Count writeLatencyHistogram[kLatencyBucketCount];
+        // Number of times a lock was already held by another thread or process, and had to be waited for.
+        Count lockContentionCount;
+        // Number of times the index of a shard was read again because another cache changed it.
+        Count indexReloadCount;
     };
 
     using Key = SHA1::Digest;
@@ -43,46 +62,115 @@ public:
     /// Clear the contents of the cache by removing the cache index and all entry files.
     SlangResult clear();
 
-    const Stats& getStats() const { return m_stats; }
+    /// Get a snapshot of the stats.
+    Stats getStats() const;
     void resetStats();
 
     /// Read an entry from the cache.
     /// Returns SLANG_OK if successful, SLANG_E_NOT_FOUND if the entry is not in the cache.
     SlangResult readEntry(const Key& key, ISlangBlob** outData);
-    
-    /// Write an entry to the cache.
+
+    /// Write an entry to the cache. If the key is already in the cache the existing entry is kept,
+    /// as keys identify their data.
     /// Returns SLANG_OK if successful.
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
 private:
+    // Number of shards the index is split into. Must be a power of 2.
+    static const Index kShardCount = 16;
+    // Number of reads of a shard after which the LRU order is written to its index.
+    static const Index kMaxPendingTouchCount = 64;
+
     struct CacheEntry
     {
         Key key;
-        uint32_t age;
+        uint32_t reserved;
+        // Tick of the last time the entry was read or written. Ticks are comparable across shards.
+        uint64_t lastUsed;
     };
 
     using CacheIndex = List<CacheEntry>;
 
+    struct Shard
+    {
+        String indexFileName;
+        String lockFileName;
+
+        // For locking a shard we need both a mutex (acquired first) followed by a file lock.
+        // The mutex is needed because on Linux the file lock is only locking between processes,
+        // not threads. Readers of this process share a single shared file lock.
+        std::shared_mutex mutex;
+        Slang::LockFile lockFile;
+        std::mutex readerCountMutex;
+        Count readerCount = 0;
+
+        // The index as last read from or written to the index file. Only changed whilst
+        // holding the exclusive lock.
+        CacheIndex index;
+        Dictionary<Key, Index> entryIndices;
+        // Changed every time the index file is written, so changes from other caches are noticed.
+        uint64_t generation = 0;
+        bool isIndexValid = false;
+        std::atomic<Count> entryCount{0};
+
+        // Entries read since the index was last written.
+        std::mutex pendingTouchesMutex;
+        List<CacheEntry> pendingTouches;
+    };
+
+    struct WriteLock;
+    struct SharedShardLock;
+    struct ExclusiveShardLock;
+
     SlangResult initialize();
 
+    Shard& getShard(const Key& key) { return m_shards[key.data[0] & (kShardCount - 1)]; }
+
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    uint64_t nextTick();
+
+    /// Read the generation from the header of an index file, to find out if the in memory index is current.
+    SlangResult readIndexGeneration(const String& fileName, uint64_t& outGeneration);
+    /// Make the in memory index of the shard match the index file. Requires the exclusive lock.
+    /// If the index file is missing or corrupt, the shard is treated as empty and the error returned.
+    SlangResult refreshIndex(Shard& shard);
+    /// Write the in memory index of the shard, including any pending touches. Requires the exclusive lock.
+    SlangResult flushIndex(Shard& shard);
+    /// Apply the pending touches of the shard to the in memory index. Requires the exclusive lock.
+    /// Returns true if there were any.
+    bool applyPendingTouches(Shard& shard);
+    /// Write the pending touches of the shard to its index file.
+    void flushPendingTouches(Shard& shard);
+    /// Remove the least recently used entries until the cache fits. Requires the write lock.
+    void evictEntries();
+
+    void addEntry(Shard& shard, const CacheEntry& entry);
+    void removeEntry(Shard& shard, Index entryIndex);
+
+    SlangResult readIndex(const String& fileName, CacheIndex& outIndex, uint64_t& outGeneration);
+    SlangResult writeIndex(const String& fileName, const CacheIndex& index, uint64_t generation);
 
     String m_cacheDirectory;
     String m_lockFileName;
-    String m_indexFileName;
 
-    // For exclusive locking we need both a mutex (acquired first)
-    // followed by a a file lock. The mutex is needed because on Linux
-    // the file lock is only locking between processes, not threads.
+    // Writers take the write lock before any shard lock, so that eviction sees a stable entry count.
+    // As for shards, a mutex is needed as well as the lock file.
     std::mutex m_mutex;
     Slang::LockFile m_lockFile;
 
+    Shard m_shards[kShardCount];
+
     Count m_maxEntryCount;
 
-    Stats m_stats;
+    std::atomic<uint64_t> m_lastTick{0};
+
+    std::atomic<Count> m_hitCount;
+    std::atomic<Count> m_missCount;
+    std::atomic<Count> m_readLatencyHistogram[kLatencyBucketCount];
+    std::atomic<Count> m_writeLatencyHistogram[kLatencyBucketCount];
+    std::atomic<Count> m_lockContentionCount;
+    std::atomic<Count> m_indexReloadCount;
 
     // Used for unit tests.
     friend struct PersistentCacheTest;
@@ -54,12 +54,30 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
 
     if (m_compressionSystem)
     {
+        // If read-only the contents can't change, so a previous decompression can be reused
+        const bool useCache = isReadOnly();
+        if (useCache)
+        {
+            ComPtr<ISlangBlob> blob;
+            if (_findDecompressedFile(entry->m_canonicalPath, blob))
+            {
+                *outBlob = blob.detach();
+                return SLANG_OK;
+            }
+        }
+
         // Okay lets decompress into a blob
         ScopedAllocation alloc;
         void* dst = alloc.allocateTerminated(entry->m_uncompressedSizeInBytes);
         SLANG_RETURN_ON_FAIL(m_compressionSystem->decompress(contents->getBufferPointer(), contents->getBufferSize(), entry->m_uncompressedSizeInBytes, dst));
 
-        auto blob = RawBlob::moveCreate(alloc);
+        ComPtr<ISlangBlob> blob(RawBlob::moveCreate(alloc));
+
+        if (useCache)
+        {
+            // If another thread decompressed the file at the same time, its blob is used instead
+            _addDecompressedFile(entry->m_canonicalPath, blob);
+        }
 
         *outBlob = blob.detach();
         return SLANG_OK;
@@ -75,6 +93,11 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
 
 SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t size)
 {   
+    if (isReadOnly())
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
     Entry* entry;
     SLANG_RETURN_ON_FAIL(_requireFile(path, &entry));
 
@@ -99,6 +122,10 @@ SlangResult RiffFileSystem::saveFileBlob(const char* path, ISlangBlob* dataBlob)
     {
         return SLANG_E_INVALID_ARG;
     }
+    if (isReadOnly())
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
 
     if (m_compressionSystem)
     {
@@ -110,29 +137,98 @@ SlangResult RiffFileSystem::saveFileBlob(const char* path, ISlangBlob* dataBlob)
     }
 }
 
-SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeInBytes)
+SlangResult RiffFileSystem::remove(const char* path)
 {
-    // Load the riff
-    RiffContainer container;
+    return isReadOnly() ? SLANG_E_NOT_AVAILABLE : Super::remove(path);
+}
+
+SlangResult RiffFileSystem::createDirectory(const char* path)
+{
+    return isReadOnly() ? SLANG_E_NOT_AVAILABLE : Super::createDirectory(path);
+}
 
-    MemoryStreamBase stream(FileAccess::Read, archive, archiveSizeInBytes);
-    SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+void RiffFileSystem::clearCache()
+{
+    _clearDecompressedFiles();
+}
+
+void RiffFileSystem::setDecompressedCacheSize(size_t sizeInBytes)
+{
+    std::lock_guard<std::mutex> lock(m_decompressedFilesMutex);
 
-    RiffContainer::ListChunk* rootList = container.getRoot();
-    // Make sure it's the right type
-    if (rootList == nullptr || rootList->m_fourCC != RiffFileSystemBinary::kContainerFourCC)
+    m_decompressedCacheSize = sizeInBytes;
+    _trimDecompressedFiles(sizeInBytes);
+}
+
+void RiffFileSystem::_trimDecompressedFiles(size_t sizeInBytes)
+{
+    // Remove the least recently used files until they fit
+    while (m_decompressedFilesSize > sizeInBytes)
     {
-        return SLANG_FAIL;
+        LinkedNode<DecompressedFile>* lastNode = m_decompressedFiles.getLastNode();
+        m_decompressedFilesSize -= lastNode->value.m_blob->getBufferSize();
+        m_decompressedFileNodes.remove(lastNode->value.m_canonicalPath);
+        m_decompressedFiles.removeAndDelete(lastNode);
     }
+}
 
-    // Clear the contents
-    _clear();
+bool RiffFileSystem::_findDecompressedFile(const String& canonicalPath, ComPtr<ISlangBlob>& outBlob)
+{
+    std::lock_guard<std::mutex> lock(m_decompressedFilesMutex);
+
+    LinkedNode<DecompressedFile>* node = nullptr;
+    if (!m_decompressedFileNodes.tryGetValue(canonicalPath, node))
+    {
+        return false;
+    }
 
-    // Find the header
-    const auto header = rootList->findContainedData<RiffFileSystemBinary::Header>(RiffFileSystemBinary::kHeaderFourCC);
+    // Make it the most recently used
+    m_decompressedFiles.removeFromList(node);
+    m_decompressedFiles.addFirst(node);
+
+    outBlob = node->value.m_blob;
+    return true;
+}
+
+void RiffFileSystem::_addDecompressedFile(const String& canonicalPath, ComPtr<ISlangBlob>& ioBlob)
+{
+    std::lock_guard<std::mutex> lock(m_decompressedFilesMutex);
 
-    CompressionSystemType compressionType = CompressionSystemType(header->compressionSystemType);
-    switch (compressionType)
+    LinkedNode<DecompressedFile>* node = nullptr;
+    if (m_decompressedFileNodes.tryGetValue(canonicalPath, node))
+    {
+        ioBlob = node->value.m_blob;
+        return;
+    }
+
+    const size_t blobSize = ioBlob->getBufferSize();
+    if (m_decompressedCacheSize == 0 || blobSize > m_decompressedCacheSize)
+    {
+        return;
+    }
+
+    _trimDecompressedFiles(m_decompressedCacheSize - blobSize);
+
+    DecompressedFile decompressedFile;
+    decompressedFile.m_canonicalPath = canonicalPath;
+    decompressedFile.m_blob = ioBlob;
+
+    m_decompressedFileNodes.add(canonicalPath, m_decompressedFiles.addFirst(decompressedFile));
+    m_decompressedFilesSize += blobSize;
+}
+
+void RiffFileSystem::_clearDecompressedFiles()
+{
+    std::lock_guard<std::mutex> lock(m_decompressedFilesMutex);
+
+    m_decompressedFiles.clear();
+    m_decompressedFileNodes = Dictionary<String, LinkedNode<DecompressedFile>*>();
+    m_decompressedFilesSize = 0;
+}
+
+SlangResult RiffFileSystem::_setCompressionSystemType(CompressionSystemType type)
+{
+    switch (type)
     {
         case CompressionSystemType::None:
         {
@@ -152,71 +248,165 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
         }
         default: return SLANG_FAIL;
     }
+    return SLANG_OK;
+}
 
-    // Read all of the contained data
+SlangResult RiffFileSystem::_addEntry(const uint8_t* data, size_t dataSize, ISlangBlob* archiveBlob)
+{
+    if (dataSize < sizeof(RiffFileSystemBinary::Entry))
+    {
+        return SLANG_FAIL;
+    }
 
+    // The data is only aligned to the riff padding, so copy the entry out
+    RiffFileSystemBinary::Entry srcEntry;
+    ::memcpy(&srcEntry, data, sizeof(srcEntry));
+    const uint8_t* srcData = data + sizeof(srcEntry);
+
+    // Check if seems plausible
+    if (srcEntry.pathSize == 0 ||
+        sizeof(RiffFileSystemBinary::Entry) + size_t(srcEntry.compressedSize) + size_t(srcEntry.pathSize) != dataSize)
     {
-        List<RiffContainer::DataChunk*> srcEntries;
-        rootList->findContained(RiffFileSystemBinary::kEntryFourCC, srcEntries);
+        return SLANG_FAIL;
+    }
 
-        for (auto chunk : srcEntries)
-        {
-            auto data = chunk->getSingleData();
+    Entry dstEntry;
 
-            const uint8_t* srcData = (const uint8_t*)data->getPayload();
-            const size_t dataSize = data->getSize();
+    const char* path = (const char*)srcData;
+    srcData += srcEntry.pathSize;
 
-            if (dataSize < sizeof(RiffFileSystemBinary::Entry))
+    dstEntry.m_canonicalPath = UnownedStringSlice(path, srcEntry.pathSize - 1);
+    dstEntry.m_type = (SlangPathType)srcEntry.pathType;
+    dstEntry.m_uncompressedSizeInBytes = srcEntry.uncompressedSize;
+
+    switch (dstEntry.m_type)
+    {
+        case SLANG_PATH_TYPE_FILE:
+        {
+            // Get the compressed data
+            if (archiveBlob)
             {
-                return SLANG_FAIL;
+                // Reference the archive's memory, keeping the archive alive for as long as the contents are
+                dstEntry.m_contents = ScopeBlob::create(UnownedRawBlob::create(srcData, srcEntry.compressedSize), archiveBlob);
             }
-
-            auto srcEntry = (const RiffFileSystemBinary::Entry*)srcData;
-            srcData += sizeof(*srcEntry);
-
-            // Check if seems plausible
-            if (sizeof(RiffFileSystemBinary::Entry) + srcEntry->compressedSize + srcEntry->pathSize != dataSize)
+            else
             {
-                return SLANG_FAIL;
+                dstEntry.m_contents = RawBlob::create(srcData, srcEntry.compressedSize);
             }
+            break;
+        }
+        case SLANG_PATH_TYPE_DIRECTORY: break;
+        default: return SLANG_FAIL;
+    }
+
+    // If it's the root entry we can ignore (as already added)
+    if (dstEntry.m_canonicalPath == ".")
+    {
+        return SLANG_OK;
+    }
+
+    // Add to the list of entries
+    m_entries.add(dstEntry.m_canonicalPath, dstEntry);
+    return SLANG_OK;
+}
+
+SlangResult RiffFileSystem::_loadArchive(const void* archive, size_t archiveSizeInBytes, ISlangBlob* archiveBlob)
+{
+    // The chunks are read directly from the archive's memory, rather than through a RiffContainer, so the
+    // contents are copied at most once.
+    const uint8_t* cur = (const uint8_t*)archive;
+
+    RiffListHeader rootHeader;
+    if (archiveSizeInBytes < sizeof(rootHeader))
+    {
+        return SLANG_FAIL;
+    }
+    ::memcpy(&rootHeader, cur, sizeof(rootHeader));
+
+    // Make sure it's the right type. The size includes the sub type.
+    if (!RiffUtil::isListType(rootHeader.chunk.type) ||
+        rootHeader.subType != RiffFileSystemBinary::kContainerFourCC ||
+        rootHeader.chunk.size < sizeof(FourCC) ||
+        rootHeader.chunk.size > archiveSizeInBytes - sizeof(RiffHeader))
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* end = cur + sizeof(RiffHeader) + rootHeader.chunk.size;
+    cur += sizeof(RiffListHeader);
 
-            Entry dstEntry;
+    // Clear the contents
+    _clear();
 
-            const char* path = (const char*)srcData;
-            srcData += srcEntry->pathSize;
+    bool hasHeader = false;
+    while (cur < end)
+    {
+        RiffHeader chunk;
+        if (size_t(end - cur) < sizeof(chunk))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&chunk, cur, sizeof(chunk));
 
-            dstEntry.m_canonicalPath = UnownedStringSlice(path, srcEntry->pathSize - 1);
-            dstEntry.m_type = (SlangPathType)srcEntry->pathType;
-            dstEntry.m_uncompressedSizeInBytes = srcEntry->uncompressedSize;
-            
-            switch (dstEntry.m_type)
+        const uint8_t* payload = cur + sizeof(chunk);
+        if (chunk.size > size_t(end - payload))
+        {
+            return SLANG_FAIL;
+        }
+
+        switch (chunk.type)
+        {
+            case RiffFileSystemBinary::kHeaderFourCC:
             {
-                case SLANG_PATH_TYPE_FILE:
+                RiffFileSystemBinary::Header header;
+                if (chunk.size < sizeof(header))
                 {
-                    if (srcData + srcEntry->compressedSize != data->getPayloadEnd())
-                    {
-                        return SLANG_FAIL;
-                    }
-
-                    // Get the compressed data
-                    dstEntry.m_contents = RawBlob::create(srcData, srcEntry->compressedSize);
-                    break;
+                    return SLANG_FAIL;
                 }
-                case SLANG_PATH_TYPE_DIRECTORY: break;
-                default: return SLANG_FAIL;
-            }
+                ::memcpy(&header, payload, sizeof(header));
 
-            // If it's the root entry we can ignore (as already added)
-            if (dstEntry.m_canonicalPath == ".")
+                SLANG_RETURN_ON_FAIL(_setCompressionSystemType(CompressionSystemType(header.compressionSystemType)));
+                hasHeader = true;
+                break;
+            }
+            case RiffFileSystemBinary::kEntryFourCC:
             {
-                continue;
+                SLANG_RETURN_ON_FAIL(_addEntry(payload, chunk.size, archiveBlob));
+                break;
             }
-
-            // Add to the list of entries
-            m_entries.add(dstEntry.m_canonicalPath, dstEntry);
+            // Anything else isn't used
+            default: break;
         }
+
+        // Chunks are padded, the padding of the last chunk may be missing
+        cur = payload + RiffUtil::getPadSize(chunk.size);
     }
 
+    return hasHeader ? SLANG_OK : SLANG_FAIL;
+}
+
+SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeInBytes)
+{
+    // The contents are copied, so the file system can be modified
+    m_archiveBlob.setNull();
+    _clearDecompressedFiles();
+
+    return _loadArchive(archive, archiveSizeInBytes, nullptr);
+}
+
+SlangResult RiffFileSystem::loadArchiveBlob(ISlangBlob* archiveBlob)
+{
+    if (!archiveBlob)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    m_archiveBlob.setNull();
+    _clearDecompressedFiles();
+
+    SLANG_RETURN_ON_FAIL(_loadArchive(archiveBlob->getBufferPointer(), archiveBlob->getBufferSize(), archiveBlob));
+
+    m_archiveBlob = archiveBlob;
     return SLANG_OK;
 }
 
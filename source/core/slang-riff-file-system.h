@@ -5,6 +5,9 @@
 #include "slang-memory-file-system.h"
 
 #include "slang-riff.h"
+#include "slang-linked-list.h"
+
+#include <mutex>
 
 namespace Slang
 {
@@ -43,6 +46,10 @@ implementation on construction. If constructed without an ICompressionSystem, da
 used, files 'contents' blob is actually the *compressed* version of the contents. Calling loadFile/saveFile will 
 uncompress/compress as need. If there is no compression contents is identical to the file contents.
 
+An archive can also be loaded read-only with loadArchiveBlob. The entries then reference the archive blob's memory
+(which can be a memory mapped file) directly, so nothing is copied, and the file system can't be modified. As the
+contents can't change, decompressed files are cached, up to a total size set with setDecompressedCacheSize.
+
 NOTE:
 * The RIFF chunk IDs are *slang specific*. It conforms to RIFF but is unlikely to be usable with other tooling.
 * The RIFF chunk IDs are in RiffFileSystemBinary struct
@@ -64,25 +71,76 @@ public:
     // ISlangModifyableFileSystem
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL saveFile(const char* path, const void* data, size_t size) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL saveFileBlob(const char* path, ISlangBlob* dataBlob) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL remove(const char* path) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL createDirectory(const char* path) SLANG_OVERRIDE;
+
+    // ISlangFileSystemExt
+    virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE;
 
     // IArchiveFileSystem
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadArchive(const void* archive, size_t archiveSizeInBytes) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL storeArchive(bool blobOwnsContent, ISlangBlob** outBlob) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW void SLANG_MCALL setCompressionStyle(const CompressionStyle& style) SLANG_OVERRIDE { m_compressionStyle = style; }
 
+        /// Load the archive in `archiveBlob` read-only, without copying it.
+        /// File contents reference the blob's memory, and keep the blob alive.
+    SlangResult loadArchiveBlob(ISlangBlob* archiveBlob);
+
+        /// True if the file system was loaded with loadArchiveBlob, and so can't be modified
+    bool isReadOnly() const { return m_archiveBlob != nullptr; }
+
+        /// Set the maximum total size of the decompressed files cached when read-only. 0 disables the cache.
+    void setDecompressedCacheSize(size_t sizeInBytes);
+
         /// Pass in nullptr, if no compression is wanted. 
     explicit RiffFileSystem(ICompressionSystem* compressionSystem);
 
         /// True if this appears to be Riff archive
     static bool isArchive(const void* data, size_t sizeInBytes);
 
+        /// The default maximum size of the decompressed file cache
+    static const size_t kDefaultDecompressedCacheSize = 16 * 1024 * 1024;
+
 protected:
+    struct DecompressedFile
+    {
+        String m_canonicalPath;
+        ComPtr<ISlangBlob> m_blob;
+    };
+
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+        /// Read the archive, referencing the contents in the archive blob if it's set, else copying them
+    SlangResult _loadArchive(const void* archive, size_t archiveSizeInBytes, ISlangBlob* archiveBlob);
+        /// Add the entry held in the data of an entry chunk
+    SlangResult _addEntry(const uint8_t* data, size_t dataSize, ISlangBlob* archiveBlob);
+    SlangResult _setCompressionSystemType(CompressionSystemType type);
+
+        /// Find the decompressed file at `canonicalPath`, making it the most recently used
+    bool _findDecompressedFile(const String& canonicalPath, ComPtr<ISlangBlob>& outBlob);
+        /// Add the decompressed file at `canonicalPath`. If it has already been added, `ioBlob` is set to the cached blob.
+    void _addDecompressedFile(const String& canonicalPath, ComPtr<ISlangBlob>& ioBlob);
+        /// Remove the least recently used decompressed files until their total size is at most `sizeInBytes`.
+        /// The mutex must be held.
+    void _trimDecompressedFiles(size_t sizeInBytes);
+    void _clearDecompressedFiles();
+
     ComPtr<ICompressionSystem> m_compressionSystem;
 
     CompressionStyle m_compressionStyle;
+
+    // Set if loaded read-only, holding the memory the entries reference
+    ComPtr<ISlangBlob> m_archiveBlob;
+
+    // Decompressed files, only used when read-only. Files can be loaded from more than one thread, so
+    // these are guarded by the mutex.
+    std::mutex m_decompressedFilesMutex;
+    // Ordered from the most to the least recently used
+    LinkedList<DecompressedFile> m_decompressedFiles;
+    Dictionary<String, LinkedNode<DecompressedFile>*> m_decompressedFileNodes;
+    size_t m_decompressedFilesSize = 0;
+    size_t m_decompressedCacheSize = kDefaultDecompressedCacheSize;
 };
 
 }
@@ -508,6 +508,16 @@ SlangResult BufferedReadStream::flush()
     return SLANG_E_NOT_AVAILABLE;
 }
 
+SlangResult BufferedReadStream::waitForRead(Int timeOutInMs)
+{
+    return (getCount() > 0) ? SLANG_OK : waitForUpdate(timeOutInMs);
+}
+
+SlangResult BufferedReadStream::waitForUpdate(Int timeOutInMs)
+{
+    return m_stream ? m_stream->waitForRead(timeOutInMs) : SLANG_OK;
+}
+
 SlangResult BufferedReadStream::update()
 {
     if (m_stream == nullptr)
@@ -577,10 +587,22 @@ SlangResult BufferedReadStream::readUntilContains(size_t size)
         // Update buffer
         SLANG_RETURN_ON_FAIL(update());
 
-        // If nothing was read yield
+        // If nothing was read wait for more, or yield if the stream can't wait
         if (preCount == getCount())
         {
-            Process::sleepCurrentThread(0);
+            if (m_stream == nullptr || m_stream->isEnd())
+            {
+                return SLANG_FAIL;
+            }
+            const SlangResult waitRes = waitForUpdate(-1);
+            if (waitRes == SLANG_E_NOT_IMPLEMENTED)
+            {
+                Process::sleepCurrentThread(0);
+            }
+            else
+            {
+                SLANG_RETURN_ON_FAIL(waitRes);
+            }
         }
     }
 }
@@ -54,6 +54,11 @@ public:
         /// Only applicable for write streams, flushes any buffers to underlying representation (such as pipe, or file)
     virtual SlangResult flush() = 0;
 
+        /// Block until a read may return bytes, or the end of the stream is reached, waiting at most `timeOutInMs`.
+        /// A time out of -1 waits indefinitely. Returns SLANG_E_TIME_OUT if the time out was reached.
+        /// Returns SLANG_E_NOT_IMPLEMENTED if the stream can't wait, in which case the caller has to poll with read.
+    virtual SlangResult waitForRead(Int timeOutInMs) { SLANG_UNUSED(timeOutInMs); return SLANG_E_NOT_IMPLEMENTED; }
+
         /// Helper function that will also *fail* if the specified amount of bytes aren't read.
     SlangResult readExactly(void* buffer, size_t length);
 };
@@ -205,10 +210,15 @@ public:
     virtual void close() SLANG_OVERRIDE;
     virtual bool isEnd() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
+    virtual SlangResult waitForRead(Int timeOutInMs) SLANG_OVERRIDE;
 
         /// Will read assuming backing stream is 
     SlangResult update();
 
+        /// Block until an update may add bytes to the buffer (ie the backing stream can be read), waiting at most `timeOutInMs`.
+        /// Unlike waitForRead, this waits even if the buffer already holds bytes.
+    SlangResult waitForUpdate(Int timeOutInMs);
+
         /// Consume bytes in the buffer.
     void consume(Index byteCount);
 
@@ -0,0 +1,158 @@
+#include "slang-thread-pool.h"
+
+namespace Slang
+{
+
+ThreadPool::ThreadPool(Count threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = getDefaultThreadCount();
+    }
+
+    m_ranges.reset(new TaskRange[threadCount]);
+
+    // The calling thread is participant 0, so we only need to create `threadCount - 1` workers.
+    m_workers.reserve(threadCount - 1);
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_workers.add(std::thread(&ThreadPool::_workerThreadFunc, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShutdown = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+/* static */Count ThreadPool::getDefaultThreadCount()
+{
+    const auto count = Count(std::thread::hardware_concurrency());
+    return count > 0 ? count : 1;
+}
+
+void ThreadPool::parallelFor(Index taskCount, const TaskFunc& func)
+{
+    if (taskCount <= 0)
+    {
+        return;
+    }
+
+    // If there is nothing to run in parallel, just run on this thread.
+    if (taskCount == 1 || m_workers.getCount() == 0)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+
+    // Split the tasks evenly between all of the participants.
+    const Count participantCount = getThreadCount();
+    for (Index i = 0; i < participantCount; ++i)
+    {
+        auto& range = m_ranges[i];
+        std::lock_guard<std::mutex> rangeLock(range.mutex);
+        range.begin = Index((int64_t(taskCount) * i) / participantCount);
+        range.end = Index((int64_t(taskCount) * (i + 1)) / participantCount);
+    }
+
+    // Wake up the workers.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_currentFunc = &func;
+        m_busyWorkerCount = m_workers.getCount();
+        m_jobGeneration++;
+    }
+    m_jobAvailable.notify_all();
+
+    _runTasks(0);
+
+    // Wait for all of the workers to run out of work, so that `func` is no longer referenced.
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobFinished.wait(lock, [this]() { return m_busyWorkerCount == 0; });
+        m_currentFunc = nullptr;
+    }
+}
+
+void ThreadPool::_workerThreadFunc(Index participantIndex)
+{
+    uint64_t lastGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [&]() { return m_isShutdown || m_jobGeneration != lastGeneration; });
+            if (m_isShutdown)
+            {
+                return;
+            }
+            lastGeneration = m_jobGeneration;
+        }
+
+        _runTasks(participantIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkerCount == 0)
+            {
+                m_jobFinished.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::_runTasks(Index participantIndex)
+{
+    const TaskFunc& func = *m_currentFunc;
+
+    Index taskIndex;
+    while (_popTask(participantIndex, taskIndex) || _stealTask(participantIndex, taskIndex))
+    {
+        func(taskIndex);
+    }
+}
+
+bool ThreadPool::_popTask(Index participantIndex, Index& outTaskIndex)
+{
+    auto& range = m_ranges[participantIndex];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end)
+    {
+        return false;
+    }
+    outTaskIndex = range.begin++;
+    return true;
+}
+
+bool ThreadPool::_stealTask(Index participantIndex, Index& outTaskIndex)
+{
+    // Start with the next participant along, so that thieves spread out over the victims.
+    const Count participantCount = getThreadCount();
+    for (Index i = 1; i < participantCount; ++i)
+    {
+        auto& range = m_ranges[(participantIndex + i) % participantCount];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        if (range.begin < range.end)
+        {
+            outTaskIndex = --range.end;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
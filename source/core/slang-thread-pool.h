@@ -0,0 +1,77 @@
+#pragma once
+#include "../core/slang-basic.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// A fixed size pool of worker threads that can execute a range of independent tasks in parallel.
+///
+/// The range of task indices passed to `parallelFor` is split evenly between all participating
+/// threads (the worker threads plus the calling thread). Each thread consumes tasks from the front
+/// of its own range, and once it runs out of work it steals tasks from the back of the range
+/// belonging to another thread. This keeps load balanced even when tasks vary in cost.
+class ThreadPool : public RefObject
+{
+public:
+    typedef std::function<void(Index taskIndex)> TaskFunc;
+
+        /// Create a pool that uses `threadCount` threads in total, *including* the thread that
+        /// calls `parallelFor`. If `threadCount` is <= 0, `getDefaultThreadCount` is used.
+    explicit ThreadPool(Count threadCount = 0);
+    ~ThreadPool();
+
+        /// The total number of threads that participate in a `parallelFor`.
+    Count getThreadCount() const { return m_workers.getCount() + 1; }
+
+        /// Run `func(i)` for every `i` in [0, taskCount), returning once all tasks have completed.
+        /// The calling thread takes part in executing the tasks.
+        /// Calls from multiple threads are serialized.
+    void parallelFor(Index taskCount, const TaskFunc& func);
+
+        /// Returns the number of hardware threads available, or 1 if it can't be determined.
+    static Count getDefaultThreadCount();
+
+private:
+        /// A range of task indices owned by a single participating thread.
+    struct alignas(64) TaskRange
+    {
+        std::mutex mutex;
+        Index begin = 0;
+        Index end = 0;
+    };
+
+    void _workerThreadFunc(Index participantIndex);
+
+        /// Execute tasks from the current job until there is no work left anywhere.
+    void _runTasks(Index participantIndex);
+
+        /// Take a task from the front of the range owned by `participantIndex`.
+    bool _popTask(Index participantIndex, Index& outTaskIndex);
+        /// Take a task from the back of a range owned by another participant.
+    bool _stealTask(Index participantIndex, Index& outTaskIndex);
+
+    List<std::thread> m_workers;
+    std::unique_ptr<TaskRange[]> m_ranges;
+
+    // Serializes calls to `parallelFor`.
+    std::mutex m_dispatchMutex;
+
+    // Protects the fields used to hand a job to the workers, and to signal its completion.
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_jobFinished;
+    uint64_t m_jobGeneration = 0;
+    Count m_busyWorkerCount = 0;
+    bool m_isShutdown = false;
+
+    const TaskFunc* m_currentFunc = nullptr;
+};
+
+}
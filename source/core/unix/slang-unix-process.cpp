@@ -62,6 +62,7 @@ public:
     virtual bool canWrite() SLANG_OVERRIDE { return _has(FileAccess::Write) && !m_isClosed; }
     virtual void close() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
+    virtual SlangResult waitForRead(Int timeOutInMs) SLANG_OVERRIDE;
 
     UnixPipeStream(int fd, FileAccess access, bool isOwned) :
         m_fd(fd),
@@ -308,6 +309,34 @@ SlangResult UnixPipeStream::read(void* buffer, size_t length, size_t& outReadByt
     return SLANG_OK;
 }
 
+SlangResult UnixPipeStream::waitForRead(Int timeOutInMs)
+{
+    if (!_has(FileAccess::Read))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (m_isClosed)
+    {
+        return SLANG_OK;
+    }
+
+    pollfd pollInfo;
+
+    pollInfo.fd = m_fd;
+    pollInfo.events = POLLIN | POLLHUP;
+    pollInfo.revents = 0;
+
+    // A negative timeout waits indefinitely
+    const int pollResult = ::poll(&pollInfo, 1, int(timeOutInMs));
+    if (pollResult < 0)
+    {
+        // If interrupted by a signal, let the caller try again
+        return (errno == EINTR) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    return (pollResult == 0) ? SLANG_E_TIME_OUT : SLANG_OK;
+}
+
 SlangResult UnixPipeStream::write(const void* buffer, size_t length)
 {
     if (!_has(FileAccess::Write))
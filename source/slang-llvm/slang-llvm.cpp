@@ -16,6 +16,7 @@
 #include "clang/Lex/PreprocessorOptions.h"
 
 #include "clang/Frontend/FrontendAction.h"
+#include "clang/Frontend/FrontendActions.h"
 #include "clang/CodeGen/CodeGenAction.h"
 #include "clang/Basic/Version.h"
 
@@ -73,6 +74,7 @@
 #include <compiler-core/slang-artifact-associated-impl.h>
 #include <compiler-core/slang-artifact-desc-util.h>
 #include <compiler-core/slang-slice-allocator.h>
+#include <compiler-core/slang-prefix-header-util.h>
 
 #include <stdio.h>
 
@@ -531,6 +533,193 @@ static SlangResult _initLLVM()
 }
 
 
+    /// Set the options on the invocation that control how source is compiled. The same options are used
+    /// to compile the prefix header into a precompiled header.
+static SlangResult _initInvocation(const DownstreamCompileOptions& options, const InputKind& inputKind, LangStandard::Kind langStd, CompilerInvocation& invocation)
+{
+    {
+        auto& opts = invocation.getPreprocessorOpts();
+
+        // Add definition so that 'LLVM/Clang' compilations can be recognized
+        opts.addMacroDef("SLANG_LLVM");
+
+        for (const auto& define : options.defines)
+        {
+            const Index index = asStringSlice(define.nameWithSig).indexOf('(');
+            if (index >= 0)
+            {
+                // Interface does not support having a signature.
+                return SLANG_E_NOT_AVAILABLE;
+            }
+
+            // TODO(JS): NOTE! The options do not support setting a *value* just that a macro is defined.
+            // So strictly speaking, we should probably have a warning/error if the value is not appropriate
+            opts.addMacroDef(define.nameWithSig.begin());
+        }
+    }
+
+
+    llvm::Triple targetTriple;
+    {
+        auto& opts = invocation.getTargetOpts();
+
+        opts.Triple = LLVM_DEFAULT_TARGET_TRIPLE;
+
+        // A code model isn't set by default, "default" seems to fit the bill here 
+        opts.CodeModel = "default";
+
+        targetTriple = llvm::Triple(opts.Triple);
+    }
+
+    {
+        auto opts = invocation.getLangOpts();
+
+        std::vector<std::string> includes;
+        for (const auto& includePath : options.includePaths)
+        {
+            includes.push_back(includePath.begin());
+        }
+
+        clang::CompilerInvocation::setLangDefaults(*opts, inputKind, targetTriple, includes, langStd);
+
+        if (options.floatingPointMode == DownstreamCompileOptions::FloatingPointMode::Fast)
+        {
+            opts->FastMath = true;
+        }
+    }
+
+    {
+        auto& opts = invocation.getHeaderSearchOpts();
+
+        // These only work if the resource directory is setup (or a virtual file system points to it)
+        opts.UseBuiltinIncludes = true;
+        opts.UseStandardSystemIncludes = true;
+        opts.UseStandardCXXIncludes = true;
+
+        /// Use libc++ instead of the default libstdc++.
+        //opts.UseLibcxx = true;
+    }
+
+
+    {
+        auto& opts = invocation.getCodeGenOpts();
+
+        // Set to -O optimization level
+        opts.OptimizationLevel = _getOptimizationLevel(options.optimizationLevel);
+
+        // Copy over the targets CodeModel
+        opts.CodeModel = invocation.getTargetOpts().CodeModel;
+    }
+
+    return SLANG_OK;
+}
+
+    /// Precompile the header at `headerPath`, writing the result to `outputPath`
+static SlangResult _generatePrecompiledHeader(const DownstreamCompileOptions& options, const InputKind& inputKind, LangStandard::Kind langStd, const String& headerPath, const String& outputPath)
+{
+    std::unique_ptr<CompilerInstance> clang(new CompilerInstance());
+
+    auto pchOps = clang->getPCHContainerOperations();
+    pchOps->registerWriter(std::make_unique<ObjectFilePCHContainerWriter>());
+    pchOps->registerReader(std::make_unique<ObjectFilePCHContainerReader>());
+
+    // Diagnostics are ignored. If the header can't be precompiled the compile parses it, and reports any errors.
+    IntrusiveRefCntPtr<DiagnosticIDs> diagID(new DiagnosticIDs());
+    IntrusiveRefCntPtr<DiagnosticOptions> diagOpts = new DiagnosticOptions();
+    IgnoringDiagConsumer diagsConsumer;
+    IntrusiveRefCntPtr<DiagnosticsEngine> diags = new DiagnosticsEngine(diagID, diagOpts, &diagsConsumer, false);
+
+    auto& invocation = clang->getInvocation();
+    {
+        auto& opts = invocation.getFrontendOpts();
+
+        opts.Inputs.push_back(FrontendInputFile(headerPath.getBuffer(), inputKind.getHeader()));
+        opts.OutputFile = outputPath.getBuffer();
+        opts.ProgramAction = frontend::ActionKind::GeneratePCH;
+    }
+
+    SLANG_RETURN_ON_FAIL(_initInvocation(options, inputKind, langStd, invocation));
+
+    clang->createDiagnostics();
+    clang->setDiagnostics(diags.get());
+
+    if (!clang->hasDiagnostics())
+        return SLANG_FAIL;
+
+    clang->createFileManager();
+    clang->createSourceManager(clang->getFileManager());
+
+    GeneratePCHAction action;
+    if (!clang->ExecuteAction(action) || diags->hasErrorOccurred())
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+    /// Get the path of the prefix header in the options cache directory, and the path to its precompiled header.
+    /// The header is precompiled if it isn't already in the cache. If that fails `outPrecompiledPath` is empty.
+static SlangResult _requirePrefixHeader(const DownstreamCompileOptions& options, const InputKind& inputKind, LangStandard::Kind langStd, String& outHeaderPath, String& outPrecompiledPath)
+{
+    if (options.precompiledHeaderDirectory.count == 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // The key identifies this build of slang-llvm, the options that are used for the precompiled header
+    // and the contents of the header.
+    SHA1::Digest key;
+    {
+        DigestBuilder<SHA1> builder;
+
+        builder.append(uint32_t(LLVM_VERSION_MAJOR));
+        builder.append(uint32_t(LLVM_VERSION_MINOR));
+        builder.append(uint32_t(LLVM_VERSION_PATCH));
+        builder.append(SharedLibraryUtils::getSharedLibraryTimestamp((void*)createLLVMDownstreamCompiler_V4));
+
+        builder.append(options.sourceLanguage);
+        builder.append(options.optimizationLevel);
+        builder.append(options.floatingPointMode);
+
+        builder.append(uint32_t(options.defines.count));
+        for (const auto& define : options.defines)
+        {
+            builder.append(asStringSlice(define.nameWithSig));
+            builder.append(uint8_t(0));
+        }
+        builder.append(uint32_t(options.includePaths.count));
+        for (const auto& includePath : options.includePaths)
+        {
+            builder.append(asStringSlice(includePath));
+            builder.append(uint8_t(0));
+        }
+
+        PrefixHeaderUtil::appendContents(options, builder);
+        key = builder.finalize();
+    }
+
+    const auto paths = PrefixHeaderUtil::calcPaths(options, key, "pch");
+    SLANG_RETURN_ON_FAIL(PrefixHeaderUtil::requireHeader(options, paths));
+
+    outHeaderPath = paths.headerPath;
+    outPrecompiledPath = String();
+
+    if (!File::exists(paths.precompiledPath))
+    {
+        const String tempPath = PrefixHeaderUtil::calcTemporaryPath(paths.precompiledPath);
+
+        if (SLANG_FAILED(_generatePrecompiledHeader(options, inputKind, langStd, paths.headerPath, tempPath)) ||
+            SLANG_FAILED(File::rename(tempPath, paths.precompiledPath)))
+        {
+            File::remove(tempPath);
+            return SLANG_OK;
+        }
+    }
+
+    outPrecompiledPath = paths.precompiledPath;
+    return SLANG_OK;
+}
+
 bool LLVMDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     return false;
@@ -565,6 +754,10 @@ void* LLVMDownstreamCompiler::castAs(const Guid& guid)
     {
         return ptr;
     }
+    if (guid == DownstreamCompilerPrefixHeaderFeature::getTypeGuid())
+    {
+        return static_cast<IDownstreamCompiler*>(this);
+    }
     return getObject(guid);
 }
 
@@ -699,80 +892,27 @@ SlangResult LLVMDownstreamCompiler::compile(const CompileOptions& inOptions, IAr
         opts.ProgramAction = action;
     }
 
-    {
-        auto& opts = invocation.getPreprocessorOpts();
-
-        // Add definition so that 'LLVM/Clang' compilations can be recognized
-        opts.addMacroDef("SLANG_LLVM");
-
-        for (const auto& define : options.defines)
-        {
-            const Index index = asStringSlice(define.nameWithSig).indexOf('(');
-            if (index >= 0)
-            {
-                // Interface does not support having a signature.
-                return SLANG_E_NOT_AVAILABLE;
-            }
-
-            // TODO(JS): NOTE! The options do not support setting a *value* just that a macro is defined.
-            // So strictly speaking, we should probably have a warning/error if the value is not appropriate
-            opts.addMacroDef(define.nameWithSig.begin());
-        }
-    }
-
+    SLANG_RETURN_ON_FAIL(_initInvocation(options, inputKind, langStd, invocation));
 
-    llvm::Triple targetTriple;
+    if (options.prefixHeader.count)
     {
-        auto& opts = invocation.getTargetOpts();
-
-        opts.Triple = LLVM_DEFAULT_TARGET_TRIPLE;
-
-        // A code model isn't set by default, "default" seems to fit the bill here 
-        opts.CodeModel = "default";
-
-        targetTriple = llvm::Triple(opts.Triple);
-    }
+        String headerPath;
+        String precompiledPath;
+        SLANG_RETURN_ON_FAIL(_requirePrefixHeader(options, inputKind, langStd, headerPath, precompiledPath));
 
-    {
-        auto opts = invocation.getLangOpts();
+        auto& opts = invocation.getPreprocessorOpts();
 
-        std::vector<std::string> includes;
-        for (const auto& includePath : options.includePaths)
+        // If the header couldn't be precompiled it's parsed, as if it was included with -include
+        if (precompiledPath.getLength())
         {
-            includes.push_back(includePath.begin());
+            opts.ImplicitPCHInclude = precompiledPath.getBuffer();
         }
-
-        clang::CompilerInvocation::setLangDefaults(*opts, inputKind, targetTriple, includes, langStd);
-
-        if (options.floatingPointMode == DownstreamCompileOptions::FloatingPointMode::Fast)
+        else
         {
-            opts->FastMath = true;
+            opts.Includes.push_back(headerPath.getBuffer());
         }
     }
 
-    {
-        auto& opts = invocation.getHeaderSearchOpts();
-
-        // These only work if the resource directory is setup (or a virtual file system points to it)
-        opts.UseBuiltinIncludes = true;
-        opts.UseStandardSystemIncludes = true;
-        opts.UseStandardCXXIncludes = true;
-
-        /// Use libc++ instead of the default libstdc++.
-        //opts.UseLibcxx = true;
-    }
-
-
-    {
-        auto& opts = invocation.getCodeGenOpts();
-
-        // Set to -O optimization level
-        opts.OptimizationLevel = _getOptimizationLevel(options.optimizationLevel);
-
-        // Copy over the targets CodeModel
-        opts.CodeModel = invocation.getTargetOpts().CodeModel;
-    }
-
     //const llvm::opt::OptTable& opts = clang::driver::getDriverOptTable();
 
     // TODO(JS): Need a way to find in system search paths, for now we just don't bother
@@ -198,6 +198,102 @@ namespace Slang
         }
     };
 
+    // Identifies a call to an overloaded global stdlib function, by the candidates found for the
+    // function name and the types of the arguments. The stdlib is the same for all of the sessions
+    // created from a global session, so the selected candidate depends only on this key.
+    struct CallOverloadCacheKey
+    {
+        static const Index kMaxArgCount = 4;
+
+        // Every candidate found for the function name, in lookup order
+        ShortList<Decl*, 4> candidates;
+        HashCode candidatesHash = 0;
+        Index argCount = 0;
+        BasicTypeKey args[kMaxArgCount];
+
+        bool operator==(const CallOverloadCacheKey& rhs) const
+        {
+            if (candidatesHash != rhs.candidatesHash || candidates.getCount() != rhs.candidates.getCount() ||
+                argCount != rhs.argCount)
+            {
+                return false;
+            }
+            for (Index i = 0; i < candidates.getCount(); i++)
+            {
+                if (candidates[i] != rhs.candidates[i])
+                    return false;
+            }
+            for (Index i = 0; i < argCount; i++)
+            {
+                if (!(args[i] == rhs.args[i]))
+                    return false;
+            }
+            return true;
+        }
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.addHash(candidatesHash);
+            hasher.hashValue(argCount);
+            for (Index i = 0; i < argCount; i++)
+                hasher.hashValue(args[i].getRaw());
+            return hasher.getResult();
+        }
+
+            /// True if `item` is a function (or generic function) declared at the top level of a stdlib module.
+            /// Such a candidate doesn't depend on where it is called from.
+        static bool isCacheableCandidate(LookupResultItem const& item)
+        {
+            if (item.breadcrumbs || !as<DirectDeclRef>(item.declRef.declRefBase))
+                return false;
+
+            Decl* decl = item.declRef.getDecl();
+            Decl* innerDecl = decl;
+            if (auto genericDecl = as<GenericDecl>(decl))
+                innerDecl = genericDecl->inner;
+            if (!as<CallableDecl>(innerDecl))
+                return false;
+
+            auto moduleDecl = as<ModuleDecl>(decl->parentDecl);
+            return moduleDecl && moduleDecl->hasModifier<FromStdLibModifier>();
+        }
+
+        bool fromInvokeExpr(InvokeExpr* invokeExpr)
+        {
+            // Operators have their own cache
+            auto overloadedExpr = as<OverloadedExpr>(invokeExpr->functionExpr);
+            if (!overloadedExpr || as<OperatorExpr>(invokeExpr))
+                return false;
+
+            // The argument types must be fully known, and be ones that we can encode in a key
+            argCount = invokeExpr->arguments.getCount();
+            if (argCount > kMaxArgCount)
+                return false;
+            for (Index i = 0; i < argCount; i++)
+            {
+                auto argKey = makeBasicTypeKey(invokeExpr->arguments[i]->type, invokeExpr->arguments[i]);
+                if (argKey.getRaw() == BasicTypeKey::invalid().getRaw())
+                    return false;
+                args[i] = argKey;
+            }
+
+            // Every candidate must be from the stdlib
+            Hasher hasher;
+            candidates.clear();
+            for (auto item : overloadedExpr->lookupResult2)
+            {
+                if (!isCacheableCandidate(item))
+                    return false;
+
+                Decl* decl = item.declRef.getDecl();
+                hasher.hashValue(decl);
+                candidates.add(decl);
+            }
+            candidatesHash = hasher.getResult();
+            return candidates.getCount() > 0;
+        }
+    };
+
     struct OverloadCandidate
     {
         enum class Flavor
@@ -257,9 +353,22 @@ namespace Slang
     struct TypeCheckingCache
     {
         Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
+        Dictionary<CallOverloadCacheKey, OverloadCandidate> resolvedCallOverloadCache;
         Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
     };
 
+        /// Type checking results shared by all of the sessions created from a global session
+    struct SharedTypeCheckingCache
+    {
+        // Only the selected declaration is held, because a checked candidate refers
+        // to types created by the session that checked it
+        Dictionary<CallOverloadCacheKey, Decl*> resolvedCallOverloadCache;
+
+        // Overload resolution results found in a cache, and not found
+        Count hitCount = 0;
+        Count missCount = 0;
+    };
+
     enum class CoercionSite
     {
         General,
@@ -1844,6 +1844,25 @@ namespace Slang
         return argsListBuilder.produceString();
     }
 
+        /// Find the declaration in the lookup result of `overloadedExpr` that `candidate` was created from.
+        /// For a generic, the candidate refers to the inner declaration.
+    static Decl* _findCandidateLookupDecl(OverloadedExpr* overloadedExpr, OverloadCandidate const& candidate)
+    {
+        Decl* candidateDecl = candidate.item.declRef.getDecl();
+        for (auto item : overloadedExpr->lookupResult2)
+        {
+            Decl* decl = item.declRef.getDecl();
+            if (decl == candidateDecl)
+                return decl;
+            if (auto genericDecl = as<GenericDecl>(decl))
+            {
+                if (genericDecl->inner == candidateDecl)
+                    return decl;
+            }
+        }
+        return nullptr;
+    }
+
     Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr * expr)
     {
         OverloadResolveContext context;
@@ -1852,6 +1871,14 @@ namespace Slang
         bool shouldAddToCache = false;
         OperatorOverloadCacheKey key;
         TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+        SharedTypeCheckingCache* sharedTypeCheckingCache = getSession()->getSharedTypeCheckingCache();
+
+        // Calls to global stdlib functions are cached in the same way. The declaration selected is
+        // also shared with other sessions, which then only need to check that one candidate.
+        bool shouldAddCallToCache = false;
+        CallOverloadCacheKey callKey;
+        Decl* sharedCallDecl = nullptr;
+
         if (auto opExpr = as<OperatorExpr>(expr))
         {
             if (key.fromOperatorExpr(opExpr))
@@ -1861,13 +1888,30 @@ namespace Slang
                 {
                     context.bestCandidateStorage = candidate;
                     context.bestCandidate = &context.bestCandidateStorage;
+                    sharedTypeCheckingCache->hitCount++;
                 }
                 else
                 {
                     shouldAddToCache = true;
+                    sharedTypeCheckingCache->missCount++;
                 }
             }
         }
+        else if (callKey.fromInvokeExpr(expr))
+        {
+            OverloadCandidate candidate;
+            if (typeCheckingCache->resolvedCallOverloadCache.tryGetValue(callKey, candidate))
+            {
+                context.bestCandidateStorage = candidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+                sharedTypeCheckingCache->hitCount++;
+            }
+            else
+            {
+                shouldAddCallToCache = true;
+                sharedTypeCheckingCache->resolvedCallOverloadCache.tryGetValue(callKey, sharedCallDecl);
+            }
+        }
 
         // Look at the base expression for the call, and figure out how to invoke it.
         auto funcExpr = expr->functionExpr;
@@ -1937,8 +1981,36 @@ namespace Slang
         // `visitTypeCastExpr`) would allow us to continue to ensure
         // equivalent in (almost) all cases.
 
+        if (sharedCallDecl)
+        {
+            // Another session has resolved the same call, so only the declaration it selected needs checking
+            for (auto item : as<OverloadedExpr>(funcExpr)->lookupResult2)
+            {
+                if (item.declRef.getDecl() == sharedCallDecl)
+                {
+                    AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
+                    break;
+                }
+            }
+
+            if (context.bestCandidate && context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+            {
+                sharedTypeCheckingCache->hitCount++;
+            }
+            else
+            {
+                // Fall back to checking all of the candidates
+                context.bestCandidate = nullptr;
+                context.bestCandidates.clear();
+                sharedCallDecl = nullptr;
+            }
+        }
+
         if (!context.bestCandidate)
         {
+            if (shouldAddCallToCache)
+                sharedTypeCheckingCache->missCount++;
+
             AddOverloadCandidates(funcExpr, context);
         }
 
@@ -2040,6 +2112,15 @@ namespace Slang
             // the user the most help we can.
             if (shouldAddToCache)
                 typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+            if (shouldAddCallToCache && context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+            {
+                typeCheckingCache->resolvedCallOverloadCache[callKey] = *context.bestCandidate;
+                if (!sharedCallDecl)
+                {
+                    if (auto lookupDecl = _findCandidateLookupDecl(as<OverloadedExpr>(funcExpr), *context.bestCandidate))
+                        sharedTypeCheckingCache->resolvedCallOverloadCache[callKey] = lookupDecl;
+                }
+            }
             return CompleteOverloadCandidate(context, *context.bestCandidate);
         }
         else if (auto typetype = as<TypeType>(funcExprType))
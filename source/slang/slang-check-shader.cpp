@@ -873,60 +873,65 @@ namespace Slang
             // For now we'll start with an extremely basic approach that
             // should work for typical HLSL code.
             //
-            Index translationUnitCount = translationUnits.getCount();
-            for(Index tt = 0; tt < translationUnitCount; ++tt)
+            for (auto translationUnit : translationUnits)
             {
-                auto translationUnit = translationUnits[tt];
-                for( auto globalDecl : translationUnit->getModuleDecl()->members )
-                {
-                    auto maybeFuncDecl = globalDecl;
-                    if( auto genericDecl = as<GenericDecl>(maybeFuncDecl) )
-                    {
-                        maybeFuncDecl = genericDecl->inner;
-                    }
+                translationUnit->getModule()->_discoverEntryPoints(sink);
+            }
+        }
+    }
 
-                    auto funcDecl = as<FuncDecl>(maybeFuncDecl);
-                    if(!funcDecl)
-                        continue;
+    void Module::_discoverEntryPoints(DiagnosticSink* sink)
+    {
+        auto linkage = getLinkage();
 
-                    auto entryPointAttr = funcDecl->findModifier<EntryPointAttribute>();
-                    if(!entryPointAttr)
-                        continue;
+        for( auto globalDecl : getModuleDecl()->members )
+        {
+            auto maybeFuncDecl = globalDecl;
+            if( auto genericDecl = as<GenericDecl>(maybeFuncDecl) )
+            {
+                maybeFuncDecl = genericDecl->inner;
+            }
 
-                    // We've discovered a valid entry point. It is a function (possibly
-                    // generic) that has a `[shader(...)]` attribute to mark it as an
-                    // entry point.
-                    //
-                    // We will now register that entry point as an `EntryPoint`
-                    // with an appropriately chosen profile.
-                    //
-                    // The profile will only include a stage, so that the profile "family"
-                    // and "version" are left unspecified. Downstream code will need
-                    // to be able to handle this case.
-                    //
-                    Profile profile;
-                    profile.setStage(entryPointAttr->stage);
+            auto funcDecl = as<FuncDecl>(maybeFuncDecl);
+            if(!funcDecl)
+                continue;
 
-                    RefPtr<EntryPoint> entryPoint = EntryPoint::create(
-                        linkage,
-                        makeDeclRef(funcDecl),
-                        profile);
+            auto entryPointAttr = funcDecl->findModifier<EntryPointAttribute>();
+            if(!entryPointAttr)
+                continue;
 
-                    validateEntryPoint(entryPoint, sink);
+            // We've discovered a valid entry point. It is a function (possibly
+            // generic) that has a `[shader(...)]` attribute to mark it as an
+            // entry point.
+            //
+            // We will now register that entry point as an `EntryPoint`
+            // with an appropriately chosen profile.
+            //
+            // The profile will only include a stage, so that the profile "family"
+            // and "version" are left unspecified. Downstream code will need
+            // to be able to handle this case.
+            //
+            Profile profile;
+            profile.setStage(entryPointAttr->stage);
 
-                    // Note: in the case that the user didn't explicitly
-                    // specify entry points and we are instead compiling
-                    // a shader "library," then we do not want to automatically
-                    // combine the entry points into groups in the generated
-                    // `Program`, since that would be slightly too magical.
-                    //
-                    // Instead, each entry point will end up in a singleton
-                    // group, so that its entry-point parameters lay out
-                    // independent of the others.
-                    //
-                    translationUnit->module->_addEntryPoint(entryPoint);
-                }
-            }
+            RefPtr<EntryPoint> entryPoint = EntryPoint::create(
+                linkage,
+                makeDeclRef(funcDecl),
+                profile);
+
+            validateEntryPoint(entryPoint, sink);
+
+            // Note: in the case that the user didn't explicitly
+            // specify entry points and we are instead compiling
+            // a shader "library," then we do not want to automatically
+            // combine the entry points into groups in the generated
+            // `Program`, since that would be slightly too magical.
+            //
+            // Instead, each entry point will end up in a singleton
+            // group, so that its entry-point parameters lay out
+            // independent of the others.
+            //
+            _addEntryPoint(entryPoint);
         }
     }
 
@@ -0,0 +1,130 @@
+// slang-compile-result-cache.cpp
+#include "slang-compile-result-cache.h"
+
+namespace Slang
+{
+
+SHA1::Digest getCompileResultCacheKey(ISlangBlob* key)
+{
+    if (key->getBufferSize() == sizeof(SHA1::Digest::data))
+    {
+        return SHA1::Digest(key);
+    }
+    return SHA1::compute(key->getBufferPointer(), SlangInt(key->getBufferSize()));
+}
+
+SlangResult createCompileResultCache(const slang::CompileResultCacheDesc& desc, slang::ICompileResultCache** outCache)
+{
+    ComPtr<slang::ICompileResultCache> cache;
+    if (desc.directory && desc.directory[0])
+    {
+        PersistentCache::Desc cacheDesc;
+        cacheDesc.directory = desc.directory;
+        cacheDesc.maxEntryCount = Count(desc.maxEntryCount);
+        cache = new DirectoryCompileResultCache(cacheDesc);
+    }
+    else
+    {
+        cache = new MemoryCompileResultCache(Count(desc.maxEntryCount));
+    }
+
+    *outCache = cache.detach();
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! MemoryCompileResultCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+MemoryCompileResultCache::MemoryCompileResultCache(Count maxEntryCount)
+    : m_maxEntryCount(maxEntryCount)
+{
+}
+
+ISlangUnknown* MemoryCompileResultCache::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == slang::ICompileResultCache::getTypeGuid())
+    {
+        return static_cast<slang::ICompileResultCache*>(this);
+    }
+    return nullptr;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL MemoryCompileResultCache::readEntry(ISlangBlob* key, ISlangBlob** outCode)
+{
+    const SHA1::Digest digest = getCompileResultCacheKey(key);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LinkedNode<Entry>* node = nullptr;
+    if (!m_entryNodes.tryGetValue(digest, node))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Make it the most recently used
+    m_entries.removeFromList(node);
+    m_entries.addFirst(node);
+
+    ComPtr<ISlangBlob> code(node->value.code);
+    *outCode = code.detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL MemoryCompileResultCache::writeEntry(ISlangBlob* key, ISlangBlob* code)
+{
+    const SHA1::Digest digest = getCompileResultCacheKey(key);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    LinkedNode<Entry>* node = nullptr;
+    if (m_entryNodes.tryGetValue(digest, node))
+    {
+        // Keys identify their code, so there's nothing to change other than the order
+        m_entries.removeFromList(node);
+        m_entries.addFirst(node);
+        return SLANG_OK;
+    }
+
+    if (m_maxEntryCount > 0)
+    {
+        while (m_entries.getCount() >= m_maxEntryCount)
+        {
+            LinkedNode<Entry>* lastNode = m_entries.getLastNode();
+            m_entryNodes.remove(lastNode->value.key);
+            m_entries.removeAndDelete(lastNode);
+        }
+    }
+
+    Entry entry;
+    entry.key = digest;
+    entry.code = code;
+    m_entryNodes.add(digest, m_entries.addFirst(entry));
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DirectoryCompileResultCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+DirectoryCompileResultCache::DirectoryCompileResultCache(const PersistentCache::Desc& desc)
+    : m_cache(new PersistentCache(desc))
+{
+}
+
+ISlangUnknown* DirectoryCompileResultCache::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == slang::ICompileResultCache::getTypeGuid())
+    {
+        return static_cast<slang::ICompileResultCache*>(this);
+    }
+    return nullptr;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL DirectoryCompileResultCache::readEntry(ISlangBlob* key, ISlangBlob** outCode)
+{
+    return m_cache->readEntry(getCompileResultCacheKey(key), outCode);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL DirectoryCompileResultCache::writeEntry(ISlangBlob* key, ISlangBlob* code)
+{
+    return m_cache->writeEntry(getCompileResultCacheKey(key), code);
+}
+
+} // namespace Slang
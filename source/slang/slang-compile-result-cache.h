@@ -0,0 +1,78 @@
+// slang-compile-result-cache.h
+#ifndef SLANG_COMPILE_RESULT_CACHE_H
+#define SLANG_COMPILE_RESULT_CACHE_H
+
+#include "../../slang.h"
+
+#include "../core/slang-com-object.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
+#include "../core/slang-linked-list.h"
+#include "../core/slang-persistent-cache.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+/* Implementations of `slang::ICompileResultCache`, as created by `IGlobalSession::createCompileResultCache`.
+
+The cache is consulted by `ComponentType::getEntryPointCode` with the key from `getEntryPointHash`. */
+
+    /// Holds entries in memory, discarding the least recently used when full.
+class MemoryCompileResultCache : public ComBaseObject, public slang::ICompileResultCache
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ICompileResultCache
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL readEntry(ISlangBlob* key, ISlangBlob** outCode) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeEntry(ISlangBlob* key, ISlangBlob* code) SLANG_OVERRIDE;
+
+        /// A `maxEntryCount` of 0 means there is no limit
+    MemoryCompileResultCache(Count maxEntryCount);
+
+protected:
+    struct Entry
+    {
+        SHA1::Digest key;
+        ComPtr<ISlangBlob> code;
+    };
+
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    std::mutex m_mutex;
+    // Ordered from the most to the least recently used
+    LinkedList<Entry> m_entries;
+    Dictionary<SHA1::Digest, LinkedNode<Entry>*> m_entryNodes;
+    Count m_maxEntryCount;
+};
+
+    /// Holds entries in files in a directory, using a `PersistentCache`.
+class DirectoryCompileResultCache : public ComBaseObject, public slang::ICompileResultCache
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ICompileResultCache
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL readEntry(ISlangBlob* key, ISlangBlob** outCode) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeEntry(ISlangBlob* key, ISlangBlob* code) SLANG_OVERRIDE;
+
+    DirectoryCompileResultCache(const PersistentCache::Desc& desc);
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    RefPtr<PersistentCache> m_cache;
+};
+
+    /// Create a cache as described by `desc`
+SlangResult createCompileResultCache(const slang::CompileResultCacheDesc& desc, slang::ICompileResultCache** outCache);
+
+    /// Get the key used to store `key` in the cache. Keys are normally SHA1 digests already, but any
+    /// other blob is hashed to one.
+SHA1::Digest getCompileResultCacheKey(ISlangBlob* key);
+
+} // namespace Slang
+
+#endif
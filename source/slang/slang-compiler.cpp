@@ -9,6 +9,8 @@
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-castable.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-check.h"
 #include "slang-compiler.h"
@@ -23,6 +25,7 @@
 #include "../compiler-core/slang-artifact-associated.h"
 #include "../compiler-core/slang-artifact-diagnostic-util.h"
 #include "../compiler-core/slang-artifact-container-util.h"
+#include "../compiler-core/slang-prefix-header-util.h"
 
 // Artifact output
 #include "slang-artifact-output-util.h"
@@ -227,7 +230,11 @@ namespace Slang
 
     void EntryPoint::buildHash(DigestBuilder<SHA1>& builder)
     {
-        SLANG_UNUSED(builder);
+        builder.append(getText(getName()));
+        if (auto module = getModule())
+        {
+            module->buildHash(builder);
+        }
     }
 
     List<Module*> const& EntryPoint::getModuleDependencies()
@@ -890,6 +897,14 @@ namespace Slang
         return true;
     }
 
+        /// True if the C++ prelude can be passed to the downstream compiler separately from the generated source,
+        /// such that it can be precompiled.
+    static bool _canPrecompilePrelude(IDownstreamCompiler* compiler, CodeGenTarget sourceTarget)
+    {
+        return sourceTarget == CodeGenTarget::CPPSource &&
+            compiler->castAs(DownstreamCompilerPrefixHeaderFeature::getTypeGuid()) != nullptr;
+    }
+
     static Severity _getDiagnosticSeverity(ArtifactDiagnostic::Severity severity)
     {
         switch (severity)
@@ -1037,7 +1052,9 @@ namespace Slang
         RefPtr<ExtensionTracker> extensionTracker = _newExtensionTracker(target);
         PassThroughMode compilerType;
 
-        SliceAllocator allocator;
+        // The job owns the options, and the storage they reference, so that it can be deferred
+        RefPtr<DownstreamCompileJob> job = new DownstreamCompileJob;
+        SliceAllocator& allocator = job->allocator;
         
         if (auto endToEndReq = isPassThroughEnabled())
         {
@@ -1076,11 +1093,11 @@ namespace Slang
         List<String> includePaths;
 
         typedef DownstreamCompileOptions CompileOptions;
-        CompileOptions options;
+        CompileOptions& options = job->options;
 
-        List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+        List<DownstreamCompileOptions::CapabilityVersion>& requiredCapabilityVersions = job->requiredCapabilityVersions;
         List<String> compilerSpecificArguments;
-        List<ComPtr<IArtifact>> libraries;
+        List<ComPtr<IArtifact>>& libraries = job->libraries;
         List<String> libraryPaths;
 
         // Set compiler specific args
@@ -1108,7 +1125,7 @@ namespace Slang
             }
         }
 
-        ComPtr<IArtifact> sourceArtifact;
+        ComPtr<IArtifact>& sourceArtifact = job->sourceArtifact;
 
         /* This is more convoluted than the other scenarios, because when we invoke C/C++ compiler we would ideally like
         to use the original file. We want to do this because we want includes relative to the source file to work, and
@@ -1192,9 +1209,28 @@ namespace Slang
         {
             CodeGenContext sourceCodeGenContext(this, sourceTarget, extensionTracker);
 
+            // If the downstream compiler can precompile the prelude, it's passed separately from the
+            // generated source. A dumped intermediate needs to compile on its own, so it keeps the prelude.
+            String prelude;
+            String preludePCHCacheDirectory;
+            if (_canPrecompilePrelude(compiler, sourceTarget) && !shouldDumpIntermediates())
+            {
+                preludePCHCacheDirectory = getLinkage()->getPreludePCHCacheDirectory();
+                if (preludePCHCacheDirectory.getLength())
+                {
+                    sourceCodeGenContext.setSeparatePrelude(&prelude);
+                }
+            }
+
             SLANG_RETURN_ON_FAIL(sourceCodeGenContext.emitEntryPointsSource(sourceArtifact));
             sourceCodeGenContext.maybeDumpIntermediate(sourceArtifact);
 
+            if (prelude.getLength())
+            {
+                options.prefixHeader = allocator.allocate(prelude);
+                options.precompiledHeaderDirectory = allocator.allocate(preludePCHCacheDirectory);
+            }
+
             sourceLanguage = (SourceLanguage)TypeConvertUtil::getSourceLanguageFromTarget((SlangCompileTarget)sourceTarget);
         }
 
@@ -1483,16 +1519,117 @@ namespace Slang
         options.requiredCapabilityVersions = SliceUtil::asSlice(requiredCapabilityVersions);
         options.libraries = SliceUtil::asSlice(libraries);
         options.libraryPaths = allocator.allocate(libraryPaths);
-        
+
+        job->compiler = compiler;
+
+        if (_canDeferDownstreamCompile())
+        {
+            // The file system and source manager are shared with the rest of the linkage, and aren't
+            // thread safe. Code we generate doesn't include anything from them, so deferred compiles
+            // just use the OS file system.
+            options.fileSystemExt = OSFileSystem::getExtSingleton();
+            options.sourceManager = nullptr;
+
+            job->targetProgram = getTargetProgram();
+            job->entryPointIndex = getTargetReq()->isWholeProgramRequest() ? -1 : getSingleEntryPointIndex();
+
+            // The result will be set on the target program, once the job has been executed
+            isEndToEndCompile()->m_deferredDownstreamCompileJobs.add(job);
+            return SLANG_OK;
+        }
+
         // Compile
-        ComPtr<IArtifact> artifact;
-        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
-        auto downstreamElapsedTime =
-            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-        getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+        job->execute();
+        return job->finish(getSession(), getSink(), outArtifact);
+    }
 
-        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+    String Linkage::getPreludePCHCacheDirectory()
+    {
+        if (!m_isPreludePCHCacheDirectorySet)
+        {
+            // If there isn't a temporary directory the path stays empty, and the prelude isn't precompiled
+            PrefixHeaderUtil::calcDefaultDirectory("slang-prelude-pch", m_preludePCHCacheDirectory);
+            m_isPreludePCHCacheDirectorySet = true;
+        }
+        return m_preludePCHCacheDirectory;
+    }
+
+    bool CodeGenContext::_canDeferDownstreamCompile()
+    {
+        auto endToEndReq = isEndToEndCompile();
+        if (!endToEndReq || (endToEndReq->getFrontEndReq()->compileFlags & SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE) == 0)
+            return false;
+
+        // Only the final result can be deferred. Intermediates (such as binaries that will be disassembled)
+        // are needed immediately.
+        if (getTargetFormat() != getFinalTargetFormat())
+            return false;
+
+        // Dumping intermediates needs the result immediately, and pass-through compiles may
+        // depend on the linkage file system for includes.
+        if (shouldDumpIntermediates() || isPassThroughEnabled())
+            return false;
+
+        // Module libraries are shared between all compiles.
+        if (getLinkage()->m_libModules.getCount())
+            return false;
+
+        return true;
+    }
+
+    void DownstreamCompileJob::execute()
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        result = compiler->compile(options, artifact.writeRef());
+
+        // Clang fails the compile if a precompiled header in the cache is stale or corrupt, rather than parsing the
+        // header, and the cache directory may not be usable at all. Only those failures are tried again, with the
+        // prefix header as part of the source. Errors in the source would just be reported twice.
+        if (options.prefixHeader.count && PrefixHeaderUtil::isCacheFailure(options, result, artifact))
+        {
+            isPrefixHeaderCacheUnusable = true;
+            _compileWithInlinePrefixHeader();
+        }
+
+        elapsedTime = (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001;
+    }
+
+    void DownstreamCompileJob::_compileWithInlinePrefixHeader()
+    {
+        ComPtr<ISlangBlob> sourceBlob;
+        if (!sourceArtifact || SLANG_FAILED(sourceArtifact->loadBlob(ArtifactKeep::No, sourceBlob.writeRef())))
+        {
+            return;
+        }
+
+        StringBuilder source;
+        source << asStringSlice(options.prefixHeader) << "\n";
+        const char* sourceText = (const char*)sourceBlob->getBufferPointer();
+        source.append(sourceText, sourceText + sourceBlob->getBufferSize());
+
+        auto inlineSourceArtifact = ArtifactUtil::createArtifact(sourceArtifact->getDesc());
+        inlineSourceArtifact->addRepresentationUnknown(StringBlob::moveCreate(source));
+
+        DownstreamCompileOptions inlineOptions = options;
+        inlineOptions.prefixHeader = TerminatedCharSlice();
+        inlineOptions.precompiledHeaderDirectory = TerminatedCharSlice();
+        inlineOptions.sourceArtifacts = makeSlice(inlineSourceArtifact.readRef(), 1);
+
+        artifact.setNull();
+        result = compiler->compile(inlineOptions, artifact.writeRef());
+    }
+
+    SlangResult DownstreamCompileJob::finish(Session* session, DiagnosticSink* sink, ComPtr<IArtifact>& outArtifact)
+    {
+        if (isPrefixHeaderCacheUnusable)
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::preludePCHCacheNotUsed, asStringSlice(options.precompiledHeaderDirectory));
+        }
+
+        SLANG_RETURN_ON_FAIL(result);
+        session->addDownstreamCompileTime(elapsedTime);
+
+        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(sink, compiler, artifact));
 
         // Copy over all of the information associated with the source into the output
         if (sourceArtifact)
@@ -1576,6 +1713,7 @@ namespace Slang
     // Do emit logic for a zero or more entry points
     SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
     {
+        SLANG_PROFILE;
         CompileTimerRAII recordCompileTime(getSession());
 
         auto target = getTargetFormat();
@@ -1596,7 +1734,11 @@ namespace Slang
             {
                 SLANG_RETURN_ON_FAIL(_emitEntryPoints(outArtifact));
 
-                maybeDumpIntermediate(outArtifact);
+                // If the downstream compile has been deferred there is no artifact yet
+                if (outArtifact)
+                {
+                    maybeDumpIntermediate(outArtifact);
+                }
                 return SLANG_OK;
             }
             break;
@@ -2174,6 +2316,45 @@ namespace Slang
             auto targetProgram = program->getTargetProgram(targetReq);
             generateOutput(targetProgram);
         }
+
+        // With parallel code generation the downstream compiles were only prepared above
+        _executeDeferredDownstreamCompileJobs();
+    }
+
+    void EndToEndCompileRequest::_executeDeferredDownstreamCompileJobs()
+    {
+        auto& jobs = m_deferredDownstreamCompileJobs;
+        if (jobs.getCount() == 0)
+            return;
+
+        // The jobs hold the only references the compile takes on the downstream compilers, and are
+        // created and released on this thread. The pool threads only use plain pointers, so no
+        // reference count is changed concurrently.
+        getSession()->getDownstreamCompileThreadPool()->parallelFor(jobs.getCount(), [&](Index jobIndex)
+            {
+                DownstreamCompileJob* job = jobs[jobIndex];
+                job->execute();
+            });
+
+        // Diagnostics and results are handled in the order the jobs were created, so the
+        // output is the same as for a serial compile.
+        auto sink = getSink();
+        for (auto& job : jobs)
+        {
+            ComPtr<IArtifact> artifact;
+            if (SLANG_FAILED(job->finish(getSession(), sink, artifact)))
+                continue;
+
+            if (job->entryPointIndex < 0)
+            {
+                job->targetProgram->_setWholeProgramResult(artifact);
+            }
+            else
+            {
+                job->targetProgram->_setEntryPointResult(job->entryPointIndex, artifact);
+            }
+        }
+        jobs.clear();
     }
 
     
@@ -2389,4 +2570,13 @@ namespace Slang
         }
         return false;
     }
+
+    bool CodeGenContext::shouldCompactIR()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->compactIR;
+        }
+        return false;
+    }
 }
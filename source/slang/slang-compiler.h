@@ -4,11 +4,14 @@
 #include "../core/slang-basic.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-thread-pool.h"
 
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-downstream-compiler-util.h"
 
 #include "../compiler-core/slang-name.h"
+#include "../compiler-core/slang-slice-allocator.h"
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-command-line-args.h"
 
@@ -32,6 +35,9 @@
 #include "slang-content-assist-info.h"
 
 #include "slang-hlsl-to-vulkan-layout-options.h"
+#include "slang-ir-ssa-simplification.h"
+#include "slang-ir-specialization-cache.h"
+#include "slang-ir-symbol-index.h"
 
 #include "slang-serialize-ir-types.h"
 
@@ -1327,14 +1333,26 @@ namespace Slang
 
         virtual void buildHash(DigestBuilder<SHA1>& builder) SLANG_OVERRIDE;
 
+            /// Get a hash of the module's name and the contents of all of its source files,
+            /// including those of the modules it imports.
+        SHA1::Digest getContentHash();
+
             /// Create a module (initially empty).
         Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
 
             /// Get the AST for the module (if it has been parsed)
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
-            /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            /// The the IR for the module (if it has been generated).
+            ///
+            /// Can be called from any thread, as the stdlib modules are shared by every link,
+            /// and links can run on more than one thread at a time.
+        IRModule* getIRModule()
+        {
+            if (m_hasDeferredIRModule.load(std::memory_order_acquire))
+                _readDeferredIRModule();
+            return m_irModule;
+        }
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1360,6 +1378,16 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set IR that is turned into the module's IR when it is first needed, instead of the IR itself.
+            ///
+            /// This should only be called once, during creation of the module.
+            ///
+        void setDeferredIRModule(IRSerialDeferredModule* deferredIRModule)
+        {
+            m_deferredIRModule = deferredIRModule;
+            m_hasDeferredIRModule.store(deferredIRModule != nullptr, std::memory_order_release);
+        }
+
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
         String getEntryPointMangledName(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return String(); }
@@ -1414,6 +1442,9 @@ namespace Slang
         void _addEntryPoint(EntryPoint* entryPoint);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
 
+            /// Add an entry point for each function in the module marked with `[shader(...)]`
+        void _discoverEntryPoints(DiagnosticSink* sink);
+
         // Gets the files that has been included into the module.
         Dictionary<SourceFile*, FileDecl*>& getIncludedSourceFileMap() { return m_mapSourceFileToFileDecl; }
 
@@ -1426,12 +1457,21 @@ namespace Slang
             DiagnosticSink*             sink) SLANG_OVERRIDE;
 
     private:
+            /// Create m_irModule from m_deferredIRModule
+        void _readDeferredIRModule();
+
         // The AST for the module
         ModuleDecl*  m_moduleDecl = nullptr;
 
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // IR that hasn't been read into m_irModule yet. See `setDeferredIRModule`.
+        RefPtr<IRSerialDeferredModule> m_deferredIRModule;
+        // Set while m_deferredIRModule is, so getIRModule can check it without taking the lock
+        std::atomic<bool> m_hasDeferredIRModule = false;
+        std::mutex m_deferredIRModuleMutex;
+
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
 
@@ -1443,6 +1483,10 @@ namespace Slang
         // List of source files this module depends on
         FileDependencyList m_fileDependencyList;
 
+        // See `getContentHash`
+        SHA1::Digest m_contentHash;
+        bool m_isContentHashValid = false;
+
         // Entry points that were defined in thsi module
         //
         // Note: the entry point defined in the module are *not*
@@ -1619,6 +1663,12 @@ namespace Slang
         {
             forceGLSLScalarBufferLayout = value;
         }
+            /// Set the width the loop over the threads of a compute group is hinted to be auto-vectorized at on CPU
+            /// targets. 0 (the default) runs the threads of a group one at a time, without hints.
+        void setCPUVectorizeWidth(Int count)
+        {
+            cpuVectorizeWidth = count;
+        }
 
         void addCapability(CapabilityName capability);
 
@@ -1650,6 +1700,7 @@ namespace Slang
         SlangTargetFlags getTargetFlags() { return targetFlags; }
         CapabilitySet getTargetCaps();
         bool getForceGLSLScalarBufferLayout() { return forceGLSLScalarBufferLayout; }
+        Int getCPUVectorizeWidth() { return cpuVectorizeWidth; }
         Session* getSession();
         MatrixLayoutMode getDefaultMatrixLayoutMode();
 
@@ -1672,6 +1723,7 @@ namespace Slang
         bool                    dumpIntermediates = false;
         bool                    forceGLSLScalarBufferLayout = false;
         bool                    enableLivenessTracking = false;
+        Int                     cpuVectorizeWidth = 0;
 
         RefPtr<HLSLToVulkanLayoutOptions> hlslToVulkanLayoutOptions;           ///< Optional vulkan layout options
     };
@@ -1710,6 +1762,7 @@ namespace Slang
     const char* getBuildTagString();
 
     struct TypeCheckingCache;
+    struct SharedTypeCheckingCache;
 
     struct ContainerTypeKey
     {
@@ -1871,6 +1924,13 @@ namespace Slang
 
         TypeCheckingCache* m_typeCheckingCache = nullptr;
 
+            /// Get the cache of specialized generic functions shared by the links of this linkage.
+            /// Links can run on several threads, so the cache is created under a lock.
+        IRSpecializationCache* getIRSpecializationCache();
+
+        RefPtr<IRSpecializationCache> m_irSpecializationCache;
+        std::mutex m_irSpecializationCacheMutex;
+
         // Modules that have been dynamically loaded via `import`
         //
         // This is a list of unique modules loaded, in the order they were encountered.
@@ -1982,6 +2042,18 @@ namespace Slang
 
         void setFileSystem(ISlangFileSystem* fileSystem);
 
+            /// Set the directory used to cache the serialized AST and IR of `import`ed modules
+            /// between compilations. An empty path disables the cache.
+        void setModuleCacheDirectory(const String& path);
+
+            /// Set the directory used to cache precompiled C++ preludes. An empty path disables precompiling
+            /// the prelude.
+        void setPreludePCHCacheDirectory(const String& path) { m_preludePCHCacheDirectory = path; m_isPreludePCHCacheDirectorySet = true; }
+            /// Get the directory used to cache precompiled C++ preludes, or an empty string if the prelude isn't
+            /// precompiled. Unless it has been set, it is a directory in the temporary directory that is only used
+            /// by the current user.
+        String getPreludePCHCacheDirectory();
+
         /// The layout to use for matrices by default (row/column major)
         MatrixLayoutMode defaultMatrixLayoutMode = kMatrixLayoutMode_ColumnMajor;
         MatrixLayoutMode getDefaultMatrixLayoutMode() { return defaultMatrixLayoutMode; }
@@ -2003,6 +2075,16 @@ namespace Slang
         // Modules that have been read in with the -r option
         List<ComPtr<IArtifact>> m_libModules;
 
+            /// Cache of serialized imported modules. Null if module caching is disabled.
+        RefPtr<PersistentCache> m_moduleCache;
+
+            /// The key of each module loaded while the module cache is enabled, covering the
+            /// module and everything it depends on. See `ModuleCacheManifest`.
+        Dictionary<Module*, SHA1::Digest> m_moduleCacheKeys;
+
+        String m_preludePCHCacheDirectory;
+        bool m_isPreludePCHCacheDirectorySet = false;
+
         void _stopRetainingParentSession()
         {
             m_retainedSession = nullptr;
@@ -2059,6 +2141,38 @@ namespace Slang
         void _diagnoseErrorInImportedModule(
             DiagnosticSink*     sink);
 
+            /// Calculate the key used to look up a module in the module cache
+        SHA1::Digest _calcModuleCacheLookupKey(
+            Name*               name,
+            const PathInfo&     filePathInfo,
+            ISlangBlob*         fileContentsBlob);
+
+            /// Try to load a module from the module cache.
+            /// Returns nullptr if there is no entry, or if the entry is out of date.
+        RefPtr<Module> _loadModuleFromCache(
+            const SHA1::Digest& lookupKey,
+            Name*               name,
+            const PathInfo&     filePathInfo,
+            ISlangBlob*         fileContentsBlob,
+            SourceLoc const&    loc,
+            DiagnosticSink*     sink,
+            const LoadedModuleDictionary* additionalLoadedModules);
+
+            /// Record the key of a module that has been loaded from source, and if possible write it to the module cache,
+            /// along with the `diagnostics` reported whilst checking it
+        void _saveModuleToCache(
+            const SHA1::Digest& lookupKey,
+            Module*             module,
+            const PathInfo&     filePathInfo,
+            const List<DiagnosticSink::RecordedDiagnostic>& diagnostics);
+
+            /// Remove a module that failed to import, so that importing it again is retried
+        void _forgetImport(Name* name);
+
+            /// Names of modules currently being loaded from the module cache.
+            /// Used to stop out of date entries that import each other from recursing.
+        HashSet<Name*> m_modulesBeingLoadedFromCache;
+
         List<Type*> m_specializedTypes;
 
     };
@@ -2336,11 +2450,23 @@ namespace Slang
         {
             return m_entryPointResults[entryPointIndex];
         }
+            /// Get the number of entry points there is space for a result for
+        Index getEntryPointResultCount() { return m_entryPointResults.getCount(); }
 
         IArtifact* _createWholeProgramResult(
             DiagnosticSink*         sink,
             EndToEndCompileRequest* endToEndReq = nullptr);
 
+            /// Set the result for the whole program or an entry point.
+            /// Used when the result is produced by a deferred downstream compilation.
+        void _setWholeProgramResult(IArtifact* artifact) { m_wholeProgramResult = artifact; }
+        void _setEntryPointResult(Int entryPointIndex, IArtifact* artifact)
+        {
+            if (entryPointIndex >= m_entryPointResults.getCount())
+                m_entryPointResults.setCount(entryPointIndex + 1);
+            m_entryPointResults[entryPointIndex] = artifact;
+        }
+
             /// Internal helper for `getOrCreateEntryPointResult`.
             ///
             /// This is used so that command-line and API-based
@@ -2411,6 +2537,45 @@ namespace Slang
     public:
     };
 
+        /// A fully prepared invocation of a downstream compiler.
+        ///
+        /// Everything the downstream compile needs is owned by the job, so `execute` can be
+        /// run on any thread, concurrently with other jobs. Reporting diagnostics and storing
+        /// the result touch shared compiler state, so `finish` must be called serially.
+    class DownstreamCompileJob : public RefObject
+    {
+    public:
+            /// Run the downstream compiler. Safe to call concurrently with other jobs.
+        void execute();
+            /// Report diagnostics and timing, and produce the final artifact.
+        SlangResult finish(Session* session, DiagnosticSink* sink, ComPtr<IArtifact>& outArtifact);
+
+        ComPtr<IDownstreamCompiler> compiler;
+        DownstreamCompileOptions options;
+
+        // Storage referenced by `options`
+        SliceAllocator allocator = SliceAllocator(4096);
+        List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+        List<ComPtr<IArtifact>> libraries;
+        ComPtr<IArtifact> sourceArtifact;
+
+        // Where the result should be stored, if the job was deferred.
+        // An `entryPointIndex` of -1 means the whole program result.
+        RefPtr<TargetProgram> targetProgram;
+        Index entryPointIndex = -1;
+
+        // Set by `execute`
+        SlangResult result = SLANG_FAIL;
+        ComPtr<IArtifact> artifact;
+        double elapsedTime = 0.0;
+        // Set if the prefix header cache couldn't be used, so the prefix header was compiled as part of the source
+        bool isPrefixHeaderCacheUnusable = false;
+
+    private:
+            /// Compile again with `options.prefixHeader` at the start of the source, rather than from the cache
+        void _compileWithInlinePrefixHeader();
+    };
+
         /// A context for code generation in the compiler back-end
     struct CodeGenContext
     {
@@ -2562,6 +2727,8 @@ namespace Slang
 
         bool isSpecializationDisabled();
 
+        bool shouldCompactIR();
+
         SlangResult requireTranslationUnitSourceFiles();
 
         //
@@ -2570,9 +2737,15 @@ namespace Slang
 
         void maybeDumpIntermediate(IArtifact* artifact);
 
+            /// If set, the prelude isn't emitted at the start of generated source, and is written to `prelude`
+            /// instead. This allows the downstream compiler to precompile it.
+        void setSeparatePrelude(String* prelude) { m_separatePrelude = prelude; }
+        String* getSeparatePrelude() { return m_separatePrelude; }
+
     protected:
         CodeGenTarget m_targetFormat = CodeGenTarget::Unknown;
         ExtensionTracker* m_extensionTracker = nullptr;
+        String* m_separatePrelude = nullptr;
 
             /// Will output assembly as well as the artifact if appropriate for the artifact type for assembly output
             /// and conversion is possible
@@ -2592,6 +2765,10 @@ namespace Slang
             
         SlangResult emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact);
 
+            /// True if the downstream compile for this context can be deferred and run
+            /// in parallel with other downstream compiles.
+        bool _canDeferDownstreamCompile();
+
         /* Determines a suitable filename to identify the input for a given entry point being compiled.
         If the end-to-end compile is a pass-through case, will attempt to find the (unique) source file
         pathname for the translation unit containing the entry point at `entryPointIndex.
@@ -2757,8 +2934,14 @@ namespace Slang
 
         bool m_reportDownstreamCompileTime = false;
 
+            /// Downstream compiles deferred by `SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE`. Run and drained by `generateOutput`.
+        List<RefPtr<DownstreamCompileJob>> m_deferredDownstreamCompileJobs;
+
         // If set, will print out compiler performance benchmark results.
         bool m_reportPerfBenchmark = false;
+
+            /// If set, the profiler events recorded during compilation are written to this path as a Chrome trace
+        String m_perfTracePath;
         
         String m_diagnosticOutput;
 
@@ -2873,6 +3056,10 @@ namespace Slang
         // If true will disable generics/existential value specialization pass.
         bool disableSpecialization = false;
 
+        // If true, the live IR is copied into a new module between phases of optimization,
+        // so the memory of removed instructions is released.
+        bool compactIR = false;
+
         // If true will disable generating dynamic dispatch code.
         bool disableDynamicDispatch = false;
 
@@ -2898,6 +3085,9 @@ namespace Slang
         void generateOutput(ComponentType* program);
         void generateOutput(TargetProgram* targetProgram);
 
+            /// Execute all deferred downstream compiles in parallel, then store their results
+        void _executeDeferredDownstreamCompileJobs();
+
         void init();
 
         Session*                        m_session = nullptr;
@@ -3025,6 +3215,9 @@ namespace Slang
         SLANG_NO_THROW SlangResult SLANG_MCALL loadStdLib(const void* stdLib, size_t stdLibSizeInBytes) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBlob) override;
 
+            /// Load the StdLib from the archive file at `path`, as saved by `saveStdLib`
+        SlangResult loadStdLibFromFile(const String& path);
+
         SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(char const* name) override;
 
         SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerForTransition(SlangCompileTarget source, SlangCompileTarget target, SlangPassThrough compiler) override;
@@ -3037,6 +3230,21 @@ namespace Slang
 
         SLANG_NO_THROW SlangResult SLANG_MCALL setSPIRVCoreGrammar(char const* jsonPath) override;
 
+        SLANG_NO_THROW void SLANG_MCALL setPerformanceProfilingEnabled(bool enable) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceTrace(ISlangBlob** outTrace) override;
+        SLANG_NO_THROW void SLANG_MCALL clearPerformanceTrace() override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL createCompileResultCache(slang::CompileResultCacheDesc const& desc, slang::ICompileResultCache** outCache) override;
+        SLANG_NO_THROW void SLANG_MCALL setCompileResultCache(slang::ICompileResultCache* cache) override;
+
+        SLANG_NO_THROW void SLANG_MCALL getOverloadResolutionCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount) override;
+        SLANG_NO_THROW void SLANG_MCALL getModuleCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount) override;
+
+            /// Get the cache of entry point code set by `setCompileResultCache`, or nullptr
+        slang::ICompileResultCache* getCompileResultCache() { return m_compileResultCache; }
+
+            /// Get the type checking results shared by all sessions created from this one
+        SharedTypeCheckingCache* getSharedTypeCheckingCache();
+
             /// Get the downstream compiler for a transition
         IDownstreamCompiler* getDownstreamCompiler(CodeGenTarget source, CodeGenTarget target);
         
@@ -3055,6 +3263,11 @@ namespace Slang
         ModuleDecl* baseModuleDecl = nullptr;
         List<RefPtr<Module>> stdlibModules;
 
+            /// Get the index of the global values with linkage in the IR of the stdlib modules.
+            /// It is built on first use, and shared by all link operations. Can be called from any
+            /// thread, but not whilst builtin modules are being added, as that replaces the index.
+        IRSymbolIndex* getStdLibIRSymbolIndex();
+
         SourceManager   builtinSourceManager;
 
         SourceManager* getBuiltinSourceManager() { return &builtinSourceManager; }
@@ -3130,6 +3343,10 @@ namespace Slang
         ~Session();
 
         void addDownstreamCompileTime(double time) { m_downstreamCompileTime += time; }
+
+            /// The pool that runs downstream compiles in parallel (see `SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE`).
+            /// Created on first use, and shared by all compiles with the session.
+        ThreadPool* getDownstreamCompileThreadPool();
         void addTotalCompileTime(double time) { m_totalCompileTime += time; }
 
         ComPtr<ISlangSharedLibraryLoader> m_sharedLibraryLoader;                    ///< The shared library loader (never null)
@@ -3145,10 +3362,27 @@ namespace Slang
         CommandOptions m_commandOptions;
 
         int m_typeDictionarySize = 0;
+
+            /// Add the work done by the `simplifyIR` calls of a compile to the session's stats.
+            /// Can be called from any thread.
+        void addIRSimplificationStats(const IRSimplificationStats& stats);
+            /// Get the counts of the work done by `simplifyIR` in all compiles so far
+        IRSimplificationStats getIRSimplificationStats();
+
+            /// Accumulated size of the IR instructions allocated in the memory of deallocated
+            /// instructions (see `IRModule::reclaimDeallocatedInsts`). Atomic, as links can run on
+            /// more than one thread.
+        std::atomic<size_t> m_irRecycledInstBytes = 0;
+
+            /// Accumulated counts of the modules loaded from a module cache, and compiled
+            /// from source and added to one. See `getModuleCacheCounts`.
+        Count m_moduleCacheHitCount = 0;
+        Count m_moduleCacheMissCount = 0;
     private:
 
         void _initCodeGenTransitionMap();
 
+        SlangResult _loadStdLib(ISlangFileSystemExt* fileSystem);
         SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
 
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
@@ -3165,6 +3399,22 @@ namespace Slang
 
         double m_downstreamCompileTime = 0.0;
         double m_totalCompileTime = 0.0;
+
+        RefPtr<ThreadPool> m_downstreamCompileThreadPool;
+        std::mutex m_downstreamCompileThreadPoolMutex;
+
+        IRSimplificationStats m_irSimplificationStats;
+        std::mutex m_irSimplificationStatsMutex;
+
+            /// Index of the stdlib IR symbols. See `getStdLibIRSymbolIndex`.
+        RefPtr<IRSymbolIndex> m_stdlibIRSymbolIndex;
+        std::mutex m_stdlibIRSymbolIndexMutex;
+
+            /// Cache of entry point code shared by all sessions. See `setCompileResultCache`.
+        ComPtr<slang::ICompileResultCache> m_compileResultCache;
+
+            /// Overload resolution results for stdlib calls shared by all sessions. See `getSharedTypeCheckingCache`.
+        SharedTypeCheckingCache* m_sharedTypeCheckingCache = nullptr;
     };
 
     void checkTranslationUnit(
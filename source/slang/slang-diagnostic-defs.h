@@ -89,6 +89,7 @@ DIAGNOSTIC(    33, Error, stageSpecificationIgnoredBecauseNoEntryPoints, "one or
 DIAGNOSTIC(    34, Error, stageSpecificationIgnoredBecauseBeforeAllEntryPoints, "when compiling multiple entry points, any '-stage' options must follow the '-entry' option that they apply to")
 DIAGNOSTIC(    35, Error, noStageSpecifiedInPassThroughMode, "no stage was specified for entry point '$0'; when using the '-pass-through' option, stages must be fully specified on the command line")
 DIAGNOSTIC(    36, Error, expectingAnInteger, "expecting an integer value")
+DIAGNOSTIC(    37, Error, expectingAPositiveInteger, "expecting an integer of at least 1 for '$0', but got '$1'")
 
 DIAGNOSTIC(    40, Warning, sameProfileSpecifiedMoreThanOnce, "the '$0' was specified more than once for target '$0'")
 DIAGNOSTIC(    41, Error, conflictingProfilesSpecifiedForTarget, "conflicting profiles have been specified for target '$0'")
@@ -145,6 +146,7 @@ DIAGNOSTIC(  100, Error, failedToLoadDownstreamCompiler, "failed to load downstr
 DIAGNOSTIC(  101, Error, downstreamCompilerDoesntSupportWholeProgramCompilation, "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(  102, Note,  downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(  103, Note,  performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(  104, Warning, preludePCHCacheNotUsed, "the precompiled prelude cache in '$0' could not be used, so the prelude was compiled as part of the source")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -751,6 +753,7 @@ DIAGNOSTIC(52006, Error, compilerNotDefinedForTransition, "compiler not defined
 
 DIAGNOSTIC(52007, Error, typeCannotBeUsedInDynamicDispatch, "failed to generate dynamic dispatch code for type '$0'.")
 DIAGNOSTIC(52008, Error, dynamicDispatchOnSpecializeOnlyInterface, "type '$0' is marked for specialization only, but dynamic dispatch is needed for the call.")
+DIAGNOSTIC(52009, Error, groupBarrierNotSplitForCPU, "entry point '$0' has group barriers in control flow that can't be split for the CPU target. A barrier inside a loop is only supported if every trip around the loop passes a barrier.")
 DIAGNOSTIC(53001, Error, invalidTypeMarshallingForImportedDLLSymbol, "invalid type marshalling in imported func $0.")
 
 DIAGNOSTIC(54001, Error, meshOutputMustBeOut, "Mesh shader outputs must be declared with 'out'.")
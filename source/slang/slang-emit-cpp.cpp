@@ -876,6 +876,13 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
     // Deal with decorations that need
     // to be emitted as attributes
 
+    // If the loop over the threads of a group is hinted to be vectorized, the body of the entry point has to be
+    // inlined into the loop for the downstream compiler to be able to vectorize it.
+    if (_getVectorizeWidth(func) > 1)
+    {
+        m_writer->emit("SLANG_VECTORIZE_THREAD_INLINE ");
+    }
+
     // If `func` is not public or exported, emit `static` to prevent linking clash.
     if (!isPublicOrExportedFunc(func))
     {
@@ -1432,7 +1439,8 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOut
                 m_writer->emit("(&(");
                 auto base = inst->getOperand(0);
                 auto outerPrec = getInfo(EmitOp::General);
-                emitOperand(base, outerPrec);
+                auto prec = getInfo(EmitOp::Postfix);
+                emitOperand(base, leftSide(outerPrec, prec));
                 m_writer->emit("[");
                 emitOperand(inst->getOperand(1), EmitOpInfo());
                 m_writer->emit("]))");
@@ -1945,16 +1953,112 @@ static void _calcAxisOrder(const Int sizeAlongAxis[CLikeSourceEmitter::kThreadGr
     // axes.sort();
 }
 
-void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+Int CPPSourceEmitter::_getVectorizeWidth(IRFunc* func)
+{
+    // A kernel split at group barriers resumes each thread through a switch, which isn't worth vectorizing
+    if (func->findDecoration<IRSplitAtGroupBarriersDecoration>())
+    {
+        return 0;
+    }
+    auto entryPointDecor = func->findDecoration<IREntryPointDecoration>();
+    if (!entryPointDecor || entryPointDecor->getProfile().getStage() != Stage::Compute)
+    {
+        return 0;
+    }
+    return getTargetReq()->getCPUVectorizeWidth();
+}
+
+IRType* CPPSourceEmitter::_getGroupThreadStateType(IRFunc* func)
+{
+    // An entry point split at its group barriers takes a pointer to the thread state as its last parameter
+    if (!func->findDecoration<IRSplitAtGroupBarriersDecoration>())
+    {
+        return nullptr;
+    }
+    return as<IRPtrTypeBase>(func->getLastParam()->getDataType())->getValueType();
+}
+
+IRType* CPPSourceEmitter::_getGroupSharedType(IRFunc* func)
+{
+    // The `groupshared` variables are fields of a struct that is allocated for each group,
+    // and passed to the entry point (see `introduceExplicitGlobalContext`)
+    for (auto param : func->getParams())
+    {
+        if (auto groupSharedParamDecoration = param->findDecoration<IRGroupSharedParamDecoration>())
+        {
+            return groupSharedParamDecoration->getGroupSharedType();
+        }
+    }
+    return nullptr;
+}
+
+void CPPSourceEmitter::_emitEntryPointCall(IRFunc* func, const String& funcName, const char* threadInputName, const char* resumePointName, const char* threadStateName)
+{
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit("(");
+    m_writer->emit(threadInputName);
+    m_writer->emit(", entryPointParams, globalParams");
+    if (_getGroupSharedType(func))
+    {
+        m_writer->emit(", &groupShared");
+    }
+    if (_getGroupThreadStateType(func))
+    {
+        StringBuilder builder;
+        builder << ", &" << resumePointName << ", &" << threadStateName;
+        m_writer->emit(builder);
+    }
+    m_writer->emit(");\n");
+}
+
+void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], IRFunc* func, const String& funcName)
 {
     List<AxisWithSize> axes;
     _calcAxisOrder(sizeAlongAxis, false, axes);
 
-    // Open all the loops
+    // If the entry point is split at group barriers, each phase runs all of the threads up to their next barrier.
+    // The threads are run in phases until none of them is waiting at a barrier.
+    IRType* threadStateType = _getGroupThreadStateType(func);
+    if (threadStateType)
+    {
+        Int threadCount = 1;
+        for (const auto& axis : axes)
+        {
+            threadCount *= axis.size;
+        }
+
+        // The states of a large group can be too large for the stack, so `GroupThreadStates` puts them on the heap
+        StringBuilder builder;
+        builder << "uint32_t resumePoints[" << threadCount << "] = {};\n";
+        builder << "GroupThreadStates<";
+        m_writer->emit(builder);
+        emitType(threadStateType);
+        builder.clear();
+        builder << ", " << threadCount << "> threadStates;\n";
+        m_writer->emit(builder);
+
+        m_writer->emit("for (uint32_t phase = 0; ; ++phase)\n{\n");
+        m_writer->indent();
+        m_writer->emit("uint32_t threadIndex = 0;\n");
+        m_writer->emit("uint32_t waitingCount = 0;\n");
+    }
+
+    // If a vectorize width is set, the threads along the innermost axis are run in gangs of `laneCount`, and each
+    // thread of a gang gets its own copy of the varying input. The loop over the threads of a gang has a fixed trip
+    // count and is marked with hints that its iterations are independent, so the downstream compiler can vectorize it
+    // at that width. Whether it does is up to the compiler: nothing here generates vector code. Threads left over
+    // after the last whole gang are run one at a time.
+    const Int laneCount = _getVectorizeWidth(func);
+    const Int gangCount = (laneCount > 1 && axes.getCount() > 0) ? axes.getLast().size / laneCount : 0;
+    const Index threadLoopCount = (gangCount > 0) ? axes.getCount() - 1 : axes.getCount();
+
+    // Open all the loops, apart from the loop over the lanes
     StringBuilder builder;
-    for (Index i = 0; i < axes.getCount(); ++i)
+    for (Index i = 0; i < threadLoopCount; ++i)
     {
         const auto& axis = axes[i];
+
         builder.clear();
         const char elem[2] = { s_xyzwNames[axis.axis], 0 };
         builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++" << elem << ")\n{\n";
@@ -1966,17 +2070,89 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
         m_writer->emit(builder);
     }
 
+    auto emitCall = [&](const char* threadInputName)
+    {
+        _emitEntryPointCall(func, funcName, threadInputName, nullptr, nullptr);
+    };
+
     // just call at inner loop point
-    m_writer->emit("_");
-    m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    if (threadStateType)
+    {
+        m_writer->emit("if (phase == 0 || resumePoints[threadIndex] != 0)\n{\n");
+        m_writer->indent();
+        _emitEntryPointCall(func, funcName, "&threadInput", "resumePoints[threadIndex]", "threadStates[threadIndex]");
+        m_writer->emit("waitingCount += (resumePoints[threadIndex] != 0);\n");
+        m_writer->dedent();
+        m_writer->emit("}\n");
+        m_writer->emit("++threadIndex;\n");
+    }
+    else if (gangCount > 0)
+    {
+        const auto& axis = axes.getLast();
+        const char elem[2] = { s_xyzwNames[axis.axis], 0 };
+        const Int gangThreadCount = gangCount * laneCount;
+
+        builder.clear();
+        builder << "for (uint32_t " << elem << "Gang = 0; " << elem << "Gang < " << gangThreadCount << "; " << elem << "Gang += " << laneCount << ")\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+
+        builder.clear();
+        builder << "SLANG_VECTORIZE_THREAD_LOOP(" << laneCount << ")\n";
+        builder << "for (uint32_t lane = 0; lane < " << laneCount << "; ++lane)\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+
+        builder.clear();
+        builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+        builder << "laneInput.groupThreadID." << elem << " = " << elem << "Gang + lane;\n";
+        m_writer->emit(builder);
+        emitCall("&laneInput");
+
+        m_writer->dedent();
+        m_writer->emit("}\n");
+        m_writer->dedent();
+        m_writer->emit("}\n");
+
+        if (gangThreadCount < axis.size)
+        {
+            builder.clear();
+            builder << "for (uint32_t " << elem << " = " << gangThreadCount << "; " << elem << " < " << axis.size << "; ++" << elem << ")\n{\n";
+            m_writer->emit(builder);
+            m_writer->indent();
+
+            builder.clear();
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+            m_writer->emit(builder);
+            emitCall("&threadInput");
+
+            m_writer->dedent();
+            m_writer->emit("}\n");
+        }
+    }
+    else
+    {
+        emitCall("&threadInput");
+    }
 
     // Close all the loops
-    for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
+    for (Index i = Index(threadLoopCount - 1); i >= 0; --i)
     {
         m_writer->dedent();
         m_writer->emit("}\n");
     }
+
+    if (threadStateType)
+    {
+        m_writer->emit("if (waitingCount == 0)\n{\n");
+        m_writer->indent();
+        m_writer->emit("break;\n");
+        m_writer->dedent();
+        m_writer->emit("}\n");
+
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
 }
 
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
@@ -2144,9 +2320,29 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 
                     _emitEntryPointDefinitionStart(func, threadFuncName, UnownedStringSlice::fromLiteral("ComputeThreadVaryingInput"));
 
-                    m_writer->emit("_");
-                    m_writer->emit(funcName);
-                    m_writer->emit("(varyingInput, entryPointParams, globalParams);\n");
+                    // A single thread is the only user of its `groupshared` storage
+                    if (auto groupSharedType = _getGroupSharedType(func))
+                    {
+                        emitType(groupSharedType, "groupShared");
+                        m_writer->emit(" = {};\n");
+                    }
+
+                    if (auto threadStateType = _getGroupThreadStateType(func))
+                    {
+                        // There are no other threads to wait for, so run straight through the barriers
+                        m_writer->emit("uint32_t resumePoint = 0;\n");
+                        emitType(threadStateType, "threadState");
+                        m_writer->emit(";\n");
+                        m_writer->emit("do\n{\n");
+                        m_writer->indent();
+                        _emitEntryPointCall(func, funcName, "varyingInput", "resumePoint", "threadState");
+                        m_writer->dedent();
+                        m_writer->emit("} while (resumePoint != 0);\n");
+                    }
+                    else
+                    {
+                        _emitEntryPointCall(func, funcName, "varyingInput", nullptr, nullptr);
+                    }
 
                     _emitEntryPointDefinitionEnd(func);
                 }
@@ -2164,7 +2360,14 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    // All of the threads of the group share its `groupshared` storage
+                    if (auto groupSharedType = _getGroupSharedType(func))
+                    {
+                        emitType(groupSharedType, "groupShared");
+                        m_writer->emit(" = {};\n");
+                    }
+
+                    _emitEntryPointGroup(groupThreadSize, func, funcName);
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -96,7 +96,17 @@ protected:
 
     void _emitEntryPointDefinitionStart(IRFunc* func, const String& funcName, const UnownedStringSlice& varyingTypeName);
     void _emitEntryPointDefinitionEnd(IRFunc* func);
-    void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// Get the width the loop over the threads of a group of the compute entry point `func` is hinted to be
+        /// vectorized at. 0 or 1 if it isn't hinted.
+    Int _getVectorizeWidth(IRFunc* func);
+        /// Get the type of the per-thread state of an entry point split at group barriers, or nullptr if it isn't split
+    IRType* _getGroupThreadStateType(IRFunc* func);
+        /// Get the type of the `groupshared` storage of a compute entry point, or nullptr if it has none
+    IRType* _getGroupSharedType(IRFunc* func);
+        /// Emit a call to the entry point `func`, for the thread with varying input `threadInputName`.
+        /// If the entry point is split at group barriers, the thread's resume point and state are passed by address.
+    void _emitEntryPointCall(IRFunc* func, const String& funcName, const char* threadInputName, const char* resumePointName, const char* threadStateName);
+    void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], IRFunc* func, const String& funcName);
     void _emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
 
     void _emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupAxisCount], const UnownedStringSlice& mulName, const UnownedStringSlice& addName);
@@ -32,6 +32,7 @@
 #include "slang-ir-legalize-varying-params.h"
 #include "slang-ir-link.h"
 #include "slang-ir-com-interface.h"
+#include "slang-ir-compact.h"
 #include "slang-ir-lower-append-consume-structured-buffer.h"
 #include "slang-ir-lower-binding-query.h"
 #include "slang-ir-lower-generics.h"
@@ -51,16 +52,19 @@
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-ir-specialize.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-buffer-load-arg.h"
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-specialize-matrix-layout.h"
+#include "slang-ir-split-group-barriers.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-strip-cached-dict.h"
 #include "slang-ir-strip-witness-tables.h"
 #include "slang-ir-synthesize-active-mask.h"
+#include "slang-ir-util.h"
 #include "slang-ir-validate.h"
 #include "slang-ir-wrap-structured-buffers.h"
 #include "slang-ir-liveness.h"
@@ -198,6 +202,80 @@ static void dumpIRIfEnabled(
     }
 }
 
+    // Makes the memory of the instructions removed by the passes so far reusable, and if
+    // enabled (and `canCompact`), copies the live IR into a new module to release it.
+    //
+    // Passes can hold pointers to instructions they have removed, so this must only be
+    // called between passes, where the only pointers into the module are held by the arguments.
+static void reclaimIRMemory(
+    CodeGenContext*                 codeGenContext,
+    bool                            canCompact,
+    RefPtr<IRModule>&               ioModule,
+    List<IRFunc*>&                  ioEntryPoints,
+    LinkedIR&                       ioLinkedIR,
+    IRSpecializationCacheSymbols&   ioCacheSymbols)
+{
+    // The arena never shrinks, so the largest value recorded is the high-water mark of the module
+    SLANG_PROFILE_COUNTER("irArenaBytes", ioModule->getMemoryArena().calcTotalMemoryUsed());
+
+    ioCacheSymbols.removeDeallocated();
+    ioModule->reclaimDeallocatedInsts();
+
+    // Memory reclaimed by a call is reused by the passes that follow it, so is counted by the next call
+    auto session = codeGenContext->getSession();
+    session->m_irRecycledInstBytes += ioModule->takeRecycledInstBytes();
+    SLANG_PROFILE_COUNTER("irRecycledInstBytes", session->m_irRecycledInstBytes.load());
+
+    if (!canCompact || !codeGenContext->shouldCompactIR())
+        return;
+
+    Dictionary<IRInst*, IRInst*> mapping;
+    RefPtr<IRModule> compactedModule = SLANG_PROFILE_PASS(compactIRModule, ioModule, mapping);
+    if (!compactedModule)
+        return;
+
+    auto findCopy = [&](IRInst* inst) -> IRInst*
+    {
+        IRInst* copy = nullptr;
+        mapping.tryGetValue(inst, copy);
+        return copy;
+    };
+
+    // Every value held outside of the module has to be in it, as the old module is released.
+    List<IRFunc*> entryPoints;
+    for (auto entryPoint : ioEntryPoints)
+    {
+        auto copy = as<IRFunc>(findCopy(entryPoint));
+        if (!copy)
+            return;
+        entryPoints.add(copy);
+    }
+    List<IRFunc*> linkedEntryPoints;
+    for (auto entryPoint : ioLinkedIR.entryPoints)
+    {
+        auto copy = as<IRFunc>(findCopy(entryPoint));
+        if (!copy)
+            return;
+        linkedEntryPoints.add(copy);
+    }
+    IRVarLayout* globalScopeVarLayout = nullptr;
+    if (ioLinkedIR.globalScopeVarLayout)
+    {
+        globalScopeVarLayout = as<IRVarLayout>(findCopy(ioLinkedIR.globalScopeVarLayout));
+        if (!globalScopeVarLayout)
+            return;
+    }
+
+    ioCacheSymbols.remap(mapping);
+    ioEntryPoints = _Move(entryPoints);
+    ioLinkedIR.entryPoints = _Move(linkedEntryPoints);
+    ioLinkedIR.globalScopeVarLayout = globalScopeVarLayout;
+    ioLinkedIR.module = compactedModule;
+    ioModule = compactedModule;
+
+    SLANG_PROFILE_COUNTER("compactedIRArenaBytes", ioModule->getMemoryArena().calcTotalMemoryUsed());
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
@@ -209,10 +287,13 @@ Result linkAndOptimizeIR(
     LinkingAndOptimizationOptions const&    options,
     LinkedIR&                               outLinkedIR)
 {
-    SLANG_PROFILE;
     auto session = codeGenContext->getSession();
     auto sink = codeGenContext->getSink();
     auto target = codeGenContext->getTargetFormat();
+
+    // Each pass below is recorded as a nested section, so label the whole
+    // pipeline with the target to tell apart the runs for different targets.
+    SLANG_PROFILE_SECTION_WITH_LABEL(__func__, String(TypeTextUtil::getCompileTargetName(asExternal(target))));
     auto targetRequest = codeGenContext->getTargetReq();
 
     // Get the artifact desc for the target 
@@ -226,9 +307,16 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(codeGenContext);
+    outLinkedIR = SLANG_PROFILE_PASS(linkIR, codeGenContext);
     auto irModule = outLinkedIR.module;
+
+    // The work done by the `simplifyIR` calls below, added to the session's stats once at the end
+    IRSimplificationStats simplificationStats;
     auto irEntryPoints = outLinkedIR.entryPoints;
+    // Values in `irModule` by mangled name, for `specializeModule` to share specializations with other links.
+    // Built by the first `specializeModule`, and kept up to date by `reclaimIRMemory`.
+    IRSpecializationCacheSymbols specializationCacheSymbols;
+    SLANG_PROFILE_COUNTER("linkedIRInstCount", countInstsRecursively(irModule->getModuleInst()));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
@@ -242,13 +330,13 @@ Result linkAndOptimizeIR(
     // un-specialized IR.
     dumpIRIfEnabled(codeGenContext, irModule);
 
-    lowerGLSLShaderStorageBufferObjects(irModule, sink);
+    SLANG_PROFILE_PASS(lowerGLSLShaderStorageBufferObjects, irModule, sink);
 
-    translateGLSLGlobalVar(codeGenContext, irModule);
+    SLANG_PROFILE_PASS(translateGLSLGlobalVar, codeGenContext, irModule);
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_PROFILE_PASS(replaceGlobalConstants, irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -262,7 +350,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    bindExistentialSlots(irModule, sink);
+    SLANG_PROFILE_PASS(bindExistentialSlots, irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -286,7 +374,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_PROFILE_PASS(collectGlobalUniformParameters, irModule, outLinkedIR.globalScopeVarLayout);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -307,7 +395,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_PROFILE_PASS(collectOptiXEntryPointUniformParams, irModule);
             #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
             #endif
@@ -318,7 +406,7 @@ Result linkAndOptimizeIR(
             passOptions.alwaysCreateCollectedParam = true;
             [[fallthrough]];
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_PROFILE_PASS(collectEntryPointUniformParams, irModule, passOptions);
         #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -330,7 +418,7 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_PROFILE_PASS(moveEntryPointUniformParamsToGlobalScope, irModule);
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -342,23 +430,23 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    lowerOptionalType(irModule, sink);
+    SLANG_PROFILE_PASS(lowerOptionalType, irModule, sink);
 
     switch (target)
     {
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
     {
-        lowerComInterfaces(irModule, artifactDesc.style, sink);
-        generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink);
-        generateDllExportFuncs(irModule, sink);
+        SLANG_PROFILE_PASS(lowerComInterfaces, irModule, artifactDesc.style, sink);
+        SLANG_PROFILE_PASS(generateDllImportFuncs, codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_PROFILE_PASS(generateDllExportFuncs, irModule, sink);
         break;
     }
     default: break;
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
-    lowerResultType(irModule, sink);
+    SLANG_PROFILE_PASS(lowerResultType, irModule, sink);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
@@ -366,20 +454,20 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
-    lowerLValueCast(targetRequest, irModule);
+    SLANG_PROFILE_PASS(lowerLValueCast, targetRequest, irModule);
 
-    simplifyIR(targetRequest, irModule, IRSimplificationOptions::getDefault(), sink);
+    SLANG_PROFILE_PASS(simplifyIR, targetRequest, irModule, IRSimplificationOptions::getDefault(), sink, &simplificationStats);
 
     // Fill in default matrix layout into matrix types that left layout unspecified.
-    specializeMatrixLayout(codeGenContext->getTargetReq(), irModule);
+    SLANG_PROFILE_PASS(specializeMatrixLayout, codeGenContext->getTargetReq(), irModule);
 
     // It's important that this takes place before defunctionalization as we
     // want to be able to easily discover the cooperate and fallback funcitons
     // being passed to saturated_cooperation
-    fuseCallsToSaturatedCooperation(irModule);
+    SLANG_PROFILE_PASS(fuseCallsToSaturatedCooperation, irModule);
 
     // Generate any requested derivative wrappers
-    generateDerivativeWrappers(irModule, sink);
+    SLANG_PROFILE_PASS(generateDerivativeWrappers, irModule, sink);
 
     // Next, we need to ensure that the code we emit for
     // the target doesn't contain any operations that would
@@ -408,25 +496,27 @@ Result linkAndOptimizeIR(
         //auto b1 = dumpIRToString(irModule->getModuleInst());
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
-            changed |= specializeModule(codeGenContext->getTargetReq(), irModule, codeGenContext->getSink());
+            changed |= SLANG_PROFILE_PASS(specializeModule, codeGenContext->getTargetReq(), irModule, codeGenContext->getSink(), &specializationCacheSymbols);
         if (codeGenContext->getSink()->getErrorCount() != 0)
             return SLANG_FAIL;
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
         //auto b2 = dumpIRToString(irModule->getModuleInst());
 
-        applySparseConditionalConstantPropagation(irModule, codeGenContext->getSink());
-        eliminateDeadCode(irModule);
+        SLANG_PROFILE_PASS(applySparseConditionalConstantPropagation, irModule, codeGenContext->getSink());
+        SLANG_PROFILE_PASS(eliminateDeadCode, irModule);
 
         validateIRModuleIfEnabled(codeGenContext, irModule);
+
+        reclaimIRMemory(codeGenContext, false, irModule, irEntryPoints, outLinkedIR, specializationCacheSymbols);
     
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
+        SLANG_PROFILE_PASS(performMandatoryEarlyInlining, irModule);
 
         // Unroll loops.
         if (codeGenContext->getSink()->getErrorCount() == 0)
         {
-            if (!unrollLoopsInModule(targetRequest, irModule, codeGenContext->getSink()))
+            if (!SLANG_PROFILE_PASS(unrollLoopsInModule, targetRequest, irModule, codeGenContext->getSink()))
                 return SLANG_FAIL;
         }
 
@@ -435,11 +525,11 @@ Result linkAndOptimizeIR(
         // which do.
         // Specialize away these parameters
         // TODO: We should implement a proper defunctionalization pass
-        changed |= specializeHigherOrderParameters(codeGenContext, irModule);
+        changed |= SLANG_PROFILE_PASS(specializeHigherOrderParameters, codeGenContext, irModule);
 
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
         enableIRValidationAtInsert();
-        changed |= processAutodiffCalls(targetRequest, irModule, sink);
+        changed |= SLANG_PROFILE_PASS(processAutodiffCalls, targetRequest, irModule, sink);
         disableIRValidationAtInsert();
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
 
@@ -447,19 +537,23 @@ Result linkAndOptimizeIR(
             break;
     }
 
-    finalizeAutoDiffPass(targetRequest, irModule);
+    SLANG_PROFILE_PASS(finalizeAutoDiffPass, targetRequest, irModule);
+
+    SLANG_PROFILE_PASS(finalizeSpecialization, irModule);
 
-    finalizeSpecialization(irModule);
+    // Specialization leaves behind most of the removed instructions, so this is where
+    // compaction is most useful.
+    reclaimIRMemory(codeGenContext, true, irModule, irEntryPoints, outLinkedIR, specializationCacheSymbols);
 
     switch (target)
     {
     case CodeGenTarget::PyTorchCppBinding:
-        generatePyTorchCppBinding(irModule, sink);
-        handleAutoBindNames(irModule);
+        SLANG_PROFILE_PASS(generatePyTorchCppBinding, irModule, sink);
+        SLANG_PROFILE_PASS(handleAutoBindNames, irModule);
         break;
     case CodeGenTarget::CUDASource:
-        removeTorchKernels(irModule);
-        handleAutoBindNames(irModule);
+        SLANG_PROFILE_PASS(removeTorchKernels, irModule);
+        SLANG_PROFILE_PASS(handleAutoBindNames, irModule);
         break;
     default:
         break;
@@ -475,26 +569,26 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
-        SLANG_RETURN_ON_FAIL(performStringInlining(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_PROFILE_PASS(performStringInlining, irModule, sink));
     }
 
-    lowerReinterpret(targetRequest, irModule, sink);
+    SLANG_PROFILE_PASS(lowerReinterpret, targetRequest, irModule, sink);
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    simplifyIR(targetRequest, irModule, IRSimplificationOptions::getFast(), sink);
+    SLANG_PROFILE_PASS(simplifyIR, targetRequest, irModule, IRSimplificationOptions::getFast(), sink, &simplificationStats);
 
     if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc))
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is not a string literal
-        SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_PROFILE_PASS(checkGetStringHashInsts, irModule, sink));
     }
 
     // For targets that supports dynamic dispatch, we need to lower the
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink);
+    SLANG_PROFILE_PASS(lowerGenerics, targetRequest, irModule, sink);
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -505,13 +599,13 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
-    performForceInlining(irModule);
+    SLANG_PROFILE_PASS(performForceInlining, irModule);
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
     // will run a DCE pass to clean up after the specialization.
     //
-    simplifyIR(targetRequest, irModule, IRSimplificationOptions::getDefault(), sink);
+    SLANG_PROFILE_PASS(simplifyIR, targetRequest, irModule, IRSimplificationOptions::getDefault(), sink, &simplificationStats);
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -520,7 +614,7 @@ Result linkAndOptimizeIR(
     // of `RWStructuredBuffer` typed fields now.
     if (target != CodeGenTarget::HLSL)
     {
-        lowerAppendConsumeStructuredBuffers(targetRequest, irModule, sink);
+        SLANG_PROFILE_PASS(lowerAppendConsumeStructuredBuffers, targetRequest, irModule, sink);
     }
 
     // We don't need the legalize pass for C/C++ based types
@@ -551,7 +645,7 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
+        SLANG_PROFILE_PASS(legalizeExistentialTypeLayout,
             irModule,
             sink);
 
@@ -571,7 +665,7 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
+        SLANG_PROFILE_PASS(legalizeResourceTypes,
             irModule,
             sink);
 
@@ -585,19 +679,19 @@ Result linkAndOptimizeIR(
     {
         // On CPU/CUDA targets, we simply elminate any empty types if
         // they are not part of public interface.
-        legalizeEmptyTypes(
+        SLANG_PROFILE_PASS(legalizeEmptyTypes,
             irModule,
             sink);
     }
 
-    legalizeVectorTypes(irModule, sink);
+    SLANG_PROFILE_PASS(legalizeVectorTypes, irModule, sink);
 
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    simplifyIR(targetRequest, irModule, IRSimplificationOptions::getFast(), sink);
+    SLANG_PROFILE_PASS(simplifyIR, targetRequest, irModule, IRSimplificationOptions::getFast(), sink, &simplificationStats);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -613,17 +707,19 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_PROFILE_PASS(specializeResourceUsage, codeGenContext, irModule);
+    SLANG_PROFILE_PASS(specializeFuncsForBufferLoadArgs, codeGenContext, irModule);
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
-        specializeArrayParameters(codeGenContext, irModule);
+        SLANG_PROFILE_PASS(specializeArrayParameters, codeGenContext, irModule);
     }
-    eliminateDeadCode(irModule);
+    SLANG_PROFILE_PASS(eliminateDeadCode, irModule);
+
+    reclaimIRMemory(codeGenContext, true, irModule, irEntryPoints, outLinkedIR, specializationCacheSymbols);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
@@ -642,7 +738,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_PROFILE_PASS(wrapStructuredBuffersOfMatrices, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -741,7 +837,7 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        SLANG_PROFILE_PASS(legalizeByteAddressBufferOps, session, targetRequest, irModule, byteAddressBufferOptions);
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -753,7 +849,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(
+            SLANG_PROFILE_PASS(synthesizeActiveMask,
                 irModule,
                 codeGenContext->getSink());
 
@@ -787,7 +883,7 @@ Result linkAndOptimizeIR(
             ? as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker())
             : &glslExtensionTracker;
 
-        legalizeEntryPointsForGLSL(
+        SLANG_PROFILE_PASS(legalizeEntryPointsForGLSL,
             session,
             irModule,
             irEntryPoints,
@@ -804,13 +900,13 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_PROFILE_PASS(legalizeEntryPointVaryingParamsForCPU, irModule, codeGenContext->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_PROFILE_PASS(legalizeEntryPointVaryingParamsForCUDA, irModule, codeGenContext->getSink());
         }
         break;
 
@@ -825,9 +921,9 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeImageSubscriptForGLSL(irModule);
-            legalizeConstantBufferLoadForGLSL(irModule);
-            legalizeDispatchMeshPayloadForGLSL(irModule);
+            SLANG_PROFILE_PASS(legalizeImageSubscriptForGLSL, irModule);
+            SLANG_PROFILE_PASS(legalizeConstantBufferLoadForGLSL, irModule);
+            SLANG_PROFILE_PASS(legalizeDispatchMeshPayloadForGLSL, irModule);
         }
         break;
     default:
@@ -841,15 +937,18 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::GLSL:
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
-        moveGlobalVarInitializationToEntryPoints(irModule);
+        SLANG_PROFILE_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
         break;
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_PROFILE_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
+        SLANG_PROFILE_PASS(introduceExplicitGlobalContext, irModule, target);
         if(target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_PROFILE_PASS(convertEntryPointPtrParamsToRawPtrs, irModule);
+
+            // Barriers have to be in the body of an entry point for it to be split at them (see below)
+            SLANG_PROFILE_PASS(inlineGroupBarrierCallsForCPU, irModule);
         }
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -858,12 +957,12 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    SLANG_PROFILE_PASS(stripCachedDictionaries, irModule);
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    SLANG_PROFILE_PASS(stripWitnessTables, irModule);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER STRIP WITNESS TABLES");
@@ -878,70 +977,70 @@ Result linkAndOptimizeIR(
     //
     // We run DCE pass again to clean things up.
     //
-    eliminateDeadCode(irModule);
+    SLANG_PROFILE_PASS(eliminateDeadCode, irModule);
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type parameters, we will
         // inline the functions in question to make sure we can produce valid GLSL.
-        performGLSLResourceReturnFunctionInlining(irModule);
+        SLANG_PROFILE_PASS(performGLSLResourceReturnFunctionInlining, irModule);
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    SLANG_PROFILE_PASS(cleanUpVoidType, irModule);
 
     // Lower the `getRegisterIndex` and `getRegisterSpace` intrinsics.
     //
-    lowerBindingQueries(irModule, sink);
+    SLANG_PROFILE_PASS(lowerBindingQueries, irModule, sink);
 
     // For some small improvement in type safety we represent these as opaque
     // structs instead of regular arrays.
     //
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
-    legalizeMeshOutputTypes(irModule);
+    SLANG_PROFILE_PASS(legalizeMeshOutputTypes, irModule);
 
     if (options.shouldLegalizeExistentialAndResourceTypes)
     {
         // We need to lower any types used in a buffer resource (e.g. ContantBuffer or StructuredBuffer) into
         // a simple storage type that has target independent layout based on the kind of buffer resource.
-        lowerBufferElementTypeToStorageType(targetRequest, irModule);
+        SLANG_PROFILE_PASS(lowerBufferElementTypeToStorageType, targetRequest, irModule);
     }
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
-    legalizeArrayReturnType(irModule);
+    SLANG_PROFILE_PASS(legalizeArrayReturnType, irModule);
 
     if (isKhronosTarget(targetRequest) || target == CodeGenTarget::HLSL)
     {
-        legalizeUniformBufferLoad(irModule);
+        SLANG_PROFILE_PASS(legalizeUniformBufferLoad, irModule);
         if (targetRequest->getHLSLToVulkanLayoutOptions() && targetRequest->getHLSLToVulkanLayoutOptions()->shouldInvertY())
-            invertYOfPositionOutput(irModule);
+            SLANG_PROFILE_PASS(invertYOfPositionOutput, irModule);
     }
 
     // Lower sizeof/alignof
 
-    lowerSizeOfLike(targetRequest, irModule, sink);
+    SLANG_PROFILE_PASS(lowerSizeOfLike, targetRequest, irModule, sink);
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    lowerBitCast(targetRequest, irModule);
+    SLANG_PROFILE_PASS(lowerBitCast, targetRequest, irModule);
 
 
     if (isKhronosTarget(targetRequest) && targetRequest->shouldEmitSPIRVDirectly())
     {
-        performIntrinsicFunctionFunctionInlining(irModule);
-        eliminateDeadCode(irModule);
+        SLANG_PROFILE_PASS(performIntrinsicFunctionFunctionInlining, irModule);
+        SLANG_PROFILE_PASS(eliminateDeadCode, irModule);
     }
-    eliminateMultiLevelBreak(irModule);
+    SLANG_PROFILE_PASS(eliminateMultiLevelBreak, irModule);
 
     {
         IRSimplificationOptions simplificationOptions = IRSimplificationOptions::getFast();
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
-        simplifyIR(targetRequest, irModule, simplificationOptions, sink);
+        SLANG_PROFILE_PASS(simplifyIR, targetRequest, irModule, simplificationOptions, sink, &simplificationStats);
     }
 
     // As a late step, we need to take the SSA-form IR and move things *out*
@@ -965,7 +1064,7 @@ Result linkAndOptimizeIR(
         //
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addVariableRangeStarts(irModule, livenessMode);
+            SLANG_PROFILE_PASS(LivenessUtil::addVariableRangeStarts, irModule, livenessMode);
         }
 
         // We only want to accumulate locations if liveness tracking is enabled.
@@ -975,7 +1074,7 @@ Result linkAndOptimizeIR(
             phiEliminationOptions.eliminateCompositeTypedPhiOnly = false;
             phiEliminationOptions.useRegisterAllocation = true;
         }
-        eliminatePhis(livenessMode, irModule, phiEliminationOptions);
+        SLANG_PROFILE_PASS(eliminatePhis, livenessMode, irModule, phiEliminationOptions);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -984,7 +1083,7 @@ Result linkAndOptimizeIR(
 
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addRangeEnds(irModule, livenessMode);
+            SLANG_PROFILE_PASS(LivenessUtil::addRangeEnds, irModule, livenessMode);
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "LIVENESS");
@@ -992,6 +1091,20 @@ Result linkAndOptimizeIR(
         }
     }
 
+    // The threads of a group on the CPU are run one after another by a single host thread,
+    // so entry points with group barriers are split into phases that the threads run in turn.
+    // This relies on there being no phis.
+    //
+    if (target == CodeGenTarget::CPPSource)
+    {
+        SLANG_PROFILE_PASS(splitEntryPointsAtGroupBarriersForCPU, irModule, sink);
+#if 0
+        dumpIRIfEnabled(codeGenContext, irModule, "SPLIT AT GROUP BARRIERS");
+#endif
+        if (sink->getErrorCount() != 0)
+            return SLANG_FAIL;
+    }
+
     // TODO: We need to insert the logic that fixes variable scoping issues
     // here (rather than doing it very late in the emit process), because
     // otherwise the `applyGLSLLiveness()` operation below wouldn't be
@@ -1014,12 +1127,12 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_PROFILE_PASS(applyGLSLLiveness, irModule);
         }
     }
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
-    simplifyNonSSAIR(targetRequest, irModule, IRSimplificationOptions::getFast());
+    SLANG_PROFILE_PASS(simplifyNonSSAIR, targetRequest, irModule, IRSimplificationOptions::getFast());
 
     // We include one final step to (optionally) dump the IR and validate
     // it after all of the optimization passes are complete. This should
@@ -1029,6 +1142,8 @@ Result linkAndOptimizeIR(
     dumpIRIfEnabled(codeGenContext, irModule, "OPTIMIZED");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
+    SLANG_PROFILE_COUNTER("optimizedIRInstCount", countInstsRecursively(irModule->getModuleInst()));
+    SLANG_PROFILE_COUNTER("irArenaBytes", irModule->getMemoryArena().calcTotalMemoryUsed());
 
     auto metadata = new ArtifactPostEmitMetadata;
     outLinkedIR.metadata = metadata;
@@ -1037,6 +1152,8 @@ Result linkAndOptimizeIR(
 
     outLinkedIR.metadata = metadata;
 
+    session->addIRSimplificationStats(simplificationStats);
+
     return SLANG_OK;
 }
 
@@ -1221,7 +1338,14 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         {
             // Get the prelude
             String prelude = session->getPreludeForLanguage(sourceLanguage);
-            sourceWriter.emit(prelude);
+            if (auto separatePrelude = getSeparatePrelude())
+            {
+                *separatePrelude = prelude;
+            }
+            else
+            {
+                sourceWriter.emit(prelude);
+            }
         }
         break;
     }
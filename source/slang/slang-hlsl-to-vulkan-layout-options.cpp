@@ -89,6 +89,40 @@ Index HLSLToVulkanLayoutOptions::getShift(Kind kind, Index set) const
     return kInvalidShift;
 }
 
+void HLSLToVulkanLayoutOptions::buildHash(DigestBuilder<SHA1>& builder) const
+{
+    builder.append(m_globalsBinding.set);
+    builder.append(m_globalsBinding.index);
+    for (auto shift : m_allShifts)
+    {
+        builder.append(shift);
+    }
+    builder.append(m_kindShiftEnabledFlags);
+
+    // The dictionary has no defined order, so sort the shifts first
+    List<KeyValuePair<Key, Index>> shifts;
+    for (const auto& [key, shift] : m_shifts)
+    {
+        shifts.add(KeyValuePair<Key, Index>(key, shift));
+    }
+    shifts.sort([](const KeyValuePair<Key, Index>& a, const KeyValuePair<Key, Index>& b)
+        {
+            return a.key.kind < b.key.kind || (a.key.kind == b.key.kind && a.key.set < b.key.set);
+        });
+    builder.append(shifts.getCount());
+    for (const auto& shift : shifts)
+    {
+        builder.append(shift.key.kind);
+        builder.append(shift.key.set);
+        builder.append(shift.value);
+    }
+
+    builder.append(m_invertY);
+    builder.append(m_useOriginalEntryPointName);
+    builder.append(m_useGLLayout);
+    builder.append(m_emitSPIRVReflectionInfo);
+}
+
 bool HLSLToVulkanLayoutOptions::hasState() const
 {
     return canInferBindings() || hasGlobalsBinding() || shouldInvertY() || getUseOriginalEntryPointName()
@@ -3,6 +3,7 @@
 #define SLANG_HLSL_TO_VULKAN_LAYOUT_OPTIONS_H
 
 #include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-name-value.h"
 
 namespace Slang
@@ -142,6 +143,9 @@ public:
         /// Returns true if contains default reset state. If so it can in effect be ignored
     bool isReset() const { return !hasState(); }
 
+        /// Add all of the state to the hash `builder`
+    void buildHash(DigestBuilder<SHA1>& builder) const;
+
         /// Set the global binding
     void setGlobalsBinding(Index set, Index bindingIndex) { setGlobalsBinding(Binding{set, bindingIndex}); }
         /// Set the global bindings
@@ -740,7 +740,13 @@ namespace Slang
             diffPropagateFunc, primalFunc, primalsInfo, paramTransposeInfo, intermediateType);
 
         // At this point the unzipped func is just an empty shell
-        // and we can simply remove it.
+        // and we can simply remove it, along with any derivative
+        // decorations that still refer to it.
+        while (auto use = unzippedFwdDiffFunc->firstUse)
+        {
+            SLANG_RELEASE_ASSERT(as<IRDecoration>(use->getUser()));
+            use->getUser()->removeAndDeallocate();
+        }
         unzippedFwdDiffFunc->removeAndDeallocate();
         
         // Write back derivatives to inout parameters.
@@ -1165,10 +1171,9 @@ namespace Slang
         }
 
         // Actually remove all the insts that we decided to remove in the process.
-        for (auto inst : instsToRemove)
-        {
-            inst->removeAndDeallocate();
-        }
+        // A param is removed along with the refs that use it, so they are removed
+        // as a batch.
+        removeAndDeallocateInsts(instsToRemove);
 
 
         // The next step is to insert new parameters that is not related to any existing parameters.
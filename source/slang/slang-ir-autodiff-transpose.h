@@ -668,11 +668,51 @@ struct DiffTransposePass
         builder.setInsertInto(lastRevBlock);
         builder.emitReturn();
 
-        // Remove fwd-mode blocks.
+        // Hoistable insts (such as a func type that depends on an opened existential)
+        // are shared through deduplication, so one that was emitted into a fwd-mode
+        // block can still be used from the primal and rev-mode blocks. Move those
+        // right after the local operand they depend on, so they outlive the fwd-mode
+        // blocks.
+        //
+        HashSet<IRInst*> fwdBlockSet;
+        for (auto block : workList)
+            fwdBlockSet.add(block);
+
+        List<IRInst*> instsToMove;
         for (auto block : workList)
         {
-            block->removeAndDeallocate();
+            for (auto inst : block->getChildren())
+            {
+                if (!getIROpInfo(inst->getOp()).isHoistable())
+                    continue;
+                for (auto use = inst->firstUse; use; use = use->nextUse)
+                {
+                    if (!fwdBlockSet.contains(use->getUser()->getParent()))
+                    {
+                        instsToMove.add(inst);
+                        break;
+                    }
+                }
+            }
+        }
+        for (auto inst : instsToMove)
+        {
+            IRInst* localOperand = nullptr;
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                auto operand = inst->getOperand(i);
+                if (as<IRBlock>(operand->getParent()) && !fwdBlockSet.contains(operand->getParent()))
+                    localOperand = operand;
+            }
+            if (!localOperand)
+                continue;
+            setInsertAfterOrdinaryInst(&builder, localOperand);
+            inst->insertAt(builder.getInsertLoc());
         }
+
+        // Remove fwd-mode blocks. They branch to each other, so they are removed
+        // as a batch.
+        removeAndDeallocateInsts(workList);
     }
 
     IRInst* extractAccumulatorVarGradient(IRBuilder* builder, IRInst* fwdInst)
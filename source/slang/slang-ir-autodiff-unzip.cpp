@@ -255,8 +255,7 @@ struct ExtractPrimalFuncContext
             if (isDiffInst(block) || block->findDecoration<IRRecomputeBlockDecoration>())
                 unusedBlocks.add(block);
         }
-        for (auto block : unusedBlocks)
-            block->removeAndDeallocate();
+        removeAndDeallocateInsts(unusedBlocks);
 
         builder.setInsertBefore(firstBlock->getFirstOrdinaryInst());
         auto defVal = builder.emitDefaultConstructRaw((IRType*)intermediateType);
@@ -318,14 +317,28 @@ IRFunc* DiffUnzipPass::extractPrimalFunc(
                 decor->removeAndDeallocate();
 
     // Remove propagate func specific primal insts from cloned func.
+    // They can use each other, so they are removed as a batch. The differential
+    // code can still use them too, but it is removed later, so those uses are
+    // replaced with `undefined` first.
+    List<IRInst*> propagateFuncSpecificInsts;
     for (auto inst : paramInfo.propagateFuncSpecificPrimalInsts)
     {
         IRInst* newInst = nullptr;
         if (subEnv.mapOldValToNew.tryGetValue(inst, newInst))
         {
-            newInst->removeAndDeallocate();
+            propagateFuncSpecificInsts.add(newInst);
         }
     }
+    IRInst* undefInst = nullptr;
+    for (auto inst : propagateFuncSpecificInsts)
+    {
+        if (!inst->hasUses())
+            continue;
+        if (!undefInst)
+            undefInst = getUndefInst(builder, builder.getModule());
+        inst->replaceUsesWith(undefInst);
+    }
+    removeAndDeallocateInsts(propagateFuncSpecificInsts);
 
     HashSet<IRInst*> newPrimalParams;
     for (auto param : func->getParams())
@@ -181,8 +181,9 @@ struct DiffUnzipPass
             if (primalMap.containsKey(block))
                 splitInfo->diffBlockMap[as<IRBlock>(primalMap[block])] = as<IRBlock>(diffMap[block]);
 
-        for (auto block : mixedBlocks)
-            block->removeAndDeallocate();
+        // The mixed blocks (and the split insts left in them) can use each other,
+        // so they are removed as a batch.
+        removeAndDeallocateInsts(mixedBlocks);
     }
 
     IRFunc* extractPrimalFunc(
@@ -742,7 +743,9 @@ struct DiffUnzipPass
             }
         }
 
-        // Remove insts that were split.
+        // Insts that were split are left in the original block, and removed along
+        // with it once all mixed blocks are split, as the terminators (kept for CFG info)
+        // and insts in mixed blocks that are not split yet can still use them.
         for (auto inst : splitInsts)
         {
             if (!isDifferentiableType(diffTypeContext, inst->getDataType()))
@@ -756,14 +759,11 @@ struct DiffUnzipPass
                 SLANG_RELEASE_ASSERT((use->getUser()->getParent() != primalBlock) && 
                     (use->getUser()->getParent() != diffBlock));
             }
-
-            // Leave terminator in to keep CFG info.
-            if (!as<IRTerminatorInst>(inst))
-                inst->removeAndDeallocate();
         }
 
-        // Nothing should be left in the original block.
-        SLANG_ASSERT(block->getFirstChild() == block->getTerminator());
+        // Nothing but the split insts should be left in the original block.
+        for (auto child : block->getChildren())
+            SLANG_ASSERT(splitInsts.contains(child));
     }
 };
 
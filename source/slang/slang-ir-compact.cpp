@@ -0,0 +1,201 @@
+// slang-ir-compact.cpp
+#include "slang-ir-compact.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+#include <string.h>
+
+namespace Slang
+{
+    struct CompactIRContext
+    {
+        IRModule* oldModule;
+        IRModule* newModule;
+        Dictionary<IRInst*, IRInst*>& mapping;
+
+        // Every instruction below the module instruction, parents before their children
+        List<IRInst*> oldInsts;
+
+        CompactIRContext(IRModule* inOldModule, IRModule* inNewModule, Dictionary<IRInst*, IRInst*>& inMapping)
+            : oldModule(inOldModule)
+            , newModule(inNewModule)
+            , mapping(inMapping)
+        {}
+
+        IRInst* findCopy(IRInst* oldInst)
+        {
+            if (!oldInst)
+                return nullptr;
+            if (auto newInst = mapping.tryGetValue(oldInst))
+                return *newInst;
+            return nullptr;
+        }
+
+        // Allocate a copy of each decoration and child of `oldParent` (recursively),
+        // with everything but its parent and uses.
+        void allocateCopies(IRInst* oldParent)
+        {
+            for (auto oldInst : oldParent->getDecorationsAndChildren())
+            {
+                const UInt operandCount = oldInst->getOperandCount();
+                auto newInst = newModule->_allocateInst(oldInst->getOp(), operandCount, oldInst->m_allocatedSize);
+
+                // Copy any state after the operands, such as the value of a constant
+                const size_t operandsEnd = sizeof(IRInst) + operandCount * sizeof(IRUse);
+                if (oldInst->m_allocatedSize > operandsEnd)
+                {
+                    ::memcpy((char*)newInst + operandsEnd, (char*)oldInst + operandsEnd, oldInst->m_allocatedSize - operandsEnd);
+                }
+
+                newInst->sourceLoc = oldInst->sourceLoc;
+#ifdef SLANG_ENABLE_IR_BREAK_ALLOC
+                newInst->_debugUID = oldInst->_debugUID;
+#endif
+
+                mapping.add(oldInst, newInst);
+                oldInsts.add(oldInst);
+
+                allocateCopies(oldInst);
+            }
+        }
+
+        bool isCopied(IRInst* oldInst)
+        {
+            return !oldInst || mapping.containsKey(oldInst);
+        }
+
+        // All of the types and operands must be in the module to be copied.
+        bool canCopyUses()
+        {
+            for (auto oldInst : oldInsts)
+            {
+                if (!isCopied(oldInst->getFullType()))
+                    return false;
+
+                const UInt operandCount = oldInst->getOperandCount();
+                for (UInt i = 0; i < operandCount; ++i)
+                {
+                    if (!isCopied(oldInst->getOperand(i)))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        IRUse* findCopyOfUse(IRUse* oldUse)
+        {
+            auto oldUser = oldUse->getUser();
+            auto newUser = findCopy(oldUser);
+            if (!newUser)
+                return nullptr;
+
+            if (oldUse == &oldUser->typeUse)
+                return &newUser->typeUse;
+            return newUser->getOperands() + (oldUse - oldUser->getOperands());
+        }
+
+        void copyUses()
+        {
+            // Give every use its user first, as a use without one can't be set.
+            for (auto oldInst : oldInsts)
+            {
+                auto newInst = findCopy(oldInst);
+                newInst->typeUse.init(newInst, nullptr);
+
+                const UInt operandCount = oldInst->getOperandCount();
+                for (UInt i = 0; i < operandCount; ++i)
+                {
+                    newInst->getOperands()[i].init(newInst, nullptr);
+                }
+            }
+
+            // Each use is added to the start of the list of uses of a value, so adding
+            // them in reverse keeps their order.
+            List<IRUse*> oldUses;
+            for (auto oldInst : oldInsts)
+            {
+                oldUses.clear();
+                for (auto oldUse = oldInst->firstUse; oldUse; oldUse = oldUse->nextUse)
+                {
+                    oldUses.add(oldUse);
+                }
+
+                auto newInst = findCopy(oldInst);
+                for (Index i = oldUses.getCount() - 1; i >= 0; --i)
+                {
+                    // Users that aren't in the module (such as deallocated instructions) aren't copied
+                    if (auto newUse = findCopyOfUse(oldUses[i]))
+                    {
+                        newUse->init(newUse->getUser(), newInst);
+                    }
+                }
+            }
+        }
+
+        void insertCopies()
+        {
+            for (auto oldInst : oldInsts)
+            {
+                auto oldParent = oldInst->getParent();
+                auto newParent = oldParent == oldModule->getModuleInst() ? newModule->getModuleInst() : findCopy(oldParent);
+
+                findCopy(oldInst)->insertAtEnd(newParent);
+            }
+        }
+
+        void copyDeduplicationMaps()
+        {
+            auto oldContext = oldModule->getDeduplicationContext();
+            auto newContext = newModule->getDeduplicationContext();
+
+            // The keys are recalculated, as the hash of a key is calculated when it is created
+            for (const auto& [key, value] : oldContext->getGlobalValueNumberingMap())
+            {
+                if (auto newValue = findCopy(value))
+                {
+                    newContext->getGlobalValueNumberingMap().tryGetValueOrAdd(IRInstKey{ newValue }, newValue);
+                }
+            }
+            for (const auto& [key, value] : oldContext->getConstantMap())
+            {
+                if (auto newValue = as<IRConstant>(findCopy(value)))
+                {
+                    newContext->getConstantMap().tryGetValueOrAdd(IRConstantKey{ newValue }, newValue);
+                }
+            }
+            for (const auto& [key, value] : oldContext->getInstReplacementMap())
+            {
+                auto newKey = findCopy(key);
+                auto newValue = findCopy(value);
+                if (newKey && newValue)
+                {
+                    newContext->getInstReplacementMap()[newKey] = newValue;
+                }
+            }
+        }
+    };
+
+    RefPtr<IRModule> compactIRModule(
+        IRModule*                       module,
+        Dictionary<IRInst*, IRInst*>&   outMapping)
+    {
+        RefPtr<IRModule> newModule = IRModule::create(module->getSession());
+
+        CompactIRContext context(module, newModule, outMapping);
+        context.allocateCopies(module->getModuleInst());
+
+        if (!context.canCopyUses())
+        {
+            outMapping.clear();
+            return nullptr;
+        }
+
+        context.copyUses();
+        context.insertCopies();
+        context.copyDeduplicationMaps();
+
+        newModule->setObfuscatedSourceMap(module->getObfuscatedSourceMap());
+        return newModule;
+    }
+}
@@ -0,0 +1,26 @@
+// slang-ir-compact.h
+#pragma once
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+    /// Copy the IR of `module` into a new module.
+    ///
+    /// Deallocated instructions are never freed while their module exists, so after
+    /// many passes most of the memory of a module can be taken by instructions that
+    /// have been removed. The copy only allocates memory for the live instructions.
+    ///
+    /// The copy is exact: instructions keep their order, and the uses of each
+    /// instruction are in the same order, so passes run on the copy give the same result.
+    ///
+    /// The copy of each instruction of `module` is added to `outMapping`.
+    /// Returns nullptr if `module` refers to instructions that aren't in it, in which
+    /// case it can't be copied.
+    ///
+    RefPtr<IRModule> compactIRModule(
+        IRModule*                       module,
+        Dictionary<IRInst*, IRInst*>&   outMapping);
+}
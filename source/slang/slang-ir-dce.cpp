@@ -29,6 +29,11 @@ struct DeadCodeEliminationContext
     // there could be new DCE opportunities.
     bool phiRemoved = false;
 
+    // The dead instructions found by `eliminateDeadInstsRec`, which are
+    // only deallocated once all of them have been found, as dead
+    // instructions can use each other.
+    List<IRInst*> deadInsts;
+
     // Querying whether an instruction has been
     // determined to be live is easy.
     // To speedup the test, we use the
@@ -200,6 +205,7 @@ struct DeadCodeEliminationContext
             //
             phiRemoved = false;
             result |= eliminateDeadInstsRec(root);
+            deallocateDeadInsts();
 
 
             if (!phiRemoved)
@@ -232,6 +238,11 @@ struct DeadCodeEliminationContext
             // because they must have been dead too (since we always
             // mark the parent of a live instruction as live).
             //
+            // A live instruction can only use `inst` through a "weak"
+            // reference, which is replaced here. Other dead instructions
+            // can use `inst` or its descendents though, so it is only
+            // deallocated once all of them have been found.
+            //
             if (inst->hasUses())
             {
                 inst->replaceUsesWith(getUndefInst());
@@ -242,8 +253,16 @@ struct DeadCodeEliminationContext
                 // For Phi parameters, we need to update all branch arguments.
                 removePhiArgs(inst);
                 phiRemoved = true;
+
+                // A param has no descendents, and it has to be removed right
+                // away so that the index of the next param in its block stays
+                // in step with the branch arguments.
+                inst->removeAndDeallocate();
+            }
+            else
+            {
+                deadInsts.add(inst);
             }
-            inst->removeAndDeallocate();
             changed = true;
         }
         else
@@ -275,6 +294,12 @@ struct DeadCodeEliminationContext
         return changed;
     }
 
+    void deallocateDeadInsts()
+    {
+        removeAndDeallocateInsts(deadInsts);
+        deadInsts.clear();
+    }
+
     // Now we come to the decision procedure we put off before:
     // should a given `inst` be live if its parent is?
     //
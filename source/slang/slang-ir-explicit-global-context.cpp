@@ -19,8 +19,13 @@ struct IntroduceExplicitGlobalContextPass
     IRStructType*       m_contextStructType     = nullptr;
     IRPtrType*          m_contextStructPtrType  = nullptr;
 
+    IRStructType*       m_groupSharedStructType = nullptr;
+    IRPtrType*          m_groupSharedPtrType    = nullptr;
+    IRStructKey*        m_groupSharedFieldKey   = nullptr;
+
     IRGlobalParam*      m_globalUniformsParam   = nullptr;
     List<IRGlobalVar*>  m_globalVars;
+    List<IRGlobalVar*>  m_groupSharedVars;
     List<IRFunc*>       m_entryPoints;
 
     void processModule()
@@ -67,6 +72,21 @@ struct IntroduceExplicitGlobalContextPass
                             continue;
                     }
 
+                    // On the CPU all of the threads of a group are run by the
+                    // same host thread, but other groups can be run at the same
+                    // time by other host threads. The `groupshared` variables
+                    // are thus moved into a `GroupShared` struct instead, that
+                    // the code running a group allocates once for the group.
+                    //
+                    if( m_target == CodeGenTarget::CPPSource )
+                    {
+                        if( as<IRGroupSharedRate>(globalVar->getRate()) )
+                        {
+                            m_groupSharedVars.add(globalVar);
+                            continue;
+                        }
+                    }
+
                     m_globalVars.add(globalVar);
                 }
                 break;
@@ -171,14 +191,36 @@ struct IntroduceExplicitGlobalContextPass
             // For the parameter representing all the global uniform shader
             // parameters, we create a field that exactly matches its type.
             //
-            createContextStructField(m_globalUniformsParam, m_globalUniformsParam->getFullType());
+            createContextStructField(m_contextStructType, m_globalUniformsParam, m_globalUniformsParam->getFullType());
         }
         for( auto globalVar : m_globalVars )
         {
             // A `IRGlobalVar` represents a pointer to where the variable is stored,
             // so we need to create a field of the pointed-to type to represent it.
             //
-            createContextStructField(globalVar, globalVar->getDataType()->getValueType());
+            createContextStructField(m_contextStructType, globalVar, globalVar->getDataType()->getValueType());
+        }
+
+        // The `groupshared` variables get fields in the `GroupShared` type
+        // instead, and the `KernelContext` holds a pointer to the storage
+        // for the group, which is passed in to each entry point.
+        //
+        if( m_groupSharedVars.getCount() )
+        {
+            m_groupSharedStructType = builder.createStructType();
+            builder.addNameHintDecoration(m_groupSharedStructType, UnownedTerminatedStringSlice("GroupShared"));
+            m_groupSharedStructType->insertBefore(m_contextStructType);
+            m_groupSharedPtrType = builder.getPtrType(m_groupSharedStructType);
+
+            for( auto globalVar : m_groupSharedVars )
+            {
+                createContextStructField(m_groupSharedStructType, globalVar, globalVar->getDataType()->getValueType());
+            }
+
+            builder.setInsertBefore(m_contextStructType);
+            m_groupSharedFieldKey = builder.createStructKey();
+            builder.addNameHintDecoration(m_groupSharedFieldKey, UnownedTerminatedStringSlice("groupShared"));
+            builder.createStructField(m_contextStructType, m_groupSharedFieldKey, m_groupSharedPtrType);
         }
 
         // Once all the fields have been created, we can process the entry points.
@@ -212,6 +254,10 @@ struct IntroduceExplicitGlobalContextPass
         {
             replaceUsesOfGlobalVar(globalVar);
         }
+        for( auto globalVar : m_groupSharedVars )
+        {
+            replaceUsesOfGroupSharedVar(globalVar);
+        }
     }
 
     // As noted above, we will maintain mappings to record
@@ -222,19 +268,20 @@ struct IntroduceExplicitGlobalContextPass
     Dictionary<IRInst*, IRStructKey*> m_mapInstToContextFieldKey;
     Dictionary<IRFunc*, IRInst*> m_mapFuncToContextPtr;
 
-    void createContextStructField(IRInst* originalInst, IRType* type)
+    void createContextStructField(IRStructType* structType, IRInst* originalInst, IRType* type)
     {
-        // Creating a field in the context struct to represent
-        // `originalInst` is straightforward.
+        // Creating a field in the context struct (or the struct
+        // for `groupshared` variables) to represent `originalInst`
+        // is straightforward.
 
         IRBuilder builder(m_module);
-        builder.setInsertBefore(m_contextStructType);
+        builder.setInsertBefore(structType);
 
         // We create a "key" for the new field, and then a field
         // of the appropraite type.
         //
         auto key = builder.createStructKey();
-        auto field = builder.createStructField(m_contextStructType, key, type);
+        auto field = builder.createStructField(structType, key, type);
 
         // If the original instruction had a name hint on it,
         // then we transfer that name hint over to the key,
@@ -304,6 +351,20 @@ struct IntroduceExplicitGlobalContextPass
             placeholderParam->insertBefore(firstOrdinary);
         }
 
+        // A compute entry point with `groupshared` variables
+        // also takes a pointer to the `GroupShared` storage
+        // of its group.
+        //
+        IRParam* groupSharedParam = nullptr;
+        auto entryPointDecor = entryPointFunc->findDecoration<IREntryPointDecoration>();
+        if( m_groupSharedStructType && entryPointDecor->getProfile().getStage() == Stage::Compute )
+        {
+            groupSharedParam = builder.createParam(m_groupSharedPtrType);
+            builder.addNameHintDecoration(groupSharedParam, UnownedTerminatedStringSlice("groupShared"));
+            builder.addDecoration(groupSharedParam, kIROp_GroupSharedParamDecoration, m_groupSharedStructType);
+            groupSharedParam->insertBefore(firstOrdinary);
+        }
+
         // The `KernelContext` to use inside the entry point
         // will be a local variable declared in the first block.
         //
@@ -329,6 +390,16 @@ struct IntroduceExplicitGlobalContextPass
             builder.emitStore(fieldPtr, globalUniformsParam);
         }
 
+        // The pointer to the `groupshared` storage is
+        // stored in the context in the same way.
+        //
+        if( groupSharedParam )
+        {
+            auto fieldPtrType = builder.getPtrType(m_groupSharedPtrType);
+            auto fieldPtr = builder.emitFieldAddress(fieldPtrType, contextVarPtr, m_groupSharedFieldKey);
+            builder.emitStore(fieldPtr, groupSharedParam);
+        }
+
         // Note: at this point the `KernelContext` has additional
         // fields for global variables that do not seem to have
         // been initialized.
@@ -414,6 +485,39 @@ struct IntroduceExplicitGlobalContextPass
         }
     }
 
+    void replaceUsesOfGroupSharedVar(IRGlobalVar* globalVar)
+    {
+        IRBuilder builder(m_module);
+
+        // A `groupshared` variable was mapped to a field of
+        // the `GroupShared` struct, which is reached through
+        // a pointer in the context structure.
+        //
+        auto key = m_mapInstToContextFieldKey[globalVar];
+
+        auto ptrType = globalVar->getDataType();
+        auto groupSharedPtrPtrType = builder.getPtrType(m_groupSharedPtrType);
+
+        IRUse* nextUse = nullptr;
+        for( IRUse* use = globalVar->firstUse; use; use = nextUse )
+        {
+            nextUse = use->nextUse;
+
+            auto user = use->getUser();
+            auto contextParam = findOrCreateContextPtrForInst(user);
+            builder.setInsertBefore(user);
+
+            // The address of the variable is the address of
+            // its field in the storage of the group.
+            //
+            auto groupSharedPtr = builder.emitLoad(
+                m_groupSharedPtrType,
+                builder.emitFieldAddress(groupSharedPtrPtrType, contextParam, m_groupSharedFieldKey));
+            auto ptr = builder.emitFieldAddress(ptrType, groupSharedPtr, key);
+            use->set(ptr);
+        }
+    }
+
     IRInst* findOrCreateContextPtrForInst(IRInst* inst)
     {
         // When looking up the context pointer to use for
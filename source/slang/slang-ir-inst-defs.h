@@ -824,6 +824,16 @@ INST(HighLevelDeclDecoration,               highLevelDecl,          1, 0)
         /// Applie to an IR function and signals that inlining should not be performed unless unavoidable.
     INST(NoInlineDecoration, noInline, 0, 0)
 
+        /// Applied to a compute entry point for the CPU that has been split at its group barriers.
+        /// The entry point takes a `uint*` resume point and a pointer to the per-thread state as its last two
+        /// parameters, and returns early at each barrier until the resume point is set back to 0.
+    INST(SplitAtGroupBarriersDecoration, splitAtGroupBarriers, 0, 0)
+
+        /// Marks the parameter of a CPU compute entry point that points to the storage for the `groupshared`
+        /// variables of the group the thread belongs to. The operand is the type of that storage, as the
+        /// parameter itself becomes a raw pointer (see `convertEntryPointPtrParamsToRawPtrs`).
+    INST(GroupSharedParamDecoration, groupSharedParam, 1, 0)
+
         // Marks a type to be non copyable, causing SSA pass to skip turning variables of the the type into SSA values.
     INST(NonCopyableTypeDecoration, nonCopyable, 0, 0)
 
@@ -6,6 +6,7 @@
 #include "slang-ir-insts.h"
 #include "slang-mangle.h"
 #include "slang-ir-string-hash.h"
+#include "slang-ir-symbol-index.h"
 #include "slang-ir-autodiff.h"
 #include "slang-ir-specialize-target-switch.h"
 #include "slang-module-library.h"
@@ -24,12 +25,6 @@ EntryPointLayout* findEntryPointLayout(
     ProgramLayout*          programLayout,
     EntryPoint*             entryPoint);
 
-struct IRSpecSymbol : RefObject
-{
-    IRInst*                 irGlobalValue;
-    RefPtr<IRSpecSymbol>    nextWithSameName;
-};
-
 struct IRSpecEnv
 {
     IRSpecEnv*  parent = nullptr;
@@ -52,9 +47,25 @@ struct IRSharedSpecContext
 
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    // in the *original* modules.
+    //
+    // Symbols from the stdlib are held in `stdlibSymbols`, which is
+    // shared between all links, and `symbols` only holds the symbols
+    // of the other modules being linked. If a name is in both, `symbols`
+    // holds the complete list.
+    typedef IRSymbolIndex::SymbolDictionary SymbolDictionary;
     SymbolDictionary symbols;
+    IRSymbolIndex* stdlibSymbols = nullptr;
+
+        /// Find the first global value named `mangledName`, or nullptr if there are none
+    IRSpecSymbol* findSymbol(const UnownedStringSlice& mangledName)
+    {
+        if (auto symbol = symbols.tryGetValue(mangledName))
+        {
+            return *symbol;
+        }
+        return stdlibSymbols ? stdlibSymbols->findSymbol(mangledName) : nullptr;
+    }
 
     IRBuilder builderStorage;
 
@@ -70,7 +81,7 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    IRSpecSymbol* findSymbol(const UnownedStringSlice& mangledName) { return getShared()->findSymbol(mangledName); }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -892,12 +903,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = context->findSymbol(mangledName.getUnownedSlice());
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().tryGetValue(hashedName, sym))
+        sym = context->findSymbol(hashedName.getUnownedSlice());
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1264,9 +1276,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // with the same mangled name as `originalVal` and try
     // to pick the "best" one for our target.
 
-    auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().tryGetValue(mangledName, sym) )
+    IRSpecSymbol* sym = context->findSymbol(originalLinkage->getMangledName());
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1323,35 +1334,6 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
-{
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
-
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
-
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
-    {
-        sharedContext->symbols.add(mangledName, sym);
-    }
-}
-
 void insertGlobalValueSymbols(
     IRSharedSpecContext*    sharedContext,
     IRModule*               originalModule)
@@ -1361,7 +1343,7 @@ void insertGlobalValueSymbols(
 
     for(auto ii : originalModule->getGlobalInsts())
     {
-        insertGlobalValueSymbol(sharedContext, ii);
+        IRSymbolIndex::addGlobalValue(sharedContext->symbols, ii, sharedContext->stdlibSymbols);
     }
 }
 
@@ -1465,12 +1447,13 @@ LinkedIR linkIR(
     // up IR definitions by their mangled name.
     //
 
-    List<IRModule*> irModules;
+    // The symbols of the stdlib modules never change, so are indexed once
+    // per session, and the symbols of the other modules are layered on top.
+    //
+    IRSymbolIndex* stdlibSymbols = static_cast<Session*>(linkage->getGlobalSession())->getStdLibIRSymbolIndex();
+    sharedContext->stdlibSymbols = stdlibSymbols;
 
-    // Link stdlib modules.
-    auto& stdlibModules = static_cast<Session*>(linkage->getGlobalSession())->stdlibModules;
-    for (auto& m : stdlibModules)
-        irModules.add(m->getIRModule());
+    List<IRModule*> irModules;
 
     // Link modules in the program.
     program->enumerateIRModules([&](IRModule* irModule)
@@ -1504,6 +1487,10 @@ LinkedIR linkIR(
     // Combine all of the contents of IRGlobalHashedStringLiterals
     {
         StringSlicePool pool(StringSlicePool::Style::Empty);
+        for (const auto& slice : stdlibSymbols->getHashedStringLiterals())
+        {
+            pool.add(slice);
+        }
         for (IRModule* irModule : irModules)
         {
             findGlobalHashedStringLiterals(irModule, pool);
@@ -1565,7 +1552,13 @@ LinkedIR linkIR(
     // In the long run we do not want to *ever* iterate over all the
     // instructions in all the input modules.
     //
-    
+    // The instructions of the stdlib modules that are needed are found when
+    // the stdlib symbols are indexed, so only the other modules are scanned here.
+    //
+    for (auto bindInst : stdlibSymbols->getBindGlobalGenericParams())
+    {
+        cloneValue(context, bindInst);
+    }
     for (IRModule* irModule : irModules)
     {
         for (auto inst : irModule->getGlobalInsts())
@@ -1577,6 +1570,18 @@ LinkedIR linkIR(
         }
     }
 
+    auto cloneHLSLExported = [&](IRInst* inst)
+    {
+        auto cloned = cloneValue(context, inst);
+        if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
+        {
+            context->builder->addKeepAliveDecoration(cloned);
+        }
+    };
+    for (auto inst : stdlibSymbols->getHLSLExportedValues())
+    {
+        cloneHLSLExported(inst);
+    }
     for (IRModule* irModule : irModules)
     {
         for (auto inst : irModule->getGlobalInsts())
@@ -1584,11 +1589,7 @@ LinkedIR linkIR(
             // Is it (HLSL) `export` clone
             if (_isHLSLExported(inst))
             {
-                auto cloned = cloneValue(context, inst);
-                if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
-                {
-                    context->builder->addKeepAliveDecoration(cloned);
-                }
+                cloneHLSLExported(inst);
             }
         }
     }
@@ -1603,6 +1604,8 @@ LinkedIR linkIR(
     // `[assumedWaveSize(...)]` decoration might require that all specified
     // values match exactly).
     //
+    List<IRDecoration*> moduleDecorations;
+    moduleDecorations.addRange(stdlibSymbols->getModuleDecorations());
     for (IRModule* irModule : irModules)
     {
         for( auto decoration : irModule->getModuleInst()->getDecorations() )
@@ -1610,19 +1613,7 @@ LinkedIR linkIR(
             switch( decoration->getOp() )
             {
             case kIROp_NVAPISlotDecoration:
-                {
-                    // For now we just clone every decoration we see,
-                    // which means that an arbitrary one will end up
-                    // "winning" and being the one found by searches
-                    // in later code.
-                    //
-                    // TODO: need validation to check if decorations are
-                    // consistent with one another, in the case where
-                    // multiple input modules have matching decorations.
-                    //
-                    auto cloned = cloneInst(context, context->builder, decoration);
-                    cloned->insertAtStart(state->irModule->getModuleInst());
-                }
+                moduleDecorations.add(decoration);
                 break;
 
             default:
@@ -1630,6 +1621,20 @@ LinkedIR linkIR(
             }
         }
     }
+    for (auto decoration : moduleDecorations)
+    {
+        // For now we just clone every decoration we see,
+        // which means that an arbitrary one will end up
+        // "winning" and being the one found by searches
+        // in later code.
+        //
+        // TODO: need validation to check if decorations are
+        // consistent with one another, in the case where
+        // multiple input modules have matching decorations.
+        //
+        auto cloned = cloneInst(context, context->builder, decoration);
+        cloned->insertAtStart(state->irModule->getModuleInst());
+    }
 
     // Specialize target_switch branches to use the best branch for the target.
     specializeTargetSwitch(targetReq, state->irModule);
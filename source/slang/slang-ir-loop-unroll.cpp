@@ -32,6 +32,8 @@ static bool _eliminateDeadBlocks(List<IRBlock*>& blocks, IRBlock* unreachableBlo
             }
         }
     }
+    // Dead blocks can use each other's insts, so they are removed as a batch.
+    List<IRBlock*> deadBlocks;
     for (auto& b : blocks)
     {
         if (!aliveBlocks.contains(b))
@@ -40,11 +42,30 @@ static bool _eliminateDeadBlocks(List<IRBlock*>& blocks, IRBlock* unreachableBlo
             {
                 b->replaceUsesWith(unreachableBlock);
             }
-            b->removeAndDeallocate();
+            deadBlocks.add(b);
             b = nullptr;
             changed = true;
         }
     }
+    // Insts in dead blocks can still be used from other unreachable code, such as
+    // the args of the loop inst in `firstIterationBreakBlock`, which are replaced
+    // with `undefined` so nothing points at the deallocated insts.
+    IRInst* undefInst = nullptr;
+    for (auto b : deadBlocks)
+    {
+        for (auto inst : b->getChildren())
+        {
+            if (!inst->hasUses())
+                continue;
+            if (!undefInst)
+            {
+                auto module = b->getModule();
+                undefInst = getUndefInst(IRBuilder(module), module);
+            }
+            inst->replaceUsesWith(undefInst);
+        }
+    }
+    removeAndDeallocateInsts(deadBlocks);
     return changed;
 }
 
@@ -391,12 +412,15 @@ static bool _unrollLoop(
             }
 
             // Now we can safely delete the original loop blocks.
+            // The loop inst in `firstIterationBreakBlock` can still use their insts,
+            // so its children are cleared first, as they are deleted below.
 
+            firstIterationBreakBlock->removeArgumentsOfDecorationsAndChildren();
             for (auto block : blocks)
             {
                 block->replaceUsesWith(unreachableBlock);
-                block->removeAndDeallocate();
             }
+            removeAndDeallocateInsts(blocks);
 
             // firstIterationBreakBlock is no longer reachable, so we can delete its children
             // and turn it into an unreachable block.
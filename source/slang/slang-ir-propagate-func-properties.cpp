@@ -139,7 +139,7 @@ public:
     }
 };
 
-bool propagateFuncPropertiesImpl(IRModule* module, FuncPropertyPropagationContext* context)
+bool propagateFuncPropertiesImpl(IRModule* module, FuncPropertyPropagationContext* context, List<IRFunc*>* outChangedFuncs)
 {
     bool result = false;
     List<IRFunc*> workList;
@@ -230,6 +230,8 @@ bool propagateFuncPropertiesImpl(IRModule* module, FuncPropertyPropagationContex
             {
                 addCallersToWorkList(f);
                 changed = true;
+                if (outChangedFuncs)
+                    outChangedFuncs->add(f);
             }
         }
         result |= changed;
@@ -331,13 +333,13 @@ public:
     }
 };
 
-bool propagateFuncProperties(IRModule* module)
+bool propagateFuncProperties(IRModule* module, List<IRFunc*>* outChangedFuncs)
 {
     ReadNoneFuncPropertyPropagationContext readNoneContext;
-    bool changed = propagateFuncPropertiesImpl(module, &readNoneContext);
+    bool changed = propagateFuncPropertiesImpl(module, &readNoneContext, outChangedFuncs);
 
     NoSideEffectFuncPropertyPropagationContext noSideEffectContext;
-    changed|= propagateFuncPropertiesImpl(module, &noSideEffectContext);
+    changed|= propagateFuncPropertiesImpl(module, &noSideEffectContext, outChangedFuncs);
 
     return changed;
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "../core/slang-list.h"
+
 namespace Slang
 {
 struct IRModule;
-bool propagateFuncProperties(IRModule* module);
+struct IRFunc;
+
+    /// Propagate side effect properties (such as `[ReadNone]`) from callees to callers.
+    /// If `outChangedFuncs` is set, every function that gained a property is added to it.
+bool propagateFuncProperties(IRModule* module, List<IRFunc*>* outChangedFuncs = nullptr);
 }
@@ -1646,6 +1646,14 @@ struct SCCPContext
         // by removing the instructions from the bodies of our unreachable
         // blocks to eliminate any cross-references between them.
         //
+        // The instructions in one unreachable block can also use those in
+        // another, so their operands are all cleared before any of them
+        // is deallocated.
+        //
+        for( auto block : unreachableBlocks )
+        {
+            block->removeArgumentsOfDecorationsAndChildren();
+        }
         for( auto block : unreachableBlocks )
         {
             // TODO: In principle we could produce a diagnostic here
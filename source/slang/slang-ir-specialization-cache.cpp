@@ -0,0 +1,492 @@
+// slang-ir-specialization-cache.cpp
+#include "slang-ir-specialization-cache.h"
+
+#include "slang-compiler.h"
+#include "slang-ir.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+
+#include <string.h>
+
+namespace Slang
+{
+
+static bool _isDescendantOf(IRInst* inst, IRInst* ancestor)
+{
+    for (IRInst* cur = inst; cur; cur = cur->getParent())
+    {
+        if (cur == ancestor)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+    // Types and other hoistable values are identified by their structure, which is only complete
+    // if they have no decorations or children.
+static bool _isStructuralValue(IRInst* inst)
+{
+    return getIROpInfo(inst->getOp()).isHoistable() && inst->getFirstDecorationOrChild() == nullptr;
+}
+
+static bool _appendValueKey(IRInst* inst, const IRSpecializationCache::SymbolMap& symbols, StringBuilder& ioKey)
+{
+    if (!inst)
+    {
+        ioKey << "_";
+        return true;
+    }
+
+    if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+    {
+        const UnownedStringSlice mangledName = linkage->getMangledName();
+        if (symbols.find(mangledName) != inst)
+        {
+            return false;
+        }
+        ioKey << "L" << Int64(mangledName.getLength()) << ":" << mangledName;
+        return true;
+    }
+
+    if (auto constant = as<IRConstant>(inst))
+    {
+        ioKey << "C" << Int32(inst->getOp()) << "(";
+        if (!_appendValueKey(inst->getFullType(), symbols, ioKey))
+        {
+            return false;
+        }
+        ioKey << ")";
+
+        switch (inst->getOp())
+        {
+            case kIROp_BoolLit:
+            case kIROp_IntLit:
+            {
+                ioKey << Int64(constant->value.intVal);
+                return true;
+            }
+            case kIROp_FloatLit:
+            {
+                // Use the bits, so the key is exact
+                uint64_t bits;
+                ::memcpy(&bits, &constant->value.floatVal, sizeof(bits));
+                ioKey << UInt64(bits);
+                return true;
+            }
+            case kIROp_StringLit:
+            {
+                const UnownedStringSlice slice = constant->getStringSlice();
+                ioKey << Int64(slice.getLength()) << ":" << slice;
+                return true;
+            }
+            case kIROp_PtrLit:
+            {
+                return constant->value.ptrVal == nullptr;
+            }
+            case kIROp_VoidLit:
+            {
+                return true;
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!_isStructuralValue(inst))
+    {
+        return false;
+    }
+
+    ioKey << "H" << Int32(inst->getOp()) << "(";
+    if (!_appendValueKey(inst->getFullType(), symbols, ioKey))
+    {
+        return false;
+    }
+
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        ioKey << ",";
+        if (!_appendValueKey(inst->getOperand(i), symbols, ioKey))
+        {
+            return false;
+        }
+    }
+    ioKey << ")";
+    return true;
+}
+
+namespace { // anonymous
+
+/* Clones the values a function uses from outside of itself, between a module being specialized and the cache module.
+
+Global values with linkage are mapped by mangled name. In the cache module they are represented by placeholders,
+because the cache only needs their names. Constants and other hoistable values are rebuilt from their (mapped)
+operands, so they are deduplicated in the destination module. */
+struct ExternalValueCloner
+{
+    bool cloneExternalValues(IRInst* root, IRInst* inst)
+    {
+        if (!_cloneIfExternal(root, inst->getFullType()))
+        {
+            return false;
+        }
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (!_cloneIfExternal(root, inst->getOperand(i)))
+            {
+                return false;
+            }
+        }
+
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (!cloneExternalValues(root, child))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ExternalValueCloner(IRCloneEnv* env, IRBuilder* builder, const IRSpecializationCache::SymbolMap* symbols) :
+        m_env(env),
+        m_builder(builder),
+        m_symbols(symbols)
+    {
+    }
+
+        // Set when cloning into the cache module
+    Dictionary<String, IRInst*>* m_placeholders = nullptr;
+
+protected:
+    bool _cloneIfExternal(IRInst* root, IRInst* value)
+    {
+        if (!value || _isDescendantOf(value, root))
+        {
+            return true;
+        }
+        IRInst* clonedValue;
+        return _clone(value, clonedValue);
+    }
+
+    bool _clone(IRInst* value, IRInst*& outClonedValue)
+    {
+        if (!value)
+        {
+            outClonedValue = nullptr;
+            return true;
+        }
+        if (auto clonedValuePtr = m_env->mapOldValToNew.tryGetValue(value))
+        {
+            outClonedValue = *clonedValuePtr;
+            return true;
+        }
+
+        if (!_cloneImpl(value, outClonedValue))
+        {
+            return false;
+        }
+        m_env->mapOldValToNew.add(value, outClonedValue);
+        return true;
+    }
+
+    bool _cloneSymbol(IRInst* value, const UnownedStringSlice& mangledName, IRInst*& outClonedValue)
+    {
+        if (!m_placeholders)
+        {
+            // Into a module being specialized
+            outClonedValue = m_symbols->find(mangledName);
+            return outClonedValue != nullptr;
+        }
+
+        // Into the cache. The name must identify the value in the module being specialized.
+        if (m_symbols->find(mangledName) != value)
+        {
+            return false;
+        }
+
+        const String name(mangledName);
+        if (auto placeholderPtr = m_placeholders->tryGetValue(name))
+        {
+            outClonedValue = *placeholderPtr;
+            return true;
+        }
+
+        IRInst* placeholder = m_builder->createStructKey();
+        m_builder->addImportDecoration(placeholder, mangledName);
+        m_placeholders->add(name, placeholder);
+
+        outClonedValue = placeholder;
+        return true;
+    }
+
+    bool _cloneConstant(IRConstant* constant, IRInst*& outClonedValue)
+    {
+        IRInst* type;
+        if (!_clone(constant->getFullType(), type))
+        {
+            return false;
+        }
+
+        switch (constant->getOp())
+        {
+            case kIROp_BoolLit:     outClonedValue = m_builder->getBoolValue(constant->value.intVal != 0); break;
+            case kIROp_IntLit:      outClonedValue = m_builder->getIntValue((IRType*)type, constant->value.intVal); break;
+            case kIROp_FloatLit:    outClonedValue = m_builder->getFloatValue((IRType*)type, constant->value.floatVal); break;
+            case kIROp_StringLit:   outClonedValue = m_builder->getStringValue(constant->getStringSlice()); break;
+            case kIROp_VoidLit:     outClonedValue = m_builder->getVoidValue(); break;
+            case kIROp_PtrLit:
+            {
+                if (constant->value.ptrVal)
+                {
+                    return false;
+                }
+                outClonedValue = m_builder->getNullPtrValue((IRType*)type);
+                break;
+            }
+            default: return false;
+        }
+        return true;
+    }
+
+    bool _cloneImpl(IRInst* value, IRInst*& outClonedValue)
+    {
+        if (auto linkage = value->findDecoration<IRLinkageDecoration>())
+        {
+            return _cloneSymbol(value, linkage->getMangledName(), outClonedValue);
+        }
+
+        if (auto constant = as<IRConstant>(value))
+        {
+            return _cloneConstant(constant, outClonedValue);
+        }
+
+        // Anything else from outside the function (such as a function created by specialization) can't be
+        // identified in another module.
+        if (!_isStructuralValue(value))
+        {
+            return false;
+        }
+
+        IRInst* type;
+        if (!_clone(value->getFullType(), type))
+        {
+            return false;
+        }
+
+        const UInt operandCount = value->getOperandCount();
+        ShortList<IRInst*> operands;
+        operands.setCount(operandCount);
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (!_clone(value->getOperand(i), operands[i]))
+            {
+                return false;
+            }
+        }
+
+        // Hoistable instructions are deduplicated, so this finds the existing value if there is one
+        outClonedValue = m_builder->emitIntrinsicInst((IRType*)type, value->getOp(), operandCount, operands.getArrayView().getBuffer());
+        return true;
+    }
+
+    IRCloneEnv* m_env;
+    IRBuilder* m_builder;
+    const IRSpecializationCache::SymbolMap* m_symbols;
+};
+
+} // anonymous
+
+void IRSpecializationCacheSymbols::build(IRModule* module)
+{
+    m_names.clear();
+    m_values.clear();
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto linkage = inst->findDecoration<IRLinkageDecoration>();
+        if (!linkage)
+        {
+            continue;
+        }
+
+        StringSlicePool::Handle handle;
+        if (m_names.findOrAdd(linkage->getMangledName(), handle))
+        {
+            m_values[StringSlicePool::asIndex(handle)] = nullptr;
+        }
+        else
+        {
+            m_values.add(inst);
+        }
+    }
+    m_isBuilt = true;
+}
+
+IRInst* IRSpecializationCacheSymbols::find(const UnownedStringSlice& mangledName) const
+{
+    const Index index = m_names.findIndex(mangledName);
+    if (index < 0)
+    {
+        return nullptr;
+    }
+    // Values removed by the current pass are still readable, as their memory isn't reclaimed until after it
+    IRInst* value = m_values[index];
+    return (value && value->getParent()) ? value : nullptr;
+}
+
+void IRSpecializationCacheSymbols::removeDeallocated()
+{
+    for (auto& value : m_values)
+    {
+        if (value && !value->getParent())
+        {
+            value = nullptr;
+        }
+    }
+}
+
+void IRSpecializationCacheSymbols::remap(const Dictionary<IRInst*, IRInst*>& mapping)
+{
+    for (auto& value : m_values)
+    {
+        if (value)
+        {
+            auto copyPtr = mapping.tryGetValue(value);
+            value = copyPtr ? *copyPtr : nullptr;
+        }
+    }
+}
+
+IRSpecializationCache::IRSpecializationCache(Session* session)
+{
+    m_module = IRModule::create(session);
+}
+
+IRSpecializationCache::~IRSpecializationCache()
+{
+}
+
+/* static */void IRSpecializationCache::appendTargetKey(TargetRequest* targetReq, StringBuilder& ioKey)
+{
+    auto linkage = targetReq->getLinkage();
+
+    ioKey << Int32(targetReq->getTarget()) << ","
+        << UInt32(targetReq->getTargetFlags()) << ","
+        << Int32(targetReq->getTargetProfile().raw) << ","
+        << Int32(targetReq->getFloatingPointMode()) << ","
+        << Int32(targetReq->getDefaultMatrixLayoutMode()) << ","
+        << Int32(linkage->optimizationLevel) << ","
+        << Int32(linkage->debugInfoLevel);
+
+    // Linking chooses between definitions of a function for different targets by capability
+    List<List<CapabilityAtom>> conjunctions;
+    targetReq->getTargetCaps().calcCompactedAtoms(conjunctions);
+    for (const auto& atoms : conjunctions)
+    {
+        ioKey << "|";
+        for (auto atom : atoms)
+        {
+            ioKey << Int32(atom) << ",";
+        }
+    }
+    ioKey << ";";
+}
+
+/* static */bool IRSpecializationCache::appendSpecializationKey(IRSpecialize* specializeInst, const SymbolMap& symbols, StringBuilder& ioKey)
+{
+    auto base = specializeInst->getBase();
+    if (!_appendValueKey(base, symbols, ioKey))
+    {
+        return false;
+    }
+
+    // Modules loaded from source more than once (with the same name) can have different generics with
+    // the same mangled name. Their source locations are different.
+    ioKey << "@" << UInt64(base->sourceLoc.getRaw());
+
+    const UInt argCount = specializeInst->getArgCount();
+    for (UInt i = 0; i < argCount; ++i)
+    {
+        ioKey << ";";
+        if (!_appendValueKey(specializeInst->getArg(i), symbols, ioKey))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+IRFunc* IRSpecializationCache::findAndClone(const String& key, const SymbolMap& symbols, IRBuilder* builder)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    IRFunc* cachedFunc = nullptr;
+    if (!m_funcs.tryGetValue(key, cachedFunc) || !cachedFunc)
+    {
+        m_missCount++;
+        return nullptr;
+    }
+
+    IRCloneEnv env;
+    ExternalValueCloner cloner(&env, builder, &symbols);
+    if (!cloner.cloneExternalValues(cachedFunc, cachedFunc))
+    {
+        // Something the function uses isn't in this module
+        m_missCount++;
+        return nullptr;
+    }
+
+    m_hitCount++;
+    return cast<IRFunc>(cloneInst(&env, builder, cachedFunc));
+}
+
+Count IRSpecializationCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hitCount;
+}
+
+Count IRSpecializationCache::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_missCount;
+}
+
+void IRSpecializationCache::append(StringBuilder& out) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out << "IR specialization cache hits: " << m_hitCount << "\n";
+    out << "IR specialization cache misses: " << m_missCount << "\n";
+}
+
+void IRSpecializationCache::add(const String& key, IRFunc* func, const SymbolMap& symbols)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_funcs.containsKey(key))
+    {
+        return;
+    }
+
+    IRBuilder builder(m_module);
+    builder.setInsertInto(m_module->getModuleInst());
+
+    IRCloneEnv env;
+    ExternalValueCloner cloner(&env, &builder, &symbols);
+    cloner.m_placeholders = &m_placeholders;
+
+    IRFunc* cachedFunc = nullptr;
+    if (cloner.cloneExternalValues(func, func))
+    {
+        cachedFunc = cast<IRFunc>(cloneInst(&env, &builder, func));
+    }
+    m_funcs.add(key, cachedFunc);
+}
+
+} // namespace Slang
@@ -0,0 +1,112 @@
+// slang-ir-specialization-cache.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-string-slice-pool.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+struct IRBuilder;
+struct IRFunc;
+struct IRInst;
+struct IRModule;
+struct IRSpecialize;
+class Session;
+class TargetRequest;
+
+    /// The global values with linkage in the module of a link, by mangled name, which is how values are
+    /// identified in the `IRSpecializationCache`. A name held by more than one value identifies nothing.
+    ///
+    /// It is built by the first `specializeModule` of a link, and kept up to date between passes with
+    /// `removeDeallocated` and `remap`, rather than built again by every `specializeModule`.
+class IRSpecializationCacheSymbols
+{
+public:
+        /// Build the map of the global values with linkage in `module`
+    void build(IRModule* module);
+        /// True once `build` has been called
+    bool isBuilt() const { return m_isBuilt; }
+
+        /// Find the value named `mangledName`. Returns nullptr if the name doesn't identify a value,
+        /// or the value has since been removed from the module.
+    IRInst* find(const UnownedStringSlice& mangledName) const;
+
+        /// Forget values that have been removed from the module. Must be called before the module
+        /// reclaims the memory of deallocated instructions.
+    void removeDeallocated();
+        /// Replace each value with its copy in `mapping`, after the module has been copied (such as
+        /// by `compactIRModule`). Values without a copy are forgotten.
+    void remap(const Dictionary<IRInst*, IRInst*>& mapping);
+
+    IRSpecializationCacheSymbols()
+        : m_names(StringSlicePool::Style::Empty)
+    {
+    }
+
+protected:
+    // Indexed by the handle of the name
+    StringSlicePool m_names;
+    List<IRInst*> m_values;
+    bool m_isBuilt = false;
+};
+
+    /// A cache of specialized generic functions, shared by every link of a Linkage.
+    ///
+    /// Each link clones the generics it uses into a new module, and specializes and simplifies them again.
+    /// When many entry points use the same generics (such as stdlib texture and vector math functions),
+    /// most of that work is repeated. The cache holds a copy of each specialized function, after the
+    /// simplification done by `specializeModule`, so later links can clone it instead.
+    ///
+    /// Values in a module being specialized are identified by the mangled names of global values with
+    /// linkage, and by the structure of types and constants. A specialization is only cached if
+    /// everything it (and its key) references can be identified this way.
+class IRSpecializationCache : public RefObject
+{
+public:
+    typedef IRSpecializationCacheSymbols SymbolMap;
+
+        /// Append the options of `targetReq` that can change how the IR of generics is specialized
+    static void appendTargetKey(TargetRequest* targetReq, StringBuilder& ioKey);
+
+        /// Append the key for `specializeInst` to `ioKey`, which should start with the target key.
+        /// Returns false if the specialization can't be cached.
+    static bool appendSpecializationKey(IRSpecialize* specializeInst, const SymbolMap& symbols, StringBuilder& ioKey);
+
+        /// Clone the function cached for `key` into the module of `builder`, at its insert location.
+        /// Returns nullptr if there isn't one, or it can't be used in that module.
+    IRFunc* findAndClone(const String& key, const SymbolMap& symbols, IRBuilder* builder);
+
+        /// Add a copy of `func` as the specialization for `key`, if `key` hasn't been added before.
+        /// If `func` can't be copied, the key is remembered so the copy isn't attempted again.
+    void add(const String& key, IRFunc* func, const SymbolMap& symbols);
+
+        /// The number of lookups that found a usable specialization, and that didn't
+    Count getHitCount() const;
+    Count getMissCount() const;
+
+        /// Append the hit and miss counts, for `-report-perf-benchmark`
+    void append(StringBuilder& out) const;
+
+    IRSpecializationCache(Session* session);
+    ~IRSpecializationCache();
+
+protected:
+    // Links for different targets and entry points can run at the same time, so everything below is
+    // guarded by the mutex
+    mutable std::mutex m_mutex;
+
+    // Holds the cached functions, and a placeholder (an import declaration) for each mangled name they reference
+    RefPtr<IRModule> m_module;
+    Dictionary<String, IRInst*> m_placeholders;
+
+    // The function cached for a key, or nullptr if the specialization couldn't be cached
+    Dictionary<String, IRFunc*> m_funcs;
+
+    Count m_hitCount = 0;
+    Count m_missCount = 0;
+};
+
+} // namespace Slang
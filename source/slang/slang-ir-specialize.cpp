@@ -7,6 +7,8 @@
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-lower-witness-lookup.h"
 #include "slang-ir-dce.h"
+#include "slang-ir-specialization-cache.h"
+#include "slang-compiler.h"
 #include "../core/slang-performance-profiler.h"
 
 namespace Slang
@@ -198,6 +200,47 @@ struct SpecializationContext
     typedef IRSimpleSpecializationKey Key;
     Dictionary<Key, IRInst*> genericSpecializations;
 
+    // Specialized functions are also shared between the links of
+    // a linkage, which would otherwise each specialize and simplify
+    // the same generics again. The cache identifies values by mangled
+    // name, so we use the link's map of the global values with linkage
+    // in this module, and the part of the key that comes from the target.
+    //
+    IRSpecializationCache* specializationCache = nullptr;
+    IRSpecializationCacheSymbols* specializationCacheSymbols = nullptr;
+    StringBuilder specializationCacheTargetKey;
+
+    void initSpecializationCache()
+    {
+        if (!targetRequest || !specializationCacheSymbols)
+            return;
+
+        specializationCache = targetRequest->getLinkage()->getIRSpecializationCache();
+        if (!specializationCacheSymbols->isBuilt())
+            specializationCacheSymbols->build(module);
+        IRSpecializationCache::appendTargetKey(targetRequest, specializationCacheTargetKey);
+    }
+
+    // Only specializations of generic functions are cached, and
+    // only if nothing has been added to the `specialize` instruction
+    // in this module.
+    //
+    bool calcSpecializationCacheKey(
+        IRGeneric* genericVal,
+        IRSpecialize* specializeInst,
+        StringBuilder& outKey)
+    {
+        if (!specializationCache ||
+            specializeInst->getFirstDecoration() ||
+            !as<IRFunc>(findGenericReturnVal(genericVal)))
+        {
+            return false;
+        }
+
+        outKey << specializationCacheTargetKey;
+        return IRSpecializationCache::appendSpecializationKey(specializeInst, *specializationCacheSymbols, outKey);
+    }
+
 
     // Now let's look at the task of finding or generation a
     // specialization of some generic `g`, given a specialization
@@ -249,7 +292,31 @@ struct SpecializationContext
         // can be re-used in other cases that need to
         // do one-off specialization.
         //
-        IRInst* specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+        // Before doing that work, we check whether another link has
+        // already produced this specialization.
+        //
+        StringBuilder cacheKey;
+        const bool isCacheable = calcSpecializationCacheKey(genericVal, specializeInst, cacheKey);
+
+        IRInst* specializedVal = nullptr;
+        if (isCacheable)
+        {
+            IRBuilder builder(module);
+            builder.setInsertBefore(genericVal);
+            specializedVal = specializationCache->findAndClone(cacheKey, *specializationCacheSymbols, &builder);
+            if (specializedVal)
+                addToWorkList(specializedVal);
+        }
+        if (!specializedVal)
+        {
+            specializedVal = specializeGenericImpl(genericVal, specializeInst, module, this);
+
+            if (isCacheable)
+            {
+                if (auto func = as<IRFunc>(specializedVal))
+                    specializationCache->add(cacheKey, func, *specializationCacheSymbols);
+            }
+        }
 
         // The body of the specialized generic may expose more specialization opportunities, so
         // we add the children to workList.
@@ -736,6 +803,8 @@ struct SpecializationContext
         // when this pass is invoked iteratively.
         readSpecializationDictionaries();
 
+        initSpecializationCache();
+
         // The unspecialized IR we receive as input will have
         // `IRBindGlobalGenericParam` instructions that associate
         // each global-scope generic parameter (a type, witness
@@ -2234,11 +2303,13 @@ struct SpecializationContext
 bool specializeModule(
     TargetRequest* target,
     IRModule* module,
-    DiagnosticSink* sink)
+    DiagnosticSink* sink,
+    IRSpecializationCacheSymbols* cacheSymbols)
 {
     SLANG_PROFILE;
     SpecializationContext context(module, target);
     context.sink = sink;
+    context.specializationCacheSymbols = cacheSymbols;
     context.processModule();
     return context.changed;
 }
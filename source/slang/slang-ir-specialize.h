@@ -5,13 +5,18 @@ namespace Slang
 {
 struct IRModule;
 class DiagnosticSink;
+class IRSpecializationCacheSymbols;
 class TargetRequest;
 
     /// Specialize generic and interface-based code to use concrete types.
+    ///
+    /// If `cacheSymbols` is set, specialized functions are shared with other links through the linkage's
+    /// `IRSpecializationCache`. It should be the same for every call in a link, and is built by the first.
 bool specializeModule(
     TargetRequest* target,
     IRModule*   module,
-    DiagnosticSink* sink);
+    DiagnosticSink* sink,
+    IRSpecializationCacheSymbols* cacheSymbols = nullptr);
 
 void finalizeSpecialization(IRModule* module);
 
@@ -0,0 +1,566 @@
+// slang-ir-split-group-barriers.cpp
+#include "slang-ir-split-group-barriers.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-inline.h"
+#include "slang-ir-util.h"
+
+namespace Slang
+{
+
+// On the CPU target all of the threads of a group are run by a single host thread, one after
+// another. A group barrier requires every thread of the group to reach the barrier before any of
+// them continue, which can't be done by running each thread to completion.
+//
+// Instead a compute entry point that reaches a barrier is made *resumable*. It gets two extra
+// parameters: a pointer to the resume point of the thread, and a pointer to a `struct` holding the
+// state of the thread that has to survive a barrier. At a barrier the entry point stores where to
+// resume and returns, and when it is called again it continues from there. When the entry point
+// finally returns the resume point is set back to 0.
+//
+// The code emitted for a group (see `CPPSourceEmitter::_emitEntryPointGroup`) calls each thread in
+// turn, until none of them is waiting at a barrier.
+//
+// The state of a thread that is kept is
+//
+// * Any local variable that can be read after a barrier before it is written, or whose address is
+//   used in ways that aren't followed here.
+// * Any other value that is defined before a barrier and used after it. Such a use is no longer
+//   dominated by the definition once the entry point can be entered at a resume point.
+
+static bool _isGroupBarrier(IRInst* inst)
+{
+    if (inst->getOp() == kIROp_GroupMemoryBarrierWithGroupSync)
+        return true;
+
+    auto call = as<IRCall>(inst);
+    if (!call)
+        return false;
+
+    const auto name = getBuiltinFuncName(call->getCallee());
+    return name == toSlice("GroupMemoryBarrierWithGroupSync") ||
+        name == toSlice("AllMemoryBarrierWithGroupSync") ||
+        name == toSlice("DeviceMemoryBarrierWithGroupSync");
+}
+
+static bool _isComputeEntryPoint(IRFunc* func)
+{
+    auto entryPointDecor = func->findDecoration<IREntryPointDecoration>();
+    return entryPointDecor &&
+        entryPointDecor->getProfile().getStage() == Stage::Compute &&
+        func->getFirstBlock() != nullptr;
+}
+
+    /// True if `func` has a barrier, or a call to one of `barrierFuncs`
+static bool _hasGroupBarrier(IRFunc* func, const HashSet<IRFunc*>& barrierFuncs)
+{
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (_isGroupBarrier(inst))
+                return true;
+
+            auto call = as<IRCall>(inst);
+            auto callee = call ? as<IRFunc>(call->getCallee()) : nullptr;
+            if (callee && barrierFuncs.contains(callee))
+                return true;
+        }
+    }
+    return false;
+}
+
+void inlineGroupBarrierCallsForCPU(IRModule* module)
+{
+    // Find all of the functions that reach a barrier, directly or through the functions they call
+    HashSet<IRFunc*> barrierFuncs;
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(globalInst);
+            if (func && !barrierFuncs.contains(func) && _hasGroupBarrier(func, barrierFuncs))
+            {
+                barrierFuncs.add(func);
+                changed = true;
+            }
+        }
+    }
+
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !barrierFuncs.contains(func) || !_isComputeEntryPoint(func))
+            continue;
+
+        // Inlined code can contain more calls to inline, so keep going until there are none
+        List<IRCall*> calls;
+        for (;;)
+        {
+            calls.clear();
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                {
+                    auto call = as<IRCall>(inst);
+                    auto callee = call ? as<IRFunc>(call->getCallee()) : nullptr;
+                    if (callee && barrierFuncs.contains(callee))
+                        calls.add(call);
+                }
+            }
+
+            bool inlined = false;
+            for (auto call : calls)
+            {
+                inlined |= inlineCall(call);
+            }
+            if (!inlined)
+                break;
+        }
+    }
+}
+
+struct SplitGroupBarriersContext
+{
+    IRModule* m_module = nullptr;
+    DiagnosticSink* m_sink = nullptr;
+
+    IRFunc* m_func = nullptr;
+
+        /// The blocks that end at a barrier, and the blocks that follow them.
+        /// The resume point of `m_resumeBlocks[i]` is `i + 1`.
+    List<IRBlock*> m_barrierBlocks;
+    List<IRBlock*> m_resumeBlocks;
+    HashSet<IRBlock*> m_barrierBlockSet;
+
+        /// Variables that have to be kept in the thread state
+    HashSet<IRInst*> m_threadStateVars;
+
+    IRStructType* m_threadStateType = nullptr;
+    IRParam* m_resumePointParam = nullptr;
+    IRParam* m_threadStateParam = nullptr;
+
+    void processFunc(IRFunc* func)
+    {
+        m_func = func;
+
+        _splitBlocksAtBarriers();
+        if (m_resumeBlocks.getCount() == 0)
+            return;
+
+        if (!_isSupported())
+        {
+            // The threads of a group can't wait for each other at the barriers, so the code can't be run correctly
+            auto entryPointDecor = func->findDecoration<IREntryPointDecoration>();
+            m_sink->diagnose(func->sourceLoc, Diagnostics::groupBarrierNotSplitForCPU, entryPointDecor->getName()->getStringSlice());
+            return;
+        }
+
+        _findThreadStateVars();
+        auto dispatchBlock = _addResumePoints();
+        _addThreadState(dispatchBlock);
+
+        IRBuilder builder(m_module);
+        builder.addSimpleDecoration<IRSplitAtGroupBarriersDecoration>(func);
+        fixUpFuncType(func);
+    }
+
+        /// Split each block with a barrier, such that the barrier is the last instruction before
+        /// an unconditional branch to the rest of the block.
+    void _splitBlocksAtBarriers()
+    {
+        IRBuilder builder(m_module);
+
+        List<IRBlock*> blocks;
+        for (auto block : m_func->getBlocks())
+        {
+            blocks.add(block);
+        }
+
+        // A block that is split off is processed in turn, as it can hold more barriers
+        for (Index i = 0; i < blocks.getCount(); ++i)
+        {
+            auto block = blocks[i];
+            for (auto inst : block->getChildren())
+            {
+                if (!_isGroupBarrier(inst))
+                    continue;
+
+                auto resumeBlock = builder.createBlock();
+                resumeBlock->insertAfter(block);
+                while (auto next = inst->getNextInst())
+                {
+                    next->insertAtEnd(resumeBlock);
+                }
+
+                builder.setInsertInto(block);
+                builder.emitBranch(resumeBlock);
+
+                m_barrierBlocks.add(block);
+                m_barrierBlockSet.add(block);
+                m_resumeBlocks.add(resumeBlock);
+                blocks.add(resumeBlock);
+                break;
+            }
+        }
+    }
+
+        /// True if a path from one of `starts` reaches `target` without passing through `avoid`.
+        /// Threads leave a phase at a barrier, so the edges from barrier blocks are not followed.
+    bool _canReach(const List<IRBlock*>& starts, IRBlock* target, IRBlock* avoid)
+    {
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> workList;
+        for (auto start : starts)
+        {
+            if (start != avoid && visited.add(start))
+                workList.add(start);
+        }
+        while (workList.getCount())
+        {
+            auto block = workList.getLast();
+            workList.removeLast();
+            if (block == target)
+                return true;
+            if (m_barrierBlockSet.contains(block))
+                continue;
+            for (auto succ : block->getSuccessors())
+            {
+                if (succ != avoid && visited.add(succ))
+                    workList.add(succ);
+            }
+        }
+        return false;
+    }
+
+        /// Resuming jumps into the middle of the function. That is only possible if the C-like emitter can
+        /// still structure the code, which isn't the case if a phase can enter a loop other than through
+        /// its start and then go around it. Code that runs until the end of a loop body and then
+        /// leaves it is fine (the emitter duplicates it).
+    bool _isSupported()
+    {
+        List<IRLoop*> loops;
+        for (auto block : m_func->getBlocks())
+        {
+            if (auto loop = as<IRLoop>(block->getTerminator()))
+                loops.add(loop);
+        }
+
+        for (auto resumeBlock : m_resumeBlocks)
+        {
+            for (auto loop : loops)
+            {
+                auto loopBlock = as<IRBlock>(loop->getParent());
+                auto header = loop->getTargetBlock();
+
+                List<IRBlock*> headerSuccs;
+                for (auto succ : header->getSuccessors())
+                {
+                    headerSuccs.add(succ);
+                }
+
+                if (_canReach(List<IRBlock*>::makeRepeated(resumeBlock, 1), header, loopBlock) &&
+                    _canReach(headerSuccs, header, loopBlock))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    enum class Access
+    {
+        None,
+        Read,
+        Write,
+    };
+
+        /// Collect the accesses to the variable `var` through `address`.
+        /// Returns false if the address is used in some other way.
+    bool _collectAccesses(IRInst* var, IRInst* address, Dictionary<IRInst*, Access>& ioAccesses)
+    {
+        for (auto use = address->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+            case kIROp_Load:
+            case kIROp_Call:
+                ioAccesses[user] = Access::Read;
+                break;
+            case kIROp_Store:
+            {
+                if (use != &cast<IRStore>(user)->ptr)
+                    return false;
+                // Writing part of the variable doesn't end its previous value
+                if (address == var)
+                    ioAccesses[user] = Access::Write;
+                break;
+            }
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+                if (!_collectAccesses(var, user, ioAccesses))
+                    return false;
+                break;
+            case kIROp_LiveRangeStart:
+            case kIROp_LiveRangeEnd:
+                break;
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+        /// True if the value of `var` can be read after a barrier, before it is written
+    bool _isLiveAfterBarrier(IRVar* var)
+    {
+        Dictionary<IRInst*, Access> accesses;
+        if (!_collectAccesses(var, var, accesses))
+            return true;
+
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> workList;
+        for (auto resumeBlock : m_resumeBlocks)
+        {
+            if (visited.add(resumeBlock))
+                workList.add(resumeBlock);
+        }
+        while (workList.getCount())
+        {
+            auto block = workList.getLast();
+            workList.removeLast();
+
+            Access firstAccess = Access::None;
+            for (auto inst : block->getChildren())
+            {
+                if (auto access = accesses.tryGetValue(inst))
+                {
+                    firstAccess = *access;
+                    break;
+                }
+            }
+
+            if (firstAccess == Access::Read)
+                return true;
+            if (firstAccess == Access::Write)
+                continue;
+
+            for (auto succ : block->getSuccessors())
+            {
+                if (visited.add(succ))
+                    workList.add(succ);
+            }
+        }
+        return false;
+    }
+
+    void _findThreadStateVars()
+    {
+        for (auto block : m_func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto var = as<IRVar>(inst);
+                if (var && _isLiveAfterBarrier(var))
+                    m_threadStateVars.add(var);
+            }
+        }
+    }
+
+        /// Add the resume point parameter, and a dispatch block that jumps to the resume point.
+        /// Each barrier is replaced by storing its resume point and returning.
+    IRBlock* _addResumePoints()
+    {
+        IRBuilder builder(m_module);
+
+        builder.setInsertBefore(m_func);
+        m_threadStateType = builder.createStructType();
+        builder.addNameHintDecoration(m_threadStateType, UnownedStringSlice("GroupThreadState"));
+
+        auto uintType = builder.getUIntType();
+
+        // The parameters move to a new entry block
+        auto startBlock = m_func->getFirstBlock();
+        auto dispatchBlock = builder.createBlock();
+        dispatchBlock->insertBefore(startBlock);
+
+        List<IRParam*> params;
+        for (auto param : startBlock->getParams())
+        {
+            params.add(param);
+        }
+        for (auto param : params)
+        {
+            param->insertAtEnd(dispatchBlock);
+        }
+
+        builder.setInsertInto(dispatchBlock);
+        m_resumePointParam = builder.emitParam(builder.getPtrType(uintType));
+        builder.addNameHintDecoration(m_resumePointParam, UnownedStringSlice("resumePoint"));
+        m_threadStateParam = builder.emitParam(builder.getPtrType(m_threadStateType));
+        builder.addNameHintDecoration(m_threadStateParam, UnownedStringSlice("threadState"));
+
+        // Returning from the entry point means the thread is done
+        for (auto block : m_func->getBlocks())
+        {
+            if (auto returnInst = as<IRReturn>(block->getTerminator()))
+            {
+                builder.setInsertBefore(returnInst);
+                builder.emitStore(m_resumePointParam, builder.getIntValue(uintType, 0));
+            }
+        }
+
+        List<IRInst*> caseArgs;
+        for (Index i = 0; i < m_resumeBlocks.getCount(); ++i)
+        {
+            auto barrierBlock = m_barrierBlocks[i];
+            auto branch = barrierBlock->getTerminator();
+            auto barrier = branch->getPrevInst();
+            auto resumePoint = builder.getIntValue(uintType, i + 1);
+
+            builder.setInsertBefore(branch);
+            builder.emitStore(m_resumePointParam, resumePoint);
+            builder.emitReturn();
+
+            branch->removeAndDeallocate();
+            barrier->removeAndDeallocate();
+
+            caseArgs.add(resumePoint);
+            caseArgs.add(m_resumeBlocks[i]);
+        }
+
+        auto breakBlock = builder.createBlock();
+        breakBlock->insertAtEnd(m_func);
+        builder.setInsertInto(breakBlock);
+        builder.emitUnreachable();
+
+        builder.setInsertInto(dispatchBlock);
+        builder.emitSwitch(
+            builder.emitLoad(m_resumePointParam),
+            breakBlock,
+            startBlock,
+            caseArgs.getCount(),
+            caseArgs.getBuffer());
+
+        return dispatchBlock;
+    }
+
+    IRStructKey* _addThreadStateField(IRInst* inst, IRType* type)
+    {
+        IRBuilder builder(m_module);
+        builder.setInsertBefore(m_threadStateType);
+
+        auto key = builder.createStructKey();
+        builder.createStructField(m_threadStateType, key, type);
+        if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
+        {
+            builder.addNameHintDecoration(key, nameHint->getName());
+        }
+        return key;
+    }
+
+    static bool _isDominatedUse(IRDominatorTree* dominatorTree, IRBlock* defBlock, IRInst* user)
+    {
+        auto userBlock = as<IRBlock>(user->getParent());
+        return !userBlock ||
+            userBlock == defBlock ||
+            dominatorTree->isUnreachable(userBlock) ||
+            dominatorTree->dominates(defBlock, userBlock);
+    }
+
+    static bool _hasUndominatedUse(IRDominatorTree* dominatorTree, IRInst* inst)
+    {
+        auto defBlock = as<IRBlock>(inst->getParent());
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (!_isDominatedUse(dominatorTree, defBlock, use->getUser()))
+                return true;
+        }
+        return false;
+    }
+
+        /// Move the state that has to survive a barrier into the thread state
+    void _addThreadState(IRBlock* dispatchBlock)
+    {
+        IRBuilder builder(m_module);
+        auto dominatorTree = computeDominatorTree(m_func);
+
+        List<IRInst*> insts;
+        for (auto block : m_func->getBlocks())
+        {
+            if (block == dispatchBlock)
+                continue;
+            for (auto inst : block->getOrdinaryInsts())
+            {
+                insts.add(inst);
+            }
+        }
+
+        for (auto inst : insts)
+        {
+            if (auto var = as<IRVar>(inst))
+            {
+                if (m_threadStateVars.contains(var))
+                {
+                    auto key = _addThreadStateField(var, var->getDataType()->getValueType());
+                    while (auto use = var->firstUse)
+                    {
+                        builder.setInsertBefore(use->getUser());
+                        use->set(builder.emitFieldAddress(var->getFullType(), m_threadStateParam, key));
+                    }
+                    var->removeAndDeallocate();
+                }
+                else if (_hasUndominatedUse(dominatorTree, var))
+                {
+                    // The value doesn't survive a barrier, but the variable has to be in scope wherever it is used
+                    var->insertBefore(dispatchBlock->getTerminator());
+                }
+                continue;
+            }
+
+            if (!_hasUndominatedUse(dominatorTree, inst))
+                continue;
+
+            auto key = _addThreadStateField(inst, inst->getDataType());
+            auto ptrType = builder.getPtrType(inst->getDataType());
+            auto defBlock = as<IRBlock>(inst->getParent());
+
+            for (auto use = inst->firstUse; use; )
+            {
+                auto nextUse = use->nextUse;
+                auto user = use->getUser();
+                if (!_isDominatedUse(dominatorTree, defBlock, user))
+                {
+                    builder.setInsertBefore(user);
+                    use->set(builder.emitLoad(builder.emitFieldAddress(ptrType, m_threadStateParam, key)));
+                }
+                use = nextUse;
+            }
+
+            builder.setInsertAfter(inst);
+            builder.emitStore(builder.emitFieldAddress(ptrType, m_threadStateParam, key), inst);
+        }
+    }
+};
+
+void splitEntryPointsAtGroupBarriersForCPU(IRModule* module, DiagnosticSink* sink)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !_isComputeEntryPoint(func))
+            continue;
+
+        SplitGroupBarriersContext context;
+        context.m_module = module;
+        context.m_sink = sink;
+        context.processFunc(func);
+    }
+}
+
+}
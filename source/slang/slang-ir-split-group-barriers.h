@@ -0,0 +1,17 @@
+// slang-ir-split-group-barriers.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+
+    /// Inline all of the calls within compute entry points to functions that (directly or indirectly) reach a
+    /// group barrier, so that every barrier an entry point reaches is in the body of the entry point.
+void inlineGroupBarrierCallsForCPU(IRModule* module);
+
+    /// Split compute entry points at their group barriers, so the threads of a group can be run in phases on
+    /// a single host thread. Expects phis to have been eliminated.
+void splitEntryPointsAtGroupBarriersForCPU(IRModule* module, DiagnosticSink* sink);
+
+}
@@ -15,9 +15,99 @@
 
 namespace Slang
 {
+    void IRSimplificationStats::add(const IRSimplificationStats& rhs)
+    {
+        iterationCount += rhs.iterationCount;
+        funcVisitCount += rhs.funcVisitCount;
+        funcSkipCount += rhs.funcSkipCount;
+        funcIterationCount += rhs.funcIterationCount;
+
+        deduplicateGenericChildrenChangeCount += rhs.deduplicateGenericChildrenChangeCount;
+        propagateFuncPropertiesChangeCount += rhs.propagateFuncPropertiesChangeCount;
+        removeUnusedGenericParamChangeCount += rhs.removeUnusedGenericParamChangeCount;
+        globalSCCPChangeCount += rhs.globalSCCPChangeCount;
+        globalPeepholeChangeCount += rhs.globalPeepholeChangeCount;
+
+        sccpChangeCount += rhs.sccpChangeCount;
+        peepholeChangeCount += rhs.peepholeChangeCount;
+        redundancyRemovalChangeCount += rhs.redundancyRemovalChangeCount;
+        simplifyCFGChangeCount += rhs.simplifyCFGChangeCount;
+        constructSSAChangeCount += rhs.constructSSAChangeCount;
+    }
+
+    void IRSimplificationStats::append(StringBuilder& out) const
+    {
+        out << "simplifyIR iterations: " << iterationCount << "\n";
+        out << "simplifyIR function visits: " << funcVisitCount << "\n";
+        out << "simplifyIR function skips: " << funcSkipCount << "\n";
+        out << "simplifyIR function iterations: " << funcIterationCount << "\n";
+
+        out << "simplifyIR changes:\n";
+        out << "  deduplicateGenericChildren: " << deduplicateGenericChildrenChangeCount << "\n";
+        out << "  propagateFuncProperties: " << propagateFuncPropertiesChangeCount << "\n";
+        out << "  removeUnusedGenericParam: " << removeUnusedGenericParamChangeCount << "\n";
+        out << "  global SCCP: " << globalSCCPChangeCount << "\n";
+        out << "  global peephole: " << globalPeepholeChangeCount << "\n";
+        out << "  SCCP: " << sccpChangeCount << "\n";
+        out << "  peephole: " << peepholeChangeCount << "\n";
+        out << "  redundancy removal: " << redundancyRemovalChangeCount << "\n";
+        out << "  simplifyCFG: " << simplifyCFGChangeCount << "\n";
+        out << "  constructSSA: " << constructSSAChangeCount << "\n";
+    }
+
+        // Label used for the per function profiler sections
+    static String _getFuncNameForProfiling(IRGlobalValueWithCode* func)
+    {
+        if (auto nameHint = func->findDecoration<IRNameHintDecoration>())
+            return nameHint->getName();
+        if (auto linkage = func->findDecoration<IRLinkageDecoration>())
+            return linkage->getMangledName();
+        return String("<unnamed>");
+    }
+
+    static bool _countChange(bool changed, uint64_t& ioCount)
+    {
+        ioCount += changed ? 1 : 0;
+        return changed;
+    }
+
+    // Add the module level functions that reference `inst`, either directly, or through other
+    // module level insts (such as specializations and witness tables), to `ioFuncs`.
+    static void _addReferencingFuncs(IRInst* inst, HashSet<IRGlobalValueWithCode*>& ioFuncs)
+    {
+        // A function nested in a generic is referenced through the generic
+        if (auto generic = findOuterGeneric(inst))
+            inst = generic;
+
+        List<IRInst*> workList;
+        HashSet<IRInst*> visited;
+        workList.add(inst);
+        visited.add(inst);
+
+        for (Index i = 0; i < workList.getCount(); ++i)
+        {
+            for (auto use = workList[i]->firstUse; use; use = use->nextUse)
+            {
+                // Find the module level inst that contains the user
+                IRInst* user = use->getUser();
+                while (user->getParent() && !as<IRModuleInst>(user->getParent()))
+                    user = user->getParent();
+
+                if (auto func = as<IRGlobalValueWithCode>(user))
+                {
+                    ioFuncs.add(func);
+                }
+                else if (visited.add(user))
+                {
+                    workList.add(user);
+                }
+            }
+        }
+    }
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
-    void simplifyIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options, DiagnosticSink* sink)
+    void simplifyIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options, DiagnosticSink* sink, IRSimplificationStats* outStats)
     {
         SLANG_PROFILE;
         bool changed = true;
@@ -25,6 +115,14 @@ namespace Slang
         const int kMaxFuncIterations = 16;
         int iterationCounter = 0;
 
+        IRSimplificationStats stats;
+
+        // The per function passes only look at the body of the function they are applied to, and
+        // the properties of its callees. So once a function reaches a fixed point it only needs to
+        // be simplified again if one of those properties, or something at the global scope, changes.
+        HashSet<IRGlobalValueWithCode*> dirtyFuncs;
+        bool allFuncsDirty = true;
+
         while (changed && iterationCounter < kMaxIterations)
         {
             if (sink && sink->getErrorCount())
@@ -32,33 +130,69 @@ namespace Slang
 
             changed = false;
 
-            changed |= deduplicateGenericChildren(module);
-            changed |= propagateFuncProperties(module);
-            changed |= removeUnusedGenericParam(module);
-            changed |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
-            changed |= peepholeOptimizeGlobalScope(target, module);
+            // We don't track which functions are affected by changes made by most of the global passes,
+            // and just simplify every function again.
+            bool globalChanged = false;
+            globalChanged |= _countChange(deduplicateGenericChildren(module), stats.deduplicateGenericChildrenChangeCount);
+
+            // If a function gains a property its callers may now be simplified further.
+            List<IRFunc*> funcsWithNewProperties;
+            if (_countChange(propagateFuncProperties(module, &funcsWithNewProperties), stats.propagateFuncPropertiesChangeCount))
+            {
+                changed = true;
+                for (auto func : funcsWithNewProperties)
+                    _addReferencingFuncs(func, dirtyFuncs);
+            }
 
+            globalChanged |= _countChange(removeUnusedGenericParam(module), stats.removeUnusedGenericParamChangeCount);
+            globalChanged |= _countChange(applySparseConditionalConstantPropagationForGlobalScope(module, sink), stats.globalSCCPChangeCount);
+            globalChanged |= _countChange(peepholeOptimizeGlobalScope(target, module), stats.globalPeepholeChangeCount);
+            if (globalChanged)
+            {
+                changed = true;
+                allFuncsDirty = true;
+            }
+
+            HashSet<IRGlobalValueWithCode*> nextDirtyFuncs;
             for (auto inst : module->getGlobalInsts())
             {
                 auto func = as<IRGlobalValueWithCode>(inst);
                 if (!func)
                     continue;
+
+                if (!allFuncsDirty && !dirtyFuncs.contains(func))
+                {
+                    stats.funcSkipCount++;
+                    continue;
+                }
+                stats.funcVisitCount++;
+
+                SLANG_PROFILE_SECTION_WITH_LABEL("simplifyFunc", _getFuncNameForProfiling(func));
+
                 bool funcChanged = true;
                 int funcIterationCount = 0;
                 while (funcChanged && funcIterationCount < kMaxFuncIterations)
                 {
                     funcChanged = false;
-                    funcChanged |= applySparseConditionalConstantPropagation(func, sink);
-                    funcChanged |= peepholeOptimize(target, func);
-                    funcChanged |= removeRedundancyInFunc(func);
-                    funcChanged |= simplifyCFG(func, options.cfgOptions);
+                    funcChanged |= _countChange(applySparseConditionalConstantPropagation(func, sink), stats.sccpChangeCount);
+                    funcChanged |= _countChange(peepholeOptimize(target, func), stats.peepholeChangeCount);
+                    funcChanged |= _countChange(removeRedundancyInFunc(func), stats.redundancyRemovalChangeCount);
+                    funcChanged |= _countChange(simplifyCFG(func, options.cfgOptions), stats.simplifyCFGChangeCount);
                     eliminateDeadCode(func);
-                    funcChanged |= constructSSA(func);
+                    funcChanged |= _countChange(constructSSA(func), stats.constructSSAChangeCount);
                     changed |= funcChanged;
                     funcIterationCount++;
                 }
+                stats.funcIterationCount += funcIterationCount;
+
+                // If we gave up before reaching a fixed point, the function needs to be visited again.
+                if (funcChanged)
+                    nextDirtyFuncs.add(func);
             }
 
+            dirtyFuncs = _Move(nextDirtyFuncs);
+            allFuncsDirty = false;
+
             // Note: we disregard the `changed` state from dead code elimination pass since
             // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
             // DCE will always remove those nearly generated consts and always returns true here.
@@ -66,6 +200,11 @@ namespace Slang
 
             iterationCounter++;
         }
+
+        stats.iterationCount = iterationCounter;
+
+        if (outStats)
+            outStats->add(stats);
     }
 
     void simplifyNonSSAIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options)
@@ -3,6 +3,8 @@
 
 #include "slang-ir-simplify-cfg.h"
 
+#include "../core/slang-string.h"
+
 namespace Slang
 {
     struct IRModule;
@@ -27,9 +29,39 @@ namespace Slang
         }
     };
 
+        /// Counts of the work done by `simplifyIR`, and of how many times each pass made a change.
+    struct IRSimplificationStats
+    {
+        // Work done
+        uint64_t iterationCount = 0;                    ///< Iterations over the whole module
+        uint64_t funcVisitCount = 0;                    ///< Times a function was simplified
+        uint64_t funcSkipCount = 0;                     ///< Times a function was skipped because nothing it depends on changed
+        uint64_t funcIterationCount = 0;                ///< Iterations of the per function passes
+
+        // Changes made by the global passes
+        uint64_t deduplicateGenericChildrenChangeCount = 0;
+        uint64_t propagateFuncPropertiesChangeCount = 0;
+        uint64_t removeUnusedGenericParamChangeCount = 0;
+        uint64_t globalSCCPChangeCount = 0;
+        uint64_t globalPeepholeChangeCount = 0;
+
+        // Changes made by the per function passes
+        uint64_t sccpChangeCount = 0;
+        uint64_t peepholeChangeCount = 0;
+        uint64_t redundancyRemovalChangeCount = 0;
+        uint64_t simplifyCFGChangeCount = 0;
+        uint64_t constructSSAChangeCount = 0;
+
+        void add(const IRSimplificationStats& rhs);
+        void append(StringBuilder& out) const;
+    };
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
-    void simplifyIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options, DiagnosticSink* sink = nullptr);
+    //
+    // Only functions that changed in the previous iteration, or that depend on something outside
+    // of their body that changed, are simplified again. The work done is added to `outStats` if set.
+    void simplifyIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options, DiagnosticSink* sink = nullptr, IRSimplificationStats* outStats = nullptr);
 
     // Run simplifications on IR that is out of SSA form.
     void simplifyNonSSAIR(TargetRequest* target, IRModule* module, IRSimplificationOptions options);
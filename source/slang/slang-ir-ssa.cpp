@@ -1220,14 +1220,10 @@ bool constructSSA(ConstructSSAContext* context)
     //
     // Currently these are "access chain" instructions for
     // loads from (parts of) variables that got promoted.
-    for (auto inst : context->instsToRemove)
-    {
-        // TODO: do we need to be careful here in case one
-        // of thes operations still has uses, as part of
-        // another to-be-remvoed instruction?
-
-        inst->removeAndDeallocate();
-    }
+    //
+    // An access chain can use another one (e.g. a field of
+    // an array element), so they are removed as a batch.
+    removeAndDeallocateInsts(context->instsToRemove);
 
     // Now we should be able to go through and remove
     // of of the variables
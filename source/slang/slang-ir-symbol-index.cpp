@@ -0,0 +1,108 @@
+// slang-ir-symbol-index.cpp
+#include "slang-ir-symbol-index.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+/* static */void IRSymbolIndex::addGlobalValue(SymbolDictionary& ioSymbols, IRInst* globalValue, const IRSymbolIndex* baseIndex)
+{
+    auto linkage = globalValue->findDecoration<IRLinkageDecoration>();
+
+    // Don't try to register a symbol for global values
+    // that don't have linkage.
+    //
+    if (!linkage)
+        return;
+
+    const UnownedStringSlice mangledName = linkage->getMangledName();
+
+    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+    sym->irGlobalValue = globalValue;
+
+    if (auto prevPtr = ioSymbols.tryGetValue(mangledName))
+    {
+        IRSpecSymbol* prev = *prevPtr;
+        sym->nextWithSameName = prev->nextWithSameName;
+        prev->nextWithSameName = sym;
+        return;
+    }
+
+    IRSpecSymbol* baseSym = baseIndex ? baseIndex->findSymbol(mangledName) : nullptr;
+    if (!baseSym)
+    {
+        ioSymbols.add(mangledName, sym);
+        return;
+    }
+
+    // Copy the list from the base, as it can't be modified. The list is small (typically one
+    // entry, or one per target specialization), and this only happens for names the modules being
+    // added have in common with the base (such as declarations of stdlib functions).
+    RefPtr<IRSpecSymbol> head = new IRSpecSymbol();
+    head->irGlobalValue = baseSym->irGlobalValue;
+
+    IRSpecSymbol* tail = head;
+    for (IRSpecSymbol* ss = baseSym->nextWithSameName; ss; ss = ss->nextWithSameName)
+    {
+        RefPtr<IRSpecSymbol> copy = new IRSpecSymbol();
+        copy->irGlobalValue = ss->irGlobalValue;
+        tail->nextWithSameName = copy;
+        tail = copy;
+    }
+
+    // Insert after the first, as if the base symbols had been added to ioSymbols
+    sym->nextWithSameName = head->nextWithSameName;
+    head->nextWithSameName = sym;
+
+    ioSymbols.add(mangledName, head);
+}
+
+/* static */RefPtr<IRSymbolIndex> IRSymbolIndex::create(const List<IRModule*>& modules)
+{
+    RefPtr<IRSymbolIndex> index = new IRSymbolIndex;
+    index->m_moduleCount = modules.getCount();
+
+    for (IRModule* module : modules)
+    {
+        if (!module)
+            continue;
+
+        for (auto inst : module->getGlobalInsts())
+        {
+            addGlobalValue(index->m_symbols, inst);
+
+            if (auto hashedStringLits = as<IRGlobalHashedStringLiterals>(inst))
+            {
+                const Index count = hashedStringLits->getOperandCount();
+                for (Index i = 0; i < count; ++i)
+                {
+                    IRStringLit* stringLit = as<IRStringLit>(hashedStringLits->getOperand(i));
+                    index->m_hashedStringLiterals.add(stringLit->getStringSlice());
+                }
+            }
+            else if (as<IRBindGlobalGenericParam>(inst))
+            {
+                index->m_bindGlobalGenericParams.add(inst);
+            }
+
+            if (inst->findDecorationImpl(kIROp_HLSLExportDecoration))
+            {
+                index->m_hlslExportedValues.add(inst);
+            }
+        }
+
+        for (auto decoration : module->getModuleInst()->getDecorations())
+        {
+            if (decoration->getOp() == kIROp_NVAPISlotDecoration)
+            {
+                index->m_moduleDecorations.add(decoration);
+            }
+        }
+    }
+
+    return index;
+}
+
+} // namespace Slang
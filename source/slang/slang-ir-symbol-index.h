@@ -0,0 +1,75 @@
+// slang-ir-symbol-index.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+
+struct IRInst;
+struct IRModule;
+struct IRDecoration;
+
+    /// A global value that has linkage. Global values with the same mangled name form a singly linked list.
+struct IRSpecSymbol : RefObject
+{
+    IRInst*                 irGlobalValue;
+    RefPtr<IRSpecSymbol>    nextWithSameName;
+};
+
+    /// A map from mangled name to the global values with that name, for a set of IR modules.
+    ///
+    /// The keys are the mangled name string literals held in the modules themselves, so no copies of
+    /// the names are made, but an index must not outlive the modules it was built from.
+    ///
+    /// Once built the index is not modified. This allows the index for the stdlib modules to be built
+    /// once per session and shared by every link, with the symbols of the modules being linked
+    /// layered on top.
+class IRSymbolIndex : public RefObject
+{
+public:
+    typedef Dictionary<UnownedStringSlice, RefPtr<IRSpecSymbol>> SymbolDictionary;
+
+        /// Find the first of the global values named `mangledName`, or nullptr if there are none
+    IRSpecSymbol* findSymbol(const UnownedStringSlice& mangledName) const
+    {
+        auto symbol = m_symbols.tryGetValue(mangledName);
+        return symbol ? symbol->Ptr() : nullptr;
+    }
+
+        /// Get the contents of all of the GlobalHashedStringLiterals of the modules
+    const List<UnownedStringSlice>& getHashedStringLiterals() const { return m_hashedStringLiterals; }
+
+        /// Get the BindGlobalGenericParam instructions of the modules
+    const List<IRInst*>& getBindGlobalGenericParams() const { return m_bindGlobalGenericParams; }
+        /// Get the global values of the modules marked with HLSL `export`
+    const List<IRInst*>& getHLSLExportedValues() const { return m_hlslExportedValues; }
+        /// Get the decorations on the modules themselves that are copied to the linked module
+    const List<IRDecoration*>& getModuleDecorations() const { return m_moduleDecorations; }
+
+        /// Get the number of modules the index was built from
+    Count getModuleCount() const { return m_moduleCount; }
+
+        /// Build an index of the global values of `modules`
+    static RefPtr<IRSymbolIndex> create(const List<IRModule*>& modules);
+
+        /// Add `globalValue` (if it has linkage) to `ioSymbols`. `globalValue` is placed after the first
+        /// symbol with the same name, matching the order the linker has always used.
+        /// 
+        /// If `baseIndex` is set and `ioSymbols` doesn't yet contain the name, the symbols with the
+        /// name in `baseIndex` are copied first, so that `ioSymbols` holds all of the values
+        /// with that name.
+    static void addGlobalValue(SymbolDictionary& ioSymbols, IRInst* globalValue, const IRSymbolIndex* baseIndex = nullptr);
+
+protected:
+    SymbolDictionary m_symbols;
+    List<UnownedStringSlice> m_hashedStringLiterals;
+
+    // Instructions the linker needs regardless of whether they are referenced
+    List<IRInst*> m_bindGlobalGenericParams;
+    List<IRInst*> m_hlslExportedValues;
+    List<IRDecoration*> m_moduleDecorations;
+    Count m_moduleCount = 0;
+};
+
+} // namespace Slang
@@ -258,6 +258,16 @@ void moveInstChildren(IRInst* dest, IRInst* src)
     }
 }
 
+Count countInstsRecursively(IRInst* inst)
+{
+    Count count = 1;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        count += countInstsRecursively(child);
+    }
+    return count;
+}
+
 String dumpIRToString(IRInst* root, IRDumpOptions options)
 {
     StringBuilder sb;
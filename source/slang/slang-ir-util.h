@@ -140,6 +140,9 @@ IRInst* hoistValueFromGeneric(
 // Clear dest and move all chidlren from src to dest.
 void moveInstChildren(IRInst* dest, IRInst* src);
 
+// Count `inst` and all of its decorations and children, recursively.
+Count countInstsRecursively(IRInst* inst);
+
 inline bool isGenericParam(IRInst* param)
 {
     auto parent = param->getParent();
@@ -221,6 +224,24 @@ void moveParams(IRBlock* dest, IRBlock* src);
 
 void removePhiArgs(IRInst* phiParam);
 
+// Remove and deallocate a batch of instructions (or blocks) that may use each
+// other or each other's descendents, but are no longer used from anywhere else.
+// All their operands are cleared first, so that none of them still has uses
+// when it is deallocated.
+template<typename TInstList>
+void removeAndDeallocateInsts(const TInstList& insts)
+{
+    for (auto inst : insts)
+    {
+        inst->removeArguments();
+        inst->removeArgumentsOfDecorationsAndChildren();
+    }
+    for (auto inst : insts)
+    {
+        inst->removeAndDeallocate();
+    }
+}
+
 int getParamIndexInBlock(IRParam* paramInst);
 
 bool isGlobalOrUnknownMutableAddress(IRGlobalValueWithCode* parentFunc, IRInst* inst);
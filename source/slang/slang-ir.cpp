@@ -9,6 +9,20 @@
 
 #include "slang-mangle.h"
 
+// Under ASan, the memory of deallocated instructions is poisoned until it is reused, so that
+// accesses through anything still referring to them are reported.
+#if defined(__has_feature)
+#   if __has_feature(address_sanitizer)
+#       define SLANG_IR_POISON_FREE_INSTS 1
+#   endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#   define SLANG_IR_POISON_FREE_INSTS 1
+#endif
+#ifdef SLANG_IR_POISON_FREE_INSTS
+#   include <sanitizer/asan_interface.h>
+#endif
+
 namespace Slang
 {
     struct IRSpecContext;
@@ -1484,17 +1498,115 @@ namespace Slang
         size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
         size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-        IRInst* inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        // Rounding up the size means instructions of similar sizes can share memory
+        // once they have been deallocated.
+        totalSize = (totalSize + kInstSizeGranularity - 1) & ~size_t(kInstSizeGranularity - 1);
+
+        IRInst* inst = nullptr;
+        if (totalSize <= kMaxRecycledInstSize)
+        {
+            void*& freeInst = m_freeInsts[totalSize / kInstSizeGranularity];
+            if (freeInst)
+            {
+                inst = (IRInst*) freeInst;
+                freeInst = *(void**) freeInst;
+
+#ifdef SLANG_IR_POISON_FREE_INSTS
+                ASAN_UNPOISON_MEMORY_REGION(inst, totalSize);
+#endif
+                ::memset(inst, 0, totalSize);
+                m_recycledInstBytes += totalSize;
+            }
+        }
+        if (!inst)
+        {
+            inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        }
 
         // TODO: Is it actually important to run a constructor here?
         new(inst) IRInst();
 
         inst->operandCount = uint32_t(operandCount);
         inst->m_op = op;
+        inst->m_allocatedSize = uint32_t(totalSize);
 
         return inst;
     }
 
+    void IRModule::_deallocateInst(IRInst* inst)
+    {
+        // Nothing should use an instruction once it has been deallocated, as the users could
+        // write to it after its memory has been reused.
+        SLANG_ASSERT(!inst->firstUse);
+
+        DeallocatedInst deallocatedInst;
+        deallocatedInst.inst = inst;
+        deallocatedInst.allocatedSize = inst->firstUse ? 0 : inst->m_allocatedSize;
+        m_deallocatedInsts.add(deallocatedInst);
+    }
+
+    void IRModule::reclaimDeallocatedInsts()
+    {
+        if (m_deallocatedInsts.getCount() == 0)
+            return;
+
+        // Analyses (such as dominator trees) can refer to instructions that have been
+        // deallocated, without being invalidated.
+        invalidateAllAnalysis();
+
+        // The deduplication maps can keep a deallocated instruction if its key was out
+        // of date when it was removed. Those instructions can't be reused, as the maps
+        // would then find whatever reuses the memory.
+        HashSet<IRInst*> deallocatedInsts;
+        for (const auto& deallocatedInst : m_deallocatedInsts)
+            deallocatedInsts.add(deallocatedInst.inst);
+
+        HashSet<IRInst*> keptInsts;
+        auto keepIfDeallocated = [&](IRInst* inst)
+        {
+            if (deallocatedInsts.contains(inst))
+                keptInsts.add(inst);
+        };
+        for (const auto& [key, value] : m_deduplicationContext.getGlobalValueNumberingMap())
+        {
+            keepIfDeallocated(key.getInst());
+            keepIfDeallocated(value);
+        }
+        for (const auto& [key, value] : m_deduplicationContext.getConstantMap())
+        {
+            keepIfDeallocated(key.inst);
+            keepIfDeallocated(value);
+        }
+        for (const auto& [key, value] : m_deduplicationContext.getInstReplacementMap())
+        {
+            keepIfDeallocated(key);
+            keepIfDeallocated(value);
+        }
+
+        for (const auto& deallocatedInst : m_deallocatedInsts)
+        {
+            // Only the recorded state of an instruction can be read here, as it has been destroyed.
+            // Adding to `keptInsts` makes sure an instruction is only freed once.
+            IRInst* inst = deallocatedInst.inst;
+            if (!keptInsts.add(inst))
+                continue;
+
+            const size_t size = deallocatedInst.allocatedSize;
+            if (size == 0 || size > kMaxRecycledInstSize)
+                continue;
+
+            void*& freeInst = m_freeInsts[size / kInstSizeGranularity];
+            *(void**) inst = freeInst;
+            freeInst = inst;
+
+            // The first word is the link in the list of free instructions.
+#ifdef SLANG_IR_POISON_FREE_INSTS
+            ASAN_POISON_MEMORY_REGION((char*) inst + sizeof(void*), size - sizeof(void*));
+#endif
+        }
+        m_deallocatedInsts.clear();
+    }
+
         /// Return whichever of `left` or `right` represents the later point in a common parent
     static IRInst* pickLaterInstInSameParent(
         IRInst* left,
@@ -7692,13 +7804,31 @@ namespace Slang
         return;
     }
 
+    void IRInst::removeArgumentsOfDecorationsAndChildren()
+    {
+        for (auto child : getDecorationsAndChildren())
+        {
+            child->removeArguments();
+            child->removeArgumentsOfDecorationsAndChildren();
+        }
+    }
+
     // Remove this instruction from its parent block,
     // and then destroy it (it had better have no uses!)
     void IRInst::removeAndDeallocate()
     {
-        removeAndDeallocateAllDecorationsAndChildren();
+        // The descendents of this instruction can use each other, and are
+        // deallocated with it, so none of those uses should be left behind.
+        removeArgumentsOfDecorationsAndChildren();
+        _removeAndDeallocate();
+    }
+
+    void IRInst::_removeAndDeallocate()
+    {
+        _removeAndDeallocateAllDecorationsAndChildren();
 
-        if (auto module = getModule())
+        auto module = getModule();
+        if (module)
         {
             if (getIROpInfo(getOp()).isHoistable())
             {
@@ -7715,17 +7845,29 @@ namespace Slang
         removeArguments();
         removeFromParent();
 
+        // The module records what it needs to reuse the memory before the instruction is destroyed.
+        if (module)
+        {
+            module->_deallocateInst(this);
+        }
+
         // Run destructor to be sure...
         this->~IRInst();
     }
 
     void IRInst::removeAndDeallocateAllDecorationsAndChildren()
+    {
+        removeArgumentsOfDecorationsAndChildren();
+        _removeAndDeallocateAllDecorationsAndChildren();
+    }
+
+    void IRInst::_removeAndDeallocateAllDecorationsAndChildren()
     {
         IRInst* nextChild = nullptr;
         for( IRInst* child = getFirstDecorationOrChild(); child; child = nextChild )
         {
             nextChild = child->getNextInst();
-            child->removeAndDeallocate();
+            child->_removeAndDeallocate();
         }
     }
 
@@ -591,6 +591,10 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // The number of bytes allocated for this instruction by its module,
+    // so that the memory can be reused once it has been deallocated.
+    uint32_t m_allocatedSize = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -705,6 +709,8 @@ struct IRInst
             m_decorationsAndChildren.last);
     }
     void removeAndDeallocateAllDecorationsAndChildren();
+    void _removeAndDeallocateAllDecorationsAndChildren();
+    void _removeAndDeallocate();
 
 #ifdef SLANG_ENABLE_IR_BREAK_ALLOC
     // Unique allocation ID for this instruction since start of current process.
@@ -789,6 +795,11 @@ struct IRInst
     // for those values.
     void removeArguments();
 
+    // Clear out the arguments of all the descendents of this
+    // instruction, so that those that use each other can be
+    // deallocated in any order.
+    void removeArgumentsOfDecorationsAndChildren();
+
     // Remove operand `index` from operand list.
     // For example, if the inst is `op(a,b,c)`, calling removeOperand(inst, 1) will result
     // `op(a,c)`.
@@ -2296,6 +2307,31 @@ public:
     {
         return m_containerPool;
     }
+
+        /// Called by `IRInst::removeAndDeallocate` for an instruction removed from this module.
+        ///
+        /// The memory isn't reused immediately, because passes often hold (and compare)
+        /// pointers to instructions they have removed. See `reclaimDeallocatedInsts`.
+        ///
+        /// Must be called before the destructor of `inst` runs, as it reads the state of `inst`.
+    void _deallocateInst(IRInst* inst);
+
+        /// Make the memory of the instructions deallocated since the last call available
+        /// to `_allocateInst`.
+        ///
+        /// This must only be called between passes, when nothing holds a pointer to
+        /// a deallocated instruction.
+    void reclaimDeallocatedInsts();
+
+        /// Get the total size of the allocations by `_allocateInst` that reused the memory of
+        /// deallocated instructions since the last call
+    size_t takeRecycledInstBytes()
+    {
+        const size_t bytes = m_recycledInstBytes;
+        m_recycledInstBytes = 0;
+        return bytes;
+    }
+
 private:
     IRModule() = delete;
 
@@ -2334,6 +2370,25 @@ private:
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
+    enum
+    {
+        kInstSizeGranularity = 8,           ///< Instruction allocations are rounded up to a multiple of this
+        kMaxRecycledInstSize = 512,         ///< Larger instructions are rare, so their memory isn't reused
+    };
+
+        /// An instruction deallocated since the last `reclaimDeallocatedInsts`
+    struct DeallocatedInst
+    {
+        IRInst* inst;
+        uint32_t allocatedSize;     ///< 0 if the memory of `inst` must not be reused
+    };
+    List<DeallocatedInst> m_deallocatedInsts;
+
+        /// Free lists of instruction memory, indexed by size in granules.
+        /// The first pointer in each free block links to the next one of the same size.
+    void* m_freeInsts[kMaxRecycledInstSize / kInstSizeGranularity + 1] = {};
+
+    size_t m_recycledInstBytes = 0;
 };
 
 
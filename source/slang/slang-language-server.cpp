@@ -42,6 +42,15 @@ ArrayView<const char*> getCommitChars()
     return makeArrayView(_commitCharsArray, SLANG_COUNT_OF(_commitCharsArray));
 }
 
+static LanguageServer::TraceOptions _parseTraceOptions(UnownedStringSlice str)
+{
+    if (str == "messages")
+        return LanguageServer::TraceOptions::Messages;
+    else if (str == "verbose")
+        return LanguageServer::TraceOptions::Verbose;
+    return LanguageServer::TraceOptions::Off;
+}
+
 SlangResult LanguageServer::init(const InitializeParams& args)
 {
     SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams(JSONRPCConnection::CallStyle::Object));
@@ -49,6 +58,7 @@ SlangResult LanguageServer::init(const InitializeParams& args)
     m_typeMap = JSONNativeUtil::getTypeFuncsMap();
 
     m_workspaceFolders = args.workspaceFolders;
+    m_traceOptions = _parseTraceOptions(args.trace.getUnownedSlice());
     m_workspace = new Workspace();
     List<URI> rootUris;
     for (auto& wd : m_workspaceFolders)
@@ -1754,12 +1764,7 @@ void LanguageServer::updateTraceOptions(const JSONValue& value)
         String str;
         if (SLANG_SUCCEEDED(converter.convert(value, &str)))
         {
-            if (str == "messages")
-                m_traceOptions = TraceOptions::Messages;
-            else if (str == "verbose")
-                m_traceOptions = TraceOptions::Verbose;
-            else
-                m_traceOptions = TraceOptions::Off;
+            m_traceOptions = _parseTraceOptions(str.getUnownedSlice());
         }
     }
 }
@@ -2152,7 +2157,17 @@ void LanguageServer::processCommands()
         }
         else
         {
+            auto commandStart = platform::PerformanceCounter::now();
+
             runCommand(cmd);
+
+            if (m_initialized && m_traceOptions == TraceOptions::Verbose)
+            {
+                auto commandTime = platform::PerformanceCounter::getElapsedTimeInSeconds(commandStart);
+                StringBuilder msgBuilder;
+                msgBuilder << cmd.method << " executed in " << String(int(commandTime * 1000)) << "ms";
+                logMessage(3, msgBuilder.produceString());
+            }
         }
     }
 }
@@ -2206,6 +2221,7 @@ SlangResult LanguageServer::execute()
         }
 
         auto workStart = platform::PerformanceCounter::now();
+        const Index versionCreationCount = m_workspace ? m_workspace->versionCreationCount : 0;
 
         processCommands();
 
@@ -2222,6 +2238,17 @@ SlangResult LanguageServer::execute()
             logMessage(3, msgBuilder.produceString());
         }
 
+        // Versions can also be created when diagnostics are updated, so this is reported even when
+        // there were no commands.
+        if (m_workspace && m_workspace->versionCreationCount != versionCreationCount && m_initialized &&
+            m_traceOptions != TraceOptions::Off)
+        {
+            StringBuilder msgBuilder;
+            msgBuilder << "Workspace version created, reused " << m_workspace->lastReusedModuleCount
+                       << " modules and discarded " << m_workspace->lastDiscardedModuleCount;
+            logMessage(3, msgBuilder.produceString());
+        }
+
         m_connection->getUnderlyingConnection()->waitForResult(1000);
     }
 
@@ -29,6 +29,7 @@
 #include "slang-ir-lower-error-handling.h"
 #include "slang-ir-obfuscate-loc.h"
 #include "slang-ir-use-uninitialized-out-param.h"
+#include "slang-ir-util.h"
 #include "slang-ir-peephole.h"
 #include "slang-mangle.h"
 #include "slang-type-layout.h"
@@ -10456,6 +10457,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
         dumpIR(module, compileRequest->m_irDumpOptions, "LOWER-TO-IR", compileRequest->getSourceManager(), &writer);
     }
 
+    SLANG_PROFILE_COUNTER("loweredIRInstCount", countInstsRecursively(module->getModuleInst()));
+
     return module;
 }
 
@@ -0,0 +1,705 @@
+// slang-module-cache.cpp
+#include "slang-module-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-stream.h"
+#include "../core/slang-performance-profiler.h"
+#include "../core/slang-string-escape-util.h"
+#include "../core/slang-string-util.h"
+
+#include "slang-compiler.h"
+#include "slang-serialize-container.h"
+
+namespace Slang
+{
+
+// The version of the manifest text. Bump if the format, or what goes into a key changes.
+static const UnownedStringSlice kManifestVersion = UnownedStringSlice::fromLiteral("slang-module-cache 2");
+
+static void _appendString(DigestBuilder<SHA1>& builder, const UnownedStringSlice& slice)
+{
+    // Prefix with the length, so the boundaries between strings are part of the hash
+    builder.append(uint32_t(slice.getLength()));
+    builder.append(slice);
+}
+
+static bool _parseDigest(const UnownedStringSlice& text, SHA1::Digest& outDigest)
+{
+    return DigestUtil::stringToDigest(text.begin(), text.getLength(), outDigest.data, sizeof(outDigest.data));
+}
+
+    // Split "<hex digest> <rest>" as used by the 'file' and 'import' lines
+static bool _parseDigestAndText(const UnownedStringSlice& text, SHA1::Digest& outDigest, UnownedStringSlice& outRest)
+{
+    const Index spaceIndex = text.indexOf(' ');
+    if (spaceIndex < 0 ||
+        !_parseDigest(text.head(spaceIndex), outDigest))
+    {
+        return false;
+    }
+    outRest = text.tail(spaceIndex + 1);
+    return outRest.getLength() > 0;
+}
+
+    // Split off the next space separated integer
+static bool _parseInt(UnownedStringSlice& ioText, Int& outValue)
+{
+    Index spaceIndex = ioText.indexOf(' ');
+    if (spaceIndex <= 0 ||
+        SLANG_FAILED(StringUtil::parseInt(ioText.head(spaceIndex), outValue)))
+    {
+        return false;
+    }
+    ioText = ioText.tail(spaceIndex + 1);
+    return true;
+}
+
+    // Split off the next quoted string, and unquote it
+static bool _parseQuoted(UnownedStringSlice& ioText, String& outValue)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    // The JSON handler lexes from just after the opening quote
+    const char* end = nullptr;
+    if (ioText.getLength() == 0 || ioText[0] != '"' ||
+        SLANG_FAILED(handler->lexQuoted(ioText.begin() + 1, &end)) || end > ioText.end())
+    {
+        return false;
+    }
+
+    StringBuilder buf;
+    if (SLANG_FAILED(StringEscapeUtil::appendUnquoted(handler, UnownedStringSlice(ioText.begin(), end), buf)))
+    {
+        return false;
+    }
+    outValue = buf;
+
+    ioText = UnownedStringSlice(end, ioText.end()).trimStart();
+    return true;
+}
+
+SHA1::Digest ModuleCacheManifest::calcKey(const SHA1::Digest& lookupKey) const
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(lookupKey);
+
+    builder.append(uint32_t(files.getCount()));
+    for (const auto& file : files)
+    {
+        _appendString(builder, file.path.getUnownedSlice());
+        builder.append(file.contentHash);
+    }
+
+    builder.append(uint32_t(imports.getCount()));
+    for (const auto& import : imports)
+    {
+        builder.append(import.key);
+    }
+
+    return builder.finalize();
+}
+
+void ModuleCacheManifest::writeText(StringBuilder& out) const
+{
+    out << kManifestVersion << "\n";
+    out << "key " << key.toString() << "\n";
+    for (const auto& file : files)
+    {
+        out << "file " << file.contentHash.toString() << " " << file.path << "\n";
+    }
+    for (const auto& import : imports)
+    {
+        out << "import " << import.key.toString() << " " << import.moduleName << "\n";
+    }
+
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    for (const auto& diagnostic : diagnostics)
+    {
+        out << "diagnostic " << diagnostic.id << " " << diagnostic.severity << " " << diagnostic.offset << " ";
+        StringEscapeUtil::appendQuoted(handler, diagnostic.path.getUnownedSlice(), out);
+        out << " ";
+        StringEscapeUtil::appendQuoted(handler, diagnostic.message.getUnownedSlice(), out);
+        out << "\n";
+    }
+}
+
+SlangResult ModuleCacheManifest::readText(const UnownedStringSlice& text)
+{
+    files.clear();
+    imports.clear();
+    diagnostics.clear();
+
+    bool hasVersion = false;
+    bool hasKey = false;
+
+    for (auto line : LineParser(text))
+    {
+        if (line.getLength() == 0)
+        {
+            continue;
+        }
+
+        if (!hasVersion)
+        {
+            if (line != kManifestVersion)
+            {
+                return SLANG_FAIL;
+            }
+            hasVersion = true;
+            continue;
+        }
+
+        const Index spaceIndex = line.indexOf(' ');
+        if (spaceIndex < 0)
+        {
+            return SLANG_FAIL;
+        }
+
+        const UnownedStringSlice kind = line.head(spaceIndex);
+        const UnownedStringSlice rest = line.tail(spaceIndex + 1);
+
+        if (kind == toSlice("key"))
+        {
+            if (!_parseDigest(rest, key))
+            {
+                return SLANG_FAIL;
+            }
+            hasKey = true;
+        }
+        else if (kind == toSlice("file"))
+        {
+            File file;
+            UnownedStringSlice path;
+            if (!_parseDigestAndText(rest, file.contentHash, path))
+            {
+                return SLANG_FAIL;
+            }
+            file.path = path;
+            files.add(file);
+        }
+        else if (kind == toSlice("import"))
+        {
+            Import import;
+            UnownedStringSlice moduleName;
+            if (!_parseDigestAndText(rest, import.key, moduleName))
+            {
+                return SLANG_FAIL;
+            }
+            import.moduleName = moduleName;
+            imports.add(import);
+        }
+        else if (kind == toSlice("diagnostic"))
+        {
+            Diagnostic diagnostic;
+            UnownedStringSlice fields = rest;
+            Int id, severity, offset;
+            if (!_parseInt(fields, id) ||
+                !_parseInt(fields, severity) ||
+                !_parseInt(fields, offset) ||
+                !_parseQuoted(fields, diagnostic.path) ||
+                !_parseQuoted(fields, diagnostic.message) ||
+                fields.getLength() != 0)
+            {
+                return SLANG_FAIL;
+            }
+            diagnostic.id = int(id);
+            diagnostic.severity = int(severity);
+            diagnostic.offset = uint32_t(offset);
+            diagnostics.add(diagnostic);
+        }
+        else
+        {
+            return SLANG_FAIL;
+        }
+    }
+
+    return (hasVersion && hasKey) ? SLANG_OK : SLANG_FAIL;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Linkage !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void Linkage::setModuleCacheDirectory(const String& path)
+{
+    m_moduleCacheKeys.clear();
+
+    if (path.getLength() == 0)
+    {
+        m_moduleCache.setNull();
+        return;
+    }
+
+    PersistentCache::Desc desc;
+    desc.directory = path.getBuffer();
+    m_moduleCache = new PersistentCache(desc);
+}
+
+SHA1::Digest Linkage::_calcModuleCacheLookupKey(
+    Name*               name,
+    const PathInfo&     filePathInfo,
+    ISlangBlob*         fileContentsBlob)
+{
+    DigestBuilder<SHA1> builder;
+
+    // A different compiler may produce a different AST/IR, or serialize it differently
+    _appendString(builder, UnownedStringSlice(getBuildTagString()));
+
+    _appendString(builder, getText(name).getUnownedSlice());
+    _appendString(builder, filePathInfo.getMostUniqueIdentity().getUnownedSlice());
+    builder.append(uint64_t(fileContentsBlob->getBufferSize()));
+    builder.append(fileContentsBlob);
+
+    // Options that control how files are found, preprocessed and checked
+    for (auto searchDirectoryList = &searchDirectories; searchDirectoryList; searchDirectoryList = searchDirectoryList->parent)
+    {
+        builder.append(uint32_t(searchDirectoryList->searchDirectories.getCount()));
+        for (const auto& searchDirectory : searchDirectoryList->searchDirectories)
+        {
+            _appendString(builder, searchDirectory.path.getUnownedSlice());
+        }
+    }
+
+    // The dictionary has no defined order, so sort the definitions first
+    List<KeyValuePair<String, String>> definitions;
+    for (const auto& [key, value] : preprocessorDefinitions)
+    {
+        definitions.add(KeyValuePair<String, String>(key, value));
+    }
+    definitions.sort([](const KeyValuePair<String, String>& a, const KeyValuePair<String, String>& b) { return a.key < b.key; });
+
+    builder.append(uint32_t(definitions.getCount()));
+    for (const auto& definition : definitions)
+    {
+        _appendString(builder, definition.key.getUnownedSlice());
+        _appendString(builder, definition.value.getUnownedSlice());
+    }
+
+    builder.append(defaultMatrixLayoutMode);
+    builder.append(debugInfoLevel);
+    builder.append(optimizationLevel);
+    builder.append(m_flag);
+    builder.append(m_useFalcorCustomSharedKeywordSemantics);
+    builder.append(m_enableEffectAnnotations);
+    builder.append(m_allowGLSLInput);
+    builder.append(m_obfuscateCode);
+
+    return builder.finalize();
+}
+
+namespace { // anonymous
+
+struct ModuleBeingLoadedFromCacheRAII
+{
+    ModuleBeingLoadedFromCacheRAII(HashSet<Name*>& names, Name* name)
+        : m_names(names)
+        , m_name(name)
+    {
+        m_names.add(name);
+    }
+    ~ModuleBeingLoadedFromCacheRAII()
+    {
+        m_names.remove(m_name);
+    }
+
+    HashSet<Name*>& m_names;
+    Name* m_name;
+};
+
+} // anonymous
+
+RefPtr<Module> Linkage::_loadModuleFromCache(
+    const SHA1::Digest& lookupKey,
+    Name*               name,
+    const PathInfo&     filePathInfo,
+    ISlangBlob*         fileContentsBlob,
+    SourceLoc const&    loc,
+    DiagnosticSink*     sink,
+    const LoadedModuleDictionary* additionalLoadedModules)
+{
+    if (!m_moduleCache || m_modulesBeingLoadedFromCache.contains(name))
+    {
+        return nullptr;
+    }
+    ModuleBeingLoadedFromCacheRAII moduleBeingLoadedFromCache(m_modulesBeingLoadedFromCache, name);
+
+    SLANG_PROFILE;
+
+    ComPtr<ISlangBlob> entryBlob;
+    if (SLANG_FAILED(m_moduleCache->readEntry(lookupKey, entryBlob.writeRef())))
+    {
+        return nullptr;
+    }
+
+    RiffContainer container;
+    {
+        MemoryStreamBase stream(FileAccess::Read, entryBlob->getBufferPointer(), entryBlob->getBufferSize());
+        if (SLANG_FAILED(RiffUtil::read(&stream, container)))
+        {
+            return nullptr;
+        }
+    }
+
+    // Read the manifest
+    ModuleCacheManifest manifest;
+    {
+        auto entryList = container.getRoot();
+        if (!entryList || entryList->getSubType() != ModuleCacheManifest::kEntryFourCc)
+        {
+            return nullptr;
+        }
+        auto manifestChunk = as<RiffContainer::DataChunk>(entryList->findContained(ModuleCacheManifest::kManifestFourCc));
+        if (!manifestChunk)
+        {
+            return nullptr;
+        }
+
+        List<char> manifestText;
+        manifestText.setCount(Index(manifestChunk->calcPayloadSize()));
+        manifestChunk->getPayload(manifestText.getBuffer());
+
+        if (SLANG_FAILED(manifest.readText(UnownedStringSlice(manifestText.begin(), manifestText.end()))))
+        {
+            return nullptr;
+        }
+    }
+
+    // Check the files that make up the module are unchanged
+    IncludeSystem includeSystem(&searchDirectories, getFileSystemExt(), getSourceManager());
+
+    List<SourceFile*> sourceFiles;
+    for (const auto& file : manifest.files)
+    {
+        PathInfo pathInfo;
+        ComPtr<ISlangBlob> blob;
+        SourceFile* sourceFile = nullptr;
+        if (SLANG_FAILED(includeSystem.findFile(SLANG_PATH_TYPE_DIRECTORY, String(), file.path, pathInfo)) ||
+            SLANG_FAILED(includeSystem.loadFile(pathInfo, blob, sourceFile)) ||
+            !sourceFile)
+        {
+            return nullptr;
+        }
+
+        DigestBuilder<SHA1> builder;
+        builder.append(blob);
+        if (builder.finalize() != file.contentHash)
+        {
+            return nullptr;
+        }
+        sourceFiles.add(sourceFile);
+    }
+
+    // Load the imports, which may themselves come from the cache, and check they are the same
+    // as when the entry was written
+    List<RefPtr<Module>> importedModules;
+    for (const auto& import : manifest.imports)
+    {
+        Name* importName = getNamePool()->getName(import.moduleName);
+        const bool wasImported = mapNameToLoadedModules.containsKey(importName);
+
+        // The manifest may be out of date, and name a module that no longer exists or fails
+        // to compile, so nothing is output until the module is known to have loaded
+        RefPtr<Module> importedModule;
+        List<DiagnosticSink::RecordedDiagnostic> importDiagnostics;
+        {
+            DiagnosticSink::Recording recording(sink, false);
+            importedModule = findOrImportModule(importName, loc, sink, additionalLoadedModules);
+            importDiagnostics = recording.getDiagnostics();
+        }
+
+        if (!importedModule)
+        {
+            // Forget the failed import, so if the module is imported again (such as when this
+            // module is compiled from source) it is retried and the errors are output
+            if (!wasImported)
+            {
+                _forgetImport(importName);
+            }
+            return nullptr;
+        }
+
+        for (const auto& diagnostic : importDiagnostics)
+        {
+            sink->diagnoseRecorded(diagnostic);
+        }
+
+        SHA1::Digest importKey;
+        if (!m_moduleCacheKeys.tryGetValue(importedModule, importKey) ||
+            importKey != import.key)
+        {
+            return nullptr;
+        }
+        importedModules.add(importedModule);
+    }
+
+    if (manifest.calcKey(lookupKey) != manifest.key)
+    {
+        return nullptr;
+    }
+
+    // The entry is valid, so read the AST and IR
+    SerialContainerData containerData;
+    {
+        SerialContainerUtil::ReadOptions options;
+        options.namePool = getNamePool();
+        options.session = getSessionImpl();
+        options.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
+        options.sourceManager = getSourceManager();
+        options.linkage = this;
+        options.sink = sink;
+        options.useExistingVals = true;
+
+        if (SLANG_FAILED(SerialContainerUtil::read(&container, options, containerData)) ||
+            containerData.modules.getCount() != 1)
+        {
+            return nullptr;
+        }
+    }
+
+    auto& srcModule = containerData.modules[0];
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !srcModule.irModule)
+    {
+        return nullptr;
+    }
+
+    RefPtr<Module> module(new Module(this, srcModule.astBuilder));
+
+    // Set the module back reference on the decl
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+    module->setIRModule(srcModule.irModule);
+
+    // Scopes aren't serialized, so recreate the ones parsing would have made. Without them
+    // importing the module would bring no declarations into scope.
+    {
+        auto moduleScope = srcModule.astBuilder->create<Scope>();
+        moduleScope->containerDecl = moduleDecl;
+        moduleScope->parent = getSessionImpl()->slangLanguageScope;
+        moduleDecl->ownedScope = moduleScope;
+
+        for (auto fileDecl : moduleDecl->getMembersOfType<FileDecl>())
+        {
+            auto fileScope = srcModule.astBuilder->create<Scope>();
+            fileScope->containerDecl = fileDecl;
+            fileScope->nextSibling = moduleScope->nextSibling;
+            moduleScope->nextSibling = fileScope;
+        }
+    }
+
+    // Recreate the dependencies, as if the module had been loaded from source
+    {
+        auto sourceManager = getSourceManager();
+        const String uniqueIdentity = filePathInfo.getMostUniqueIdentity();
+
+        SourceFile* mainSourceFile = sourceManager->findSourceFileRecursively(uniqueIdentity);
+        if (!mainSourceFile)
+        {
+            mainSourceFile = sourceManager->createSourceFileWithBlob(filePathInfo, fileContentsBlob);
+            sourceManager->addSourceFile(uniqueIdentity, mainSourceFile);
+        }
+        module->addFileDependency(mainSourceFile);
+    }
+    for (auto sourceFile : sourceFiles)
+    {
+        module->addFileDependency(sourceFile);
+    }
+    for (auto importedModule : importedModules)
+    {
+        module->addModuleDependency(importedModule);
+    }
+
+    mapPathToLoadedModule.add(filePathInfo.getMostUniqueIdentity(), module);
+    mapNameToLoadedModules.add(name, module);
+    loadedModulesList.add(module);
+
+    m_moduleCacheKeys[module] = manifest.key;
+
+    // Report what was reported when the module was checked
+    {
+        auto sourceManager = getSourceManager();
+        Dictionary<SourceFile*, SourceView*> sourceViews;
+        for (const auto& diagnostic : manifest.diagnostics)
+        {
+            DiagnosticSink::RecordedDiagnostic recordedDiagnostic;
+            recordedDiagnostic.id = diagnostic.id;
+            recordedDiagnostic.severity = Severity(diagnostic.severity);
+            recordedDiagnostic.message = diagnostic.message;
+
+            SourceFile* sourceFile = diagnostic.path.getLength() ? sourceManager->findSourceFileRecursively(diagnostic.path) : nullptr;
+            if (sourceFile && diagnostic.offset <= sourceFile->getContentSize())
+            {
+                SourceView* sourceView = nullptr;
+                if (!sourceViews.tryGetValue(sourceFile, sourceView))
+                {
+                    sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+                    sourceViews.add(sourceFile, sourceView);
+                }
+                recordedDiagnostic.loc = sourceView->getRange().begin + diagnostic.offset;
+            }
+
+            sink->diagnoseRecorded(recordedDiagnostic);
+        }
+    }
+
+    module->_discoverEntryPoints(sink);
+    module->_collectShaderParams();
+
+    return module;
+}
+
+void Linkage::_forgetImport(Name* name)
+{
+    RefPtr<LoadedModule> loadedModule;
+    if (!mapNameToLoadedModules.tryGetValue(name, loadedModule))
+    {
+        return;
+    }
+    mapNameToLoadedModules.remove(name);
+
+    if (loadedModule)
+    {
+        List<String> paths;
+        for (const auto& [path, pathModule] : mapPathToLoadedModule)
+        {
+            if (pathModule == loadedModule)
+            {
+                paths.add(path);
+            }
+        }
+        for (const auto& path : paths)
+        {
+            mapPathToLoadedModule.remove(path);
+        }
+
+        const Index index = loadedModulesList.indexOf(loadedModule);
+        if (index >= 0)
+        {
+            loadedModulesList.removeAt(index);
+        }
+    }
+}
+
+void Linkage::_saveModuleToCache(
+    const SHA1::Digest& lookupKey,
+    Module*             module,
+    const PathInfo&     filePathInfo,
+    const List<DiagnosticSink::RecordedDiagnostic>& diagnostics)
+{
+    if (!m_moduleCache || !module->getModuleDecl() || !module->getIRModule())
+    {
+        return;
+    }
+
+    SLANG_PROFILE;
+
+    ModuleCacheManifest manifest;
+
+    // All of the modules this module depends on. Every one must have a key, otherwise
+    // it's not possible to tell if the entry is valid.
+    HashSet<SourceFile*> importedFiles;
+    for (auto importedModule : module->getModuleDependencyList())
+    {
+        if (importedModule == module)
+        {
+            continue;
+        }
+
+        ModuleCacheManifest::Import import;
+        if (!m_moduleCacheKeys.tryGetValue(importedModule, import.key))
+        {
+            return;
+        }
+        import.moduleName = getText(importedModule->getModuleDecl()->getName());
+        manifest.imports.add(import);
+
+        for (auto sourceFile : importedModule->getFileDependencyList())
+        {
+            importedFiles.add(sourceFile);
+        }
+    }
+
+    // The files that belong to this module alone, other than the main file which is part of the lookup key
+    const String uniqueIdentity = filePathInfo.getMostUniqueIdentity();
+    for (auto sourceFile : module->getFileDependencyList())
+    {
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (importedFiles.contains(sourceFile) ||
+            pathInfo.getMostUniqueIdentity() == uniqueIdentity)
+        {
+            continue;
+        }
+
+        // Can only validate files that can be found again
+        if (!pathInfo.hasFileFoundPath() || !sourceFile->getContentBlob())
+        {
+            return;
+        }
+
+        ModuleCacheManifest::File file;
+        file.path = pathInfo.foundPath;
+
+        DigestBuilder<SHA1> builder;
+        builder.append(sourceFile->getContentBlob());
+        file.contentHash = builder.finalize();
+
+        manifest.files.add(file);
+    }
+
+    manifest.key = manifest.calcKey(lookupKey);
+
+    for (const auto& recordedDiagnostic : diagnostics)
+    {
+        ModuleCacheManifest::Diagnostic diagnostic;
+        diagnostic.id = recordedDiagnostic.id;
+        diagnostic.severity = int(recordedDiagnostic.severity);
+        diagnostic.message = recordedDiagnostic.message;
+
+        auto sourceView = recordedDiagnostic.loc.isValid() ? getSourceManager()->findSourceViewRecursively(recordedDiagnostic.loc) : nullptr;
+        if (sourceView)
+        {
+            diagnostic.path = sourceView->getSourceFile()->getPathInfo().getMostUniqueIdentity();
+            diagnostic.offset = uint32_t(sourceView->getRange().getOffset(recordedDiagnostic.loc));
+        }
+        manifest.diagnostics.add(diagnostic);
+    }
+
+    // Even if the entry can't be written, later imports of this module can be validated
+    m_moduleCacheKeys[module] = manifest.key;
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    {
+        StringBuilder manifestText;
+        manifest.writeText(manifestText);
+
+        SerialContainerUtil::WriteOptions options;
+        options.compressionType = serialCompressionType;
+        options.optionFlags |= SerialOptionFlag::SourceLocation;
+        options.sourceManager = getSourceManager();
+
+        RiffContainer container;
+        {
+            RiffContainer::ScopeChunk scopeEntry(&container, RiffContainer::Chunk::Kind::List, ModuleCacheManifest::kEntryFourCc);
+
+            container.addDataChunk(ModuleCacheManifest::kManifestFourCc, manifestText.getBuffer(), manifestText.getLength());
+
+            SerialContainerData data;
+            if (SLANG_FAILED(SerialContainerUtil::addModuleToData(module, options, data)) ||
+                SLANG_FAILED(SerialContainerUtil::write(data, options, &container)))
+            {
+                return;
+            }
+        }
+
+        if (SLANG_FAILED(RiffUtil::write(container.getRoot(), true, &stream)))
+        {
+            return;
+        }
+    }
+
+    auto contents = stream.getContents();
+    auto entryBlob = RawBlob::create(contents.getBuffer(), contents.getCount());
+
+    // Failing to write to the cache is not an error
+    m_moduleCache->writeEntry(lookupKey, entryBlob);
+}
+
+} // namespace Slang
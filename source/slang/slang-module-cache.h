@@ -0,0 +1,68 @@
+// slang-module-cache.h
+#ifndef SLANG_MODULE_CACHE_H
+#define SLANG_MODULE_CACHE_H
+
+#include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-riff.h"
+
+namespace Slang
+{
+
+/* Describes what a module stored in the module cache depends on.
+
+An entry in the module cache is found by a 'lookup key', which is the hash of the options that affect
+checking, the module's name, path and source. Each entry holds a manifest listing the other files
+(from `__include` or `#include`) and the modules that were imported, which must be validated before the
+entry can be used. The entry itself is a RIFF container holding the manifest followed by the
+serialized AST and IR of the module.
+
+The manifest also holds the diagnostics reported when the module was checked, which are reported
+again whenever the entry is used, so that using the cache doesn't change the output.
+*/
+struct ModuleCacheManifest
+{
+    struct File
+    {
+        SHA1::Digest contentHash;       ///< Hash of the contents of the file
+        String path;                    ///< The path the file was found at
+    };
+
+    struct Import
+    {
+        SHA1::Digest key;               ///< The key of the imported module
+        String moduleName;
+    };
+
+        /// A diagnostic reported when the module was checked
+    struct Diagnostic
+    {
+        int id = -1;
+        int severity = 0;               ///< The `Severity` before any overrides
+        String path;                    ///< The unique identity of the file the diagnostic is in, or empty if it has no location
+        uint32_t offset = 0;            ///< The offset in the file
+        String message;
+    };
+
+        /// Calculate the key for the module, which identifies it and everything it depends on
+    SHA1::Digest calcKey(const SHA1::Digest& lookupKey) const;
+
+        /// Write the manifest as text
+    void writeText(StringBuilder& out) const;
+        /// Read the manifest from text produced by `writeText`
+    SlangResult readText(const UnownedStringSlice& text);
+
+    SHA1::Digest key;                   ///< The key of the module, as calculated by `calcKey`
+    List<File> files;                   ///< Source files of the module, not including the main file or files of imports
+    List<Import> imports;               ///< All modules the module depends on, including transitively, in dependency order
+    List<Diagnostic> diagnostics;       ///< Not part of the key
+
+        /// Container for a module cache entry
+    static const FourCC kEntryFourCc = SLANG_FOUR_CC('S', 'L', 'm', 'C');
+        /// The manifest text
+    static const FourCC kManifestFourCc = SLANG_FOUR_CC('S', 'L', 'm', 'm');
+};
+
+} // namespace Slang
+
+#endif
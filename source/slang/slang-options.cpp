@@ -73,6 +73,10 @@ enum class OptionKind
     EmitIr,
     ReportDownstreamTime,
     ReportPerfBenchmark,
+    PerfTrace,
+    ParallelDownstreamCompile,
+    ModuleCachePath,
+    PreludePCHCachePath,
 
     SourceEmbedStyle,
     SourceEmbedName,
@@ -81,6 +85,8 @@ enum class OptionKind
     // Target
 
     Capability,
+    CompactIr,
+    CPUVectorizeWidth,
     DefaultImageFormatUnknown,
     DisableDynamicDispatch,
     DisableSpecialization,
@@ -443,6 +449,20 @@ void initCommandOptions(CommandOptions& options)
         { OptionKind::InputFilesRemain, "--", nullptr, "Treat the rest of the command line as input files."},
         { OptionKind::ReportDownstreamTime, "-report-downstream-time", nullptr, "Reports the time spent in the downstream compiler." },
         { OptionKind::ReportPerfBenchmark, "-report-perf-benchmark", nullptr, "Reports compiler performance benchmark results." },
+        { OptionKind::PerfTrace, "-perf-trace", "-perf-trace <path>",
+        "Record the time spent in each part of the compiler, including every IR pass, and write it to <path> "
+        "in the Chrome trace event JSON format. The file can be viewed with chrome://tracing or https://ui.perfetto.dev" },
+        { OptionKind::ParallelDownstreamCompile, "-parallel-downstream-compile", nullptr,
+        "Run the downstream compilation of each target and entry point (such as with dxc, glslang or a C++ compiler) "
+        "in parallel. Linking and emitting the code that is passed to them is still serial. "
+        "Output and diagnostics are the same as for a serial compile." },
+        { OptionKind::ModuleCachePath, "-module-cache-path", "-module-cache-path <path>",
+        "Cache the serialized AST and IR of imported modules in the directory <path>. A cached module is "
+        "only used if its source files, the modules it imports and the options that affect checking are unchanged." },
+        { OptionKind::PreludePCHCachePath, "-prelude-pch-cache-path", "-prelude-pch-cache-path <path>",
+        "Cache the precompiled C++ prelude, used when compiling for CPU targets with gcc, clang or LLVM, in the directory <path>. "
+        "The directory must not be writable by other users, otherwise the prelude isn't precompiled, and a warning is reported. "
+        "An empty path disables precompiling the prelude. Defaults to a directory in the temporary directory, for the current user." },
         { OptionKind::SourceEmbedStyle, "-source-embed-style", "-source-embed-style <source-embed-style>",
         "If source embedding is enabled, defines the style used. When enabled (with any style other than `none`), "
         "will write compile results into embeddable source for the target language. "
@@ -477,6 +497,12 @@ void initCommandOptions(CommandOptions& options)
     {
         { OptionKind::Capability, "-capability", "-capability <capability>[+<capability>...]",
         "Add optional capabilities to a code generation target. See Capabilities below."},
+        { OptionKind::CompactIr, "-compact-ir", nullptr,
+        "Copy the live IR into new memory between phases of optimization, to release the memory of removed instructions."},
+        { OptionKind::CPUVectorizeWidth, "-cpu-vectorize-width", "-cpu-vectorize-width <count>",
+        "For CPU targets, run the threads of a compute group in gangs of <count> threads, in a loop with hints for the "
+        "downstream C++ compiler to auto-vectorize it at that width. <count> must be at least 1. By default, or with 1, "
+        "the threads are run one at a time."},
         { OptionKind::DefaultImageFormatUnknown, "-default-image-format-unknown", nullptr,
         "Set the format of R/W images with unspecified format to 'unknown'. Otherwise try to guess the format."},
         { OptionKind::DisableDynamicDispatch, "-disable-dynamic-dispatch", nullptr, "Disables generating dynamic dispatch code." },
@@ -643,7 +669,7 @@ void initCommandOptions(CommandOptions& options)
         { OptionKind::Doc, "-doc", nullptr, "Write documentation for -compile-stdlib" },
         { OptionKind::IrCompression,"-ir-compression", "-ir-compression <type>", 
         "Set compression for IR and AST outputs.\n"
-        "Accepted compression types: none, lite"},
+        "Accepted compression types: none, lite, stream"},
         { OptionKind::LoadStdLib, "-load-stdlib", "-load-stdlib <filename>", "Load the StdLib from file." },
         { OptionKind::ReferenceModule, "-r", "-r <name>", "reference module <name>" },
         { OptionKind::SaveStdLib, "-save-stdlib", "-save-stdlib <filename>", "Save the StdLib modules to an archive file." },
@@ -767,6 +793,7 @@ struct OptionsParser
         int                 targetID = -1;
         FloatingPointMode   floatingPointMode = FloatingPointMode::Default;
         bool                forceGLSLScalarLayout = false;
+        Int                 cpuVectorizeWidth = 0;
         List<CapabilityName> capabilityAtoms;
 
         // State for tracking command-line errors
@@ -1826,10 +1853,7 @@ SlangResult OptionsParser::_parse(
                 CommandLineArg fileName;
                 SLANG_RETURN_ON_FAIL(m_reader.expectArg(fileName));
 
-                // Load the file
-                ScopedAllocation contents;
-                SLANG_RETURN_ON_FAIL(File::readAllBytes(fileName.value, contents));
-                SLANG_RETURN_ON_FAIL(m_session->loadStdLib(contents.getData(), contents.getSizeInBytes()));
+                SLANG_RETURN_ON_FAIL(asInternal(m_session)->loadStdLibFromFile(fileName.value));
                 break;
             }
             case OptionKind::CompileStdLib: m_compileStdLib = true; break;
@@ -1923,6 +1947,28 @@ SlangResult OptionsParser::_parse(
                 m_compileRequest->setReportPerfBenchmark(true);
                 break;
             }
+            case OptionKind::PerfTrace:
+            {
+                CommandLineArg perfTrace;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(perfTrace));
+                m_requestImpl->m_perfTracePath = perfTrace.value;
+                break;
+            }
+            case OptionKind::ParallelDownstreamCompile: m_flags |= SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE; break;
+            case OptionKind::ModuleCachePath:
+            {
+                CommandLineArg moduleCachePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(moduleCachePath));
+                m_requestImpl->getLinkage()->setModuleCacheDirectory(moduleCachePath.value);
+                break;
+            }
+            case OptionKind::PreludePCHCachePath:
+            {
+                CommandLineArg preludePCHCachePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(preludePCHCachePath));
+                m_requestImpl->getLinkage()->setPreludePCHCacheDirectory(preludePCHCachePath.value);
+                break;
+            }
             case OptionKind::ModuleName:
             {
                 CommandLineArg moduleName;
@@ -1973,6 +2019,7 @@ SlangResult OptionsParser::_parse(
             case OptionKind::ReproFileSystem: SLANG_RETURN_ON_FAIL(_parseReproFileSystem(arg)); break;
             case OptionKind::SerialIr: m_frontEndReq->useSerialIRBottleneck = true; break;
             case OptionKind::DisableSpecialization: m_requestImpl->disableSpecialization = true; break;
+            case OptionKind::CompactIr: m_requestImpl->compactIR = true; break;
             case OptionKind::DisableDynamicDispatch: m_requestImpl->disableDynamicDispatch = true; break;
             case OptionKind::TrackLiveness: m_requestImpl->setTrackLiveness(true); break;
             case OptionKind::VerbosePaths: m_requestImpl->getSink()->setFlag(DiagnosticSink::Flag::VerbosePath); break;
@@ -2161,6 +2208,19 @@ SlangResult OptionsParser::_parse(
                 getCurrentTarget()->forceGLSLScalarLayout = true;
                 break;
             }
+            case OptionKind::CPUVectorizeWidth:
+            {
+                CommandLineArg laneCountArg;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(laneCountArg));
+                Int laneCount = 0;
+                if (SLANG_FAILED(StringUtil::parseInt(laneCountArg.value.getUnownedSlice(), laneCount)) || laneCount < 1)
+                {
+                    m_sink->diagnose(laneCountArg.loc, Diagnostics::expectingAPositiveInteger, arg.value, laneCountArg.value);
+                    return SLANG_FAIL;
+                }
+                getCurrentTarget()->cpuVectorizeWidth = laneCount;
+                break;
+            }
             case OptionKind::EnableEffectAnnotations:
             {
                 m_compileRequest->setEnableEffectAnnotations(true);
@@ -2816,6 +2876,11 @@ SlangResult OptionsParser::_parse(
         {
             setFloatingPointMode(getCurrentTarget(), m_defaultTarget.floatingPointMode);
         }
+
+        if (m_defaultTarget.cpuVectorizeWidth)
+        {
+            getCurrentTarget()->cpuVectorizeWidth = m_defaultTarget.cpuVectorizeWidth;
+        }
     }
     else
     {
@@ -2910,6 +2975,11 @@ SlangResult OptionsParser::_parse(
         {
             m_compileRequest->setTargetForceGLSLScalarBufferLayout(targetID, true);
         }
+
+        if (rawTarget.cpuVectorizeWidth)
+        {
+            m_requestImpl->getLinkage()->targets[targetID]->setCPUVectorizeWidth(rawTarget.cpuVectorizeWidth);
+        }
     }
 
     if (m_defaultMatrixLayoutMode != SLANG_MATRIX_LAYOUT_MODE_UNKNOWN)
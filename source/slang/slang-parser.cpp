@@ -10,6 +10,7 @@
 #include "slang-lookup-spirv.h"
 
 #include "../core/slang-semantic-version.h"
+#include "../core/slang-performance-profiler.h"
 
 namespace Slang
 {
@@ -7334,6 +7335,8 @@ namespace Slang
         Scope*                          outerScope,
         ContainerDecl*                  parentDecl)
     {
+        SLANG_PROFILE;
+
         ParserOptions options = {};
         options.enableEffectAnnotations = translationUnit->compileRequest->getLinkage()->getEnableEffectAnnotations();
         options.allowGLSLInput = translationUnit->compileRequest->getLinkage()->getAllowGLSLInput();
@@ -14,6 +14,7 @@
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
 #include "../compiler-core/slang-lexer.h"
+#include "../core/slang-performance-profiler.h"
 
 #include <assert.h>
 
@@ -4047,6 +4048,8 @@ TokenList preprocessSource(
     SourceFile*             file,
     PreprocessorDesc const& desc)
 {
+    SLANG_PROFILE;
+
     using namespace preprocessor;
 
     Preprocessor preprocessor;
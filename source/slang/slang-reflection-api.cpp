@@ -6,6 +6,7 @@
 #include "../../slang.h"
 
 #include "slang-compiler.h"
+#include "slang-reflection-snapshot.h"
 #include "slang-type-layout.h"
 #include "slang-syntax.h"
 #include <assert.h>
@@ -2945,6 +2946,21 @@ SLANG_API SlangReflectionVariableLayout* spReflection_getGlobalParamsVarLayout(S
     return convert(program->parametersLayout);
 }
 
+SLANG_API SlangResult spReflection_getSnapshot(SlangReflection* inProgram, ISlangBlob** outBlob)
+{
+    auto program = convert(inProgram);
+    if(!program || !outBlob) return SLANG_E_INVALID_ARG;
+
+    if (!program->reflectionSnapshot)
+    {
+        SLANG_RETURN_ON_FAIL(createReflectionSnapshot(program, program->reflectionSnapshot));
+    }
+
+    ComPtr<ISlangBlob> snapshot(program->reflectionSnapshot);
+    *outBlob = snapshot.detach();
+    return SLANG_OK;
+}
+
 SLANG_API unsigned int spReflection_GetTypeParameterCount(SlangReflection * reflection)
 {
     auto program = convert(reflection);
@@ -0,0 +1,283 @@
+// slang-reflection-snapshot.cpp
+#include "slang-reflection-snapshot.h"
+
+#include "../../slang-reflection-snapshot.h"
+
+#include "../core/slang-blob.h"
+
+#include <string.h>
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+/* Builds the tables of a snapshot by walking the public reflection API, so the snapshot holds exactly what
+the API returns.
+
+Type layouts are often shared (such as the layout of `float4`), so each is only added once. Variable layouts
+are added for each use, such that the fields of a struct are a contiguous range. */
+struct ReflectionSnapshotBuilder
+{
+    typedef slang::ReflectionSnapshotRange Range;
+    typedef slang::ReflectionSnapshotTable Table;
+
+    static const uint32_t kNone = slang::kReflectionSnapshotNone;
+
+    SlangResult build(slang::ShaderReflection* reflection, ComPtr<ISlangBlob>& outBlob)
+    {
+        // The empty string is at offset 0
+        m_strings.add(0);
+
+        slang::ReflectionSnapshotHeader header = {};
+        header.magic = slang::kReflectionSnapshotMagic;
+        header.version = slang::kReflectionSnapshotVersion;
+
+        header.globalParamsVarLayout = addVarLayout(reflection->getGlobalParamsVarLayout());
+
+        const unsigned parameterCount = reflection->getParameterCount();
+        header.parameters = _reserveVarLayouts(parameterCount);
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            _setVarLayout(header.parameters.start + i, reflection->getParameterByIndex(i));
+        }
+
+        const SlangUInt entryPointCount = reflection->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+        {
+            m_entryPoints.add(_createEntryPoint(reflection->getEntryPointByIndex(i)));
+        }
+
+        // Strings are last, as they don't need to be aligned
+        size_t offset = sizeof(header);
+        header.typeLayouts = _allocateTable(m_typeLayouts, offset);
+        header.varLayouts = _allocateTable(m_varLayouts, offset);
+        header.sizes = _allocateTable(m_sizes, offset);
+        header.offsets = _allocateTable(m_offsets, offset);
+        header.entryPoints = _allocateTable(m_entryPoints, offset);
+        header.strings = _allocateTable(m_strings, offset);
+
+        if (offset > 0xffffffff)
+        {
+            return SLANG_FAIL;
+        }
+        header.size = uint32_t(offset);
+
+        List<uint8_t> data;
+        data.setCount(Index(offset));
+        ::memset(data.getBuffer(), 0, offset);
+
+        ::memcpy(data.getBuffer(), &header, sizeof(header));
+        _writeTable(m_typeLayouts, header.typeLayouts, data);
+        _writeTable(m_varLayouts, header.varLayouts, data);
+        _writeTable(m_sizes, header.sizes, data);
+        _writeTable(m_offsets, header.offsets, data);
+        _writeTable(m_entryPoints, header.entryPoints, data);
+        _writeTable(m_strings, header.strings, data);
+
+        outBlob = ListBlob::moveCreate(data);
+        return SLANG_OK;
+    }
+
+    uint32_t addString(const char* text)
+    {
+        if (!text || !*text)
+        {
+            return 0;
+        }
+
+        const UnownedStringSlice slice(text);
+        if (auto indexPtr = m_stringMap.tryGetValue(slice))
+        {
+            return *indexPtr;
+        }
+
+        const uint32_t index = uint32_t(m_strings.getCount());
+        m_strings.addRange(text, slice.getLength());
+        m_strings.add(0);
+
+        // The key has to stay valid, so it refers to the text held by the reflection (not the table, which can move)
+        m_stringMap.add(slice, index);
+        return index;
+    }
+
+    uint32_t addTypeLayout(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+        {
+            return kNone;
+        }
+        if (auto indexPtr = m_typeLayoutMap.tryGetValue(typeLayout))
+        {
+            return *indexPtr;
+        }
+
+        // The index is added to the map before the contents, as a type can refer to itself (through a pointer)
+        const uint32_t index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayouts.add(slang::ReflectionSnapshotTypeLayout());
+        m_typeLayoutMap.add(typeLayout, index);
+
+        slang::ReflectionSnapshotTypeLayout record = {};
+        record.kind = uint32_t(typeLayout->getKind());
+        record.name = addString(typeLayout->getName());
+        if (typeLayout->getType())
+        {
+            record.scalarType = uint32_t(typeLayout->getScalarType());
+            record.rowCount = typeLayout->getRowCount();
+            record.columnCount = typeLayout->getColumnCount();
+            record.resourceShape = uint32_t(typeLayout->getResourceShape());
+            record.resourceAccess = uint32_t(typeLayout->getResourceAccess());
+            record.elementCount = _getSize(typeLayout->getElementCount());
+        }
+        record.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+        record.matrixLayoutMode = uint32_t(typeLayout->getMatrixLayoutMode());
+
+        record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+        record.elementVarLayout = addVarLayout(typeLayout->getElementVarLayout());
+        record.containerVarLayout = addVarLayout(typeLayout->getContainerVarLayout());
+
+        const unsigned fieldCount = typeLayout->getFieldCount();
+        record.fields = _reserveVarLayouts(fieldCount);
+        for (unsigned i = 0; i < fieldCount; ++i)
+        {
+            _setVarLayout(record.fields.start + i, typeLayout->getFieldByIndex(i));
+        }
+
+        const unsigned categoryCount = typeLayout->getCategoryCount();
+        record.sizes = Range{ uint32_t(m_sizes.getCount()), categoryCount };
+        for (unsigned i = 0; i < categoryCount; ++i)
+        {
+            const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+            slang::ReflectionSnapshotSize size = {};
+            size.category = uint32_t(category);
+            size.alignment = typeLayout->getAlignment(category);
+            size.size = _getSize(typeLayout->getSize(category));
+            size.stride = _getSize(typeLayout->getStride(category));
+            m_sizes.add(size);
+        }
+
+        m_typeLayouts[index] = record;
+        return index;
+    }
+
+    uint32_t addVarLayout(slang::VariableLayoutReflection* varLayout)
+    {
+        if (!varLayout)
+        {
+            return kNone;
+        }
+        const uint32_t index = _reserveVarLayouts(1).start;
+        _setVarLayout(index, varLayout);
+        return index;
+    }
+
+protected:
+    static uint64_t _getSize(size_t size)
+    {
+        return size == SLANG_UNBOUNDED_SIZE ? slang::kReflectionSnapshotUnboundedSize : uint64_t(size);
+    }
+
+    Range _reserveVarLayouts(unsigned count)
+    {
+        const Range range = { uint32_t(m_varLayouts.getCount()), count };
+        m_varLayouts.growToCount(m_varLayouts.getCount() + count);
+        return range;
+    }
+
+    void _setVarLayout(uint32_t index, slang::VariableLayoutReflection* varLayout)
+    {
+        slang::ReflectionSnapshotVarLayout record = {};
+        record.name = addString(varLayout->getName());
+        record.typeLayout = addTypeLayout(varLayout->getTypeLayout());
+        record.semanticName = addString(varLayout->getSemanticName());
+        record.semanticIndex = uint32_t(varLayout->getSemanticIndex());
+        record.stage = uint32_t(varLayout->getStage());
+
+        const unsigned categoryCount = varLayout->getCategoryCount();
+        record.offsets = Range{ uint32_t(m_offsets.getCount()), categoryCount };
+        for (unsigned i = 0; i < categoryCount; ++i)
+        {
+            const auto category = SlangParameterCategory(varLayout->getCategoryByIndex(i));
+
+            slang::ReflectionSnapshotOffset offset = {};
+            offset.category = uint32_t(category);
+            offset.space = uint32_t(varLayout->getBindingSpace(category));
+            offset.offset = _getSize(varLayout->getOffset(category));
+            m_offsets.add(offset);
+        }
+
+        m_varLayouts[index] = record;
+    }
+
+    slang::ReflectionSnapshotEntryPoint _createEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        slang::ReflectionSnapshotEntryPoint record = {};
+        record.name = addString(entryPoint->getName());
+        record.nameOverride = addString(entryPoint->getNameOverride());
+        record.stage = uint32_t(entryPoint->getStage());
+        record.varLayout = addVarLayout(entryPoint->getVarLayout());
+        record.resultVarLayout = addVarLayout(entryPoint->getResultVarLayout());
+        record.usesAnySampleRateInput = entryPoint->usesAnySampleRateInput() ? 1 : 0;
+        record.hasDefaultConstantBuffer = entryPoint->hasDefaultConstantBuffer() ? 1 : 0;
+
+        SlangUInt threadGroupSize[3] = {};
+        entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+        for (Index i = 0; i < 3; ++i)
+        {
+            record.threadGroupSize[i] = uint32_t(threadGroupSize[i]);
+        }
+
+        const unsigned parameterCount = entryPoint->getParameterCount();
+        record.parameters = _reserveVarLayouts(parameterCount);
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            _setVarLayout(record.parameters.start + i, entryPoint->getParameterByIndex(i));
+        }
+        return record;
+    }
+
+    template <typename T>
+    static Table _allocateTable(const List<T>& records, size_t& ioOffset)
+    {
+        // Every table starts 8 byte aligned, which is enough for any record
+        ioOffset = (ioOffset + 7) & ~size_t(7);
+
+        Table table;
+        table.offset = uint32_t(ioOffset);
+        table.count = uint32_t(records.getCount());
+
+        ioOffset += sizeof(T) * records.getCount();
+        return table;
+    }
+
+    template <typename T>
+    static void _writeTable(const List<T>& records, const Table& table, List<uint8_t>& ioData)
+    {
+        if (records.getCount())
+        {
+            ::memcpy(ioData.getBuffer() + table.offset, records.getBuffer(), sizeof(T) * records.getCount());
+        }
+    }
+
+    List<char> m_strings;
+    Dictionary<UnownedStringSlice, uint32_t> m_stringMap;
+
+    List<slang::ReflectionSnapshotTypeLayout> m_typeLayouts;
+    Dictionary<slang::TypeLayoutReflection*, uint32_t> m_typeLayoutMap;
+
+    List<slang::ReflectionSnapshotVarLayout> m_varLayouts;
+    List<slang::ReflectionSnapshotSize> m_sizes;
+    List<slang::ReflectionSnapshotOffset> m_offsets;
+    List<slang::ReflectionSnapshotEntryPoint> m_entryPoints;
+};
+
+} // anonymous
+
+SlangResult createReflectionSnapshot(ProgramLayout* programLayout, ComPtr<ISlangBlob>& outBlob)
+{
+    ReflectionSnapshotBuilder builder;
+    return builder.build((slang::ShaderReflection*)programLayout, outBlob);
+}
+
+}
@@ -0,0 +1,18 @@
+// slang-reflection-snapshot.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+namespace Slang
+{
+
+class ProgramLayout;
+
+    /// Create a snapshot of the reflection information of `programLayout`.
+    /// The format is described in `slang-reflection-snapshot.h` in the root of the repository.
+SlangResult createReflectionSnapshot(ProgramLayout* programLayout, ComPtr<ISlangBlob>& outBlob);
+
+}
@@ -300,6 +300,38 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
     return entry->candidateExtensions;
 }
 
+    /// Get the Val that val should be replaced with, so that it is identical to any equal Val that
+    /// already exists (for example a stdlib type). Vals are deduplicated, and so compared by identity.
+static Val* _getUniqueVal(ASTBuilder* astBuilder, Val* val, Dictionary<Val*, Val*>& uniqueVals)
+{
+    if (auto uniqueVal = uniqueVals.tryGetValue(val))
+    {
+        return *uniqueVal;
+    }
+
+    // The key depends on the operands, so they must be made unique first
+    for (auto& operand : val->m_operands)
+    {
+        if (operand.kind == ValNodeOperandKind::ValNode && operand.values.nodeOperand)
+        {
+            operand = ValNodeOperand(_getUniqueVal(astBuilder, as<Val>(operand.values.nodeOperand), uniqueVals));
+        }
+    }
+
+    Val* uniqueVal = val;
+    if (auto existingVal = astBuilder->m_cachedNodes.tryGetValueOrAdd(ValKey(val), val))
+    {
+        uniqueVal = *existingVal;
+    }
+    else
+    {
+        val->_setUnique();
+    }
+
+    uniqueVals.add(val, uniqueVal);
+    return uniqueVal;
+}
+
 /* static */Result SerialContainerUtil::read(RiffContainer* container, const ReadOptions& options, SerialContainerData& out)
 {
     out.clear();
@@ -353,16 +385,26 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             RefPtr<ASTBuilder> astBuilder = options.astBuilder;
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
+            RefPtr<IRSerialDeferredModule> deferredIRModule;
 
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                if (options.deferIRModules)
+                {
+                    // Only decode the data, the instructions are created when the IR is first needed
+                    deferredIRModule = new IRSerialDeferredModule(options.session, sourceLocReader);
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &deferredIRModule->m_data));
+                }
+                else
+                {
+                    IRSerialData serialData;
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
 
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    // Read IR back from serialData
+                    IRSerialReader reader;
+                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -498,7 +540,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                     // Go through all AST nodes:
                     // 1) Add the extensions to the module mapTypeToCandidateExtensions cache
                     // 2) We need to fix the callback pointers for parsing
-                    // 3) Register all `Val`s to the ASTBuilder's deduplication map.
+                    // 3) Register all `Val`s to the ASTBuilder's deduplication map (replacing any that already exist if `useExistingVals` is set).
 
                     {
                         ModuleDecl* moduleDecl = as<ModuleDecl>(astRootNode);
@@ -513,9 +555,11 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         const auto syntaxParseInfos = getSyntaxParseInfos();
                         SLANG_ASSERT(syntaxParseInfos.getCount());
 
-                        for (auto& obj : reader.getObjects())
-                        {
+                        Dictionary<Val*, Val*> uniqueVals;
 
+                        for (Index i = 0; i < reader.getObjects().getCount(); ++i)
+                        {
+                            const auto& obj = reader.getObjects()[i];
                             if (obj.m_kind == SerialTypeKind::NodeBase)
                             {
                                 NodeBase* nodeBase = (NodeBase*)obj.m_ptr;
@@ -569,11 +613,28 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                                 }
                                 else if (Val* val = dynamicCast<Val>(nodeBase))
                                 {
-                                    val->_setUnique();
-                                    astBuilder->m_cachedNodes.tryGetValueOrAdd(ValKey(val), val);
+                                    if (options.useExistingVals)
+                                    {
+                                        Val* uniqueVal = _getUniqueVal(astBuilder, val, uniqueVals);
+                                        if (uniqueVal != val)
+                                        {
+                                            reader.replaceObject(i, SerialPointer(uniqueVal));
+                                        }
+                                    }
+                                    else
+                                    {
+                                        val->_setUnique();
+                                        astBuilder->m_cachedNodes.tryGetValueOrAdd(ValKey(val), val);
+                                    }
                                 }
                             }
                         }
+
+                        // Deserialize again so that references to replaced Vals use the existing ones
+                        if (reader.hasReplacedObjects())
+                        {
+                            SLANG_RETURN_ON_FAIL(reader.deserializeObjects());
+                        }
                     }
                 }
 
@@ -581,13 +642,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || deferredIRModule)
             {
                 SerialContainerData::Module module;
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.deferredIRModule = deferredIRModule;
 
                 out.modules.add(module);
             }
@@ -4,6 +4,7 @@
 
 #include "../core/slang-riff.h"
 #include "slang-serialize-types.h"
+#include "slang-serialize-ir-types.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
 
@@ -51,6 +52,7 @@ struct SerialContainerData
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
+        RefPtr<IRSerialDeferredModule> deferredIRModule;    ///< Set instead of irModule if reading the IR was deferred
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
     };
@@ -92,6 +94,11 @@ struct SerialContainerUtil
         ASTBuilder* astBuilder = nullptr; // Optional. If not provided will create one in SerialContainerData.
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+        bool deferIRModules = false;        ///< If set, IR is read into Module::deferredIRModule, to be turned into an IRModule when needed
+            /// If set, `Val`s equal to ones the ASTBuilder already has are replaced by the existing ones, which
+            /// is needed when reading into a builder that shares `Val`s with other modules (such as the stdlib's).
+            /// Objects that reference a replaced `Val` are deserialized a second time.
+        bool useExistingVals = false;
     };
 
         /// Add module to outData
@@ -252,6 +252,29 @@ SLANG_FORCE_INLINE int IRSerialData::getOperands(const Inst& inst, const InstInd
     }
 }
 
+    /// IR that has been read from a container, but not yet turned into an IRModule.
+    ///
+    /// A module's IR is only needed if it is linked, so creating the IRModule can be deferred
+    /// until it is first used.
+class IRSerialDeferredModule : public RefObject
+{
+public:
+        /// Create the IRModule from the data. The data is released, so this can only be called once.
+    SlangResult read(RefPtr<IRModule>& outModule);
+
+    IRSerialDeferredModule(Session* session, SerialSourceLocReader* sourceLocReader) :
+        m_session(session),
+        m_sourceLocReader(sourceLocReader)
+    {
+    }
+
+    IRSerialData m_data;
+
+protected:
+    Session* m_session;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+};
+
 
 } // namespace Slang
 
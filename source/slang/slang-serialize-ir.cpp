@@ -3,6 +3,7 @@
 
 #include "../core/slang-text-io.h"
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-performance-profiler.h"
 
 #include "slang-ir-insts.h"
 
@@ -396,6 +397,78 @@ Result _encodeInsts(SerialCompressionType compressionType, const List<IRSerialDa
     return SLANG_OK;
 }
 
+    /// Get the number of 32 bit operand values held in the payload of an instruction of the type. Float64 and Int64 payloads are
+    /// held as 64 bit values, and have none.
+static Index _getPayloadUInt32Count(IRSerialData::Inst::PayloadType payloadType)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+    switch (payloadType)
+    {
+        case PayloadType::Operand_1:
+        case PayloadType::String_1:
+        case PayloadType::UInt32:
+        {
+            return 1;
+        }
+        case PayloadType::Operand_2:
+        case PayloadType::OperandAndUInt32:
+        case PayloadType::OperandExternal:
+        case PayloadType::String_2:
+        {
+            return 2;
+        }
+        default: return 0;
+    }
+}
+
+// The VariableByteStream encoding holds the instructions in columns, so that all of the 32 bit values can be decoded in one go.
+// The payload types of all of the instructions (a byte each) come first. Then the op, result type and 32 bit operands of each
+// instruction, stream encoded. Then the 64 bit payloads.
+Result _encodeInstsStream(const List<IRSerialData::Inst>& instsIn, List<uint8_t>& encodeArrayOut, uint32_t& outNumValues)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    const Index numInsts = instsIn.getCount();
+
+    List<uint32_t> values;
+    values.reserve(numInsts * 3);
+    List<uint64_t> wideValues;
+
+    encodeArrayOut.setCount(numInsts);
+    uint8_t* payloadTypes = encodeArrayOut.getBuffer();
+
+    for (Index i = 0; i < numInsts; ++i)
+    {
+        const auto& inst = instsIn[i];
+        payloadTypes[i] = uint8_t(inst.m_payloadType);
+
+        values.add(inst.m_op);
+        values.add((uint32_t)inst.m_resultTypeIndex);
+
+        const Index numOperands = _getPayloadUInt32Count(inst.m_payloadType);
+        for (Index j = 0; j < numOperands; ++j)
+        {
+            values.add((uint32_t)inst.m_payload.m_operands[j]);
+        }
+
+        if (inst.m_payloadType == PayloadType::Float64 || inst.m_payloadType == PayloadType::Int64)
+        {
+            uint64_t wideValue;
+            memcpy(&wideValue, &inst.m_payload.m_int64, sizeof(wideValue));
+            wideValues.add(wideValue);
+        }
+    }
+
+    List<uint8_t> encodedValues;
+    ByteEncodeUtil::encodeStreamUInt32(values.getBuffer(), size_t(values.getCount()), encodedValues);
+
+    encodeArrayOut.addRange(encodedValues);
+    encodeArrayOut.addRange((const uint8_t*)wideValues.getBuffer(), wideValues.getCount() * Index(sizeof(uint64_t)));
+
+    outNumValues = uint32_t(values.getCount());
+    return SLANG_OK;
+}
+
 Result _writeInstArrayChunk(SerialCompressionType compressionType, FourCC chunkId, const List<IRSerialData::Inst>& array, RiffContainer* container)
 {
     typedef RiffContainer::Chunk Chunk;
@@ -428,6 +501,24 @@ Result _writeInstArrayChunk(SerialCompressionType compressionType, FourCC chunkI
 
             return SLANG_OK;
         }
+        case SerialCompressionType::VariableByteStream:
+        {
+            List<uint8_t> compressedPayload;
+            uint32_t numValues = 0;
+            SLANG_RETURN_ON_FAIL(_encodeInstsStream(array, compressedPayload, numValues));
+
+            ScopeChunk scope(container, Chunk::Kind::Data, SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId));
+
+            SerialBinary::CompressedArrayHeader header;
+            header.numEntries = uint32_t(array.getCount());
+            // The number of stream encoded values
+            header.numCompressedEntries = numValues;
+
+            container->write(&header, sizeof(header));
+            container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
+
+            return SLANG_OK;
+        }
         default: break;
     }
     return SLANG_FAIL;
@@ -562,6 +653,65 @@ static Result _decodeInsts(SerialCompressionType compressionType, const uint8_t*
     return SLANG_OK;
 }
 
+static Result _decodeInstsStream(const uint8_t* encodeCur, size_t encodeInSize, size_t numValues, List<IRSerialData::Inst>& instsOut)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    const size_t numInsts = size_t(instsOut.getCount());
+    if (encodeInSize < numInsts)
+    {
+        SLANG_ASSERT(!"Invalid decode");
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* payloadTypes = encodeCur;
+    const uint8_t* encodeEnd = encodeCur + encodeInSize;
+    encodeCur += numInsts;
+
+    List<uint32_t> values;
+    values.setCount(Index(numValues));
+    encodeCur += ByteEncodeUtil::decodeStreamUInt32(encodeCur, size_t(encodeEnd - encodeCur), numValues, values.getBuffer());
+
+    const uint32_t* valueCur = values.getBuffer();
+    const uint32_t* valueEnd = valueCur + numValues;
+
+    IRSerialData::Inst* insts = instsOut.begin();
+    for (size_t i = 0; i < numInsts; ++i)
+    {
+        auto& inst = insts[i];
+
+        const PayloadType payloadType = PayloadType(payloadTypes[i]);
+        inst.m_payloadType = payloadType;
+
+        const Index numOperands = _getPayloadUInt32Count(payloadType);
+        if (valueEnd - valueCur < 2 + numOperands)
+        {
+            SLANG_ASSERT(!"Invalid decode");
+            return SLANG_FAIL;
+        }
+
+        inst.m_op = uint16_t(*valueCur++);
+        inst.m_resultTypeIndex = IRSerialData::InstIndex(*valueCur++);
+        for (Index j = 0; j < numOperands; ++j)
+        {
+            inst.m_payload.m_operands[j] = IRSerialData::InstIndex(*valueCur++);
+        }
+
+        if (payloadType == PayloadType::Float64 || payloadType == PayloadType::Int64)
+        {
+            if (encodeEnd - encodeCur < Index(sizeof(uint64_t)))
+            {
+                SLANG_ASSERT(!"Invalid decode");
+                return SLANG_FAIL;
+            }
+            memcpy(&inst.m_payload.m_int64, encodeCur, sizeof(uint64_t));
+            encodeCur += sizeof(uint64_t);
+        }
+    }
+
+    return SLANG_OK;
+}
+
 static Result _readInstArrayChunk(SerialCompressionType containerCompressionType, RiffContainer::DataChunk* chunk, List<IRSerialData::Inst>& arrayOut)
 {
     SerialCompressionType compressionType = SerialCompressionType::None;
@@ -589,6 +739,18 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
             SLANG_RETURN_ON_FAIL(_decodeInsts(compressionType, read.getData(), read.getRemainingSize(), arrayOut));
             break;
         }
+        case SerialCompressionType::VariableByteStream:
+        {
+            RiffReadHelper read = chunk->asReadHelper();
+
+            SerialBinary::CompressedArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+
+            arrayOut.setCount(header.numEntries);
+
+            SLANG_RETURN_ON_FAIL(_decodeInstsStream(read.getData(), read.getRemainingSize(), header.numCompressedEntries, arrayOut));
+            break;
+        }
         default:
         {
             return SLANG_FAIL;
@@ -932,4 +1094,19 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialDeferredModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+SlangResult IRSerialDeferredModule::read(RefPtr<IRModule>& outModule)
+{
+    SLANG_PROFILE;
+
+    IRSerialReader reader;
+    const SlangResult res = reader.read(m_data, m_session, m_sourceLocReader, outModule);
+
+    // The data isn't needed once the instructions have been created
+    m_data.clear();
+    m_sourceLocReader.setNull();
+    return res;
+}
+
 } // namespace Slang
@@ -162,6 +162,21 @@ struct ByteReader
             container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
             break;
         }
+        case SerialCompressionType::VariableByteStream:
+        {
+            List<uint8_t> compressedPayload;
+
+            size_t numCompressedEntries = (numEntries * typeSize) / sizeof(uint32_t);
+            ByteEncodeUtil::encodeStreamUInt32((const uint32_t*)data, numCompressedEntries, compressedPayload);
+
+            SerialBinary::CompressedArrayHeader header;
+            header.numEntries = uint32_t(numEntries);
+            header.numCompressedEntries = uint32_t(numCompressedEntries);
+
+            container->write(&header, sizeof(header));
+            container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
+            break;
+        }
         default:
         {
             return SLANG_FAIL;
@@ -191,6 +206,17 @@ struct ByteReader
             ByteEncodeUtil::decodeLiteUInt32(read.getData(), header.numCompressedEntries, (uint32_t*)dst);
             break;
         }
+        case SerialCompressionType::VariableByteStream:
+        {
+            Bin::CompressedArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+
+            void* dst = listOut.setSize(header.numEntries);
+            SLANG_ASSERT(header.numCompressedEntries == uint32_t((header.numEntries * typeSize) / sizeof(uint32_t)));
+
+            ByteEncodeUtil::decodeStreamUInt32(read.getData(), read.getRemainingSize(), header.numCompressedEntries, (uint32_t*)dst);
+            break;
+        }
         case SerialCompressionType::None:
         {
             // Read uncompressed
@@ -202,6 +228,11 @@ struct ByteReader
             ::memcpy(dst, read.getData(), payloadSize);
             break;
         }
+        default:
+        {
+            // Written with a compression type this version doesn't know about
+            return SLANG_FAIL;
+        }
     }
     return SLANG_OK;
 }
@@ -210,7 +241,8 @@ struct ByteReader
 
 #define SLANG_SERIAL_BINARY_COMPRESSION_TYPE(x) \
     x(None, none) \
-    x(VariableByteLite, lite)
+    x(VariableByteLite, lite) \
+    x(VariableByteStream, stream)
 
 /* static */SlangResult SerialParseUtil::parseCompressionType(const UnownedStringSlice& text, SerialCompressionType& outType)
 {
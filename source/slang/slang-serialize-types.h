@@ -41,6 +41,7 @@ enum class SerialCompressionType : uint8_t
 {
     None,
     VariableByteLite,
+    VariableByteStream,         ///< Stream VByte style encoding, which can be decoded with SIMD. See ByteEncodeUtil.
 };
 
 
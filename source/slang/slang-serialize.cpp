@@ -929,7 +929,7 @@ SlangResult SerialReader::deserializeObjects()
         const Entry* entry = m_entries[i];
         // First see if there is anything to construct
         SerialPointer& dstPtr = m_objects[i];
-        if (!dstPtr)
+        if (!dstPtr || (m_replacedObjects.getCount() && m_replacedObjects.contains(i)))
         {
             continue;
         }
@@ -973,6 +973,12 @@ SlangResult SerialReader::deserializeObjects()
     return SLANG_OK;
 }
 
+void SerialReader::replaceObject(Index index, const SerialPointer& obj)
+{
+    m_objects[index] = obj;
+    m_replacedObjects.add(index);
+}
+
 
 SlangResult SerialReader::load(const uint8_t* data, size_t dataCount, NamePool* namePool)
 {
@@ -238,6 +238,11 @@ public:
     SlangResult constructObjects(NamePool* namePool);
         /// Entries must be loaded (with loadEntries), and objects constructed (with constructObjects) before deserializing
     SlangResult deserializeObjects();
+        /// Replace the object at index with obj. Deserializing again then makes references to the entry
+        /// use obj, and leaves obj itself untouched.
+    void replaceObject(Index index, const SerialPointer& obj);
+        /// True if any object has been replaced
+    bool hasReplacedObjects() const { return m_replacedObjects.getCount() != 0; }
 
         /// NOTE! data must stay ins scope when reading takes place
     SlangResult load(const uint8_t* data, size_t dataCount, NamePool* namePool);
@@ -274,6 +279,7 @@ protected:
     List<const Entry*> m_entries;       ///< The entries
 
     List<SerialPointer> m_objects;      ///< The constructed objects
+    HashSet<Index> m_replacedObjects;   ///< Indices of objects set with replaceObject
     NamePool* m_namePool;               ///< Pool names are added to
 
     List<const RefObject*> m_scope;     ///< Keeping objects in scope
@@ -897,6 +897,9 @@ public:
 
         /// Holds all of the string literals that have been hashed
     StringSlicePool hashedStringLiteralPool;
+
+        /// The reflection snapshot of this layout, made when it is first requested
+    ComPtr<ISlangBlob> reflectionSnapshot;
 };
 
 StructTypeLayout* getGlobalStructLayout(
@@ -33,9 +33,29 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     RefPtr<DocumentVersion> doc = new DocumentVersion();
     doc->setText(text.getUnownedSlice());
     doc->setPath(path);
+
+    // The search paths include the directories of the documents, and a linkage can't be reused
+    // once they have changed.
+    auto directory = Path::getParentDirectory(path);
+    bool isNewSearchPath = workspaceSearchPaths.add(directory);
+    if (!searchInWorkspace)
+    {
+        isNewSearchPath = true;
+        for (const auto& [docPath, _] : openedDocuments)
+        {
+            if (docPath != path && Path::getParentDirectory(docPath) == directory)
+            {
+                isNewSearchPath = false;
+                break;
+            }
+        }
+    }
+
     openedDocuments[path] = doc;
-    workspaceSearchPaths.add(Path::getParentDirectory(path));
-    invalidate();
+    if (isNewSearchPath)
+        invalidateAll();
+    else
+        invalidate();
     return doc.Ptr();
 }
 
@@ -49,14 +69,8 @@ void Workspace::changeDoc(const String& path, LanguageServerProtocol::Range rang
         auto startOffset = doc->getOffset(line, col);
         doc->zeroBasedUTF16LocToOneBasedUTF8Loc(range.end.line, range.end.character, line, col);
         auto endOffset = doc->getOffset(line, col);
-        auto originalText = doc->getText().getUnownedSlice();
-        StringBuilder newText;
-        if (startOffset != -1)
-            newText << originalText.head(startOffset);
-        newText << text;
-        if (endOffset != -1)
-            newText << originalText.tail(endOffset);
-        changeDoc(doc.Ptr(), newText.produceString());
+        doc->replaceText(startOffset, endOffset, text.getUnownedSlice());
+        invalidate();
     }
 }
 
@@ -109,7 +123,7 @@ bool Workspace::updatePredefinedMacros(List<String> macros)
     if (changed)
     {
         predefinedMacros = _Move(newDefs);
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -133,7 +147,7 @@ bool Workspace::updateSearchPaths(List<String> paths)
     if (changed)
     {
         additionalSearchPaths = _Move(paths);
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -144,7 +158,7 @@ bool Workspace::updateSearchInWorkspace(bool value)
     searchInWorkspace = value;
     if (changed)
     {
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -188,7 +202,18 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
     slangGlobalSession = globalSession;
 }
 
-void Workspace::invalidate() { currentVersion = nullptr; }
+void Workspace::invalidate()
+{
+    if (currentVersion)
+        previousVersion = currentVersion;
+    currentVersion = nullptr;
+}
+
+void Workspace::invalidateAll()
+{
+    previousVersion = nullptr;
+    currentVersion = nullptr;
+}
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
 {
@@ -327,6 +352,169 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     return version;
 }
 
+// Remove the elements of `list` that `predicate` is true for, keeping the order of the rest.
+template<typename T, typename Func>
+static void _removeIf(List<T>& list, const Func& predicate)
+{
+    Index count = 0;
+    for (Index i = 0; i < list.getCount(); i++)
+    {
+        if (predicate(list[i]))
+            continue;
+        if (count != i)
+            list[count] = _Move(list[i]);
+        count++;
+    }
+    // Release what the removed elements hold before dropping them.
+    for (Index i = count; i < list.getCount(); i++)
+        list[i] = T();
+    list.setCount(count);
+}
+
+RefPtr<WorkspaceVersion> Workspace::createIncrementalWorkspaceVersion(WorkspaceVersion* previous)
+{
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->flavor = previous->flavor;
+    version->linkage = previous->linkage;
+    version->totalDiscardedModuleCount = previous->totalDiscardedModuleCount;
+
+    Linkage* linkage = version->linkage;
+    linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+
+    // Files may have changed on disk as well as in the editor, so don't use cached contents.
+    linkage->getFileSystemExt()->clearCache();
+    linkage->destroyTypeCheckingCache();
+
+    // Find the source files whose contents differ from what would be loaded now.
+    Dictionary<SourceFile*, bool> isFileChangedMap;
+    auto isFileChanged = [&](SourceFile* sourceFile) -> bool
+    {
+        bool changed = false;
+        if (isFileChangedMap.tryGetValue(sourceFile, changed))
+            return changed;
+
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (pathInfo.type == PathInfo::Type::Normal || pathInfo.type == PathInfo::Type::FoundPath)
+        {
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_FAILED(loadFile(pathInfo.foundPath.getBuffer(), blob.writeRef())))
+            {
+                changed = true;
+            }
+            else
+            {
+                auto content = sourceFile->getContent();
+                changed = blob->getBufferSize() != size_t(content.getLength()) ||
+                    ::memcmp(blob->getBufferPointer(), content.begin(), blob->getBufferSize()) != 0;
+            }
+        }
+        isFileChangedMap[sourceFile] = changed;
+        return changed;
+    };
+
+    // The file dependencies of a module include the files of the modules it imports, so a module is
+    // discarded along with everything it depends on that has changed.
+    HashSet<Module*> discardedModules;
+    for (auto module : linkage->loadedModulesList)
+    {
+        for (auto sourceFile : module->getFileDependencyList())
+        {
+            if (isFileChanged(sourceFile))
+            {
+                discardedModules.add(module);
+                break;
+            }
+        }
+    }
+    // Modules for documents that are no longer open aren't needed.
+    for (const auto& [path, module] : previous->modules)
+    {
+        if (!openedDocuments.containsKey(path))
+            discardedModules.add(module);
+    }
+
+    // Carry over the open documents' modules that are being kept, along with their diagnostics.
+    for (const auto& [path, module] : previous->modules)
+    {
+        if (discardedModules.contains(module))
+            continue;
+        version->modules[path] = module;
+        if (auto diagnosticOutput = previous->moduleDiagnosticOutputs.tryGetValue(path))
+            version->addModuleDiagnostics(path, *diagnosticOutput);
+    }
+    for (const auto& [moduleDecl, markup] : previous->markupASTs)
+    {
+        if (!discardedModules.contains(moduleDecl->module))
+            version->markupASTs[moduleDecl] = markup;
+    }
+
+    // The preprocessor information recorded for files that only discarded modules use will be
+    // recorded again when they are reloaded.
+    HashSet<SourceFile*> keptFiles;
+    HashSet<SourceFile*> discardedFiles;
+    for (auto module : linkage->loadedModulesList)
+    {
+        const bool isDiscarded = discardedModules.contains(module);
+        for (auto sourceFile : module->getFileDependencyList())
+            (isDiscarded ? discardedFiles : keptFiles).add(sourceFile);
+    }
+    auto sourceManager = linkage->getSourceManager();
+    auto isLocDiscarded = [&](SourceLoc loc) -> bool
+    {
+        auto sourceView = sourceManager->findSourceView(loc);
+        if (!sourceView)
+            return false;
+        auto sourceFile = sourceView->getSourceFile();
+        return discardedFiles.contains(sourceFile) && !keptFiles.contains(sourceFile);
+    };
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    _removeIf(preprocessorInfo.macroDefinitions, [&](const MacroDefinitionContentAssistInfo& info) { return isLocDiscarded(info.loc); });
+    _removeIf(preprocessorInfo.macroInvocations, [&](const MacroInvocationContentAssistInfo& info) { return isLocDiscarded(info.loc); });
+    _removeIf(preprocessorInfo.fileIncludes, [&](const FileIncludeContentAssistInfo& info) { return isLocDiscarded(info.loc); });
+
+    // Changed files must be read again rather than found by their unique identity.
+    for (const auto& [sourceFile, changed] : isFileChangedMap)
+    {
+        if (changed)
+            sourceManager->removeSourceFile(sourceFile);
+    }
+
+    // Remove the discarded modules from the linkage, so they are loaded again when needed. Imports that
+    // failed are also retried, as the files they failed on may now be available.
+    // Hold references until the end, as the linkage may hold the only ones.
+    List<RefPtr<Module>> discardedModuleRefs;
+    _removeIf(linkage->loadedModulesList, [&](const RefPtr<Module>& module)
+    {
+        if (!discardedModules.contains(module))
+            return false;
+        discardedModuleRefs.add(module);
+        return true;
+    });
+    version->reusedModuleCount = linkage->loadedModulesList.getCount();
+    version->discardedModuleCount = discardedModuleRefs.getCount();
+    version->totalDiscardedModuleCount += discardedModuleRefs.getCount();
+
+    List<String> discardedPaths;
+    for (const auto& [path, module] : linkage->mapPathToLoadedModule)
+    {
+        if (!module || discardedModules.contains(module))
+            discardedPaths.add(path);
+    }
+    for (const auto& path : discardedPaths)
+        linkage->mapPathToLoadedModule.remove(path);
+    List<Name*> discardedNames;
+    for (const auto& [name, module] : linkage->mapNameToLoadedModules)
+    {
+        if (!module || discardedModules.contains(module))
+            discardedNames.add(name);
+    }
+    for (auto name : discardedNames)
+        linkage->mapNameToLoadedModules.remove(name);
+
+    return version;
+}
+
 SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 {
     String canonnicalPath;
@@ -342,7 +530,16 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        if (previousVersion && previousVersion->totalDiscardedModuleCount < kMaxDiscardedModuleCount)
+            currentVersion = createIncrementalWorkspaceVersion(previousVersion);
+        else
+            currentVersion = createWorkspaceVersion();
+        previousVersion = nullptr;
+        versionCreationCount++;
+        lastReusedModuleCount = currentVersion->reusedModuleCount;
+        lastDiscardedModuleCount = currentVersion->discardedModuleCount;
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
@@ -379,44 +576,100 @@ void* Workspace::castAs(const Guid& guid)
     return getObject(guid);
 }
 
+const String& DocumentVersion::getText()
+{
+    return text.getText();
+}
+
 void DocumentVersion::setText(const String& newText)
 {
-    text = newText;
-    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    text.setText(newText);
     utf16CharStarts.clear();
 }
+
+void DocumentVersion::replaceText(Index startOffset, Index endOffset, UnownedStringSlice newText)
+{
+    const auto change = text.replaceText(startOffset, endOffset, newText);
+
+    // Drop the UTF-16 boundaries of the lines that changed, or have moved.
+    const Index firstLine = change.firstLine + 1;
+    List<Index> staleLines;
+    for (const auto& [line, _] : utf16CharStarts)
+    {
+        if (line >= firstLine && (change.oldLineCount != change.newLineCount || line < firstLine + change.oldLineCount))
+            staleLines.add(line);
+    }
+    for (auto line : staleLines)
+        utf16CharStarts.remove(line);
+}
+
+Index DocumentVersion::getOffset(Index lineIndex, Index colIndex)
+{
+    if (lineIndex < 0)
+        return -1;
+    if (lineIndex - 1 >= text.getLineCount())
+        return -1;
+
+    const Index lineStart = lineIndex >= 1 ? text.getLineStart(lineIndex - 1) : 0;
+    return lineStart + colIndex - 1;
+}
+
+void DocumentVersion::offsetToLineCol(Index offset, Index& line, Index& col)
+{
+    if (offset < 0)
+    {
+        line = 0;
+        col = offset + 1;
+        return;
+    }
+    Index lineStart = 0;
+    line = text.getLineForOffset(offset, lineStart) + 1;
+    col = offset - lineStart + 1;
+}
+
+UnownedStringSlice DocumentVersion::getLine(Index lineIndex)
+{
+    if (lineIndex <= 0)
+        return UnownedStringSlice();
+    if (lineIndex - 1 >= text.getLineCount())
+        return UnownedStringSlice();
+
+    return StringUtil::trimEndOfLine(text.getLineWithEnd(lineIndex - 1));
+}
+
 ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
 {
-    if (!utf16CharStarts.getCount())
+    if (auto cachedBounds = utf16CharStarts.tryGetValue(line))
+        return cachedBounds->getArrayView();
+    if (line < 1 || line > text.getLineCount())
+        return ArrayView<Index>();
+
+    auto slice = getLine(line);
+    List<Index> bounds;
+    Index index = 0;
+    while (index < slice.getLength())
     {
-        for (auto slice : lines)
-        {
-            List<Index> bounds;
-            Index index = 0;
-            while (index < slice.getLength())
+        auto startIndex = index;
+        const Char32 codePoint = getUnicodePointFromUTF8(
+            [&]() -> Byte
             {
-                auto startIndex = index;
-                const Char32 codePoint = getUnicodePointFromUTF8(
-                    [&]() -> Byte
-                    {
-                        if (index < slice.getLength())
-                            return slice[index++];
-                        else
-                            return '\0';
-                    });
-                if (!codePoint)
-                    break;
-                Char16 buffer[2];
-                int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
-                for (int i = 0; i < count; i++)
-                    bounds.add(startIndex);
-            }
-            bounds.add(slice.getLength());
-            utf16CharStarts.add(_Move(bounds));
-        }
+                if (index < slice.getLength())
+                    return slice[index++];
+                else
+                    return '\0';
+            });
+        if (!codePoint)
+            break;
+        Char16 buffer[2];
+        int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
+        for (int i = 0; i < count; i++)
+            bounds.add(startIndex);
     }
-    return line >= 1 && line <= utf16CharStarts.getCount() ? utf16CharStarts[line - 1].getArrayView()
-                                                           : ArrayView<Index>();
+    bounds.add(slice.getLength());
+
+    auto& lineBounds = utf16CharStarts[line];
+    lineBounds = _Move(bounds);
+    return lineBounds.getArrayView();
 }
 
 void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
@@ -449,30 +702,37 @@ static bool _isIdentifierChar(char ch)
 
 UnownedStringSlice DocumentVersion::peekIdentifier(Index& offset)
 {
-    Index start = offset;
-    Index end = offset;
-    if (start >= text.getLength())
+    if (offset < 0 || offset >= text.getLength())
         return UnownedStringSlice("");
 
-    while (start >= 0 && _isIdentifierChar(text[start]))
+    // Identifiers don't span lines, so are always within a single chunk.
+    Index chunkOffset = 0;
+    auto chunkText = text.getChunkText(offset, chunkOffset);
+
+    Index start = offset - chunkOffset;
+    Index end = start;
+    while (start >= 0 && _isIdentifierChar(chunkText[start]))
         start--;
-    while (end < text.getLength() && _isIdentifierChar(text[end]))
+    while (end < chunkText.getLength() && _isIdentifierChar(chunkText[end]))
         end++;
-    offset = start + 1;
-    if (end > offset)
-        return text.getUnownedSlice().subString(start + 1, end - start - 1);
+    offset = chunkOffset + start + 1;
+    if (end > start + 1)
+        return chunkText.subString(start + 1, end - start - 1);
     return UnownedStringSlice("");
 }
 
 int DocumentVersion::getTokenLength(Index offset)
 {
-    if (offset >= 0)
+    if (offset >= 0 && offset < text.getLength())
     {
-        Index pos = offset;
-        for (; pos < text.getLength() && _isIdentifierChar(text[pos]); ++pos)
+        Index chunkOffset = 0;
+        auto chunkText = text.getChunkText(offset, chunkOffset);
+        const Index chunkStart = offset - chunkOffset;
+        Index pos = chunkStart;
+        for (; pos < chunkText.getLength() && _isIdentifierChar(chunkText[pos]); ++pos)
         {
         }
-        return (int)(pos - offset);
+        return (int)(pos - chunkStart);
     }
     return 0;
 }
@@ -564,14 +824,21 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     if (diagnosticBlob)
     {
         auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.tryGetValue(path);
-        if (docDiagnostic)
-            docDiagnostic->originalOutput = diagnosticString;
+        if (parsedModule)
+            moduleDiagnosticOutputs[path] = diagnosticString;
+        addModuleDiagnostics(path, diagnosticString);
     }
     return static_cast<Module*>(parsedModule);
 }
 
+void WorkspaceVersion::addModuleDiagnostics(const String& path, const String& diagnosticOutput)
+{
+    parseDiagnostics(diagnosticOutput);
+    auto docDiagnostic = diagnostics.tryGetValue(path);
+    if (docDiagnostic)
+        docDiagnostic->originalOutput = diagnosticOutput;
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.getCount() == 0)
@@ -5,6 +5,7 @@
 #include "../../slang.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-com-object.h"
+#include "../compiler-core/slang-chunked-text.h"
 #include "../compiler-core/slang-language-server-protocol.h"
 #include "slang-compiler.h"
 #include "slang-doc-ast.h"
@@ -18,9 +19,10 @@ namespace Slang
     private:
         URI uri;
         String path;
-        String text;
-        List<UnownedStringSlice> lines;
-        List<List<Index>> utf16CharStarts;
+        // Held in chunks of lines, so an edit only rebuilds the chunks it touches.
+        ChunkedText text;
+        // The UTF-16 boundaries of each 1-based line, computed when a line is first asked for.
+        Dictionary<Index, List<Index>> utf16CharStarts;
     public:
         void setPath(String filePath)
         {
@@ -29,8 +31,12 @@ namespace Slang
         }
         URI getURI() { return uri; }
         String getPath() { return path; }
-        const String& getText() { return text; }
+        // Get the whole text. This makes a contiguous copy the first time it is called after an edit.
+        const String& getText();
         void setText(const String& newText);
+        // Replace the text between the offsets `startOffset` and `endOffset`. An offset of -1 means
+        // the start or end of the text respectively.
+        void replaceText(Index startOffset, Index endOffset, UnownedStringSlice newText);
 
         ArrayView<Index> getUTF16Boundaries(Index line);
 
@@ -39,9 +45,6 @@ namespace Slang
         void zeroBasedUTF16LocToOneBasedUTF8Loc(
             Index inLine, Index inCol, Index& outLine, Index& outCol);
 
-        // Get starting offset of line.
-        Index getLineStart(UnownedStringSlice line) { return line.begin() - text.begin(); }
-
         UnownedStringSlice peekIdentifier(Index line, Index col, Index& offset)
         {
             offset = getOffset(line, col);
@@ -51,50 +54,13 @@ namespace Slang
         UnownedStringSlice peekIdentifier(Index& offset);
 
         // Get offset from 1-based, utf-8 encoding location.
-        Index getOffset(Index lineIndex, Index colIndex)
-        {
-            if(lineIndex < 0) return -1;
-            if (lineIndex - 1 >= lines.getCount())
-                return -1;
-            if (lines.getCount() == 0)
-                return -1;
-
-            Index lineStart = lineIndex >= 1 ? getLineStart(lines[lineIndex - 1]) : 0;
-            return lineStart + colIndex - 1;
-        }
+        Index getOffset(Index lineIndex, Index colIndex);
 
         // Get 1-based, utf-8 encoding location from offset.
-        void offsetToLineCol(Index offset, Index& line, Index& col)
-        {
-            auto firstGreater = std::upper_bound(
-                lines.begin(),
-                lines.end(),
-                offset,
-                [this](Index first, UnownedStringSlice second)
-                { return first < getLineStart(second); });
-            line = Index(firstGreater - lines.begin());
-            if (firstGreater == lines.begin())
-            {
-                col = offset + 1;
-            }
-            else
-            {
-                col = Index(offset - getLineStart(lines[line-1])) + 1;
-            }
-        }
+        void offsetToLineCol(Index offset, Index& line, Index& col);
 
-        // Get line from 1-based index.
-        UnownedStringSlice getLine(Index lineIndex)
-        {
-            if (lineIndex < 0)
-                return UnownedStringSlice();
-            if (lineIndex - 1 >= lines.getCount())
-                return UnownedStringSlice();
-            if (lines.getCount() == 0)
-                return UnownedStringSlice();
-
-            return lineIndex > 0 ? lines[lineIndex - 1] : UnownedStringSlice();
-        }
+        // Get line from 1-based index. The line is valid until the text is next changed.
+        UnownedStringSlice getLine(Index lineIndex);
 
         // Get length of an identifier token starting at the specified position.
         int getTokenLength(Index line, Index col);
@@ -116,16 +82,30 @@ namespace Slang
 
     class WorkspaceVersion : public RefObject
     {
+        friend class Workspace;
     private:
         Dictionary<String, Module*> modules;
+        // The diagnostic output from loading each of `modules`, so a later version reusing the
+        // module can report the same diagnostics.
+        Dictionary<String, String> moduleDiagnosticOutputs;
         Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
         Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
         void parseDiagnostics(String compilerOutput);
+        void addModuleDiagnostics(const String& path, const String& diagnosticOutput);
     public:
         Workspace* workspace;
         WorkspaceFlavor flavor = WorkspaceFlavor::Standard;
         RefPtr<Linkage> linkage;
         Dictionary<String, DocumentDiagnostics> diagnostics;
+
+        // Number of modules loaded by an earlier version that were reused by this one.
+        Count reusedModuleCount = 0;
+        // Number of modules loaded by an earlier version that had to be loaded again, because
+        // one of their files changed.
+        Count discardedModuleCount = 0;
+        // Number of modules discarded from `linkage` since it was created. Their ASTs are
+        // still held by the linkage.
+        Count totalDiscardedModuleCount = 0;
         ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
         Module* getOrLoadModule(String path);
         void ensureWorkspaceFlavor(UnownedStringSlice path);
@@ -142,10 +122,24 @@ namespace Slang
         , public ComObject
     {
     private:
+        // Once this many modules have been discarded from a linkage, a new linkage is created
+        // rather than reusing it, to release the memory they use.
+        static const Count kMaxDiscardedModuleCount = 256;
+
         RefPtr<WorkspaceVersion> currentVersion;
+        // The version current before the last change to the documents. The next version reuses
+        // its linkage, and the modules whose files haven't changed.
+        RefPtr<WorkspaceVersion> previousVersion;
         RefPtr<WorkspaceVersion> currentCompletionVersion;
         RefPtr<WorkspaceVersion> createWorkspaceVersion();
+        RefPtr<WorkspaceVersion> createIncrementalWorkspaceVersion(WorkspaceVersion* previous);
     public:
+        // Incremented every time a version is created by `getCurrentVersion`.
+        Index versionCreationCount = 0;
+        // The modules reused and discarded by the last version created by `getCurrentVersion`.
+        Count lastReusedModuleCount = 0;
+        Count lastDiscardedModuleCount = 0;
+
         List<String> rootDirectories;
         List<String> additionalSearchPaths;
         OrderedHashSet<String> workspaceSearchPaths;
@@ -166,7 +160,10 @@ namespace Slang
         bool updateSearchInWorkspace(bool value);
 
         void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
+        // The documents have changed. The next version can reuse the modules that are unaffected.
         void invalidate();
+        // The options have changed, so the next version must load everything again.
+        void invalidateAll();
         WorkspaceVersion* getCurrentVersion();
         WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
         WorkspaceVersion* createVersionForCompletion();
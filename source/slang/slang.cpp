@@ -17,6 +17,7 @@
 
 #include "../core/slang-memory-file-system.h"
 
+#include "slang-compile-result-cache.h"
 #include "slang-module-library.h"
 
 #include "slang-check.h"
@@ -368,6 +369,24 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
 }
 
 SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
+{
+    // Make a file system to read it from
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(stdLib, stdLibSizeInBytes, fileSystem));
+
+    return _loadStdLib(fileSystem);
+}
+
+SlangResult Session::loadStdLibFromFile(const String& path)
+{
+    // The file is memory mapped, so a RIFF archive's contents are read from the mapping, rather than copied
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystemFromFile(path, fileSystem));
+
+    return _loadStdLib(fileSystem);
+}
+
+SlangResult Session::_loadStdLib(ISlangFileSystemExt* fileSystem)
 {
     SLANG_PROFILE;
 
@@ -379,10 +398,6 @@ SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
 
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(stdLib, stdLibSizeInBytes, fileSystem));
-
     // Let's try loading serialized modules and adding them
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
 
@@ -419,6 +434,9 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
         // Save with SourceLocation information
         options.optionFlags |= SerialOptionFlag::SourceLocation;
 
+        // The stdlib is only read by the version of slang that wrote it, so can use the encoding that is fastest to decode
+        options.compressionType = SerialCompressionType::VariableByteStream;
+
         // TODO(JS): Should this be the Session::getBuiltinSourceManager()?
         options.sourceManager = m_builtinLinkage->getSourceManager();
 
@@ -481,6 +499,9 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // Checking doesn't need the stdlib IR, so it is only created when it is first linked against.
+    options.deferIRModules = true;
+
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
     for (auto& srcModule : containerData.modules)
@@ -502,6 +523,7 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
         }
 
         module->setIRModule(srcModule.irModule);
+        module->setDeferredIRModule(srcModule.deferredIRModule);
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.add(sessionNamePool->getName(moduleName), module);
@@ -635,6 +657,11 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
         linkage->setEnableEffectAnnotations(desc.enableEffectAnnotations);
     }
 
+    if (desc.structureSize > offsetof(slang::SessionDesc, moduleCacheDirectory) && desc.moduleCacheDirectory)
+    {
+        linkage->setModuleCacheDirectory(desc.moduleCacheDirectory);
+    }
+
     *outSession = asExternal(linkage.detach());
     return SLANG_OK;
 }
@@ -802,6 +829,59 @@ SlangPassThrough Session::getDownstreamCompilerForTransition(SlangCompileTarget
     return SLANG_PASS_THROUGH_NONE;
 }
 
+SLANG_NO_THROW void SLANG_MCALL Session::setPerformanceProfilingEnabled(bool enable)
+{
+    PerformanceProfiler::getProfiler()->setEnabled(enable);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::getPerformanceTrace(ISlangBlob** outTrace)
+{
+    StringBuilder trace;
+    PerformanceProfiler::getProfiler()->writeChromeTrace(trace);
+
+    *outTrace = StringBlob::moveCreate(trace).detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW void SLANG_MCALL Session::clearPerformanceTrace()
+{
+    PerformanceProfiler::getProfiler()->clear();
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::createCompileResultCache(
+    slang::CompileResultCacheDesc const&    desc,
+    slang::ICompileResultCache**            outCache)
+{
+    return Slang::createCompileResultCache(desc, outCache);
+}
+
+SLANG_NO_THROW void SLANG_MCALL Session::setCompileResultCache(slang::ICompileResultCache* cache)
+{
+    m_compileResultCache = cache;
+}
+
+SLANG_NO_THROW void SLANG_MCALL Session::getOverloadResolutionCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount)
+{
+    auto cache = getSharedTypeCheckingCache();
+    *outHitCount = cache->hitCount;
+    *outMissCount = cache->missCount;
+}
+
+SLANG_NO_THROW void SLANG_MCALL Session::getModuleCacheCounts(SlangInt* outHitCount, SlangInt* outMissCount)
+{
+    *outHitCount = m_moduleCacheHitCount;
+    *outMissCount = m_moduleCacheMissCount;
+}
+
+SharedTypeCheckingCache* Session::getSharedTypeCheckingCache()
+{
+    if (!m_sharedTypeCheckingCache)
+    {
+        m_sharedTypeCheckingCache = new SharedTypeCheckingCache();
+    }
+    return m_sharedTypeCheckingCache;
+}
+
 IDownstreamCompiler* Session::getDownstreamCompiler(CodeGenTarget source, CodeGenTarget target)
 {
     PassThroughMode compilerType = (PassThroughMode)getDownstreamCompilerForTransition(SlangCompileTarget(source), SlangCompileTarget(target));
@@ -1023,6 +1103,16 @@ void Linkage::destroyTypeCheckingCache()
     m_typeCheckingCache = nullptr;
 }
 
+IRSpecializationCache* Linkage::getIRSpecializationCache()
+{
+    std::lock_guard<std::mutex> lock(m_irSpecializationCacheMutex);
+    if (!m_irSpecializationCache)
+    {
+        m_irSpecializationCache = new IRSpecializationCache(getSessionImpl());
+    }
+    return m_irSpecializationCache;
+}
+
 SLANG_NO_THROW slang::IGlobalSession* SLANG_MCALL Linkage::getGlobalSession()
 {
     return asExternal(getSessionImpl());
@@ -1420,11 +1510,30 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
         builder.append(defVal);
     }
 
-    // Add compiler settings to hash
+    // Add compiler settings to hash. Everything that can change the code generated for an entry
+    // point must be included, as the hash is the key of the compile result cache.
     builder.append(defaultMatrixLayoutMode);
     builder.append(debugInfoLevel);
     builder.append(debugInfoFormat);
     builder.append(optimizationLevel);
+    builder.append(m_flag);
+    builder.append(m_obfuscateCode);
+    builder.append(m_useFalcorCustomSharedKeywordSemantics);
+    builder.append(m_enableEffectAnnotations);
+    builder.append(m_allowGLSLInput);
+    // Warnings that are errors can make a compile fail
+    builder.append(diagnosticSinkFlags);
+
+    // Add the arguments passed to downstream tools (with -X) to the hash
+    for (const auto& entry : m_downstreamArgs.getEntries())
+    {
+        builder.append(entry.name);
+        builder.append(entry.args.getArgCount());
+        for (Index i = 0; i < entry.args.getArgCount(); ++i)
+        {
+            builder.append(entry.args[i].value);
+        }
+    }
 
     // Add the target specified by targetIndex
     auto targetReq = targets[targetIndex];
@@ -1434,9 +1543,14 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     builder.append(targetReq->getFloatingPointMode());
     builder.append(targetReq->getLineDirectiveMode());
     builder.append(targetReq->getForceGLSLScalarBufferLayout());
+    builder.append(targetReq->getCPUVectorizeWidth());
     builder.append(targetReq->getDefaultMatrixLayoutMode());
     builder.append(targetReq->shouldDumpIntermediates());
     builder.append(targetReq->shouldTrackLiveness());
+    if (auto hlslToVulkanLayoutOptions = targetReq->getHLSLToVulkanLayoutOptions())
+    {
+        hlslToVulkanLayoutOptions->buildHash(builder);
+    }
 
     auto cookedCapabilities = targetReq->getTargetCaps().getExpandedAtoms();
     builder.append(cookedCapabilities.getCount());
@@ -1450,12 +1564,16 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     const PassThroughMode passThroughMode = getDownstreamCompilerRequiredForTarget(targetReq->getTarget());
     const SourceLanguage sourceLanguage = getDefaultSourceLanguageForDownstreamCompiler(passThroughMode);
 
-    // Add prelude for the given downstream compiler.
-    ComPtr<ISlangBlob> prelude;
-    getGlobalSession()->getLanguagePrelude((SlangSourceLanguage)sourceLanguage, prelude.writeRef());
-    if (prelude)
+    // Add prelude for the given downstream compiler (targets that are emitted
+    // directly as source, such as HLSL, have none).
+    if (sourceLanguage != SourceLanguage::Unknown)
     {
-        builder.append(prelude);
+        ComPtr<ISlangBlob> prelude;
+        getGlobalSession()->getLanguagePrelude((SlangSourceLanguage)sourceLanguage, prelude.writeRef());
+        if (prelude)
+        {
+            builder.append(prelude);
+        }
     }
 
     // TODO: Downstream compilers (specifically dxc) can currently #include additional dependencies.
@@ -1464,7 +1582,9 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     // This can only be fixed by running the preprocessor in the slang compiler so dxc (or any other
     // downstream compiler for that matter) isn't resolving any includes implicitly.
 
-    // Add the downstream compiler version (if it exists) to the hash
+    // Add the downstream compiler (which can be changed on the global session), and its
+    // version (if it exists) to the hash
+    builder.append(passThroughMode);
     auto downstreamCompiler = getSessionImpl()->getOrLoadDownstreamCompiler(passThroughMode, nullptr);
     if (downstreamCompiler)
     {
@@ -1474,6 +1594,16 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
             builder.append(versionString);
         }
     }
+
+    // Libraries referenced with `-r` are linked into every program
+    for (IArtifact* libModule : m_libModules)
+    {
+        ComPtr<ISlangBlob> libBlob;
+        if (SLANG_SUCCEEDED(libModule->loadBlob(ArtifactKeep::Yes, libBlob.writeRef())))
+        {
+            builder.append(libBlob);
+        }
+    }
 }
 
 SlangResult Linkage::addSearchPath(
@@ -3332,15 +3462,55 @@ RefPtr<Module> Linkage::findOrImportModule(
         return nullptr;
     }
 
-    // We've found a file that we can load for the given module, so
-    // go ahead and perform the module-load action
-    return loadModule(
+    // If module caching is enabled, a previously serialized version of the module
+    // can be used, as long as it (and everything it depends on) is unchanged.
+    const bool useModuleCache = m_moduleCache && !isInLanguageServer();
+    if (!useModuleCache)
+    {
+        // We've found a file that we can load for the given module, so
+        // go ahead and perform the module-load action
+        return loadModule(
+            name,
+            filePathInfo,
+            fileContents,
+            loc,
+            sink,
+            loadedModules);
+    }
+
+    // Record what is reported for this module (the modules it imports record their own),
+    // so it can be stored in the cache, and reported again whenever the entry is used
+    DiagnosticSink::Recording moduleDiagnostics(sink, true);
+
+    const SHA1::Digest moduleCacheLookupKey = _calcModuleCacheLookupKey(name, filePathInfo, fileContents);
+    if (auto cachedModule = _loadModuleFromCache(moduleCacheLookupKey, name, filePathInfo, fileContents, loc, sink, loadedModules))
+    {
+        getSessionImpl()->m_moduleCacheHitCount++;
+        return cachedModule;
+    }
+
+    // Loading an out of date entry may have imported this module by another route
+    if (mapPathToLoadedModule.tryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
+        return loadedModule;
+
+    // Anything reported whilst loading the entry was for the modules it imports
+    moduleDiagnostics.clear();
+
+    auto module = loadModule(
         name,
         filePathInfo,
         fileContents,
         loc,
         sink,
         loadedModules);
+
+    if (module)
+    {
+        getSessionImpl()->m_moduleCacheMissCount++;
+        _saveModuleToCache(moduleCacheLookupKey, module, filePathInfo, moduleDiagnostics.getDiagnostics());
+    }
+
+    return module;
 }
 
 SourceFile* Linkage::findFile(Name* name, SourceLoc loc, IncludeSystem& outIncludeSystem)
@@ -3535,7 +3705,34 @@ ISlangUnknown* Module::getInterface(const Guid& guid)
 
 void Module::buildHash(DigestBuilder<SHA1>& builder)
 {
-    SLANG_UNUSED(builder);
+    builder.append(getContentHash());
+}
+
+SHA1::Digest Module::getContentHash()
+{
+    // The source of a module can't change once it has been loaded
+    if (!m_isContentHashValid)
+    {
+        DigestBuilder<SHA1> builder;
+        if (m_moduleDecl)
+        {
+            builder.append(getText(m_moduleDecl->getName()));
+        }
+
+        // The files include those of the modules imported
+        const auto& fileList = m_fileDependencyList.getFileList();
+        builder.append(uint32_t(fileList.getCount()));
+        for (SourceFile* sourceFile : fileList)
+        {
+            const auto content = sourceFile->getContent();
+            builder.append(uint64_t(content.getLength()));
+            builder.append(SHA1::compute(content.begin(), content.getLength()));
+        }
+
+        m_contentHash = builder.finalize();
+        m_isContentHashValid = true;
+    }
+    return m_contentHash;
 }
 
 void Module::addModuleDependency(Module* module)
@@ -3554,6 +3751,26 @@ void Module::setModuleDecl(ModuleDecl* moduleDecl)
     m_moduleDecl = moduleDecl;
 }
 
+void Module::_readDeferredIRModule()
+{
+    // Another thread may have read it whilst this one was waiting for the lock
+    std::lock_guard<std::mutex> lock(m_deferredIRModuleMutex);
+    if (!m_deferredIRModule)
+        return;
+
+    RefPtr<IRSerialDeferredModule> deferredIRModule = m_deferredIRModule;
+    m_deferredIRModule.setNull();
+
+    // The data was checked when the container was read, so this can only fail if it is corrupt,
+    // in which case the module is left without IR.
+    RefPtr<IRModule> irModule;
+    if (SLANG_SUCCEEDED(deferredIRModule->read(irModule)))
+    {
+        m_irModule = irModule;
+    }
+    m_hasDeferredIRModule.store(false, std::memory_order_release);
+}
+
 RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 {
     // TODO: We should consider having this function be expanded to be able
@@ -3825,6 +4042,30 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
 
     auto targetProgram = getTargetProgram(target);
 
+    // If the code hasn't been generated already, look for it in the compile result cache. Host
+    // callable results are shared libraries loaded into the process, so can't be cached.
+    slang::ICompileResultCache* cache = linkage->getSessionImpl()->getCompileResultCache();
+    const auto artifactDesc = ArtifactDescUtil::makeDescForCompileTarget(asExternal(target->getTarget()));
+    const bool hasResult = entryPointIndex < targetProgram->getEntryPointResultCount() &&
+        targetProgram->getExistingEntryPointResult(entryPointIndex);
+
+    ComPtr<ISlangBlob> cacheKey;
+    if (cache && !hasResult && artifactDesc.kind != ArtifactKind::HostCallable)
+    {
+        getEntryPointHash(entryPointIndex, targetIndex, cacheKey.writeRef());
+
+        ComPtr<ISlangBlob> code;
+        if (SLANG_SUCCEEDED(cache->readEntry(cacheKey, code.writeRef())))
+        {
+            auto artifact = Artifact::create(artifactDesc);
+            artifact->addRepresentationUnknown(code);
+            targetProgram->_setEntryPointResult(entryPointIndex, artifact);
+
+            *outCode = code.detach();
+            return SLANG_OK;
+        }
+    }
+
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
 
     IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
@@ -3833,7 +4074,14 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     if(artifact == nullptr)
         return SLANG_FAIL;
 
-    return artifact->loadBlob(ArtifactKeep::Yes, outCode);
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, outCode));
+
+    // Only the code is stored, so warnings aren't reported again when the entry is used
+    if (cacheKey)
+    {
+        cache->writeEntry(cacheKey, *outCode);
+    }
+    return SLANG_OK;
 }
 
 SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
@@ -3851,12 +4099,11 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     // will already be reflected in the resulting hash.
     getLinkage()->buildHash(builder, targetIndex);
 
-    // Enumerate all file dependencies and add them to the hash.
-    for (SourceFile* sourceFile : getFileDependencies())
+    // Add the content of all the modules depended on. The hash of each module covers its source
+    // files, and is only computed once.
+    for (Module* module : getModuleDependencies())
     {
-        // TODO: We want to lazily evaluate & cache the source file digest
-        SHA1::Digest digest = SHA1::compute(sourceFile->getContent().begin(), sourceFile->getContent().getLength());
-        builder.append(digest);
+        builder.append(module->getContentHash());
     }
 
     buildHash(builder);
@@ -4710,7 +4957,8 @@ void RenamedEntryPointComponentType::acceptVisitor(
 
 void RenamedEntryPointComponentType::buildHash(DigestBuilder<SHA1>& builder)
 {
-    SLANG_UNUSED(builder);
+    // The new name is added by `getEntryPointHash`
+    m_base->buildHash(builder);
 }
 
 void ComponentTypeVisitor::visitChildren(CompositeComponentType* composite, CompositeComponentType::CompositeSpecializationInfo* specializationInfo)
@@ -4907,6 +5155,48 @@ void Session::addBuiltinSource(
     stdlibModules.add(module);
 }
 
+IRSymbolIndex* Session::getStdLibIRSymbolIndex()
+{
+    // Links can run on more than one thread at a time (such as the background
+    // specialization of gfx), so the index is built under a lock
+    std::lock_guard<std::mutex> lock(m_stdlibIRSymbolIndexMutex);
+
+    // Builtin modules may be added after the index was built (by `addBuiltinSource`),
+    // in which case it needs to be rebuilt.
+    if (!m_stdlibIRSymbolIndex || m_stdlibIRSymbolIndex->getModuleCount() != stdlibModules.getCount())
+    {
+        List<IRModule*> irModules;
+        for (auto& module : stdlibModules)
+        {
+            irModules.add(module->getIRModule());
+        }
+        m_stdlibIRSymbolIndex = IRSymbolIndex::create(irModules);
+    }
+    return m_stdlibIRSymbolIndex;
+}
+
+ThreadPool* Session::getDownstreamCompileThreadPool()
+{
+    std::lock_guard<std::mutex> lock(m_downstreamCompileThreadPoolMutex);
+    if (!m_downstreamCompileThreadPool)
+    {
+        m_downstreamCompileThreadPool = new ThreadPool;
+    }
+    return m_downstreamCompileThreadPool;
+}
+
+void Session::addIRSimplificationStats(const IRSimplificationStats& stats)
+{
+    std::lock_guard<std::mutex> lock(m_irSimplificationStatsMutex);
+    m_irSimplificationStats.add(stats);
+}
+
+IRSimplificationStats Session::getIRSimplificationStats()
+{
+    std::lock_guard<std::mutex> lock(m_irSimplificationStatsMutex);
+    return m_irSimplificationStats;
+}
+
 Session::~Session()
 {
     // This is necessary because this ASTBuilder uses the SharedASTBuilder also owned by the session.
@@ -4916,6 +5206,12 @@ Session::~Session()
     // By destroying first we know it is destroyed, before the SharedASTBuilder.
     globalAstBuilder.setNull();
 
+    // The index refers to the stdlib IR, so must be destroyed first
+    m_stdlibIRSymbolIndex.setNull();
+
+    delete m_sharedTypeCheckingCache;
+    m_sharedTypeCheckingCache = nullptr;
+
     // destroy modules next
     stdlibModules = decltype(stdlibModules)();
 }
@@ -5467,6 +5763,9 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
     {
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
     }
+    // Only record whilst this request is compiled, so the profiler goes back to how the
+    // application (or another request) set it afterwards
+    PerformanceProfiler::ScopedEnable profilerEnable(m_reportPerfBenchmark || m_perfTracePath.getLength());
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -5534,8 +5833,23 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
         StringBuilder perfResult;
         PerformanceProfiler::getProfiler()->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+        getSession()->getIRSimplificationStats().append(perfResult);
+        perfResult << "IR instruction bytes reused: " << getSession()->m_irRecycledInstBytes.load() << "\n";
+        if (auto specializationCache = getLinkage()->m_irSpecializationCache.Ptr())
+        {
+            specializationCache->append(perfResult);
+        }
         getSink()->diagnose(SourceLoc(), Diagnostics::performanceBenchmarkResult, perfResult.produceString());
     }
+    if (m_perfTracePath.getLength())
+    {
+        StringBuilder trace;
+        PerformanceProfiler::getProfiler()->writeChromeTrace(trace);
+        if (SLANG_FAILED(File::writeAllText(m_perfTracePath, trace)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, m_perfTracePath);
+        }
+    }
 
     // Repro dump handling
     {
@@ -5,8 +5,12 @@
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
 #include "../core/slang-io.h"
+#include "../core/slang-platform.h"
+#include "../core/slang-string-util.h"
 #include "../core/slang-test-tool-util.h"
 
+#include "slangc-compile-server.h"
+
 using namespace Slang;
 
 #include <assert.h>
@@ -19,16 +23,16 @@ using namespace Slang;
 
 static void _diagnosticCallback(
     char const* message,
-    void*       /*userData*/)
+    void*       userData)
 {
-    auto stdError = StdWriters::getError();
+    WriterHelper stdError(static_cast<StdWriters*>(userData)->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
     stdError.put(message);
     stdError.flush();
 }
 
-static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const char*const* argv)
+static SlangResult _compile(StdWriters* stdWriters, SlangCompileRequest* compileRequest, int argc, const char*const* argv)
 {
-    spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, nullptr);
+    spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, stdWriters);
     spSetCommandLineCompilerMode(compileRequest);
 
     char const* appName = "slangc";
@@ -58,7 +62,7 @@ static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const
 #ifndef _DEBUG
     catch (const Exception& e)
     {
-        StdWriters::getOut().print("internal compiler error: %S\n", e.Message.toWString().begin());
+        WriterHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT)).print("internal compiler error: %S\n", e.Message.toWString().begin());
         res = SLANG_FAIL;
     }
 #endif
@@ -76,10 +80,8 @@ bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobalSession* sharedSession, int argc, const char*const* argv)
+static SlangResult _innerMain(StdWriters* stdWriters, slang::IGlobalSession* sharedSession, int argc, const char*const* argv)
 {
-    StdWriters::setSingleton(stdWriters);
-
     // Assume we will used the shared session
     ComPtr<slang::IGlobalSession> session(sharedSession);
 
@@ -101,17 +103,88 @@ SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobal
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
-    SlangResult res = _compile(compileRequest, argc, argv);
+
+    // Output goes to stdWriters, so that compiles running in a compile server don't write to the server's console
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_OUTPUT, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_ERROR, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+
+    SlangResult res = _compile(stdWriters, compileRequest, argc, argv);
     // Now that we are done, clean up after ourselves
     spDestroyCompileRequest(compileRequest);
 
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobalSession* sharedSession, int argc, const char*const* argv)
+{
+    StdWriters::setSingleton(stdWriters);
+    return _innerMain(stdWriters, sharedSession, argc, argv);
+}
+
+    /// Run as a compile server, with the command line `-compile-server <path> [-compile-server-jobs <count>]`
+static SlangResult _runCompileServer(int argc, const char*const* argv)
+{
+    Int jobCount = 0;
+    if (argc == 5 && UnownedStringSlice(argv[3]) == "-compile-server-jobs")
+    {
+        SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(argv[4]), jobCount));
+    }
+    else if (argc != 3)
+    {
+        StdWriters::getError().print("usage: %s -compile-server <path> [-compile-server-jobs <count>]\n", argv[0]);
+        return SLANG_E_INVALID_ARG;
+    }
+
+    CompileServer server;
+    SLANG_RETURN_ON_FAIL(server.init(argv[2], Count(jobCount), argv[0], &_innerMain));
+    return server.execute();
+}
+
+    /// Forward the compile to the server named by SLANGC_COMPILE_SERVER, if there is one.
+    /// Fails if the compile wasn't performed, in which case the compile should happen locally.
+static SlangResult _compileWithServer(int argc, const char*const* argv, SlangResult& outRes)
+{
+    // Building or loading a stdlib is left to this slangc, which may differ from the server's
+    if (TestToolUtil::hasDeferredStdLib(Index(argc - 1), argv + 1))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder serverPath;
+    if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(UnownedStringSlice::fromLiteral("SLANGC_COMPILE_SERVER"), serverPath)) ||
+        serverPath.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    CompileServerProtocol::CompileResult result;
+    SLANG_RETURN_ON_FAIL(CompileServer::compile(serverPath, argc, argv, result));
+
+    StdWriters::getOut().put(result.stdOut.getUnownedSlice());
+    StdWriters::getError().put(result.stdError.getUnownedSlice());
+
+    outRes = result.result;
+    return SLANG_OK;
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+
+    if (argc >= 2 && UnownedStringSlice(argv[1]) == "-compile-server")
+    {
+        return (int)TestToolUtil::getReturnCode(_runCompileServer(argc, argv));
+    }
+    if (argc == 3 && UnownedStringSlice(argv[1]) == "-compile-server-quit")
+    {
+        return (int)TestToolUtil::getReturnCode(CompileServer::quit(argv[2]));
+    }
+
+    SlangResult res = SLANG_OK;
+    if (SLANG_FAILED(_compileWithServer(argc, argv, res)))
+    {
+        res = innerMain(stdWriters, nullptr, argc, argv);
+    }
     return (int)TestToolUtil::getReturnCode(res);
 }
 
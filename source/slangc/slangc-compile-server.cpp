@@ -0,0 +1,263 @@
+// slangc-compile-server.cpp
+#include "slangc-compile-server.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-http.h"
+#include "../core/slang-test-tool-util.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-writer.h"
+
+namespace Slang
+{
+
+// How long the accept loop waits before checking if it should quit
+static const Int kAcceptTimeOutInMs = 100;
+// How long to wait for a message on a connection before giving up on it
+static const Int kConnectionTimeOutInMs = 60 * 1000;
+
+static bool _hasArg(const char* const* argv, int argc, const char* arg)
+{
+    for (int i = 0; i < argc; i++)
+    {
+        if (UnownedStringSlice(argv[i]) == arg)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static SlangResult _connect(const String& path, RefPtr<JSONRPCConnection>& outConnection)
+{
+    RefPtr<LocalSocketStream> stream;
+    SLANG_RETURN_ON_FAIL(LocalSocketStream::connect(path, stream));
+
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection(new HTTPPacketConnection(readStream, stream));
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+
+    outConnection = connection;
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileServer::compile(const String& path, int argc, const char* const* argv, CompileServerProtocol::CompileResult& outResult)
+{
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_RETURN_ON_FAIL(_connect(path, connection));
+
+    CompileServerProtocol::CompileArgs args;
+    SLANG_RETURN_ON_FAIL(Path::getCanonical(".", args.workingDirectory));
+    for (int i = 1; i < argc; ++i)
+    {
+        args.args.add(argv[i]);
+    }
+
+    SLANG_RETURN_ON_FAIL(connection->sendCall(CompileServerProtocol::CompileArgs::g_methodName, &args, JSONValue::makeInt(1)));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+
+    // If the server couldn't run the compile it replies with an error
+    if (!connection->hasMessage() || connection->getMessageType() != JSONRPCMessageType::Result)
+    {
+        return SLANG_FAIL;
+    }
+    return connection->getMessage(&outResult);
+}
+
+/* static */SlangResult CompileServer::quit(const String& path)
+{
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_RETURN_ON_FAIL(_connect(path, connection));
+    return connection->sendCall(CompileServerProtocol::QuitArgs::g_methodName);
+}
+
+SlangResult CompileServer::init(const String& path, Count jobCount, const char* exePath, CompileFunc compileFunc)
+{
+    m_exePath = exePath;
+    m_compileFunc = compileFunc;
+    SLANG_RETURN_ON_FAIL(Path::getCanonical(".", m_workingDirectory));
+
+    SLANG_RETURN_ON_FAIL(LocalSocketServer::create(path, m_server));
+
+    if (jobCount <= 0)
+    {
+        jobCount = ThreadPool::getDefaultThreadCount();
+    }
+    for (Index i = 0; i < jobCount; ++i)
+    {
+        m_workers.add(std::thread([this]() { _runWorker(); }));
+    }
+    return SLANG_OK;
+}
+
+CompileServer::~CompileServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_connectionAdded.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+SlangResult CompileServer::execute()
+{
+    while (!m_quit)
+    {
+        RefPtr<LocalSocketStream> stream;
+        SLANG_RETURN_ON_FAIL(m_server->accept(kAcceptTimeOutInMs, stream));
+
+        if (stream)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_connections.add(stream);
+            }
+            m_connectionAdded.notify_one();
+        }
+    }
+
+    m_server->close();
+    return SLANG_OK;
+}
+
+SlangResult CompileServer::_createSession(ComPtr<slang::IGlobalSession>& outSession)
+{
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, outSession.writeRef()));
+    TestToolUtil::setSessionDefaultPreludeFromExePath(m_exePath.getBuffer(), outSession);
+    return SLANG_OK;
+}
+
+void CompileServer::_runWorker()
+{
+    // The session is created on the first compile, so that start up isn't held up loading
+    // a stdlib for every worker
+    ComPtr<slang::IGlobalSession> session;
+
+    while (true)
+    {
+        RefPtr<LocalSocketStream> stream;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_connectionAdded.wait(lock, [this]() { return m_quit || m_connections.getCount() > 0; });
+            if (m_quit)
+            {
+                return;
+            }
+
+            stream = m_connections[0];
+            m_connections.removeAt(0);
+        }
+
+        // Failure only ends the connection
+        [[maybe_unused]]
+        const SlangResult res = _handleConnection(stream, session);
+        stream->close();
+    }
+}
+
+SlangResult CompileServer::_handleConnection(LocalSocketStream* stream, ComPtr<slang::IGlobalSession>& ioSession)
+{
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection(new HTTPPacketConnection(readStream, stream));
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+
+    while (connection->isActive() && !m_quit)
+    {
+        SLANG_RETURN_ON_FAIL(connection->waitForResult(kConnectionTimeOutInMs));
+
+        // Either the client has closed the connection, or it's been idle too long
+        if (!connection->hasMessage())
+        {
+            return SLANG_OK;
+        }
+
+        if (connection->getMessageType() != JSONRPCMessageType::Call)
+        {
+            SLANG_RETURN_ON_FAIL(connection->sendError(JSONRPC::ErrorCode::InvalidRequest, connection->getCurrentMessageId()));
+            continue;
+        }
+
+        JSONRPCCall call;
+        SLANG_RETURN_ON_FAIL(connection->getRPCOrSendError(&call));
+
+        if (call.method == CompileServerProtocol::QuitArgs::g_methodName)
+        {
+            m_quit = true;
+            return SLANG_OK;
+        }
+        else if (call.method == CompileServerProtocol::CompileArgs::g_methodName)
+        {
+            SLANG_RETURN_ON_FAIL(_compile(connection, call, ioSession));
+        }
+        else
+        {
+            SLANG_RETURN_ON_FAIL(connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id));
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult CompileServer::_compile(JSONRPCConnection* connection, const JSONRPCCall& call, ComPtr<slang::IGlobalSession>& ioSession)
+{
+    auto id = connection->getPersistentValue(call.id);
+
+    CompileServerProtocol::CompileArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+
+    // Paths on the command line (and output files) are relative to the working directory, which is shared
+    // by all of the jobs. The client will compile locally if it's working directory is different.
+    if (args.workingDirectory != m_workingDirectory)
+    {
+        return connection->sendError(JSONRPC::ErrorCode::InvalidParams, UnownedStringSlice::fromLiteral("Working directory differs from the compile server's"), id);
+    }
+
+    List<const char*> argv;
+    argv.add(m_exePath.getBuffer());
+    for (const auto& arg : args.args)
+    {
+        argv.add(arg.getBuffer());
+    }
+
+    // Options that change how the stdlib or prelude are set up need a session of their own
+    slang::IGlobalSession* session = nullptr;
+    if (!TestToolUtil::hasDeferredStdLib(argv.getCount() - 1, argv.getBuffer() + 1) &&
+        !_hasArg(argv.getBuffer(), int(argv.getCount()), "-embed-prelude"))
+    {
+        if (!ioSession)
+        {
+            SLANG_RETURN_ON_FAIL(_createSession(ioSession));
+        }
+        session = ioSession;
+    }
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+
+    // Make writer/s act as if they are the console.
+    RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+    RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+    StdWriters stdWriters;
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+
+    const SlangResult compileRes = m_compileFunc(&stdWriters, session, int(argv.getCount()), argv.getBuffer());
+
+    CompileServerProtocol::CompileResult result;
+    result.result = compileRes;
+    result.stdOut = stdOut;
+    result.stdError = stdError;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(compileRes));
+
+    return connection->sendResult(&result, id);
+}
+
+} // namespace Slang
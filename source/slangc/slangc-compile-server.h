@@ -0,0 +1,73 @@
+#ifndef SLANGC_COMPILE_SERVER_H
+#define SLANGC_COMPILE_SERVER_H
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../core/slang-basic.h"
+#include "../core/slang-std-writers.h"
+
+#include "../compiler-core/slang-compile-server-protocol.h"
+#include "../compiler-core/slang-json-rpc-connection.h"
+#include "../compiler-core/slang-local-socket.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/* A compile server is a resident slangc (`slangc -compile-server <path>`) that keeps warm global sessions,
+so that compiles don't need to load the stdlib and downstream compilers each time. Clients connect to the
+local socket at `path`, and send the command line to compile with the CompileServerProtocol.
+
+When the environment variable SLANGC_COMPILE_SERVER is set to the path, slangc forwards its command line
+to the server. If the server can't be reached or can't run the compile, slangc compiles as usual. */
+
+class CompileServer
+{
+public:
+        /// Compiles the slangc command line `argv` using `session`. Output and diagnostics are written to `stdWriters`.
+        /// If `session` is nullptr, a new global session is created for the compile.
+    typedef SlangResult (*CompileFunc)(StdWriters* stdWriters, slang::IGlobalSession* session, int argc, const char* const* argv);
+
+        /// Listen at `path`, running up to `jobCount` compiles at once. If `jobCount` is <= 0 the hardware thread count is used.
+    SlangResult init(const String& path, Count jobCount, const char* exePath, CompileFunc compileFunc);
+
+        /// Serve compile requests until asked to quit
+    SlangResult execute();
+
+        /// Forwards the command line to the server at `path`. Fails if the server can't be reached, or can't run the compile
+        /// (in which case the compile should be performed locally).
+    static SlangResult compile(const String& path, int argc, const char* const* argv, CompileServerProtocol::CompileResult& outResult);
+
+        /// Asks the server at `path` to quit
+    static SlangResult quit(const String& path);
+
+    ~CompileServer();
+
+protected:
+    void _runWorker();
+    SlangResult _handleConnection(LocalSocketStream* stream, ComPtr<slang::IGlobalSession>& ioSession);
+    SlangResult _compile(JSONRPCConnection* connection, const JSONRPCCall& call, ComPtr<slang::IGlobalSession>& ioSession);
+    SlangResult _createSession(ComPtr<slang::IGlobalSession>& outSession);
+
+    String m_exePath;
+    String m_workingDirectory;                          ///< Compiles can only be run for clients in the same working directory
+    CompileFunc m_compileFunc = nullptr;
+
+    RefPtr<LocalSocketServer> m_server;
+
+    std::mutex m_mutex;
+    std::condition_variable m_connectionAdded;
+    List<RefPtr<LocalSocketStream>> m_connections;      ///< Accepted connections waiting for a worker. Guarded by m_mutex.
+    std::atomic<bool> m_quit = false;
+
+    List<std::thread> m_workers;                        ///< Each worker has its own global session
+};
+
+} // namespace Slang
+
+#endif // SLANGC_COMPILE_SERVER_H
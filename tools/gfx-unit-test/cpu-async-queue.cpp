@@ -0,0 +1,191 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    static const int kElementCount = 1024;
+    static const int kSubmissionCount = 8;
+
+    static ComPtr<IBufferResource> createBuffer(
+        IDevice* device,
+        const void* initialData,
+        ComPtr<IResourceView>& outView)
+    {
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = kElementCount * sizeof(float);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> buffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(bufferDesc, initialData, buffer.writeRef()));
+
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(buffer, nullptr, viewDesc, outView.writeRef()));
+        return buffer;
+    }
+
+    // Checks that the queues of the CPU device execute their submissions asynchronously, in order,
+    // and that fences synchronize them with each other and with the host.
+    SLANG_UNIT_TEST(cpuAsyncQueue)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        auto device = createTestingDevice(unitTestContext, Slang::RenderApiFlag::CPU);
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-trivial", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        Slang::List<float> initialData;
+        initialData.setCount(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+        {
+            initialData[i] = float(i);
+        }
+
+        ComPtr<IResourceView> numbersView, resultView;
+        auto numbersBuffer = createBuffer(device, initialData.getBuffer(), numbersView);
+        auto resultBuffer = createBuffer(device, nullptr, resultView);
+
+        IFence::Desc fenceDesc = {};
+        ComPtr<IFence> hostFence, computeFence, copyFence;
+        GFX_CHECK_CALL_ABORT(device->createFence(fenceDesc, hostFence.writeRef()));
+        GFX_CHECK_CALL_ABORT(device->createFence(fenceDesc, computeFence.writeRef()));
+        GFX_CHECK_CALL_ABORT(device->createFence(fenceDesc, copyFence.writeRef()));
+
+        // A device can have several queues.
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        ComPtr<ICommandQueue> computeQueue, copyQueue;
+        GFX_CHECK_CALL_ABORT(device->createCommandQueue(queueDesc, computeQueue.writeRef()));
+        GFX_CHECK_CALL_ABORT(device->createCommandQueue(queueDesc, copyQueue.writeRef()));
+
+        // Nothing runs on the compute queue until the host signals that it may start, so all of
+        // the submissions below are recorded while the queue is waiting.
+        IFence* hostFences[] = { hostFence.get() };
+        uint64_t hostWaitValues[] = { 1 };
+        GFX_CHECK_CALL_ABORT(computeQueue->waitForFenceValuesOnDevice(1, hostFences, hostWaitValues));
+
+        for (int i = 0; i < kSubmissionCount; ++i)
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor(rootObject).getPath("buffer").setResource(numbersView);
+            encoder->dispatchCompute(kElementCount / 4, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            computeQueue->executeCommandBuffer(commandBuffer, computeFence, uint64_t(i + 1));
+        }
+
+        // The copy waits on the device for all of the increments to have been applied.
+        {
+            IFence* computeFences[] = { computeFence.get() };
+            uint64_t computeWaitValues[] = { kSubmissionCount };
+            GFX_CHECK_CALL_ABORT(copyQueue->waitForFenceValuesOnDevice(1, computeFences, computeWaitValues));
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeResourceCommands();
+            encoder->copyBuffer(resultBuffer, 0, numbersBuffer, 0, kElementCount * sizeof(float));
+            encoder->endEncoding();
+            commandBuffer->close();
+            copyQueue->executeCommandBuffer(commandBuffer, copyFence, 1);
+        }
+
+        // Neither queue can have made progress yet.
+        uint64_t fenceValue = 0;
+        GFX_CHECK_CALL_ABORT(computeFence->getCurrentValue(&fenceValue));
+        SLANG_CHECK(fenceValue == 0);
+        IFence* copyFences[] = { copyFence.get() };
+        uint64_t copyWaitValues[] = { 1 };
+        SLANG_CHECK(device->waitForFences(1, copyFences, copyWaitValues, true, 1000000) == SLANG_E_TIME_OUT);
+
+        GFX_CHECK_CALL_ABORT(hostFence->setCurrentValue(1));
+        GFX_CHECK_CALL_ABORT(device->waitForFences(1, copyFences, copyWaitValues, true, kTimeoutInfinite));
+
+        GFX_CHECK_CALL_ABORT(computeFence->getCurrentValue(&fenceValue));
+        SLANG_CHECK(fenceValue == kSubmissionCount);
+
+        Slang::List<float> expected;
+        expected.setCount(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+        {
+            expected[i] = float(i + kSubmissionCount);
+        }
+        compareComputeResult(device, resultBuffer, 0, expected.getBuffer(), kElementCount * sizeof(float));
+
+        // `waitOnHost` returns once everything submitted to the queue has executed.
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeResourceCommands();
+            encoder->copyBuffer(numbersBuffer, 0, resultBuffer, 0, kElementCount * sizeof(float));
+            encoder->endEncoding();
+            commandBuffer->close();
+            copyQueue->executeCommandBuffer(commandBuffer, copyFence, 2);
+            copyQueue->waitOnHost();
+
+            GFX_CHECK_CALL_ABORT(copyFence->getCurrentValue(&fenceValue));
+            SLANG_CHECK(fenceValue == 2);
+        }
+
+        // Destroying a queue doesn't wait for a fence that will never be signalled, and the
+        // work held back by the wait is abandoned.
+        {
+            ComPtr<ICommandQueue> blockedQueue;
+            GFX_CHECK_CALL_ABORT(device->createCommandQueue(queueDesc, blockedQueue.writeRef()));
+
+            ComPtr<IFence> unsignalledFence;
+            GFX_CHECK_CALL_ABORT(device->createFence(fenceDesc, unsignalledFence.writeRef()));
+            IFence* unsignalledFences[] = { unsignalledFence.get() };
+            uint64_t unsignalledWaitValues[] = { 1 };
+            GFX_CHECK_CALL_ABORT(
+                blockedQueue->waitForFenceValuesOnDevice(1, unsignalledFences, unsignalledWaitValues));
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeResourceCommands();
+            encoder->copyBuffer(resultBuffer, 0, numbersBuffer, 0, kElementCount * sizeof(float));
+            encoder->endEncoding();
+            commandBuffer->close();
+            blockedQueue->executeCommandBuffer(commandBuffer, copyFence, 3);
+
+            // Reading a buffer waits for the queues to finish their work, but not for a fence
+            // that only the host can signal.
+            compareComputeResult(device, resultBuffer, 0, expected.getBuffer(), kElementCount * sizeof(float));
+
+            blockedQueue = nullptr;
+
+            GFX_CHECK_CALL_ABORT(copyFence->getCurrentValue(&fenceValue));
+            SLANG_CHECK(fenceValue == 2);
+        }
+    }
+}
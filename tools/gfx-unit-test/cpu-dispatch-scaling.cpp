@@ -0,0 +1,127 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+#include "source/core/slang-thread-pool.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    static const int kGroupSize = 64;
+    static const int kGroupCount = 1024;
+    static const int kElementCount = kGroupSize * kGroupCount;
+
+        /// The value the kernel writes for `threadID`
+    static uint32_t calcExpectedValue(uint32_t threadID)
+    {
+        uint32_t value = threadID;
+        for (int i = 0; i < 512; ++i)
+        {
+            value ^= value >> 16;
+            value *= 0x7feb352du;
+            value ^= value >> 15;
+            value *= 0x846ca68bu;
+            value ^= value >> 16;
+        }
+        return value;
+    }
+
+        /// Runs the kernel on a CPU device limited to `threadCount` threads, and writes the contents
+        /// of the output buffer to `outResult`.
+    static void runDispatch(UnitTestContext* context, uint32_t threadCount, Slang::List<uint32_t>& outResult)
+    {
+        CPUDeviceExtendedDesc cpuDesc;
+        cpuDesc.maxThreadCount = threadCount;
+        auto device = createTestingDevice(context, Slang::RenderApiFlag::CPU, {}, {}, Slang::makeArray<void*>(&cpuDesc).getView());
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-dispatch-scaling", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = kElementCount * sizeof(uint32_t);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> buffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(bufferDesc, nullptr, buffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(buffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+
+        auto rootObject = encoder->bindPipeline(pipelineState);
+        ShaderCursor rootCursor(rootObject);
+        rootCursor.getPath("buffer").setResource(bufferView);
+
+        encoder->dispatchCompute(kGroupCount, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+
+        ComPtr<ISlangBlob> resultBlob;
+        GFX_CHECK_CALL_ABORT(device->readBufferResource(
+            buffer, 0, bufferDesc.sizeInBytes, resultBlob.writeRef()));
+        outResult.setCount(kElementCount);
+        memcpy(outResult.getBuffer(), resultBlob->getBufferPointer(), bufferDesc.sizeInBytes);
+    }
+
+    // Checks that a dispatch on the CPU device writes the right value for every thread, whether
+    // the groups run on one thread or are split between several. The time taken as the thread
+    // count grows is measured by `slang-profile -cpu-dispatch`.
+    SLANG_UNIT_TEST(cpuDispatchThreadCount)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        Slang::List<uint32_t> expectedResult;
+        expectedResult.setCount(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+        {
+            expectedResult[i] = calcExpectedValue(uint32_t(i));
+        }
+
+        const uint32_t maxThreadCount = uint32_t(Slang::ThreadPool::getDefaultThreadCount());
+        for (uint32_t threadCount : { 1u, 2u, 3u, maxThreadCount })
+        {
+            Slang::List<uint32_t> result;
+            runDispatch(unitTestContext, threadCount, result);
+            SLANG_CHECK(result == expectedResult);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+#include <chrono>
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    static const int kTileSize = 8;
+    static const int kMatrixSize = 64;
+    static const int kMatrixElementCount = kMatrixSize * kMatrixSize;
+
+    static const int kReduceGroupSize = 256;
+    static const int kReduceGroupCount = 1024;
+
+    static ComPtr<IBufferResource> createBuffer(
+        IDevice* device,
+        size_t elementCount,
+        size_t elementSize,
+        const void* initialData,
+        ComPtr<IResourceView>& outView)
+    {
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = elementCount * elementSize;
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = elementSize;
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> buffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(bufferDesc, initialData, buffer.writeRef()));
+
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(buffer, nullptr, viewDesc, outView.writeRef()));
+        return buffer;
+    }
+
+        /// Dispatches `entryPointName` with the buffers in `views` bound to the parameters named in `names`.
+        /// The dispatch is run twice, so that the kernel compilation isn't part of the timing, and the
+        /// time taken by the second dispatch is returned in milliseconds.
+    static double runDispatch(
+        IDevice* device,
+        const char* entryPointName,
+        const Slang::List<const char*>& names,
+        const Slang::List<IResourceView*>& views,
+        int groupCountX,
+        int groupCountY)
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-group-barrier", entryPointName, slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        auto queue = device->createCommandQueue(queueDesc);
+
+        double elapsedMs = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor rootCursor(rootObject);
+            for (Slang::Index j = 0; j < names.getCount(); ++j)
+            {
+                rootCursor.getPath(names[j]).setResource(views[j]);
+            }
+
+            encoder->dispatchCompute(groupCountX, groupCountY, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            elapsedMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        }
+        return elapsedMs;
+    }
+
+    // Checks that group barriers synchronize the threads of a group on the CPU device, with a
+    // tiled matrix multiply and a parallel reduction that both share data through group shared
+    // memory. The time taken by each dispatch is reported.
+    SLANG_UNIT_TEST(cpuGroupBarrier)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        auto device = createTestingDevice(unitTestContext, Slang::RenderApiFlag::CPU);
+
+        Slang::StringBuilder report;
+
+        // Matrix multiply. The values are small integers, so the results are exact.
+        {
+            Slang::List<float> a, b, expected;
+            a.setCount(kMatrixElementCount);
+            b.setCount(kMatrixElementCount);
+            for (int i = 0; i < kMatrixElementCount; ++i)
+            {
+                a[i] = float(i % 7);
+                b[i] = float(i % 5);
+            }
+            expected.setCount(kMatrixElementCount);
+            for (int row = 0; row < kMatrixSize; ++row)
+            {
+                for (int col = 0; col < kMatrixSize; ++col)
+                {
+                    float sum = 0;
+                    for (int k = 0; k < kMatrixSize; ++k)
+                    {
+                        sum += a[row * kMatrixSize + k] * b[k * kMatrixSize + col];
+                    }
+                    expected[row * kMatrixSize + col] = sum;
+                }
+            }
+
+            ComPtr<IResourceView> aView, bView, cView;
+            auto aBuffer = createBuffer(device, kMatrixElementCount, sizeof(float), a.getBuffer(), aView);
+            auto bBuffer = createBuffer(device, kMatrixElementCount, sizeof(float), b.getBuffer(), bView);
+            auto cBuffer = createBuffer(device, kMatrixElementCount, sizeof(float), nullptr, cView);
+
+            const double elapsedMs = runDispatch(
+                device,
+                "gemmMain",
+                Slang::List<const char*>{ "matrixA", "matrixB", "matrixC" },
+                Slang::List<IResourceView*>{ aView, bView, cView },
+                kMatrixSize / kTileSize,
+                kMatrixSize / kTileSize);
+
+            compareComputeResult(device, cBuffer, 0, expected.getBuffer(), kMatrixElementCount * sizeof(float));
+            report << "cpuGroupBarrier: " << kMatrixSize << "x" << kMatrixSize << " tiled matrix multiply: " << elapsedMs << "ms\n";
+        }
+
+        // Reduction of each group of values to their sum
+        {
+            const int valueCount = kReduceGroupSize * kReduceGroupCount;
+
+            Slang::List<uint32_t> values, expected;
+            values.setCount(valueCount);
+            for (int i = 0; i < valueCount; ++i)
+            {
+                values[i] = uint32_t(i * 2654435761u) >> 20;
+            }
+            expected.setCount(kReduceGroupCount);
+            for (int i = 0; i < kReduceGroupCount; ++i)
+            {
+                uint32_t sum = 0;
+                for (int j = 0; j < kReduceGroupSize; ++j)
+                {
+                    sum += values[i * kReduceGroupSize + j];
+                }
+                expected[i] = sum;
+            }
+
+            ComPtr<IResourceView> valuesView, sumsView;
+            auto valuesBuffer = createBuffer(device, valueCount, sizeof(uint32_t), values.getBuffer(), valuesView);
+            auto sumsBuffer = createBuffer(device, kReduceGroupCount, sizeof(uint32_t), nullptr, sumsView);
+
+            const double elapsedMs = runDispatch(
+                device,
+                "reduceMain",
+                Slang::List<const char*>{ "values", "groupSums" },
+                Slang::List<IResourceView*>{ valuesView, sumsView },
+                kReduceGroupCount,
+                1);
+
+            compareComputeResult(device, sumsBuffer, 0, expected.getBuffer(), kReduceGroupCount * sizeof(uint32_t));
+            report << "cpuGroupBarrier: reduction of " << valueCount << " values: " << elapsedMs << "ms\n";
+        }
+
+        getTestReporter()->message(TestMessageType::Info, report.getBuffer());
+    }
+}
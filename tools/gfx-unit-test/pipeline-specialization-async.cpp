@@ -0,0 +1,153 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    static const int kElementCount = 4;
+
+    struct PipelineSpecializationAsyncTest
+    {
+        ComPtr<IDevice> device;
+        ComPtr<ITransientResourceHeap> transientHeap;
+        ComPtr<ICommandQueue> queue;
+        ComPtr<IPipelineState> pipelineState;
+        slang::ProgramLayout* slangReflection = nullptr;
+
+        void init(UnitTestContext* context)
+        {
+            PipelineSpecializationDesc specializationDesc;
+            specializationDesc.mode = PipelineSpecializationMode::Asynchronous;
+            device = createTestingDevice(context, Slang::RenderApiFlag::CPU, {}, {}, Slang::makeArray<void*>(&specializationDesc).getView());
+
+            ITransientResourceHeap::Desc transientHeapDesc = {};
+            transientHeapDesc.constantBufferSize = 4096;
+            GFX_CHECK_CALL_ABORT(
+                device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            queue = device->createCommandQueue(queueDesc);
+
+            // The fallback doesn't need specializing, so it can be used whilst the specialized
+            // pipeline is created.
+            ComPtr<IShaderProgram> fallbackProgram;
+            slang::ProgramLayout* fallbackReflection;
+            GFX_CHECK_CALL_ABORT(loadComputeProgram(device, fallbackProgram, "pipeline-specialization-async-fallback", "computeMain", fallbackReflection));
+
+            ComputePipelineStateDesc fallbackPipelineDesc = {};
+            fallbackPipelineDesc.program = fallbackProgram.get();
+            ComPtr<IPipelineState> fallbackPipelineState;
+            GFX_CHECK_CALL_ABORT(
+                device->createComputePipelineState(fallbackPipelineDesc, fallbackPipelineState.writeRef()));
+
+            ComPtr<IShaderProgram> shaderProgram;
+            GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "pipeline-specialization-async", "computeMain", slangReflection));
+
+            ComputePipelineStateDesc pipelineDesc = {};
+            pipelineDesc.program = shaderProgram.get();
+            pipelineDesc.fallbackPipeline = fallbackPipelineState.get();
+            GFX_CHECK_CALL_ABORT(
+                device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+        }
+
+            /// Runs the kernel with an `AddTransformer` bound, writing the contents of the buffer to `outResult`.
+            /// If `waitForSpecialization` is set, waits for the specialized pipeline to be created before
+            /// the dispatch.
+        void dispatch(bool waitForSpecialization, float outResult[kElementCount])
+        {
+            const float initialData[kElementCount] = { 0.0f, 1.0f, 2.0f, 3.0f };
+            IBufferResource::Desc bufferDesc = {};
+            bufferDesc.sizeInBytes = sizeof(initialData);
+            bufferDesc.format = gfx::Format::Unknown;
+            bufferDesc.elementSize = sizeof(float);
+            bufferDesc.allowedStates = ResourceStateSet(
+                ResourceState::ShaderResource,
+                ResourceState::UnorderedAccess,
+                ResourceState::CopyDestination,
+                ResourceState::CopySource);
+            bufferDesc.defaultState = ResourceState::UnorderedAccess;
+            bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+            ComPtr<IBufferResource> buffer;
+            GFX_CHECK_CALL_ABORT(device->createBufferResource(bufferDesc, initialData, buffer.writeRef()));
+
+            ComPtr<IResourceView> bufferView;
+            IResourceView::Desc viewDesc = {};
+            viewDesc.type = IResourceView::Type::UnorderedAccess;
+            viewDesc.format = Format::Unknown;
+            GFX_CHECK_CALL_ABORT(
+                device->createBufferView(buffer, nullptr, viewDesc, bufferView.writeRef()));
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+
+            // The reflection belongs to the Slang session, which the background thread may be using.
+            ComPtr<IShaderObject> transformer;
+            device->lockSlangSession();
+            slang::TypeReflection* transformerType = slangReflection->findTypeByName("AddTransformer");
+            device->unlockSlangSession();
+            GFX_CHECK_CALL_ABORT(device->createShaderObject(
+                transformerType, ShaderObjectContainerType::None, transformer.writeRef()));
+
+            float c = 5.f;
+            ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+            entryPointCursor.getPath("transformer").setObject(transformer);
+
+            if (waitForSpecialization)
+            {
+                ComPtr<IPipelineSpecializationTask> task;
+                GFX_CHECK_CALL_ABORT(device->specializePipelineAsync(pipelineState, rootObject, task.writeRef()));
+                GFX_CHECK_CALL_ABORT(task->wait(kTimeoutInfinite));
+                SLANG_CHECK(task->isComplete());
+            }
+
+            encoder->dispatchCompute(1, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+
+            ComPtr<ISlangBlob> resultBlob;
+            GFX_CHECK_CALL_ABORT(device->readBufferResource(
+                buffer, 0, bufferDesc.sizeInBytes, resultBlob.writeRef()));
+            memcpy(outResult, resultBlob->getBufferPointer(), bufferDesc.sizeInBytes);
+        }
+    };
+
+    // Checks that a dispatch needing a new specialization uses either the fallback or the specialized
+    // pipeline when specializations are created in the background, and that the specialized pipeline
+    // is used once the task creating it has completed.
+    SLANG_UNIT_TEST(pipelineSpecializationAsync)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        PipelineSpecializationAsyncTest test;
+        test.init(unitTestContext);
+
+        const float fallbackResult[kElementCount] = { -1.0f, -1.0f, -1.0f, -1.0f };
+        const float specializedResult[kElementCount] = { 5.0f, 6.0f, 7.0f, 8.0f };
+
+        // Which pipeline runs depends on whether the background thread has finished.
+        float result[kElementCount];
+        test.dispatch(false, result);
+        SLANG_CHECK(
+            memcmp(result, fallbackResult, sizeof(result)) == 0 ||
+            memcmp(result, specializedResult, sizeof(result)) == 0);
+
+        test.dispatch(true, result);
+        SLANG_CHECK(memcmp(result, specializedResult, sizeof(result)) == 0);
+    }
+}
@@ -35,6 +35,9 @@ namespace cpu
     class ShaderProgramImpl;
     class PipelineStateImpl;
     class QueryPoolImpl;
+    class FenceImpl;
+    class CommandQueueImpl;
+    class Submission;
     class DeviceImpl;
 } // namespace cpu
 } // namespace gfx
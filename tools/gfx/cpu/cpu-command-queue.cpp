@@ -0,0 +1,205 @@
+// cpu-command-queue.cpp
+#include "cpu-command-queue.h"
+
+#include "cpu-device.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+ICommandQueue* CommandQueueImpl::getInterface(const Guid& guid)
+{
+    if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_ICommandQueue)
+        return static_cast<ICommandQueue*>(this);
+    return nullptr;
+}
+
+CommandQueueImpl::CommandQueueImpl(DeviceImpl* device, const Desc& desc)
+    : m_device(device)
+    , m_desc(desc)
+{
+    m_device->registerQueue(this);
+    m_workerThread = std::thread(&CommandQueueImpl::_workerThreadFunc, this);
+}
+
+CommandQueueImpl::~CommandQueueImpl()
+{
+    // The worker thread executes everything already submitted before it exits, except work
+    // held back by a fence that hasn't been signalled, which would otherwise never finish.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShutdown = true;
+    }
+    m_submissionAvailable.notify_all();
+    FenceImpl::wakeWaiters();
+    m_workerThread.join();
+
+    m_submissions.clear();
+    m_device->unregisterQueue(this);
+}
+
+SLANG_NO_THROW void SLANG_MCALL CommandQueueImpl::executeCommandBuffers(
+    GfxCount count,
+    ICommandBuffer* const* commandBuffers,
+    IFence* fenceToSignal,
+    uint64_t newFenceValue)
+{
+    RefPtr<Submission> submission = new Submission();
+    m_device->recordSubmission(submission, count, commandBuffers);
+    submission->signalFence = fenceToSignal;
+    submission->signalValue = newFenceValue;
+    _submit(submission);
+}
+
+SLANG_NO_THROW Result SLANG_MCALL CommandQueueImpl::getNativeHandle(InteropHandle* outHandle)
+{
+    SLANG_UNUSED(outHandle);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+SLANG_NO_THROW void SLANG_MCALL CommandQueueImpl::waitOnHost()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const uint64_t submittedCount = m_submittedCount;
+        m_submissionsCompleted.wait(lock, [&]() { return m_completedCount >= submittedCount; });
+    }
+    _retireCompletedSubmissions();
+}
+
+uint64_t CommandQueueImpl::waitUntilIdleOrBlocked()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_submissionsCompleted.wait(
+        lock, [&]() { return m_completedCount >= m_submittedCount || m_isWaitingOnFence; });
+    return m_completedCount + m_fenceWaitCount;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL CommandQueueImpl::waitForFenceValuesOnDevice(
+    GfxCount fenceCount, IFence** fences, uint64_t* waitValues)
+{
+    // The wait is queued as a submission without any commands, so it holds back everything
+    // submitted after it.
+    RefPtr<Submission> submission = new Submission();
+    for (GfxIndex i = 0; i < fenceCount; i++)
+    {
+        submission->waitFences.add(ComPtr<IFence>(fences[i]));
+        submission->waitValues.add(waitValues[i]);
+    }
+    _submit(submission);
+    return SLANG_OK;
+}
+
+void CommandQueueImpl::_submit(Submission* submission)
+{
+    _retireCompletedSubmissions();
+    m_submissions.add(submission);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingSubmissions.add(submission);
+        m_submittedCount++;
+    }
+    m_submissionAvailable.notify_one();
+}
+
+void CommandQueueImpl::_retireCompletedSubmissions()
+{
+    uint64_t completedCount;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completedCount = m_completedCount;
+    }
+    // Submissions complete in order, so the completed ones are at the front.
+    if (completedCount > m_retiredCount)
+    {
+        m_submissions.removeRange(0, Index(completedCount - m_retiredCount));
+        m_retiredCount = completedCount;
+    }
+}
+
+void CommandQueueImpl::_workerThreadFunc()
+{
+    // Only plain pointers are used here. The submissions are held alive by `m_submissions`
+    // until the completed count shows that this thread is done with them.
+    List<Submission*> submissions;
+    bool isAborted = false;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_submissionAvailable.wait(
+                lock, [&]() { return m_isShutdown || m_pendingSubmissions.getCount() != 0; });
+            if (m_pendingSubmissions.getCount() == 0)
+            {
+                // Only reached on shutdown, once all the work has been done.
+                return;
+            }
+            // Take all of the pending submissions at once, so the host can keep submitting
+            // while they execute.
+            submissions.swapWith(m_pendingSubmissions);
+        }
+
+        for (auto submission : submissions)
+        {
+            // Once a wait has been given up on, nothing submitted after it can run.
+            if (isAborted)
+                break;
+
+            if (submission->waitFences.getCount())
+            {
+                const GfxCount fenceCount = GfxCount(submission->waitFences.getCount());
+                IFence* const* fences = submission->waitFences[0].readRef();
+                auto waitResult = FenceImpl::waitForValues(
+                    fenceCount, fences, submission->waitValues.getBuffer(), true, 0);
+                if (waitResult == SLANG_E_TIME_OUT)
+                {
+                    // The fence may only be signalled by the host, so a wait for the queue to
+                    // finish on another thread (such as a buffer read) doesn't wait for this.
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_isWaitingOnFence = true;
+                        m_fenceWaitCount++;
+                    }
+                    m_submissionsCompleted.notify_all();
+
+                    waitResult = FenceImpl::waitForValues(
+                        fenceCount,
+                        fences,
+                        submission->waitValues.getBuffer(),
+                        true,
+                        kTimeoutInfinite,
+                        &m_isShutdown);
+
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_isWaitingOnFence = false;
+                }
+                if (SLANG_FAILED(waitResult))
+                {
+                    isAborted = true;
+                    break;
+                }
+            }
+
+            m_device->executeSubmission(submission);
+
+            if (submission->signalFence)
+            {
+                submission->signalFence->setCurrentValue(submission->signalValue);
+            }
+        }
+
+        // Submissions that were abandoned count as completed, as the thread is done with them.
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completedCount += uint64_t(submissions.getCount());
+        }
+        submissions.clear();
+        m_submissionsCompleted.notify_all();
+    }
+}
+
+} // namespace cpu
+} // namespace gfx
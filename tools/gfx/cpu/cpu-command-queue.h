@@ -0,0 +1,138 @@
+// cpu-command-queue.h
+#pragma once
+#include "cpu-base.h"
+
+#include "cpu-fence.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+// A batch of work for a queue's worker thread. Command buffers are replayed into a submission on
+// the thread that submits them, so that the worker thread only copies memory and calls kernels
+// through plain pointers. The submission holds the objects those pointers refer to alive, and is
+// only created and released on the submitting thread, as reference counts aren't atomic.
+class Submission : public RefObject
+{
+public:
+    struct Command
+    {
+        enum class Kind
+        {
+            DispatchCompute,
+            CopyBuffer,
+            UploadBufferData,
+            WriteTimestamp,
+        };
+        Kind kind;
+
+        // DispatchCompute.
+        slang_prelude::ComputeFunc func = nullptr;
+        void* entryPointParams = nullptr;
+        void* globalParams = nullptr;
+        int groupCount[3] = {};
+
+        // CopyBuffer and UploadBufferData. The source of an upload is at `uploadDataOffset`
+        // in `uploadData`, as the command buffer it was recorded in is cleared once replayed.
+        void* dst = nullptr;
+        const void* src = nullptr;
+        Offset uploadDataOffset = 0;
+        Size size = 0;
+
+        // WriteTimestamp.
+        uint64_t* timestamp = nullptr;
+    };
+
+    List<Command> commands;
+    List<uint8_t> uploadData;
+    // The objects that `commands` point into.
+    List<RefPtr<RefObject>> objects;
+
+    // Fence values that must be reached before the commands are executed.
+    List<ComPtr<IFence>> waitFences;
+    List<uint64_t> waitValues;
+
+    // Signalled with `signalValue` once the commands have been executed. Can be null.
+    ComPtr<IFence> signalFence;
+    uint64_t signalValue = 0;
+};
+
+// A queue that executes its submissions in order on a thread of its own, so that recording and
+// submitting work on the host can overlap with executing earlier submissions. The queues of a
+// device run independently of each other, and are synchronized with fences.
+class CommandQueueImpl
+    : public ICommandQueue
+    , public ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    ICommandQueue* getInterface(const Guid& guid);
+
+    CommandQueueImpl(DeviceImpl* device, const Desc& desc);
+    ~CommandQueueImpl();
+
+    virtual SLANG_NO_THROW const Desc& SLANG_MCALL getDesc() override { return m_desc; }
+
+    virtual SLANG_NO_THROW void SLANG_MCALL executeCommandBuffers(
+        GfxCount count,
+        ICommandBuffer* const* commandBuffers,
+        IFence* fenceToSignal,
+        uint64_t newFenceValue) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(InteropHandle* outHandle) override;
+
+    virtual SLANG_NO_THROW void SLANG_MCALL waitOnHost() override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        waitForFenceValuesOnDevice(GfxCount fenceCount, IFence** fences, uint64_t* waitValues) override;
+
+    // Blocks until everything submitted has executed, or the worker thread is waiting for a fence
+    // that hasn't been reached. Returns a count that increases whenever the worker thread finishes
+    // work or starts such a wait. Doesn't retire submissions, so can be called on any thread.
+    uint64_t waitUntilIdleOrBlocked();
+
+private:
+    void _submit(Submission* submission);
+
+    // Releases the submissions that the worker thread has finished with.
+    void _retireCompletedSubmissions();
+
+    void _workerThreadFunc();
+
+    RefPtr<DeviceImpl> m_device;
+    Desc m_desc;
+
+    std::thread m_workerThread;
+
+    // The submissions that haven't been retired yet, in the order they were submitted. Only
+    // accessed on the submitting thread, which owns the references, so only `waitOnHost` and
+    // submitting retire them.
+    List<RefPtr<Submission>> m_submissions;
+    uint64_t m_retiredCount = 0;
+
+    // Protects the fields below, which hand submissions to the worker thread.
+    std::mutex m_mutex;
+    std::condition_variable m_submissionAvailable;
+    // Also notified when the worker thread starts waiting for a fence.
+    std::condition_variable m_submissionsCompleted;
+    List<Submission*> m_pendingSubmissions;
+    uint64_t m_submittedCount = 0;
+    uint64_t m_completedCount = 0;
+    // Set while the worker thread waits for a fence that wasn't reached when it got to the wait,
+    // and the number of such waits.
+    bool m_isWaitingOnFence = false;
+    uint64_t m_fenceWaitCount = 0;
+    // Also read by fence waits on the worker thread, which give up once it is set.
+    std::atomic<bool> m_isShutdown = false;
+};
+
+} // namespace cpu
+} // namespace gfx
@@ -4,6 +4,8 @@
 #include <chrono>
 
 #include "cpu-buffer.h"
+#include "cpu-command-queue.h"
+#include "cpu-fence.h"
 #include "cpu-pipeline-state.h"
 #include "cpu-query.h"
 #include "cpu-resource-views.h"
@@ -19,6 +21,8 @@ namespace cpu
 {
     DeviceImpl::~DeviceImpl()
     {
+        stopPipelineSpecializationThread();
+
         m_currentPipeline = nullptr;
         m_currentRootObject = nullptr;
     }
@@ -33,6 +37,30 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        // Find extended desc.
+        for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+        {
+            StructType stype;
+            memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+            if (stype == StructType::CPUDeviceExtendedDesc)
+            {
+                memcpy(&m_extendedDesc, desc.extendedDescs[i], sizeof(m_extendedDesc));
+            }
+        }
+
+        // Set up the threads used to execute dispatches.
+        {
+            Count threadCount = ThreadPool::getDefaultThreadCount();
+            if (m_extendedDesc.maxThreadCount)
+            {
+                threadCount = Math::Min(threadCount, Count(m_extendedDesc.maxThreadCount));
+            }
+            if (threadCount > 1)
+            {
+                m_threadPool = new ThreadPool(threadCount);
+            }
+        }
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -157,6 +185,9 @@ namespace cpu
         IShaderProgram** outProgram,
         ISlangBlob** outDiagnosticBlob)
     {
+        // Linking and reflecting the program uses the session, which the background thread shares.
+        std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
         RefPtr<ShaderProgramImpl> cpuProgram = new ShaderProgramImpl();
         cpuProgram->init(desc);
         auto slangGlobalScope = cpuProgram->linkedProgram;
@@ -185,6 +216,22 @@ namespace cpu
         return Result();
     }
 
+    Result DeviceImpl::precompileSpecializedProgram(slang::IComponentType* specializedProgram)
+    {
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = specializedProgram->getEntryPointHostCallable(
+            0, 0, sharedLibrary.writeRef(), diagnostics.writeRef());
+        if (diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer());
+        }
+        return compileResult;
+    }
+
     SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::createQueryPool(
         const IQueryPool::Desc& desc, IQueryPool** outPool)
     {
@@ -196,8 +243,135 @@ namespace cpu
 
     void DeviceImpl::writeTimestamp(IQueryPool* pool, GfxIndex index)
     {
-        static_cast<QueryPoolImpl*>(pool)->m_queries[index] =
-            std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        auto poolImpl = static_cast<QueryPoolImpl*>(pool);
+
+        Submission::Command command;
+        command.kind = Submission::Command::Kind::WriteTimestamp;
+        command.timestamp = &poolImpl->m_queries[index];
+        m_recordingSubmission->commands.add(command);
+        m_recordingSubmission->objects.add(poolImpl);
+    }
+
+    void DeviceImpl::uploadBufferData(IBufferResource* dst, Offset offset, Size size, void* data)
+    {
+        auto dstImpl = static_cast<BufferResourceImpl*>(dst);
+
+        Submission::Command command;
+        command.kind = Submission::Command::Kind::UploadBufferData;
+        command.dst = (uint8_t*)dstImpl->m_data + offset;
+        command.uploadDataOffset = m_recordingSubmission->uploadData.getCount();
+        command.size = size;
+        m_recordingSubmission->uploadData.addRange((const uint8_t*)data, Index(size));
+        m_recordingSubmission->commands.add(command);
+        m_recordingSubmission->objects.add(dstImpl);
+    }
+
+    SLANG_NO_THROW Result SLANG_MCALL
+        DeviceImpl::createCommandQueue(const ICommandQueue::Desc& desc, ICommandQueue** outQueue)
+    {
+        RefPtr<CommandQueueImpl> queue = new CommandQueueImpl(this, desc);
+        returnComPtr(outQueue, queue);
+        return SLANG_OK;
+    }
+
+    SLANG_NO_THROW Result SLANG_MCALL
+        DeviceImpl::createFence(const IFence::Desc& desc, IFence** outFence)
+    {
+        RefPtr<FenceImpl> fence = new FenceImpl();
+        SLANG_RETURN_ON_FAIL(fence->init(desc));
+        returnComPtr(outFence, fence);
+        return SLANG_OK;
+    }
+
+    SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::waitForFences(
+        GfxCount fenceCount, IFence** fences, uint64_t* fenceValues, bool waitForAll, uint64_t timeout)
+    {
+        return FenceImpl::waitForValues(fenceCount, fences, fenceValues, waitForAll, timeout);
+    }
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL DeviceImpl::readBufferResource(
+        IBufferResource* buffer,
+        Offset offset,
+        Size size,
+        ISlangBlob** outBlob)
+    {
+        waitForGpu();
+        return ImmediateComputeDeviceBase::readBufferResource(buffer, offset, size, outBlob);
+    }
+
+    void DeviceImpl::waitForGpu()
+    {
+        // Called on any thread (such as by `readBufferResource`), so the queues aren't asked to
+        // retire their submissions, which only their submitting threads can release.
+        //
+        // A queue waiting for a fence is left waiting, as the fence may only be signalled by the
+        // host after this returns. Another queue finishing its work can signal the fence though,
+        // so the queues are waited on until a pass over all of them sees no progress.
+        //
+        // Queues can't be destroyed while the lock is held, and they don't need the lock to
+        // make progress.
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        List<uint64_t> lastProgress;
+        for (;;)
+        {
+            List<uint64_t> progress;
+            for (auto queue : m_queues)
+            {
+                progress.add(queue->waitUntilIdleOrBlocked());
+            }
+            if (progress == lastProgress)
+            {
+                break;
+            }
+            lastProgress.swapWith(progress);
+        }
+    }
+
+    void DeviceImpl::recordSubmission(
+        Submission* submission, GfxCount count, ICommandBuffer* const* commandBuffers)
+    {
+        m_recordingSubmission = submission;
+        executeCommandBuffers(count, commandBuffers);
+        m_recordingSubmission = nullptr;
+    }
+
+    void DeviceImpl::executeSubmission(const Submission* submission)
+    {
+        for (const auto& command : submission->commands)
+        {
+            switch (command.kind)
+            {
+            case Submission::Command::Kind::DispatchCompute:
+                _dispatchCompute(
+                    command.func, command.groupCount, command.entryPointParams, command.globalParams);
+                break;
+            case Submission::Command::Kind::CopyBuffer:
+                memcpy(command.dst, command.src, command.size);
+                break;
+            case Submission::Command::Kind::UploadBufferData:
+                memcpy(
+                    command.dst,
+                    submission->uploadData.getBuffer() + command.uploadDataOffset,
+                    command.size);
+                break;
+            case Submission::Command::Kind::WriteTimestamp:
+                *command.timestamp =
+                    std::chrono::high_resolution_clock::now().time_since_epoch().count();
+                break;
+            }
+        }
+    }
+
+    void DeviceImpl::registerQueue(CommandQueueImpl* queue)
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_queues.add(queue);
+    }
+
+    void DeviceImpl::unregisterQueue(CommandQueueImpl* queue)
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_queues.fastRemove(queue);
     }
 
     SLANG_NO_THROW const DeviceInfo& SLANG_MCALL DeviceImpl::getDeviceInfo() const
@@ -236,49 +410,100 @@ namespace cpu
         m_currentRootObject = static_cast<RootShaderObjectImpl*>(object);
     }
 
+    void DeviceImpl::endCommandBuffer(const CommandBufferInfo& info)
+    {
+        SLANG_UNUSED(info);
+
+        // The submission holds alive what its commands use.
+        m_currentPipeline = nullptr;
+        m_currentRootObject = nullptr;
+    }
+
     void DeviceImpl::dispatchCompute(int x, int y, int z)
     {
         int entryPointIndex = 0;
-        int targetIndex = 0;
+
+        auto currentRootObject = m_currentRootObject.Ptr();
 
         // Specialize the compute kernel based on the shader object bindings.
         RefPtr<PipelineStateBase> newPipeline;
-        maybeSpecializePipeline(m_currentPipeline, m_currentRootObject, newPipeline);
-        m_currentPipeline = static_cast<PipelineStateImpl*>(newPipeline.Ptr());
+        maybeSpecializePipeline(m_currentPipeline, currentRootObject, newPipeline);
+        auto pipeline = static_cast<PipelineStateImpl*>(newPipeline.Ptr());
+
+        // The kernel has already been compiled if the pipeline was specialized in the background.
+        {
+            std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+            if (SLANG_FAILED(pipeline->ensureAPIPipelineStateCreated())) return;
+        }
 
-        auto program = m_currentPipeline->getProgram();
         auto entryPointLayout =
-            m_currentRootObject->getLayout()->getEntryPoint(entryPointIndex);
+            currentRootObject->getLayout()->getEntryPoint(entryPointIndex);
         auto entryPointName = entryPointLayout->getEntryPointName();
 
-        auto entryPointObject = m_currentRootObject->getEntryPoint(entryPointIndex);
+        auto entryPointObject = currentRootObject->getEntryPoint(entryPointIndex);
+
+        Submission::Command command;
+        command.kind = Submission::Command::Kind::DispatchCompute;
+        command.func = (slang_prelude::ComputeFunc)pipeline->m_sharedLibrary->findSymbolAddressByName(entryPointName);
+        command.entryPointParams = entryPointObject->getDataBuffer();
+        command.globalParams = currentRootObject->getDataBuffer();
+        command.groupCount[0] = x;
+        command.groupCount[1] = y;
+        command.groupCount[2] = z;
+        m_recordingSubmission->commands.add(command);
+        // The pipeline holds the kernel's code, and the root object the parameter data.
+        m_recordingSubmission->objects.add(pipeline);
+        m_recordingSubmission->objects.add(currentRootObject);
+    }
 
-        ComPtr<ISlangSharedLibrary> sharedLibrary;
-        ComPtr<ISlangBlob> diagnostics;
-        auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
-            entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
-        if (diagnostics)
+    void DeviceImpl::_dispatchCompute(
+        slang_prelude::ComputeFunc func,
+        const int groupCount[3],
+        void* entryPointParams,
+        void* globalParams)
+    {
+        const int x = groupCount[0];
+        const int y = groupCount[1];
+        const int z = groupCount[2];
+
+        // Read through the plain pointer, as this runs on a queue's worker thread.
+        auto threadPool = m_threadPool.Ptr();
+        if (!threadPool || Count(x) * y * z <= 1)
         {
-            getDebugCallback()->handleMessage(
-                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                DebugMessageSource::Slang,
-                (char*)diagnostics->getBufferPointer());
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = 0;
+            varyingInput.startGroupID.y = 0;
+            varyingInput.startGroupID.z = 0;
+            varyingInput.endGroupID.x = x;
+            varyingInput.endGroupID.y = y;
+            varyingInput.endGroupID.z = z;
+
+            func(&varyingInput, entryPointParams, globalParams);
+            return;
         }
-        if (SLANG_FAILED(compileResult)) return;
-
-        auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-        slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
-
-        auto globalParamsData = m_currentRootObject->getDataBuffer();
-        auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+        // Split the grid into tiles, each of which is a run of groups along x within a single
+        // (y, z) row. We aim for several tiles per thread so that work stealing can even out
+        // groups that take different amounts of time.
+        const Count rowCount = Count(y) * z;
+        const Count targetTileCount = threadPool->getThreadCount() * 4;
+        const Count tilesPerRow = Math::Clamp((targetTileCount + rowCount - 1) / rowCount, Count(1), Count(x));
+
+        threadPool->parallelFor(rowCount * tilesPerRow, [&](Index tileIndex)
+            {
+                const Index rowIndex = tileIndex / tilesPerRow;
+                const Index columnIndex = tileIndex % tilesPerRow;
+
+                slang_prelude::ComputeVaryingInput varyingInput;
+                varyingInput.startGroupID.x = uint32_t((Count(x) * columnIndex) / tilesPerRow);
+                varyingInput.startGroupID.y = uint32_t(rowIndex % y);
+                varyingInput.startGroupID.z = uint32_t(rowIndex / y);
+                varyingInput.endGroupID.x = uint32_t((Count(x) * (columnIndex + 1)) / tilesPerRow);
+                varyingInput.endGroupID.y = varyingInput.startGroupID.y + 1;
+                varyingInput.endGroupID.z = varyingInput.startGroupID.z + 1;
+
+                func(&varyingInput, entryPointParams, globalParams);
+            });
     }
 
     void DeviceImpl::copyBuffer(
@@ -290,10 +515,15 @@ namespace cpu
     {
         auto dstImpl = static_cast<BufferResourceImpl*>(dst);
         auto srcImpl = static_cast<BufferResourceImpl*>(src);
-        memcpy(
-            (uint8_t*)dstImpl->m_data + dstOffset,
-            (uint8_t*)srcImpl->m_data + srcOffset,
-            size);
+
+        Submission::Command command;
+        command.kind = Submission::Command::Kind::CopyBuffer;
+        command.dst = (uint8_t*)dstImpl->m_data + dstOffset;
+        command.src = (uint8_t*)srcImpl->m_data + srcOffset;
+        command.size = size;
+        m_recordingSubmission->commands.add(command);
+        m_recordingSubmission->objects.add(dstImpl);
+        m_recordingSubmission->objects.add(srcImpl);
     }
 
 } // namespace cpu
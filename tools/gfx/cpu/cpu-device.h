@@ -5,6 +5,10 @@
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
 
+#include "core/slang-thread-pool.h"
+
+#include <mutex>
+
 namespace gfx
 {
 using namespace Slang;
@@ -65,20 +69,75 @@ public:
 
     virtual void writeTimestamp(IQueryPool* pool, GfxIndex index) override;
 
+    virtual void uploadBufferData(IBufferResource* dst, Offset offset, Size size, void* data) override;
+
+    // Each queue executes its submissions on a thread of its own, so any number of queues
+    // can be created, and they run concurrently.
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        createCommandQueue(const ICommandQueue::Desc& desc, ICommandQueue** outQueue) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        createFence(const IFence::Desc& desc, IFence** outFence) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL waitForFences(
+        GfxCount fenceCount, IFence** fences, uint64_t* fenceValues, bool waitForAll, uint64_t timeout) override;
+
+    // Waits for the work submitted to all queues to complete before reading the buffer.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL readBufferResource(
+        IBufferResource* buffer,
+        Offset offset,
+        Size size,
+        ISlangBlob** outBlob) override;
+
     virtual SLANG_NO_THROW const DeviceInfo& SLANG_MCALL getDeviceInfo() const override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
         createSamplerState(ISamplerState::Desc const& desc, ISamplerState** outSampler) override;
 
     virtual void submitGpuWork() override {}
-    virtual void waitForGpu() override {}
+    virtual void waitForGpu() override;
     virtual void* map(IBufferResource* buffer, MapFlavor flavor) override;
     virtual void unmap(IBufferResource* buffer, size_t offsetWritten, size_t sizeWritten) override;
 
+    virtual bool canCreatePipelinesInBackground() override { return true; }
+
+    // Compiles the host callable that `PipelineStateImpl::ensureAPIPipelineStateCreated` loads.
+    virtual Result precompileSpecializedProgram(slang::IComponentType* specializedProgram) override;
+
+    // Called by each queue when it is created and destroyed.
+    void registerQueue(CommandQueueImpl* queue);
+    void unregisterQueue(CommandQueueImpl* queue);
+
+    // Replays `commandBuffers` into `submission`, specializing pipelines and resolving resources
+    // into the pointers the commands use. Called on the thread that submits the command buffers.
+    void recordSubmission(Submission* submission, GfxCount count, ICommandBuffer* const* commandBuffers);
+
+    // Executes the commands of `submission`. Called on a queue's worker thread, so doesn't touch
+    // any reference counts.
+    void executeSubmission(const Submission* submission);
+
 private:
+    DeviceInfo m_info;
+    CPUDeviceExtendedDesc m_extendedDesc;
+
+    // Used to run the groups of a dispatch in parallel. Null if dispatches run on a single thread.
+    RefPtr<ThreadPool> m_threadPool;
+
+    // The queues created by the device. Each queue holds the device alive, so these are weak.
+    std::mutex m_queuesMutex;
+    List<CommandQueueImpl*> m_queues;
+
+    // The submission that command buffers are being replayed into, and the state bound by them.
+    Submission* m_recordingSubmission = nullptr;
     RefPtr<PipelineStateImpl> m_currentPipeline = nullptr;
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
-    DeviceInfo m_info;
+
+    // Runs the groups of a dispatch, spread over the thread pool if there is one.
+    void _dispatchCompute(
+        slang_prelude::ComputeFunc func,
+        const int groupCount[3],
+        void* entryPointParams,
+        void* globalParams);
 
     virtual void setPipelineState(IPipelineState* state) override;
 
@@ -86,6 +145,8 @@ private:
 
     virtual void dispatchCompute(int x, int y, int z) override;
 
+    virtual void endCommandBuffer(const CommandBufferInfo& info) override;
+
     virtual void copyBuffer(
         IBufferResource* dst,
         size_t dstOffset,
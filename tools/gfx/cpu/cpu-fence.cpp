@@ -0,0 +1,100 @@
+// cpu-fence.cpp
+#include "cpu-fence.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+// Fences are signalled rarely (once per submission at most), so a single mutex and condition
+// variable for all of them costs little, and makes waiting on any of several fences simple.
+static std::mutex s_fenceMutex;
+static std::condition_variable s_fenceSignalled;
+
+Result FenceImpl::init(const IFence::Desc& desc)
+{
+    if (desc.isShared)
+        return SLANG_E_NOT_AVAILABLE;
+    m_value = desc.initialValue;
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL FenceImpl::getCurrentValue(uint64_t* outValue)
+{
+    std::lock_guard<std::mutex> lock(s_fenceMutex);
+    *outValue = m_value;
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL FenceImpl::setCurrentValue(uint64_t value)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_fenceMutex);
+        m_value = value;
+    }
+    s_fenceSignalled.notify_all();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL FenceImpl::getSharedHandle(InteropHandle* outHandle)
+{
+    SLANG_UNUSED(outHandle);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL FenceImpl::getNativeHandle(InteropHandle* outNativeHandle)
+{
+    SLANG_UNUSED(outNativeHandle);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+Result FenceImpl::waitForValues(
+    GfxCount fenceCount,
+    IFence* const* fences,
+    const uint64_t* values,
+    bool waitForAll,
+    uint64_t timeout,
+    const std::atomic<bool>* cancel)
+{
+    auto isSignalled = [&]()
+    {
+        for (GfxIndex i = 0; i < fenceCount; ++i)
+        {
+            const bool reached = static_cast<FenceImpl*>(fences[i])->m_value >= values[i];
+            if (reached != waitForAll)
+                return reached;
+        }
+        return waitForAll || fenceCount == 0;
+    };
+    auto isCancelled = [&]() { return cancel && cancel->load(); };
+    auto isDone = [&]() { return isSignalled() || isCancelled(); };
+
+    std::unique_lock<std::mutex> lock(s_fenceMutex);
+    if (timeout == kTimeoutInfinite)
+    {
+        s_fenceSignalled.wait(lock, isDone);
+    }
+    else if (!s_fenceSignalled.wait_for(lock, std::chrono::nanoseconds(timeout), isDone))
+    {
+        return SLANG_E_TIME_OUT;
+    }
+    return isSignalled() ? SLANG_OK : SLANG_E_ABORT;
+}
+
+void FenceImpl::wakeWaiters()
+{
+    // Taking the lock makes sure a waiter either sees its flag set, or is already waiting.
+    {
+        std::lock_guard<std::mutex> lock(s_fenceMutex);
+    }
+    s_fenceSignalled.notify_all();
+}
+
+} // namespace cpu
+} // namespace gfx
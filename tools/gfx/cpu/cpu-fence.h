@@ -0,0 +1,50 @@
+// cpu-fence.h
+#pragma once
+#include "cpu-base.h"
+
+#include <atomic>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+class FenceImpl : public FenceBase
+{
+public:
+    Result init(const IFence::Desc& desc);
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getCurrentValue(uint64_t* outValue) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL setCurrentValue(uint64_t value) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSharedHandle(InteropHandle* outHandle) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        getNativeHandle(InteropHandle* outNativeHandle) override;
+
+        /// Block until all (or, if `waitForAll` is false, any) of `fences` have reached the
+        /// corresponding value in `values`. `timeout` is in nanoseconds, and can be `kTimeoutInfinite`.
+        /// If `cancel` is not null, the wait gives up with `SLANG_E_ABORT` once it is set and
+        /// `wakeWaiters` has been called.
+    static Result waitForValues(
+        GfxCount fenceCount,
+        IFence* const* fences,
+        const uint64_t* values,
+        bool waitForAll,
+        uint64_t timeout,
+        const std::atomic<bool>* cancel = nullptr);
+
+        /// Wake all waits so they check their `cancel` flag.
+    static void wakeWaiters();
+
+private:
+    // Protected by the mutex shared by all CPU fences, so that a wait on several fences can
+    // be woken by a signal of any of them.
+    uint64_t m_value = 0;
+};
+
+} // namespace cpu
+} // namespace gfx
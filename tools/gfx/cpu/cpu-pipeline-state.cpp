@@ -23,5 +23,26 @@ namespace cpu
         initializeBase(pipelineDesc);
     }
 
+    Result PipelineStateImpl::ensureAPIPipelineStateCreated()
+    {
+        if (m_sharedLibrary)
+            return SLANG_OK;
+
+        int entryPointIndex = 0;
+        int targetIndex = 0;
+
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = getProgram()->slangGlobalScope->getEntryPointHostCallable(
+            entryPointIndex, targetIndex, m_sharedLibrary.writeRef(), diagnostics.writeRef());
+        if (diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer());
+        }
+        return compileResult;
+    }
+
 } // namespace cpu
 } // namespace gfx
@@ -15,6 +15,12 @@ public:
     ShaderProgramImpl* getProgram();
 
     void init(const ComputePipelineStateDesc& inDesc);
+
+    // Compiles the kernel. The device's Slang session must be locked.
+    virtual Result ensureAPIPipelineStateCreated() override;
+
+    // The compiled kernel, created by `ensureAPIPipelineStateCreated`.
+    ComPtr<ISlangSharedLibrary> m_sharedLibrary;
 };
 
 } // namespace cpu
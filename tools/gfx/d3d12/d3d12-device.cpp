@@ -473,6 +473,8 @@ Result DeviceImpl::initialize(const Desc& desc)
         case StructType::D3D12ExperimentalFeaturesDesc:
             processExperimentalFeaturesDesc(d3dModule, desc.extendedDescs[i]);
             break;
+        default:
+            break;
         }
     }
 
@@ -2009,6 +2011,9 @@ Result DeviceImpl::readBufferResource(
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    // Linking and reflecting the program uses the session, which the background thread shares.
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl();
     shaderProgram->init(desc);
     ComPtr<ID3DBlob> d3dDiagnosticBlob;
@@ -2309,7 +2314,11 @@ void* DeviceImpl::loadProc(SharedLibrary::Handle module, char const* name)
     return proc;
 }
 
-DeviceImpl::~DeviceImpl() { m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)(); }
+DeviceImpl::~DeviceImpl()
+{
+    stopPipelineSpecializationThread();
+    m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+}
 
 
 } // namespace d3d12
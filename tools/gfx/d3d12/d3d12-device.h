@@ -201,6 +201,8 @@ public:
 
     ~DeviceImpl();
 
+    virtual bool canCreatePipelinesInBackground() override { return true; }
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getAccelerationStructurePrebuildInfo(
         const IAccelerationStructure::BuildInputs& buildInputs,
         IAccelerationStructure::PrebuildInfo* outPrebuildInfo) override;
@@ -487,6 +487,7 @@ Result DebugDevice::createGraphicsPipelineState(
     innerDesc.program = getInnerObj(desc.program);
     innerDesc.inputLayout = getInnerObj(desc.inputLayout);
     innerDesc.framebufferLayout = getInnerObj(desc.framebufferLayout);
+    innerDesc.fallbackPipeline = getInnerObj(desc.fallbackPipeline);
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
         baseObject->createGraphicsPipelineState(innerDesc, outObject->baseObject.writeRef());
@@ -504,6 +505,7 @@ Result DebugDevice::createComputePipelineState(
 
     ComputePipelineStateDesc innerDesc = desc;
     innerDesc.program = getInnerObj(desc.program);
+    innerDesc.fallbackPipeline = getInnerObj(desc.fallbackPipeline);
 
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
@@ -604,6 +606,27 @@ Result DebugDevice::getTextureRowAlignment(size_t* outAlignment)
     return baseObject->getTextureRowAlignment(outAlignment);
 }
 
+Result DebugDevice::specializePipelineAsync(
+    IPipelineState* pipeline,
+    IShaderObject* rootObject,
+    IPipelineSpecializationTask** outTask)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->specializePipelineAsync(getInnerObj(pipeline), getInnerObj(rootObject), outTask);
+}
+
+void DebugDevice::lockSlangSession()
+{
+    SLANG_GFX_API_FUNC;
+    baseObject->lockSlangSession();
+}
+
+void DebugDevice::unlockSlangSession()
+{
+    SLANG_GFX_API_FUNC;
+    baseObject->unlockSlangSession();
+}
+
 Result DebugDevice::createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable)
 {
     SLANG_GFX_API_FUNC;
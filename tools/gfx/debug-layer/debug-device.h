@@ -143,6 +143,12 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureAllocationInfo(
         const ITextureResource::Desc& desc, size_t* outSize, size_t* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL specializePipelineAsync(
+        IPipelineState* pipeline,
+        IShaderObject* rootObject,
+        IPipelineSpecializationTask** outTask) override;
+    virtual SLANG_NO_THROW void SLANG_MCALL lockSlangSession() override;
+    virtual SLANG_NO_THROW void SLANG_MCALL unlockSlangSession() override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
         createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable) override;
 };
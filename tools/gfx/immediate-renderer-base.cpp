@@ -673,17 +673,7 @@ public:
         // TODO: implement fence signal.
         assert(fence == nullptr);
 
-        CommandBufferInfo info = {};
-        for (GfxIndex i = 0; i < count; i++)
-        {
-            info.hasWriteTimestamps |= static_cast<CommandBufferImpl*>(commandBuffers[i])->m_writer.m_hasWriteTimestamps;
-        }
-        static_cast<ImmediateRendererBase*>(m_renderer.get())->beginCommandBuffer(info);
-        for (GfxIndex i = 0; i < count; i++)
-        {
-            static_cast<CommandBufferImpl*>(commandBuffers[i])->execute();
-        }
-        static_cast<ImmediateRendererBase*>(m_renderer.get())->endCommandBuffer(info);
+        getRenderer()->executeCommandBuffers(count, commandBuffers);
     }
 
     virtual SLANG_NO_THROW void SLANG_MCALL waitOnHost() override { getRenderer()->waitForGpu(); }
@@ -710,6 +700,23 @@ ImmediateRendererBase::ImmediateRendererBase()
     m_queue = new CommandQueueImpl(this);
 }
 
+void ImmediateRendererBase::executeCommandBuffers(
+    GfxCount count,
+    ICommandBuffer* const* commandBuffers)
+{
+    CommandBufferInfo info = {};
+    for (GfxIndex i = 0; i < count; i++)
+    {
+        info.hasWriteTimestamps |= static_cast<CommandBufferImpl*>(commandBuffers[i])->m_writer.m_hasWriteTimestamps;
+    }
+    beginCommandBuffer(info);
+    for (GfxIndex i = 0; i < count; i++)
+    {
+        static_cast<CommandBufferImpl*>(commandBuffers[i])->execute();
+    }
+    endCommandBuffer(info);
+}
+
 SLANG_NO_THROW Result SLANG_MCALL ImmediateRendererBase::createTransientResourceHeap(
     const ITransientResourceHeap::Desc& desc,
     ITransientResourceHeap** outHeap)
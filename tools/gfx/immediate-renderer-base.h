@@ -111,7 +111,10 @@ public:
         const IRenderPassLayout::Desc& desc,
         IRenderPassLayout** outRenderPassLayout) override;
 
-    void uploadBufferData(
+    // Replays the commands recorded in `commandBuffers` on the calling thread.
+    void executeCommandBuffers(GfxCount count, ICommandBuffer* const* commandBuffers);
+
+    virtual void uploadBufferData(
         IBufferResource* dst,
         Offset offset,
         Size size, void* data);
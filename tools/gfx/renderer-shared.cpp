@@ -47,6 +47,7 @@ const Slang::Guid GfxGUID::IID_IFence = SLANG_UUID_IFence;
 const Slang::Guid GfxGUID::IID_IShaderTable = SLANG_UUID_IShaderTable;
 const Slang::Guid GfxGUID::IID_IPipelineCreationAPIDispatcher = SLANG_UUID_IPipelineCreationAPIDispatcher;
 const Slang::Guid GfxGUID::IID_ITransientResourceHeapD3D12 = SLANG_UUID_ITransientResourceHeapD3D12;
+const Slang::Guid GfxGUID::IID_IPipelineSpecializationTask = SLANG_UUID_IPipelineSpecializationTask;
 
 
 StageType translateStage(SlangStage slangStage)
@@ -328,6 +329,11 @@ void PipelineStateBase::initializeBase(const PipelineStateDesc& inDesc)
     {
         inputLayout = static_cast<InputLayoutBase*>(inDesc.graphics.inputLayout);
         framebufferLayout = static_cast<FramebufferLayoutBase*>(inDesc.graphics.framebufferLayout);
+        fallbackPipelineState = static_cast<PipelineStateBase*>(inDesc.graphics.fallbackPipeline);
+    }
+    else if (inDesc.type == PipelineType::Compute)
+    {
+        fallbackPipelineState = static_cast<PipelineStateBase*>(inDesc.compute.fallbackPipeline);
     }
 }
 
@@ -338,6 +344,8 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
     // Immediately call getEntryPointCode if no shader cache has been initialized
     if (!persistentShaderCache)
     {
@@ -401,9 +409,31 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
             GfxGUID::IID_IPipelineCreationAPIDispatcher,
             (void**)m_pipelineCreationAPIDispatcher.writeRef());
     }
+
+    for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+    {
+        StructType stype;
+        memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+        if (stype == StructType::PipelineSpecializationDesc)
+        {
+            PipelineSpecializationDesc specializationDesc;
+            memcpy(&specializationDesc, desc.extendedDescs[i], sizeof(specializationDesc));
+            m_pipelineSpecializationMode = specializationDesc.mode;
+        }
+    }
+    // Implementations that can't create pipelines on another thread always specialize synchronously.
+    if (!canCreatePipelinesInBackground())
+    {
+        m_pipelineSpecializationMode = PipelineSpecializationMode::Synchronous;
+    }
     return SLANG_OK;
 }
 
+RendererBase::~RendererBase()
+{
+    stopPipelineSpecializationThread();
+}
+
 SLANG_NO_THROW Result SLANG_MCALL RendererBase::getNativeDeviceHandles(InteropHandles* outHandles)
 {
     return SLANG_OK;
@@ -458,6 +488,8 @@ Result RendererBase::getFormatSupportedResourceStates(Format format, ResourceSta
 
 SLANG_NO_THROW Result SLANG_MCALL RendererBase::getSlangSession(slang::ISession** outSlangSession)
 {
+    // The reference count of the session isn't atomic, and the background thread changes it.
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
     *outSlangSession = slangContext.session.get();
     slangContext.session->addRef();
     return SLANG_OK;
@@ -534,6 +566,8 @@ Result RendererBase::createProgram2(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnostic)
 {
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
     auto slangSession = slangContext.session.get();
     slang::IModule* module = nullptr;
     ComPtr<slang::IBlob> diagnosticsBlob;
@@ -696,6 +730,8 @@ Result RendererBase::getShaderObjectLayout(
     ShaderObjectContainerType container,
     ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
     switch (container)
     {
     case ShaderObjectContainerType::StructuredBuffer:
@@ -715,6 +751,8 @@ Result RendererBase::getShaderObjectLayout(
 Result RendererBase::getShaderObjectLayout(
     slang::TypeLayoutReflection* typeLayout, ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.tryGetValue(typeLayout, shaderObjectLayout))
     {
@@ -831,6 +869,7 @@ void ShaderObjectLayoutBase::initBase(RendererBase* renderer, slang::TypeLayoutR
 // this function will return a specialized type using the bound sub-objects' type as specialization argument.
 Result ShaderObjectBase::getSpecializedShaderObjectType(ExtendedShaderObjectType* outType)
 {
+    std::lock_guard<std::recursive_mutex> sessionLock(getRenderer()->m_slangSessionMutex);
     return _getSpecializedShaderObjectType(outType);
 }
 
@@ -877,16 +916,20 @@ Result ShaderObjectBase::setExistentialHeader(
     // Slang runtime, so we can look up the ID for this particular conformance (which
     // will create it on demand).
     //
-    ComPtr<slang::ISession> slangSession;
-    SLANG_RETURN_ON_FAIL(getRenderer()->getSlangSession(slangSession.writeRef()));
+    // The session is shared with the thread that specializes pipelines in the background, so it is
+    // used under the device's lock, without changing its reference count.
     //
     // Note: If the type doesn't actually conform to the required interface for
     // this sub-object range, then this is the point where we will detect that
     // fact and error out.
     //
     uint32_t conformanceID = 0xFFFFFFFF;
-    SLANG_RETURN_ON_FAIL(slangSession->getTypeConformanceWitnessSequentialID(
-        concreteType, existentialType, &conformanceID));
+    {
+        auto renderer = getRenderer();
+        std::lock_guard<std::recursive_mutex> sessionLock(renderer->m_slangSessionMutex);
+        SLANG_RETURN_ON_FAIL(renderer->slangContext.session->getTypeConformanceWitnessSequentialID(
+            concreteType, existentialType, &conformanceID));
+    }
     //
     // Once we have the conformance ID, then we can write it into the object
     // at the required offset.
@@ -1074,21 +1117,317 @@ bool ShaderProgramBase::isMeshShaderProgram() const
     return false;
 }
 
+IPipelineSpecializationTask* PipelineSpecializationTask::getInterface(const Slang::Guid& guid)
+{
+    if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_IPipelineSpecializationTask)
+        return static_cast<IPipelineSpecializationTask*>(this);
+    return nullptr;
+}
+
+SLANG_NO_THROW bool SLANG_MCALL PipelineSpecializationTask::isComplete()
+{
+    return _completeIfSpecialized();
+}
+
+SLANG_NO_THROW Result SLANG_MCALL PipelineSpecializationTask::wait(uint64_t timeout)
+{
+    if (!m_isComplete)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto isSpecialized = [this]() { return m_isSpecialized; };
+        if (timeout == kTimeoutInfinite)
+        {
+            m_specializedCondition.wait(lock, isSpecialized);
+        }
+        else if (!m_specializedCondition.wait_for(lock, std::chrono::nanoseconds(timeout), isSpecialized))
+        {
+            return SLANG_E_TIME_OUT;
+        }
+    }
+    _completeIfSpecialized();
+    return m_result;
+}
+
+bool PipelineSpecializationTask::_completeIfSpecialized()
+{
+    if (m_isComplete)
+        return true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isSpecialized)
+            return false;
+    }
+    device->_completeSpecialization(this);
+    return true;
+}
+
+void PipelineSpecializationTask::setSpecializedProgram(
+    Result result, ComPtr<slang::IComponentType>& specializedProgram)
+{
+    // Notified with the lock held, as the task can be released as soon as the lock is.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_specializeResult = result;
+    m_specializedProgram = _Move(specializedProgram);
+    m_isSpecialized = true;
+    m_specializedCondition.notify_all();
+}
+
+void PipelineSpecializationTask::complete(Result result, PipelineStateBase* specializedPipeline)
+{
+    m_result = result;
+    m_specializedPipeline = specializedPipeline;
+    m_isComplete = true;
+    device = nullptr;
+}
+
+Result RendererBase::precompileSpecializedProgram(slang::IComponentType* specializedProgram)
+{
+    auto programLayout = specializedProgram->getLayout();
+    if (!programLayout)
+        return SLANG_FAIL;
+    for (SlangUInt i = 0; i < programLayout->getEntryPointCount(); ++i)
+    {
+        ComPtr<ISlangBlob> code;
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = specializedProgram->getEntryPointCode(
+            SlangInt(i), 0, code.writeRef(), diagnostics.writeRef());
+        if (diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer());
+        }
+        SLANG_RETURN_ON_FAIL(compileResult);
+    }
+    return SLANG_OK;
+}
+
+Result RendererBase::_specializeProgram(
+    PipelineStateBase* unspecializedPipeline,
+    const ExtendedShaderObjectTypeList& args,
+    ComPtr<slang::IComponentType>& outSpecializedProgram)
+{
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(unspecializedPipeline->desc.type == PipelineType::Compute
+        ? unspecializedPipeline->desc.compute.program
+        : unspecializedPipeline->desc.graphics.program);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto compileRs = unspecializedProgram->linkedProgram->specialize(
+        args.components.getArrayView().getBuffer(),
+        args.getCount(),
+        outSpecializedProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+    {
+        getDebugCallback()->handleMessage(
+            compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)diagnosticBlob->getBufferPointer());
+    }
+    return compileRs;
+}
+
+Result RendererBase::_createSpecializedPipeline(
+    PipelineStateBase* unspecializedPipeline,
+    slang::IComponentType* specializedComponentType,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+
+    auto pipelineType = unspecializedPipeline->desc.type;
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
+        ? unspecializedPipeline->desc.compute.program
+        : unspecializedPipeline->desc.graphics.program);
+
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
+    specializedProgramDesc.slangGlobalScope = specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already contains
+        // entry-points, so we do not need to supply them again when creating the specialized
+        // pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+
+    // Create specialized pipeline state. The specialized pipeline never needs a fallback.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (pipelineType)
+    {
+    case PipelineType::Compute:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.compute;
+        pipelineDesc.program = specializedProgram;
+        pipelineDesc.fallbackPipeline = nullptr;
+        SLANG_RETURN_ON_FAIL(
+            createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::Graphics:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.graphics;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        pipelineDesc.fallbackPipeline = nullptr;
+        SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
+            pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::RayTracing:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.rayTracing;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+            pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    default:
+        break;
+    }
+    outPipeline = static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    outPipeline->unspecializedPipelineState = unspecializedPipeline;
+    return SLANG_OK;
+}
+
+void RendererBase::_completeSpecialization(PipelineSpecializationTask* task)
+{
+    // Completing the task removes the device's reference to it.
+    RefPtr<PipelineSpecializationTask> taskRef = task;
+
+    RefPtr<PipelineStateBase> specializedPipeline;
+    Result result = task->m_specializeResult;
+    if (SLANG_SUCCEEDED(result))
+    {
+        std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+        result = _createSpecializedPipeline(
+            task->unspecializedPipeline, task->m_specializedProgram, specializedPipeline);
+        // The code has already been compiled by the background thread, so this is quick.
+        if (SLANG_SUCCEEDED(result))
+            result = specializedPipeline->ensureAPIPipelineStateCreated();
+        task->m_specializedProgram = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_specializationMutex);
+        // A failed specialization isn't cached, so it will be tried again if it is used again.
+        if (SLANG_SUCCEEDED(result))
+            shaderCache.addSpecializedPipeline(task->key, specializedPipeline);
+        m_pendingSpecializations.remove(task->key);
+    }
+    task->unspecializedPipeline = nullptr;
+    task->complete(result, specializedPipeline);
+}
+
+RefPtr<PipelineSpecializationTask> RendererBase::_queueSpecialization(
+    const PipelineKey& key,
+    const ExtendedShaderObjectTypeList& args)
+{
+    RefPtr<PipelineSpecializationTask> task = new PipelineSpecializationTask();
+    task->key = key;
+    task->unspecializedPipeline = key.pipeline;
+    task->specializationArgs = args;
+
+    if (m_stopSpecializationThread)
+    {
+        task->complete(SLANG_E_ABORT, nullptr);
+        return task;
+    }
+    task->device = this;
+
+    // The thread is only started once something needs it.
+    if (!m_specializationThread.joinable())
+    {
+        m_specializationThread = std::thread([this]() { _runPipelineSpecializationThread(); });
+    }
+
+    m_pendingSpecializations.add(key, task);
+    m_specializationQueue.add(task);
+    m_specializationQueueCondition.notify_one();
+    return task;
+}
+
+void RendererBase::_runPipelineSpecializationThread()
+{
+    for (;;)
+    {
+        // The task is held alive by `m_pendingSpecializations` until the device's thread
+        // completes it, which can't happen before `setSpecializedProgram` is called.
+        PipelineSpecializationTask* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_specializationMutex);
+            m_specializationQueueCondition.wait(lock, [this]()
+                { return m_stopSpecializationThread || m_specializationQueue.getCount() != 0; });
+            if (m_stopSpecializationThread)
+                return;
+            task = m_specializationQueue[0];
+            m_specializationQueue.removeAt(0);
+        }
+
+        ComPtr<slang::IComponentType> specializedProgram;
+        Result result;
+        {
+            std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+            result = _specializeProgram(task->key.pipeline, task->specializationArgs, specializedProgram);
+            // Do the compile that would otherwise be done when the pipeline is created.
+            if (SLANG_SUCCEEDED(result))
+                result = precompileSpecializedProgram(specializedProgram);
+            task->setSpecializedProgram(result, specializedProgram);
+        }
+    }
+}
+
+void RendererBase::stopPipelineSpecializationThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_specializationMutex);
+        m_stopSpecializationThread = true;
+        m_specializationQueue.clear();
+    }
+    m_specializationQueueCondition.notify_all();
+
+    // Waits for the task that is running, if any.
+    if (m_specializationThread.joinable())
+        m_specializationThread.join();
+
+    // Fail everything that hasn't completed, including tasks whose program is ready, as the
+    // implementation may be about to destroy the state needed to create their pipelines.
+    List<RefPtr<PipelineSpecializationTask>> abortedTasks;
+    for (const auto& [key, task] : m_pendingSpecializations)
+        abortedTasks.add(task);
+    m_pendingSpecializations.clear();
+    for (auto& task : abortedTasks)
+    {
+        {
+            std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+            task->m_specializedProgram = nullptr;
+        }
+        task->unspecializedPipeline = nullptr;
+        task->complete(SLANG_E_ABORT, nullptr);
+    }
+}
+
 Result RendererBase::maybeSpecializePipeline(
     PipelineStateBase* currentPipeline,
     ShaderObjectBase* rootObject,
     RefPtr<PipelineStateBase>& outNewPipeline)
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
-    
-    auto pipelineType = currentPipeline->desc.type;
+
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound shader objects.
     if (currentPipeline->isSpecializable)
     {
-        specializationArgs.clear();
-        SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
+        {
+            std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+            specializationArgs.clear();
+            SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
+        }
 
         // Construct a shader cache key that represents the specialized shader kernels.
         PipelineKey pipelineKey;
@@ -1096,87 +1435,103 @@ Result RendererBase::maybeSpecializePipeline(
         pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
         pipelineKey.updateHash();
 
-        RefPtr<PipelineStateBase> specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
-        // Try to find specialized pipeline from shader cache.
-        if (!specializedPipelineState)
+        // Try to find specialized pipeline from shader cache, or a task already creating it.
+        RefPtr<PipelineStateBase> specializedPipelineState;
+        RefPtr<PipelineSpecializationTask> task;
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
-                ? currentPipeline->desc.compute.program
-                : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
+            std::lock_guard<std::mutex> lock(m_specializationMutex);
+            specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
+            if (!specializedPipelineState && !m_pendingSpecializations.tryGetValue(pipelineKey, task) &&
+                m_pipelineSpecializationMode == PipelineSpecializationMode::Asynchronous)
             {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
+                task = _queueSpecialization(pipelineKey, specializationArgs);
             }
-            SLANG_RETURN_ON_FAIL(compileRs);
-
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
+        }
 
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+        if (task)
+        {
+            // Use the fallback until the specialized pipeline is ready, if there is one that can be used directly.
+            auto fallbackPipeline = currentPipeline->fallbackPipelineState.Ptr();
+            if (fallbackPipeline && !fallbackPipeline->isSpecializable && !task->isComplete())
             {
-                // When linking style is GraphicsCompute, the specialized global scope already contains
-                // entry-points, so we do not need to supply them again when creating the specialized
-                // pipeline.
-                specializedProgramDesc.entryPointCount = 0;
+                outNewPipeline = fallbackPipeline;
+                return SLANG_OK;
             }
-            SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+            SLANG_RETURN_ON_FAIL(task->wait(kTimeoutInfinite));
+            specializedPipelineState = task->getSpecializedPipeline();
+        }
+        else if (!specializedPipelineState)
+        {
+            ComPtr<slang::IComponentType> specializedProgram;
+            SLANG_RETURN_ON_FAIL(_specializeProgram(currentPipeline, specializationArgs, specializedProgram));
+            SLANG_RETURN_ON_FAIL(
+                _createSpecializedPipeline(currentPipeline, specializedProgram, specializedPipelineState));
 
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
-            {
-            case PipelineType::Compute:
-            {
-                auto pipelineDesc = currentPipeline->desc.compute;
-                pipelineDesc.program = specializedProgram;
-                SLANG_RETURN_ON_FAIL(
-                    createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::Graphics:
-            {
-                auto pipelineDesc = currentPipeline->desc.graphics;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                    pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::RayTracing:
-            {
-                auto pipelineDesc = currentPipeline->desc.rayTracing;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                    pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            default:
-                break;
-            }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
+            std::lock_guard<std::mutex> lock(m_specializationMutex);
             shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
         }
-        auto specializedPipelineStateBase = static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+        outNewPipeline = specializedPipelineState;
     }
     return SLANG_OK;
 }
 
+Result RendererBase::specializePipelineAsync(
+    IPipelineState* pipeline,
+    IShaderObject* rootObject,
+    IPipelineSpecializationTask** outTask)
+{
+    auto pipelineBase = static_cast<PipelineStateBase*>(pipeline);
+    if (pipelineBase->unspecializedPipelineState)
+        pipelineBase = pipelineBase->unspecializedPipelineState;
+
+    RefPtr<PipelineSpecializationTask> task;
+    if (!pipelineBase->isSpecializable || !canCreatePipelinesInBackground())
+    {
+        // Nothing needs to be created in the background, so the task is already complete.
+        RefPtr<PipelineStateBase> specializedPipeline;
+        auto result = maybeSpecializePipeline(
+            pipelineBase, static_cast<ShaderObjectBase*>(rootObject), specializedPipeline);
+        task = new PipelineSpecializationTask();
+        task->complete(result, specializedPipeline);
+    }
+    else
+    {
+        ExtendedShaderObjectTypeList args;
+        {
+            std::lock_guard<std::recursive_mutex> sessionLock(m_slangSessionMutex);
+            SLANG_RETURN_ON_FAIL(static_cast<ShaderObjectBase*>(rootObject)->collectSpecializationArgs(args));
+        }
+
+        PipelineKey pipelineKey;
+        pipelineKey.pipeline = pipelineBase;
+        pipelineKey.specializationArgs.addRange(args.componentIDs);
+        pipelineKey.updateHash();
+
+        std::lock_guard<std::mutex> lock(m_specializationMutex);
+        if (auto specializedPipeline = shaderCache.getSpecializedPipelineState(pipelineKey))
+        {
+            task = new PipelineSpecializationTask();
+            task->complete(SLANG_OK, specializedPipeline);
+        }
+        else if (!m_pendingSpecializations.tryGetValue(pipelineKey, task))
+        {
+            task = _queueSpecialization(pipelineKey, args);
+        }
+    }
+    returnComPtr(outTask, task);
+    return SLANG_OK;
+}
+
+void RendererBase::lockSlangSession()
+{
+    m_slangSessionMutex.lock();
+}
+
+void RendererBase::unlockSlangSession()
+{
+    m_slangSessionMutex.unlock();
+}
+
 IDebugCallback*& _getDebugCallback()
 {
     static IDebugCallback* callback = nullptr;
@@ -8,6 +8,10 @@
 
 #include "resource-desc-utils.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace gfx
 {
 
@@ -45,6 +49,7 @@ struct GfxGUID
     static const Slang::Guid IID_IShaderTable;
     static const Slang::Guid IID_IPipelineCreationAPIDispatcher;
     static const Slang::Guid IID_ITransientResourceHeapD3D12;
+    static const Slang::Guid IID_IPipelineSpecializationTask;
 };
 
 bool isGfxDebugLayerEnabled();
@@ -1027,6 +1032,10 @@ public:
     // Indicates whether this is a specializable pipeline. A specializable
     // pipeline cannot be used directly and must be specialized first.
     bool isSpecializable = false;
+
+    // The pipeline to use while a specialization of this pipeline is being created
+    // in the background. May be null.
+    Slang::RefPtr<PipelineStateBase> fallbackPipelineState;
     Slang::RefPtr<ShaderProgramBase> m_program;
     template <typename TProgram> TProgram* getProgram()
     {
@@ -1141,6 +1150,62 @@ protected:
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
 
+// A specialized pipeline being created with the help of the device's background thread.
+//
+// The background thread only specializes and compiles the Slang program, and never touches the
+// reference counts of gfx objects, as they aren't atomic. The gfx program and pipeline are then
+// created on the thread that uses the device, the first time the task is checked after the
+// background thread is done with it.
+class PipelineSpecializationTask
+    : public IPipelineSpecializationTask
+    , public Slang::ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    IPipelineSpecializationTask* getInterface(const Slang::Guid& guid);
+
+    // Must be called on the thread that uses the device.
+    virtual SLANG_NO_THROW bool SLANG_MCALL isComplete() override;
+    // Must be called on the thread that uses the device.
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait(uint64_t timeout) override;
+
+    // Called by the background thread once it has specialized the program, or failed to.
+    void setSpecializedProgram(Result result, Slang::ComPtr<slang::IComponentType>& specializedProgram);
+
+    // Called on the thread that uses the device once the specialized pipeline has been created,
+    // or creating it failed.
+    void complete(Result result, PipelineStateBase* specializedPipeline);
+
+    // Only valid once the task has completed successfully.
+    PipelineStateBase* getSpecializedPipeline() { return m_specializedPipeline; }
+
+    PipelineKey key;
+    // Holds the pipeline in `key` alive until the task has completed.
+    Slang::RefPtr<PipelineStateBase> unspecializedPipeline;
+    // A copy of the arguments, as the device reuses its list for every draw or dispatch.
+    ExtendedShaderObjectTypeList specializationArgs;
+    // The device that completes the task once its program has been specialized. Null once complete.
+    RendererBase* device = nullptr;
+
+private:
+    // Returns true if the task has completed, completing it if its program is ready.
+    bool _completeIfSpecialized();
+
+    std::mutex m_mutex;
+    std::condition_variable m_specializedCondition;
+    bool m_isSpecialized = false;
+    Result m_specializeResult = SLANG_OK;
+    // Only moved into and out of, so its reference count is never changed by the background thread.
+    Slang::ComPtr<slang::IComponentType> m_specializedProgram;
+
+    // Only accessed on the thread that uses the device.
+    bool m_isComplete = false;
+    Result m_result = SLANG_OK;
+    Slang::RefPtr<PipelineStateBase> m_specializedPipeline;
+
+    friend class RendererBase;
+};
+
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
 {
 public:
@@ -1222,6 +1287,8 @@ public:
     SLANG_COM_OBJECT_IUNKNOWN_ADD_REF
     SLANG_COM_OBJECT_IUNKNOWN_RELEASE
 
+    ~RendererBase();
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeDeviceHandles(InteropHandles* outHandles) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW Result SLANG_MCALL getFeatures(
         const char** outFeatures, Size bufferSize, GfxCount* outFeatureCount) SLANG_OVERRIDE;
@@ -1316,6 +1383,14 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL specializePipelineAsync(
+        IPipelineState* pipeline,
+        IShaderObject* rootObject,
+        IPipelineSpecializationTask** outTask) override;
+
+    virtual SLANG_NO_THROW void SLANG_MCALL lockSlangSession() override;
+    virtual SLANG_NO_THROW void SLANG_MCALL unlockSlangSession() override;
+
     Result getEntryPointCodeFromShaderCache(
         slang::IComponentType* program,
         SlangInt entryPointIndex,
@@ -1342,6 +1417,19 @@ public:
         ShaderObjectBase* rootObject,
         Slang::RefPtr<PipelineStateBase>& outNewPipeline);
 
+    // Returns true if the implementation supports `PipelineSpecializationMode::Asynchronous`, in
+    // which the Slang programs of specialized pipelines are compiled on a background thread.
+    virtual bool canCreatePipelinesInBackground() { return false; }
+
+    // Compiles the entry points of a specialized program on the background thread, so that creating
+    // the pipeline on the device's thread finds the code in the Slang session's cache. The session
+    // must be locked.
+    virtual Result precompileSpecializedProgram(slang::IComponentType* specializedProgram);
+
+    // Stops the background thread creating specialized pipelines, failing any tasks that haven't run.
+    // Implementations that can create pipelines in the background must call this before they start
+    // destroying their state.
+    void stopPipelineSpecializationThread();
 
     virtual Result createShaderObjectLayout(
         slang::TypeLayoutReflection* typeLayout,
@@ -1363,6 +1451,35 @@ public:
 
 protected:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc);
+
+private:
+    // Specialize the program of `unspecializedPipeline` for `args`. Only uses Slang objects, so can
+    // be called on the background thread. The session must be locked.
+    Result _specializeProgram(
+        PipelineStateBase* unspecializedPipeline,
+        const ExtendedShaderObjectTypeList& args,
+        Slang::ComPtr<slang::IComponentType>& outSpecializedProgram);
+
+    // Create the specialization of `unspecializedPipeline` that uses `specializedProgram`.
+    // Must be called on the thread that uses the device.
+    Result _createSpecializedPipeline(
+        PipelineStateBase* unspecializedPipeline,
+        slang::IComponentType* specializedProgram,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
+    // Create the pipeline for a task whose program has been specialized by the background thread,
+    // and complete the task. Must be called on the thread that uses the device.
+    void _completeSpecialization(PipelineSpecializationTask* task);
+
+    // Add a task to create the specialization for `key` to the queue. `m_specializationMutex` must be held.
+    Slang::RefPtr<PipelineSpecializationTask> _queueSpecialization(
+        const PipelineKey& key,
+        const ExtendedShaderObjectTypeList& args);
+
+    void _runPipelineSpecializationThread();
+
+    friend class PipelineSpecializationTask;
+
 protected:
     Slang::List<Slang::String> m_features;
 public:
@@ -1373,6 +1490,23 @@ public:
 
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>> m_shaderObjectLayoutCache;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
+
+    // Held whilst using the Slang session, as specialized pipelines may be created on another thread.
+    std::recursive_mutex m_slangSessionMutex;
+
+    PipelineSpecializationMode m_pipelineSpecializationMode = PipelineSpecializationMode::Synchronous;
+
+private:
+    // Guards `shaderCache`'s specialized pipelines and everything below.
+    std::mutex m_specializationMutex;
+    std::condition_variable m_specializationQueueCondition;
+    // Tasks that haven't completed yet. These references are only changed on the thread that
+    // uses the device, and hold alive the tasks the background thread works on.
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PipelineSpecializationTask>> m_pendingSpecializations;
+    // Tasks waiting for the background thread.
+    Slang::List<PipelineSpecializationTask*> m_specializationQueue;
+    std::thread m_specializationThread;
+    bool m_stopSpecializationThread = false;
 };
 
 bool isDepthFormat(Format format);
@@ -1,34 +1,1358 @@
 // slang-profile-main.cpp
 
+// Compiles a fixed corpus of shaders from `tests/` and `examples/` for a set of targets, and reports
+// where the time goes in the compiler. The results can be written as JSON, and compared against a
+// stored baseline to catch compile time regressions.
+//
+// Usage: slang-profile [options]
+//
+//   -root <dir>            Root of the repository holding the corpus (default: current directory)
+//   -target <name>         Only compile for the target (spirv, hlsl, glsl or cpp). Can be repeated.
+//   -iterations <count>    Number of times each case is compiled (default: 5). The fastest is reported.
+//   -output <path>         Write the results as JSON to `path`
+//   -baseline <path>       Compare the results with JSON written by an earlier run, and fail if there are regressions
+//   -threshold <percent>   How much worse than the baseline a result can be before it's a regression (default: 10)
+//   -min-delta <ms>        Time differences smaller than this are never a regression (default: 0.5)
+//   -rpc-round-trips <count>
+//                          Instead of compiling, time <count> JSON-RPC round trips to the test-server next to slang-profile
+//   -startup <count>       Instead of compiling the corpus, time creating <count> global sessions (which loads the
+//                          standard library), and the first compile with each
+//   -byte-decode <count>   Instead of compiling, time decoding an array of variable byte encoded values <count> times, with
+//                          each of the encodings used for serialized IR
+//   -cpu-dispatch <count>  Instead of compiling, time <count> dispatches of a compute kernel on the gfx CPU device, with the
+//                          groups split between 1 and then more threads, up to the number of hardware threads
+//   -kernel-latency <count>
+//                          Instead of compiling the corpus, time compiling each kernel that can be compiled for the CPU
+//                          into host callable code <count> times, with and without the precompiled C++ prelude
+//   -cpu-vectorize <count> Instead of compiling the corpus, time a host callable kernel over <count> groups, with its
+//                          threads run one at a time, and then with several `-cpu-vectorize-width`s
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+#include "../../slang-com-helper.h"
+#include "../../slang-gfx.h"
+
+#include "../../source/core/slang-byte-encode-util.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-http.h"
 #include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-random-generator.h"
 #include "../../source/core/slang-std-writers.h"
+#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-string-escape-util.h"
+#include "../../source/core/slang-thread-pool.h"
 
-#include "../../source/core/slang-process-util.h"
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-json-lexer.h"
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-rpc-connection.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../source/compiler-core/slang-test-server-protocol.h"
 
-#include "../../slang-com-helper.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
 
-#include "../../source/core/slang-string-util.h"
+#if SLANG_WINDOWS_FAMILY
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
 
 using namespace Slang;
 
+// Count every allocation made through the global operator new, and the bytes they hold. This includes
+// the allocations made by slang when it's linked statically, or as a shared library on platforms where
+// replacing operator new applies to the whole process (so not for a Windows DLL). Memory allocated
+// with malloc directly (such as by MemoryArena) isn't counted.
+static std::atomic<uint64_t> g_allocationCount{0};
+static std::atomic<uint64_t> g_liveBytes{0};
+// The most bytes that have been live at once since `_resetPeakLiveBytes`
+static std::atomic<uint64_t> g_peakLiveBytes{0};
+
+// Each allocation is preceded by its size, so it can be subtracted from the live bytes when freed
+static const size_t kAllocationHeaderSize = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (char* base = (char*)::malloc(size + kAllocationHeaderSize))
+    {
+        *(size_t*)base = size;
+
+        const uint64_t liveBytes = g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peakLiveBytes = g_peakLiveBytes.load(std::memory_order_relaxed);
+        while (liveBytes > peakLiveBytes &&
+            !g_peakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+        {
+        }
+        return base + kAllocationHeaderSize;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return ::operator new(size); }
+void operator delete(void* ptr) noexcept
+{
+    if (ptr)
+    {
+        char* base = (char*)ptr - kAllocationHeaderSize;
+        g_liveBytes.fetch_sub(*(size_t*)base, std::memory_order_relaxed);
+        ::free(base);
+    }
+}
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { ::operator delete(ptr); }
+
+    /// Start measuring the peak of the live bytes from now. Returns the bytes that are live, which
+    /// `_getPeakAllocatedBytes` measures from.
+static uint64_t _resetPeakLiveBytes()
+{
+    const uint64_t liveBytes = g_liveBytes.load();
+    g_peakLiveBytes.store(liveBytes);
+    return liveBytes;
+}
+
+    /// Get the most bytes that were allocated at once, on top of the `startLiveBytes` that were live
+    /// when `_resetPeakLiveBytes` was called
+static uint64_t _getPeakAllocatedBytes(uint64_t startLiveBytes)
+{
+    const uint64_t peakLiveBytes = g_peakLiveBytes.load();
+    return peakLiveBytes > startLiveBytes ? peakLiveBytes - startLiveBytes : 0;
+}
+
+namespace { // anonymous
+
+enum TargetFlag : uint32_t
+{
+    kTargetFlag_SPIRV   = 0x1,
+    kTargetFlag_HLSL    = 0x2,
+    kTargetFlag_GLSL    = 0x4,
+    kTargetFlag_CPP     = 0x8,
+
+    // Graphics entry points have no C++ equivalent
+    kTargetFlags_GPU    = kTargetFlag_SPIRV | kTargetFlag_HLSL | kTargetFlag_GLSL,
+    kTargetFlags_All    = kTargetFlags_GPU | kTargetFlag_CPP,
+};
+
+struct TargetInfo
+{
+    const char* name;
+    TargetFlag flag;
+    SlangCompileTarget format;
+    const char* profileName;
+};
+
+static const TargetInfo kTargets[] =
+{
+    { "spirv",  kTargetFlag_SPIRV,  SLANG_SPIRV,        "spirv_1_5" },
+    { "hlsl",   kTargetFlag_HLSL,   SLANG_HLSL,         "sm_6_5" },
+    { "glsl",   kTargetFlag_GLSL,   SLANG_GLSL,         "glsl_460" },
+    { "cpp",    kTargetFlag_CPP,    SLANG_CPP_SOURCE,   nullptr },
+};
+
+struct CorpusEntry
+{
+    const char* path;               ///< Relative to the root of the repository
+    const char* entryPointName;     ///< Compute entry point to compile, or nullptr for the entry points marked `[shader(...)]`
+    uint32_t targetFlags;           ///< The targets the entry can be compiled for
+};
+
+    /// The corpus is fixed, so results are comparable between runs. Changing it invalidates baselines.
+static const CorpusEntry kCorpus[] =
+{
+    { "examples/hello-world/hello-world.slang",                 nullptr,        kTargetFlags_All },
+    { "examples/triangle/shaders.slang",                        nullptr,        kTargetFlags_GPU },
+    { "examples/autodiff-texture/train.slang",                  nullptr,        kTargetFlags_GPU },
+    { "examples/gpu-printing/kernels.slang",                    nullptr,        kTargetFlags_GPU },
+    { "tests/compute/buffer-layout.slang",                      "computeMain",  kTargetFlags_All },
+    { "tests/autodiff/generic-impl-jvp.slang",                  "computeMain",  kTargetFlags_All },
+    { "tests/autodiff/reverse-loop-checkpoint-test.slang",      "computeMain",  kTargetFlags_All },
+};
+
+struct StageInfo
+{
+    const char* name;
+    const char* sectionName;        ///< The profiler section the stage is recorded as
+};
+
+    /// Time in a section of one stage that is nested in a section of another (such as an imported
+    /// module being parsed whilst checking) is only counted for the inner stage.
+static const StageInfo kStages[] =
+{
+    { "preprocess",     "preprocessSource" },
+    { "parse",          "parseSourceFile" },
+    { "check",          "checkAllTranslationUnits" },
+    { "lower-to-ir",    "generateIRForTranslationUnit" },
+    { "link",           "linkIR" },
+    { "optimize",       "linkAndOptimizeIR" },
+    { "emit",           "emitEntryPoints" },
+};
+static const Index kStageCount = SLANG_COUNT_OF(kStages);
+
+struct IRCountInfo
+{
+    const char* name;
+    const char* counterName;        ///< The profiler counter holding the count
+};
+
+static const IRCountInfo kIRCounts[] =
+{
+    { "lowered",    "loweredIRInstCount" },
+    { "linked",     "linkedIRInstCount" },
+    { "optimized",  "optimizedIRInstCount" },
+};
+static const Index kIRCountCount = SLANG_COUNT_OF(kIRCounts);
+
+struct Options
+{
+    String rootDir = ".";
+    uint32_t targetFlags = 0;
+    Index iterationCount = 5;
+    String outputPath;
+    String baselinePath;
+    double threshold = 0.1;
+    double minDeltaMs = 0.5;
+    Index rpcRoundTripCount = 0;        ///< If set, time round trips to test-server instead of compiling
+    Index startupCount = 0;             ///< If set, time creating global sessions instead of compiling
+    Index byteDecodeCount = 0;          ///< If set, time decoding variable byte encodings instead of compiling
+    Index cpuDispatchCount = 0;         ///< If set, time dispatches on the CPU device instead of compiling
+    Index kernelLatencyCount = 0;       ///< If set, time host callable compiles of the corpus kernels instead
+    Index cpuVectorizeGroupCount = 0;   ///< If set, time a host callable kernel with vectorize widths instead
+};
+
+    /// The results of compiling one corpus entry for one target
+struct CaseResult
+{
+    String name;
+    double totalMs = 0.0;
+    double stageMs[kStageCount] = {};
+    int64_t irCounts[kIRCountCount] = {};
+    uint64_t allocationCount = 0;
+        /// The most bytes the compile allocated through operator new at once, on top of those that
+        /// were already allocated before it started
+    uint64_t peakAllocatedBytes = 0;
+};
+
+    /// Holds the values parsed from JSON text
+struct JSONDocument
+{
+    JSONDocument()
+        : sink(&sourceManager, nullptr)
+    {
+        sourceManager.initialize(nullptr, nullptr);
+    }
+
+    SlangResult parse(const String& text)
+    {
+        SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), text);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+        JSONLexer lexer;
+        lexer.init(sourceView, &sink);
+
+        container = new JSONContainer(&sourceManager);
+        JSONBuilder builder(container);
+
+        JSONParser parser;
+        SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+        root = builder.getRootValue();
+        return SLANG_OK;
+    }
+
+    JSONValue find(const JSONValue& object, const char* key)
+    {
+        return object.getKind() == JSONValue::Kind::Object ? container->findObjectValue(object, container->getKey(UnownedStringSlice(key))) : JSONValue();
+    }
+
+    SourceManager sourceManager;
+    DiagnosticSink sink;
+    RefPtr<JSONContainer> container;
+    JSONValue root;
+};
+
+struct TraceEvent
+{
+    Index stageIndex;
+    int64_t threadIndex;
+    double start;
+    double duration;
+    double exclusiveDuration;
+};
+
+} // anonymous
+
+    /// Get the most memory the process has used so far, in bytes. This includes everything that ran
+    /// before, so it can't be attributed to a case.
+static uint64_t _getPeakMemoryUsage()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return uint64_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#   if SLANG_APPLE_FAMILY
+    return uint64_t(usage.ru_maxrss);
+#   else
+    // Linux reports kilobytes
+    return uint64_t(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+static SlangResult _parseOptions(int argc, char** argv, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "error: unknown option or missing value '%s'\n", argv[i]);
+            return SLANG_FAIL;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "-root")
+        {
+            outOptions.rootDir = value;
+        }
+        else if (arg == "-target")
+        {
+            const TargetInfo* found = nullptr;
+            for (const auto& target : kTargets)
+            {
+                if (UnownedStringSlice(target.name) == UnownedStringSlice(value))
+                {
+                    found = &target;
+                }
+            }
+            if (!found)
+            {
+                fprintf(stderr, "error: unknown target '%s'\n", value);
+                return SLANG_FAIL;
+            }
+            outOptions.targetFlags |= found->flag;
+        }
+        else if (arg == "-iterations")
+        {
+            outOptions.iterationCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-output")
+        {
+            outOptions.outputPath = value;
+        }
+        else if (arg == "-baseline")
+        {
+            outOptions.baselinePath = value;
+        }
+        else if (arg == "-threshold")
+        {
+            outOptions.threshold = atof(value) / 100.0;
+        }
+        else if (arg == "-min-delta")
+        {
+            outOptions.minDeltaMs = atof(value);
+        }
+        else if (arg == "-rpc-round-trips")
+        {
+            outOptions.rpcRoundTripCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-startup")
+        {
+            outOptions.startupCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-byte-decode")
+        {
+            outOptions.byteDecodeCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-cpu-dispatch")
+        {
+            outOptions.cpuDispatchCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-kernel-latency")
+        {
+            outOptions.kernelLatencyCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else if (arg == "-cpu-vectorize")
+        {
+            outOptions.cpuVectorizeGroupCount = std::max(Index(1), Index(atoi(value)));
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown option '%s'\n", argv[i - 1]);
+            return SLANG_FAIL;
+        }
+    }
+
+    if (outOptions.targetFlags == 0)
+    {
+        outOptions.targetFlags = kTargetFlags_All;
+    }
+    return SLANG_OK;
+}
+
+    /// Add the time spent in each stage, and the IR counts, from the profiler's trace to the outputs.
+static SlangResult _accumulateTrace(const String& traceText, double outStageMs[kStageCount], int64_t outIRCounts[kIRCountCount])
+{
+    JSONDocument trace;
+    SLANG_RETURN_ON_FAIL(trace.parse(traceText));
+
+    const JSONValue eventsValue = trace.find(trace.root, "traceEvents");
+    if (eventsValue.getKind() != JSONValue::Kind::Array)
+    {
+        return SLANG_FAIL;
+    }
+
+    List<TraceEvent> events;
+    for (const auto& eventValue : trace.container->getArray(eventsValue))
+    {
+        const auto name = trace.container->getString(trace.find(eventValue, "name"));
+        const auto phase = trace.container->getString(trace.find(eventValue, "ph"));
+
+        if (phase == "C")
+        {
+            for (Index i = 0; i < kIRCountCount; ++i)
+            {
+                if (name == UnownedStringSlice(kIRCounts[i].counterName))
+                {
+                    const JSONValue args = trace.find(eventValue, "args");
+                    outIRCounts[i] += trace.container->asInteger(trace.find(args, "value"));
+                }
+            }
+            continue;
+        }
+
+        for (Index i = 0; i < kStageCount; ++i)
+        {
+            if (name == UnownedStringSlice(kStages[i].sectionName))
+            {
+                TraceEvent event;
+                event.stageIndex = i;
+                event.threadIndex = trace.container->asInteger(trace.find(eventValue, "tid"));
+                event.start = trace.container->asFloat(trace.find(eventValue, "ts"));
+                event.duration = trace.container->asFloat(trace.find(eventValue, "dur"));
+                event.exclusiveDuration = event.duration;
+                events.add(event);
+            }
+        }
+    }
+
+    // Order events so every event comes after the events enclosing it
+    events.sort([](const TraceEvent& a, const TraceEvent& b)
+    {
+        if (a.threadIndex != b.threadIndex)
+            return a.threadIndex < b.threadIndex;
+        if (a.start != b.start)
+            return a.start < b.start;
+        return a.duration > b.duration;
+    });
+
+    // Remove the time of each event from the innermost event enclosing it
+    List<Index> stack;
+    for (Index i = 0; i < events.getCount(); ++i)
+    {
+        auto& event = events[i];
+        while (stack.getCount())
+        {
+            const auto& top = events[stack.getLast()];
+            if (top.threadIndex == event.threadIndex && event.start < top.start + top.duration)
+            {
+                break;
+            }
+            stack.removeLast();
+        }
+        if (stack.getCount())
+        {
+            events[stack.getLast()].exclusiveDuration -= event.duration;
+        }
+        stack.add(i);
+    }
+
+    for (const auto& event : events)
+    {
+        // Trace times are in microseconds
+        outStageMs[event.stageIndex] += std::max(0.0, event.exclusiveDuration) / 1000.0;
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _compile(slang::IGlobalSession* globalSession, const Options& options, const CorpusEntry& entry, const TargetInfo& target)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    request->setCodeGenTarget(target.format);
+    if (target.profileName)
+    {
+        request->setTargetProfile(0, globalSession->findProfile(target.profileName));
+    }
+
+    const String path = Path::combine(options.rootDir, entry.path);
+    const String dir = Path::getParentDirectory(path);
+    request->addSearchPath(dir.getBuffer());
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceFile(translationUnitIndex, path.getBuffer());
+    if (entry.entryPointName)
+    {
+        request->addEntryPoint(translationUnitIndex, entry.entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    const SlangResult result = request->compile();
+    if (SLANG_FAILED(result))
+    {
+        fprintf(stderr, "error: failed to compile '%s' for %s\n%s", path.getBuffer(), target.name, request->getDiagnosticOutput());
+    }
+    return result;
+}
+
+static SlangResult _runCase(slang::IGlobalSession* globalSession, const Options& options, const CorpusEntry& entry, const TargetInfo& target, CaseResult& outResult)
+{
+    outResult.name = String(entry.path) + ":" + target.name;
+
+    for (Index iteration = 0; iteration < options.iterationCount; ++iteration)
+    {
+        globalSession->clearPerformanceTrace();
+
+        const uint64_t startAllocationCount = g_allocationCount.load();
+        const uint64_t startLiveBytes = _resetPeakLiveBytes();
+        const auto startTime = std::chrono::steady_clock::now();
+
+        SLANG_RETURN_ON_FAIL(_compile(globalSession, options, entry, target));
+
+        const auto endTime = std::chrono::steady_clock::now();
+        const uint64_t allocationCount = g_allocationCount.load() - startAllocationCount;
+        const uint64_t peakAllocatedBytes = _getPeakAllocatedBytes(startLiveBytes);
+
+        ComPtr<ISlangBlob> traceBlob;
+        SLANG_RETURN_ON_FAIL(globalSession->getPerformanceTrace(traceBlob.writeRef()));
+        const String traceText = StringUtil::getString(traceBlob);
+
+        double stageMs[kStageCount] = {};
+        int64_t irCounts[kIRCountCount] = {};
+        SLANG_RETURN_ON_FAIL(_accumulateTrace(traceText, stageMs, irCounts));
+
+        const double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        // Report the fastest of the iterations, which is the least affected by noise
+        const bool isFirst = iteration == 0;
+        outResult.totalMs = isFirst ? totalMs : std::min(outResult.totalMs, totalMs);
+        for (Index i = 0; i < kStageCount; ++i)
+        {
+            outResult.stageMs[i] = isFirst ? stageMs[i] : std::min(outResult.stageMs[i], stageMs[i]);
+        }
+        outResult.allocationCount = isFirst ? allocationCount : std::min(outResult.allocationCount, allocationCount);
+        outResult.peakAllocatedBytes = isFirst ? peakAllocatedBytes : std::min(outResult.peakAllocatedBytes, peakAllocatedBytes);
+
+        // The IR is the same every time
+        ::memcpy(outResult.irCounts, irCounts, sizeof(irCounts));
+    }
+    return SLANG_OK;
+}
+
+static void _writeJSON(const List<CaseResult>& results, const Options& options, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\n";
+    out << "  \"version\": 1,\n";
+    out << "  \"iterations\": " << options.iterationCount << ",\n";
+    // For the whole process, including creating the global session
+    out << "  \"peakMemoryBytes\": " << _getPeakMemoryUsage() << ",\n";
+    out << "  \"cases\": [";
+
+    for (Index caseIndex = 0; caseIndex < results.getCount(); ++caseIndex)
+    {
+        const auto& result = results[caseIndex];
+
+        out << (caseIndex ? ",\n" : "\n");
+        out << "    {\n";
+        out << "      \"name\": ";
+        StringEscapeUtil::appendQuoted(handler, result.name.getUnownedSlice(), out);
+        out << ",\n";
+
+        out << "      \"timeMs\": { \"total\": " << result.totalMs;
+        for (Index i = 0; i < kStageCount; ++i)
+        {
+            out << ", \"" << kStages[i].name << "\": " << result.stageMs[i];
+        }
+        out << " },\n";
+
+        out << "      \"irInstCount\": { ";
+        for (Index i = 0; i < kIRCountCount; ++i)
+        {
+            out << (i ? ", \"" : "\"") << kIRCounts[i].name << "\": " << result.irCounts[i];
+        }
+        out << " },\n";
+
+        out << "      \"allocationCount\": " << result.allocationCount << ",\n";
+        out << "      \"peakAllocatedBytes\": " << result.peakAllocatedBytes << "\n";
+        out << "    }";
+    }
+
+    out << "\n  ]\n}\n";
+}
+
+static void _printResults(const List<CaseResult>& results)
+{
+    printf("%-60s %9s", "case (ms)", "total");
+    for (const auto& stage : kStages)
+    {
+        printf(" %11s", stage.name);
+    }
+    printf(" %12s %10s %10s\n", "allocations", "peak KB", "IR insts");
+
+    for (const auto& result : results)
+    {
+        printf("%-60s %9.2f", result.name.getBuffer(), result.totalMs);
+        for (Index i = 0; i < kStageCount; ++i)
+        {
+            printf(" %11.2f", result.stageMs[i]);
+        }
+        printf(" %12llu %10.1f %10lld\n",
+            (unsigned long long)result.allocationCount,
+            double(result.peakAllocatedBytes) / 1024.0,
+            (long long)result.irCounts[kIRCountCount - 1]);
+    }
+
+    printf("process peak memory: %.1f MB\n", double(_getPeakMemoryUsage()) / (1024.0 * 1024.0));
+}
+
+    /// Compare `results` with the baseline. Returns SLANG_FAIL if anything regressed.
+static SlangResult _compareWithBaseline(const List<CaseResult>& results, const Options& options)
+{
+    String baselineText;
+    if (SLANG_FAILED(File::readAllText(options.baselinePath, baselineText)))
+    {
+        fprintf(stderr, "error: unable to read baseline '%s'\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    JSONDocument baseline;
+    if (SLANG_FAILED(baseline.parse(baselineText)))
+    {
+        fprintf(stderr, "error: unable to parse baseline '%s'\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    const JSONValue casesValue = baseline.find(baseline.root, "cases");
+    if (casesValue.getKind() != JSONValue::Kind::Array)
+    {
+        fprintf(stderr, "error: baseline '%s' has no cases\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+    const auto baselineCases = baseline.container->getArray(casesValue);
+
+    Index regressionCount = 0;
+    auto check = [&](const CaseResult& result, const char* what, double value, double baselineValue, double minDelta)
+    {
+        if (value > baselineValue * (1.0 + options.threshold) && value - baselineValue > minDelta)
+        {
+            printf("regression: %s %s %.2f -> %.2f (%+.1f%%)\n",
+                result.name.getBuffer(), what, baselineValue, value,
+                baselineValue > 0.0 ? (value / baselineValue - 1.0) * 100.0 : 100.0);
+            ++regressionCount;
+        }
+    };
+
+    for (const auto& result : results)
+    {
+        JSONValue baselineCase;
+        for (const auto& caseValue : baselineCases)
+        {
+            if (baseline.container->getString(baseline.find(caseValue, "name")) == result.name.getUnownedSlice())
+            {
+                baselineCase = caseValue;
+            }
+        }
+        if (!baselineCase.isValid())
+        {
+            printf("note: %s isn't in the baseline\n", result.name.getBuffer());
+            continue;
+        }
+
+        const JSONValue timeValue = baseline.find(baselineCase, "timeMs");
+        check(result, "total", result.totalMs, baseline.container->asFloat(baseline.find(timeValue, "total")), options.minDeltaMs);
+        for (Index i = 0; i < kStageCount; ++i)
+        {
+            const JSONValue stageValue = baseline.find(timeValue, kStages[i].name);
+            if (stageValue.isValid())
+            {
+                check(result, kStages[i].name, result.stageMs[i], baseline.container->asFloat(stageValue), options.minDeltaMs);
+            }
+        }
+
+        // Counts don't vary between runs, so any growth beyond the threshold is a regression
+        const JSONValue irCountValue = baseline.find(baselineCase, "irInstCount");
+        for (Index i = 0; i < kIRCountCount; ++i)
+        {
+            const JSONValue countValue = baseline.find(irCountValue, kIRCounts[i].name);
+            if (countValue.isValid())
+            {
+                check(result, kIRCounts[i].counterName, double(result.irCounts[i]), double(baseline.container->asInteger(countValue)), 0.0);
+            }
+        }
+
+        const JSONValue allocationValue = baseline.find(baselineCase, "allocationCount");
+        if (allocationValue.isValid())
+        {
+            check(result, "allocationCount", double(result.allocationCount), double(baseline.container->asInteger(allocationValue)), 0.0);
+        }
+
+        const JSONValue peakAllocatedValue = baseline.find(baselineCase, "peakAllocatedBytes");
+        if (peakAllocatedValue.isValid())
+        {
+            check(result, "peakAllocatedBytes", double(result.peakAllocatedBytes), double(baseline.container->asInteger(peakAllocatedValue)), 0.0);
+        }
+    }
+
+    printf("%d regression(s) compared to '%s'\n", int(regressionCount), options.baselinePath.getBuffer());
+    return regressionCount ? SLANG_FAIL : SLANG_OK;
+}
+
+    /// Time JSON-RPC round trips to a test-server process. First with one call at a time, which gives the
+    /// latency, and then with several calls in flight, which gives the throughput.
+static SlangResult _runRPCBenchmark(const Options& options)
+{
+    const Index kInFlightCount = 16;
+
+    RefPtr<Process> process;
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableLocation(ExecutableLocation(Path::getParentDirectory(Path::getExecutablePath()), "test-server"));
+        SLANG_RETURN_ON_FAIL(Process::create(cmdLine, Process::Flag::DisableStdErrRedirection, process));
+    }
+
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(process->getStream(StdStreamType::Out)));
+    RefPtr<HTTPPacketConnection> packetConnection(new HTTPPacketConnection(readStream, process->getStream(StdStreamType::In)));
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection, JSONRPCConnection::CallStyle::Default, process));
+
+    const auto ping = [&](Int id) -> SlangResult
+    {
+        return connection->sendCall(TestServerProtocol::PingArgs::g_methodName, JSONValue::makeInt(id));
+    };
+    const auto waitForPing = [&](Int id) -> SlangResult
+    {
+        SLANG_RETURN_ON_FAIL(connection->waitForResponse(JSONValue::makeInt(id)));
+        return (connection->hasMessage() && connection->getMessageType() == JSONRPCMessageType::Result) ? SLANG_OK : SLANG_FAIL;
+    };
+
+    // The first call includes the test-server start up
+    SLANG_RETURN_ON_FAIL(ping(0));
+    SLANG_RETURN_ON_FAIL(waitForPing(0));
+
+    const Index count = options.rpcRoundTripCount;
+    if (count <= 0)
+    {
+        fprintf(stderr, "error: -rpc-round-trips needs at least one round trip\n");
+        return SLANG_E_INVALID_ARG;
+    }
+    Int nextId = 1;
+
+    List<double> latenciesUs;
+    for (Index i = 0; i < count; ++i)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        const Int id = nextId++;
+        SLANG_RETURN_ON_FAIL(ping(id));
+        SLANG_RETURN_ON_FAIL(waitForPing(id));
+        latenciesUs.add(std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+
+    double inFlightUs = 0.0;
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (Index i = 0; i < count; i += kInFlightCount)
+        {
+            const Int firstId = nextId;
+            const Index batchCount = std::min(kInFlightCount, count - i);
+            for (Index j = 0; j < batchCount; ++j)
+            {
+                SLANG_RETURN_ON_FAIL(ping(nextId++));
+            }
+            // Wait in reverse, so the other responses have to be held
+            for (Index j = batchCount - 1; j >= 0; --j)
+            {
+                SLANG_RETURN_ON_FAIL(waitForPing(firstId + j));
+            }
+        }
+        inFlightUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Closing the connection tells test-server to quit
+    connection->disconnect();
+
+    latenciesUs.sort();
+    double totalUs = 0.0;
+    for (auto latency : latenciesUs)
+    {
+        totalUs += latency;
+    }
+
+    printf("test-server round trips (us), %d calls\n", int(count));
+    printf("  one in flight:  mean %.1f, median %.1f, p99 %.1f, max %.1f\n",
+        totalUs / double(count),
+        latenciesUs[count / 2],
+        latenciesUs[std::min(count - 1, (count * 99) / 100)],
+        latenciesUs.getLast());
+    printf("  %d in flight:   %.1f per call\n", int(kInFlightCount), inFlightUs / double(count));
+    return SLANG_OK;
+}
+
+    /// Time creating a global session, which is mostly loading the standard library, and the first compile
+    /// with it, which includes reading any of the standard library that is loaded on demand.
+static SlangResult _runStartupBenchmark(const Options& options)
+{
+    const CorpusEntry& entry = kCorpus[0];
+    const TargetInfo& target = kTargets[1];
+
+    double createMs = 0.0;
+    double firstCompileMs = 0.0;
+    uint64_t createAllocationCount = 0;
+    uint64_t createPeakAllocatedBytes = 0;
+
+    for (Index iteration = 0; iteration < options.startupCount; ++iteration)
+    {
+        const uint64_t startAllocationCount = g_allocationCount.load();
+        const uint64_t startLiveBytes = _resetPeakLiveBytes();
+        const auto startTime = std::chrono::steady_clock::now();
+
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+
+        const auto createdTime = std::chrono::steady_clock::now();
+        const uint64_t allocationCount = g_allocationCount.load() - startAllocationCount;
+        const uint64_t peakAllocatedBytes = _getPeakAllocatedBytes(startLiveBytes);
+
+        SLANG_RETURN_ON_FAIL(_compile(globalSession, options, entry, target));
+
+        const auto compiledTime = std::chrono::steady_clock::now();
+
+        // Report the fastest of the iterations, which is the least affected by noise
+        const bool isFirst = iteration == 0;
+        const double iterationCreateMs = std::chrono::duration<double, std::milli>(createdTime - startTime).count();
+        const double iterationCompileMs = std::chrono::duration<double, std::milli>(compiledTime - createdTime).count();
+        createMs = isFirst ? iterationCreateMs : std::min(createMs, iterationCreateMs);
+        firstCompileMs = isFirst ? iterationCompileMs : std::min(firstCompileMs, iterationCompileMs);
+        createAllocationCount = isFirst ? allocationCount : std::min(createAllocationCount, allocationCount);
+        createPeakAllocatedBytes = isFirst ? peakAllocatedBytes : std::min(createPeakAllocatedBytes, peakAllocatedBytes);
+    }
+
+    printf("global session start up, fastest of %d\n", int(options.startupCount));
+    printf("  create:         %.1f ms, %llu allocations, peak allocated %.1f MB\n",
+        createMs,
+        (unsigned long long)createAllocationCount,
+        double(createPeakAllocatedBytes) / (1024.0 * 1024.0));
+    printf("  first compile:  %.1f ms (%s:%s)\n", firstCompileMs, entry.path, target.name);
+    return SLANG_OK;
+}
+
+    /// Time decoding the same values from each of the variable byte encodings
+static SlangResult _runByteDecodeBenchmark(const Options& options)
+{
+    const Index valueCount = 1024 * 1024;
+
+    // Like IR operands, most values fit in a byte, and few need more than two
+    DefaultRandomGenerator randGen(0x5346536a);
+    List<uint32_t> values;
+    values.setCount(valueCount);
+    for (auto& value : values)
+    {
+        const int32_t kind = randGen.nextInt32InRange(0, 8);
+        const uint32_t mask = (kind < 5) ? 0xff : ((kind < 7) ? 0xffff : 0xffffffff);
+        value = uint32_t(randGen.nextInt32()) & mask;
+    }
+
+    List<uint8_t> liteEncoded;
+    ByteEncodeUtil::encodeLiteUInt32(values.getBuffer(), size_t(valueCount), liteEncoded);
+    List<uint8_t> streamEncoded;
+    ByteEncodeUtil::encodeStreamUInt32(values.getBuffer(), size_t(valueCount), streamEncoded);
+
+    List<uint32_t> decoded;
+    decoded.setCount(valueCount);
+
+    // Returns the fastest time of the iterations in ms, or a negative value if the decoded values are wrong
+    auto timeDecode = [&](auto decode) -> double
+    {
+        double fastestMs = 0.0;
+        for (Index iteration = 0; iteration < options.byteDecodeCount; ++iteration)
+        {
+            const auto startTime = std::chrono::steady_clock::now();
+            decode();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            fastestMs = (iteration == 0) ? ms : std::min(fastestMs, ms);
+        }
+        return (decoded == values) ? fastestMs : -1.0;
+    };
+
+    const double liteMs = timeDecode([&]() { ByteEncodeUtil::decodeLiteUInt32(liteEncoded.getBuffer(), size_t(valueCount), decoded.getBuffer()); });
+    const double streamScalarMs = timeDecode([&]() { ByteEncodeUtil::decodeStreamUInt32Scalar(streamEncoded.getBuffer(), size_t(valueCount), decoded.getBuffer()); });
+    const double streamMs = timeDecode([&]() { ByteEncodeUtil::decodeStreamUInt32(streamEncoded.getBuffer(), size_t(streamEncoded.getCount()), size_t(valueCount), decoded.getBuffer()); });
+
+    if (liteMs < 0.0 || streamScalarMs < 0.0 || streamMs < 0.0)
+    {
+        fprintf(stderr, "error: decoded values don't match\n");
+        return SLANG_FAIL;
+    }
+
+    printf("variable byte decode of %d values, fastest of %d\n", int(valueCount), int(options.byteDecodeCount));
+    printf("  lite:           %.2f ms, %d bytes\n", liteMs, int(liteEncoded.getCount()));
+    printf("  stream scalar:  %.2f ms, %d bytes\n", streamScalarMs, int(streamEncoded.getCount()));
+    printf("  stream:         %.2f ms (%s)\n", streamMs, ByteEncodeUtil::canDecodeStreamSimd() ? "simd" : "scalar");
+    return SLANG_OK;
+}
+
+    /// Time dispatching the same compute kernel on the gfx CPU device, with the groups split between
+    /// different numbers of threads. Returns the fastest time of `options.cpuDispatchCount` dispatches in ms.
+static SlangResult _timeCPUDispatch(const Options& options, uint32_t threadCount, double& outMs)
+{
+    const uint32_t kGroupCount = 4096;
+    const uint32_t kElementCount = kGroupCount * 64;
+
+    // The kernel is shared with the gfx unit test that checks the results
+    const String searchPath = Path::combine(options.rootDir, "tools/gfx-unit-test");
+    const char* searchPaths[] = { searchPath.getBuffer() };
+
+    gfx::CPUDeviceExtendedDesc cpuDesc;
+    cpuDesc.maxThreadCount = threadCount;
+    void* extendedDescs[] = { &cpuDesc };
+
+    gfx::IDevice::Desc deviceDesc = {};
+    deviceDesc.deviceType = gfx::DeviceType::CPU;
+    deviceDesc.slang.searchPaths = searchPaths;
+    deviceDesc.slang.searchPathCount = 1;
+    deviceDesc.extendedDescCount = 1;
+    deviceDesc.extendedDescs = extendedDescs;
+
+    ComPtr<gfx::IDevice> device;
+    SLANG_RETURN_ON_FAIL(gfxCreateDevice(&deviceDesc, device.writeRef()));
+
+    ComPtr<slang::ISession> slangSession;
+    SLANG_RETURN_ON_FAIL(device->getSlangSession(slangSession.writeRef()));
+    ComPtr<slang::IBlob> diagnosticsBlob;
+    slang::IModule* module = slangSession->loadModule("cpu-dispatch-scaling", diagnosticsBlob.writeRef());
+    if (!module)
+    {
+        fprintf(stderr, "error: unable to load cpu-dispatch-scaling.slang from '%s'\n%s", searchPath.getBuffer(),
+            diagnosticsBlob ? (const char*)diagnosticsBlob->getBufferPointer() : "");
+        return SLANG_FAIL;
+    }
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(slangSession->createCompositeComponentType(componentTypes, 2, composedProgram.writeRef()));
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef()));
+
+    gfx::IShaderProgram::Desc programDesc = {};
+    programDesc.slangGlobalScope = linkedProgram;
+    ComPtr<gfx::IShaderProgram> program;
+    SLANG_RETURN_ON_FAIL(device->createProgram(programDesc, program.writeRef()));
+
+    gfx::ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = program;
+    ComPtr<gfx::IPipelineState> pipelineState;
+    SLANG_RETURN_ON_FAIL(device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    gfx::IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = kElementCount * sizeof(uint32_t);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.allowedStates = gfx::ResourceStateSet(gfx::ResourceState::UnorderedAccess, gfx::ResourceState::CopySource);
+    bufferDesc.defaultState = gfx::ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = gfx::MemoryType::DeviceLocal;
+    ComPtr<gfx::IBufferResource> buffer;
+    SLANG_RETURN_ON_FAIL(device->createBufferResource(bufferDesc, nullptr, buffer.writeRef()));
+
+    gfx::IResourceView::Desc viewDesc = {};
+    viewDesc.type = gfx::IResourceView::Type::UnorderedAccess;
+    ComPtr<gfx::IResourceView> bufferView;
+    SLANG_RETURN_ON_FAIL(device->createBufferView(buffer, nullptr, viewDesc, bufferView.writeRef()));
+
+    gfx::ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    ComPtr<gfx::ITransientResourceHeap> transientHeap;
+    SLANG_RETURN_ON_FAIL(device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    gfx::ICommandQueue::Desc queueDesc = { gfx::ICommandQueue::QueueType::Graphics };
+    ComPtr<gfx::ICommandQueue> queue;
+    SLANG_RETURN_ON_FAIL(device->createCommandQueue(queueDesc, queue.writeRef()));
+
+    // The first dispatch is of a single group, so that compiling the kernel isn't part of the timing
+    for (Index iteration = -1; iteration < options.cpuDispatchCount; ++iteration)
+    {
+        ComPtr<gfx::ICommandBuffer> commandBuffer;
+        SLANG_RETURN_ON_FAIL(transientHeap->createCommandBuffer(commandBuffer.writeRef()));
+        auto encoder = commandBuffer->encodeComputeCommands();
+        auto rootObject = encoder->bindPipeline(pipelineState);
+        SLANG_RETURN_ON_FAIL(rootObject->setResource(gfx::ShaderOffset(), bufferView));
+        encoder->dispatchCompute((iteration < 0) ? 1 : kGroupCount, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+
+        const auto startTime = std::chrono::steady_clock::now();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        if (iteration >= 0)
+        {
+            outMs = (iteration == 0) ? ms : std::min(outMs, ms);
+        }
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runCPUDispatchBenchmark(const Options& options)
+{
+    const uint32_t maxThreadCount = uint32_t(ThreadPool::getDefaultThreadCount());
+
+    printf("gfx CPU device dispatch (ms), fastest of %d\n", int(options.cpuDispatchCount));
+
+    double singleThreadMs = 0.0;
+    for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreadCount))
+    {
+        double ms = 0.0;
+        SLANG_RETURN_ON_FAIL(_timeCPUDispatch(options, threadCount, ms));
+        if (threadCount == 1)
+        {
+            singleThreadMs = ms;
+        }
+        printf("  %3d thread(s):  %.2f ms (speedup %.2fx)\n", int(threadCount), ms, ms > 0.0 ? singleThreadMs / ms : 0.0);
+
+        if (threadCount == maxThreadCount)
+        {
+            break;
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// Compile `entry` into host callable code, with the precompiled prelude kept in `preludePCHCacheDirectory`, or
+    /// without precompiling the prelude if it's empty. `outMs` is the time taken.
+static SlangResult _compileHostCallable(slang::IGlobalSession* globalSession, const Options& options, const CorpusEntry& entry, const String& preludePCHCacheDirectory, double& outMs)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    const char* args[] = { "-target", "host-callable", "-prelude-pch-cache-path", preludePCHCacheDirectory.getBuffer() };
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args, SLANG_COUNT_OF(args)));
+
+    const String path = Path::combine(options.rootDir, entry.path);
+    request->addSearchPath(Path::getParentDirectory(path).getBuffer());
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceFile(translationUnitIndex, path.getBuffer());
+    if (entry.entryPointName)
+    {
+        request->addEntryPoint(translationUnitIndex, entry.entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    const SlangResult result = request->compile();
+    if (SLANG_FAILED(result))
+    {
+        fprintf(stderr, "error: failed to compile '%s' for host-callable\n%s", path.getBuffer(), request->getDiagnosticOutput());
+        return result;
+    }
+
+    outMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return SLANG_OK;
+}
+
+    /// Remove a prelude PCH cache directory, and the files in it
+static void _removeCacheDirectory(const String& directory)
+{
+    List<String> fileNames;
+    OSFileSystem::getMutableSingleton()->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType type, const char* fileName, void* userData)
+        {
+            if (type == SLANG_PATH_TYPE_FILE)
+            {
+                static_cast<List<String>*>(userData)->add(fileName);
+            }
+        },
+        &fileNames);
+    for (const auto& fileName : fileNames)
+    {
+        File::remove(Path::combine(directory, fileName));
+    }
+    File::remove(directory);
+}
+
+    /// Time compiling each kernel into host callable code, which is dominated by the downstream C++ compiler. With the
+    /// precompiled prelude, the first compile includes precompiling it, and later compiles reuse it.
+static SlangResult _runKernelLatencyBenchmark(const Options& options)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+
+    printf("host callable compile per kernel (ms), fastest of %d\n", int(options.kernelLatencyCount));
+    printf("  %-52s %10s %10s %10s\n", "kernel", "no pch", "first pch", "pch");
+
+    for (const auto& entry : kCorpus)
+    {
+        if ((entry.targetFlags & kTargetFlag_CPP) == 0)
+        {
+            continue;
+        }
+
+        // A new cache for each kernel, so its first compile has to precompile the prelude
+        String cacheDirectory;
+        SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-profile-pch"), cacheDirectory));
+        File::remove(cacheDirectory);
+
+        double inlineMs = 0.0;
+        double firstMs = 0.0;
+        double cachedMs = 0.0;
+        SlangResult result = SLANG_OK;
+        for (Index iteration = 0; iteration < options.kernelLatencyCount && SLANG_SUCCEEDED(result); ++iteration)
+        {
+            double ms = 0.0;
+            result = _compileHostCallable(globalSession, options, entry, String(), ms);
+            inlineMs = (iteration == 0) ? ms : std::min(inlineMs, ms);
+
+            if (SLANG_SUCCEEDED(result))
+            {
+                result = _compileHostCallable(globalSession, options, entry, cacheDirectory, ms);
+                firstMs = (iteration == 0) ? ms : firstMs;
+                cachedMs = (iteration <= 1) ? ms : std::min(cachedMs, ms);
+            }
+        }
+
+        _removeCacheDirectory(cacheDirectory);
+        SLANG_RETURN_ON_FAIL(result);
+
+        // With one iteration there is no compile that only reuses the precompiled prelude
+        if (options.kernelLatencyCount > 1)
+        {
+            printf("  %-52s %10.1f %10.1f %10.1f\n", entry.path, inlineMs, firstMs, cachedMs);
+        }
+        else
+        {
+            printf("  %-52s %10.1f %10.1f %10s\n", entry.path, inlineMs, firstMs, "-");
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// The kernel timed by `-cpu-vectorize`. Neighbouring threads take different sides of the branch, which is only
+    /// vectorized as masked code.
+static const char kCPUVectorizeKernel[] = R"(
+RWStructuredBuffer<float> gOutput;
+
+[numthreads(64, 1, 1)]
+void computeMain(uint3 id : SV_DispatchThreadID)
+{
+    float x = float(int(id.x & 1023)) * 0.001;
+    float value = x;
+    for (int i = 0; i < 32; i++)
+    {
+        value = value * x + 0.5;
+    }
+    if ((id.x & 1) == 0)
+    {
+        value = -value;
+    }
+    gOutput[id.x] = value;
+}
+)";
+
+    /// The layout of the host callable `computeMain`'s parameters, as in the C++ prelude
+struct CPUVectorizeVaryingInput
+{
+    uint32_t startGroupID[3];
+    uint32_t endGroupID[3];
+};
+struct CPUVectorizeGlobalParams
+{
+    float* data;
+    size_t count;
+};
+typedef void (*CPUVectorizeKernelFunc)(CPUVectorizeVaryingInput* varyingInput, void* entryPointParams, void* globalParams);
+
+    /// Compile `kCPUVectorizeKernel` into host callable code, with the `-cpu-vectorize-width` given by `laneCount`, or running the
+    /// threads one at a time if it's 0
+static SlangResult _compileCPUVectorizeKernel(slang::IGlobalSession* globalSession, Index laneCount, ComPtr<ISlangSharedLibrary>& outLibrary)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    const String laneCountText(laneCount);
+    const char* args[] = { "-target", "host-callable", "-O3", "-cpu-vectorize-width", laneCountText.getBuffer() };
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args, laneCount > 0 ? 5 : 3));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "cpu-vectorize.slang", kCPUVectorizeKernel);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult result = request->compile();
+    if (SLANG_FAILED(result))
+    {
+        fprintf(stderr, "error: failed to compile the -cpu-vectorize kernel for host-callable\n%s", request->getDiagnosticOutput());
+        return result;
+    }
+
+    // Get the library through the program, as the gfx CPU device does
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(request->getProgramWithEntryPoints(program.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    return program->getEntryPointHostCallable(0, 0, outLibrary.writeRef(), diagnostics.writeRef());
+}
+
+    /// Time running the same kernel over the same groups with its threads run one at a time, and with vectorize widths.
+    /// The results with a width are checked against those without, so any difference is reported.
+static SlangResult _runCPUVectorizeBenchmark(const Options& options)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+
+    const uint32_t groupCount = uint32_t(options.cpuVectorizeGroupCount);
+    const size_t threadCount = size_t(groupCount) * 64;
+
+    List<float> expected;
+    List<float> output;
+    output.setCount(Index(threadCount));
+
+    printf("host callable kernel over %u groups of 64 threads, fastest of %d\n", groupCount, int(options.iterationCount));
+    printf("  %-10s %10s %16s %10s\n", "width", "ms", "threads/s", "speedup");
+
+    double scalarMs = 0.0;
+    const Index laneCounts[] = { 0, 4, 8, 16 };
+    for (const Index laneCount : laneCounts)
+    {
+        ComPtr<ISlangSharedLibrary> library;
+        SLANG_RETURN_ON_FAIL(_compileCPUVectorizeKernel(globalSession, laneCount, library));
+        const auto func = (CPUVectorizeKernelFunc)library->findFuncByName("computeMain");
+        if (!func)
+        {
+            fprintf(stderr, "error: 'computeMain' not found in the -cpu-vectorize kernel\n");
+            return SLANG_FAIL;
+        }
+
+        CPUVectorizeGlobalParams globalParams = { output.getBuffer(), threadCount };
+        CPUVectorizeVaryingInput varyingInput = { { 0, 0, 0 }, { groupCount, 1, 1 } };
+
+        double ms = 0.0;
+        for (Index iteration = 0; iteration < options.iterationCount; ++iteration)
+        {
+            const auto startTime = std::chrono::steady_clock::now();
+            func(&varyingInput, nullptr, &globalParams);
+            const double iterationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            ms = (iteration == 0) ? iterationMs : std::min(ms, iterationMs);
+        }
+
+        if (laneCount == 0)
+        {
+            scalarMs = ms;
+            expected = output;
+        }
+        else if (memcmp(expected.getBuffer(), output.getBuffer(), sizeof(float) * threadCount) != 0)
+        {
+            fprintf(stderr, "error: the results with a vectorize width of %d differ from those without\n", int(laneCount));
+            return SLANG_FAIL;
+        }
+
+        StringBuilder lanes;
+        if (laneCount > 0)
+        {
+            lanes << laneCount;
+        }
+        else
+        {
+            lanes << "none";
+        }
+        printf("  %-10s %10.3f %16.0f %9.2fx\n", lanes.getBuffer(), ms, threadCount / (ms / 1000.0), scalarMs / ms);
+    }
+    return SLANG_OK;
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
 
-    // Time the creation of the session
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, options));
+
+    if (options.rpcRoundTripCount > 0)
+    {
+        return _runRPCBenchmark(options);
+    }
+    if (options.startupCount > 0)
+    {
+        return _runStartupBenchmark(options);
+    }
+    if (options.byteDecodeCount > 0)
+    {
+        return _runByteDecodeBenchmark(options);
+    }
+    if (options.cpuDispatchCount > 0)
+    {
+        return _runCPUDispatchBenchmark(options);
+    }
+    if (options.kernelLatencyCount > 0)
     {
-        const auto startTick = Process::getClockTick();
+        return _runKernelLatencyBenchmark(options);
+    }
+    if (options.cpuVectorizeGroupCount > 0)
+    {
+        return _runCPUVectorizeBenchmark(options);
+    }
+
+    // Creating the global session (and loading the standard library) isn't part of any case
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+    globalSession->setPerformanceProfilingEnabled(true);
 
-        for (Int i = 0; i < 32; ++i)
+    List<CaseResult> results;
+    for (const auto& entry : kCorpus)
+    {
+        for (const auto& target : kTargets)
         {
-            ComPtr<slang::IGlobalSession> slangSession;
-            slangSession.attach(spCreateSession(nullptr));
+            if ((entry.targetFlags & options.targetFlags & target.flag) == 0)
+            {
+                continue;
+            }
+
+            CaseResult result;
+            SLANG_RETURN_ON_FAIL(_runCase(globalSession, options, entry, target, result));
+            results.add(result);
         }
+    }
 
-        const auto endTick = Process::getClockTick();
+    globalSession->setPerformanceProfilingEnabled(false);
 
-        printf("Ticks %f\n", double(endTick - startTick) / Process::getClockFrequency());
-        return SLANG_OK;
+    _printResults(results);
+
+    if (options.outputPath.getLength())
+    {
+        StringBuilder json;
+        _writeJSON(results, options, json);
+        SLANG_RETURN_ON_FAIL(File::writeAllText(options.outputPath, json));
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        SLANG_RETURN_ON_FAIL(_compareWithBaseline(results, options));
     }
 
     return SLANG_OK;
@@ -1730,6 +1730,13 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return TestResult::Pass;
     }
     auto connection = context->m_languageServerConnection.Ptr();
+
+    String testFileContent;
+    if (SLANG_FAILED(File::readAllText(input.filePath, testFileContent)))
+    {
+        return TestResult::Fail;
+    }
+
     LanguageServerProtocol::InitializeParams initParams;
     LanguageServerProtocol::WorkspaceFolder wsFolder;
     wsFolder.name = "test";
@@ -1737,30 +1744,34 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     Path::getCanonical(input.filePath, fullPath);
     wsFolder.uri = URI::fromLocalFilePath(Path::getParentDirectory(fullPath).getUnownedSlice()).uri;
     initParams.workspaceFolders.add(wsFolder);
+    // How workspace versions reuse modules is only logged when tracing.
+    if (testFileContent.indexOf(UnownedStringSlice("//REUSE")) != -1)
+    {
+        initParams.trace = "messages";
+    }
     if (SLANG_FAILED(connection->sendCall(
             LanguageServerProtocol::InitializeParams::methodName, &initParams, JSONValue::makeInt(0))))
     {
         return TestResult::Fail;
     }
-    if (SLANG_FAILED(connection->waitForResult(-1)))
+    // Calls from the server made for an earlier test, such as to publish its diagnostics, can
+    // arrive before the result.
+    do
     {
-        return TestResult::Fail;
-    }
+        if (SLANG_FAILED(connection->waitForResult(-1)))
+        {
+            return TestResult::Fail;
+        }
+    } while (connection->getMessageType() == JSONRPCMessageType::Call);
 
     LanguageServerProtocol::InitializeResult initResult;
     if (SLANG_FAILED(connection->getMessage(&initResult)))
     {
         return TestResult::Fail;
     }
+    connection->sendCall(UnownedStringSlice("initialized"));
 
     // Send open document call.
-    String testFileContent;
-
-    if (SLANG_FAILED(File::readAllText(input.filePath, testFileContent)))
-    {
-        return TestResult::Fail;
-    }
-
     LanguageServerProtocol::DidOpenTextDocumentParams openDocParams;
     openDocParams.textDocument.version = 0;
     openDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
@@ -1771,28 +1782,48 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         JSONValue::makeInt(1));
     List<LanguageServerProtocol::PublishDiagnosticsParams> diagnostics;
     bool diagnosticsReceived = false;
+    // The log messages received since the last response.
+    List<String> logMessages;
+    // Reads the next message, recording diagnostics and log messages. Other calls from the server,
+    // such as the request for its configuration, aren't answered.
+    auto readMessage = [&](bool& outIsCall) -> SlangResult
+    {
+        SLANG_RETURN_ON_FAIL(connection->waitForResult(-1));
+        outIsCall = connection->getMessageType() == JSONRPCMessageType::Call;
+        if (!outIsCall)
+            return SLANG_OK;
+        JSONRPCCall call;
+        connection->getRPC(&call);
+        if (call.method == "textDocument/publishDiagnostics")
+        {
+            LanguageServerProtocol::PublishDiagnosticsParams arg;
+            SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &arg, call.id));
+            if (arg.uri == openDocParams.textDocument.uri)
+                diagnosticsReceived = true;
+            diagnostics.add(arg);
+        }
+        else if (call.method == LanguageServerProtocol::LogMessageParams::methodName)
+        {
+            LanguageServerProtocol::LogMessageParams arg;
+            SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &arg, call.id));
+            logMessages.add(arg.message);
+        }
+        return SLANG_OK;
+    };
     auto waitForNonDiagnosticResponse = [&]() -> SlangResult
     {
-        repeat:
-        if (SLANG_FAILED(connection->waitForResult(-1)))
-            return SLANG_FAIL;
-        if (connection->getMessageType() == JSONRPCMessageType::Call)
+        bool isCall = true;
+        while (isCall)
         {
-            JSONRPCCall call;
-            connection->getRPC(&call);
-            if (call.method == "textDocument/publishDiagnostics")
-            {
-                diagnosticsReceived = true;
-                LanguageServerProtocol::PublishDiagnosticsParams arg;
-                if (SLANG_FAILED(connection->getMessage(&arg)))
-                    return SLANG_FAIL;
-                diagnostics.add(arg);
-                goto repeat;
-            }
+            SLANG_RETURN_ON_FAIL(readMessage(isCall));
         }
+        logMessages.clear();
         return SLANG_OK;
     };
 
+    // The documents other than the test file that have been opened to change them, and their text.
+    Dictionary<String, String> changedDocTexts;
+
     List<UnownedStringSlice> lines;
     StringUtil::calcLines(testFileContent.getUnownedSlice(), lines);
 
@@ -1922,22 +1953,121 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         }
         else if (line.startsWith("//DIAGNOSTICS"))
         {
-            if (!diagnosticsReceived)
+            // Diagnostics are published a while after the documents change.
+            while (!diagnosticsReceived)
             {
-                waitForNonDiagnosticResponse();
+                bool isCall = false;
+                if (SLANG_FAILED(readMessage(isCall)))
+                    return TestResult::Fail;
             }
             actualOutputSB << "--------\n";
             for (auto item : diagnostics)
             {
+                // Skip the diagnostics cleared for the files of earlier tests.
+                if (item.uri != openDocParams.textDocument.uri &&
+                    !changedDocTexts.containsKey(item.uri))
+                {
+                    continue;
+                }
                 actualOutputSB << item.uri << "\n";
                 for (auto msg : item.diagnostics)
                 {
                     actualOutputSB << msg.range.start.line << "," << msg.range.start.character
                                    << "-" << msg.range.end.line << "," << msg.range.end.character
-                                   << " " << msg.message;
+                                   << " " << msg.message << "\n";
                 }
             }
         }
+        else if (line.startsWith("//CHANGE:"))
+        {
+            // //CHANGE:<file>:<line>:<text> replaces a line of a file next to the test file, as
+            // if it had been edited in the editor.
+            auto arg = line.tail(UnownedStringSlice("//CHANGE:").getLength());
+            Index pos = arg.indexOf(':');
+            if (pos == -1)
+                return TestResult::Fail;
+            String changedPath;
+            Path::getCanonical(
+                Path::combine(Path::getParentDirectory(fullPath), arg.head(pos)), changedPath);
+            pos++;
+            Int linePos = StringUtil::parseIntAndAdvancePos(arg, pos);
+            pos++;
+            if (pos > arg.getLength())
+                return TestResult::Fail;
+            String newLineText = arg.tail(pos);
+
+            String uri = URI::fromLocalFilePath(changedPath.getUnownedSlice()).uri;
+            String* docText = changedDocTexts.tryGetValue(uri);
+            if (!docText)
+            {
+                String text;
+                if (SLANG_FAILED(File::readAllText(changedPath, text)))
+                    return TestResult::Fail;
+                LanguageServerProtocol::DidOpenTextDocumentParams params;
+                params.textDocument.uri = uri;
+                params.textDocument.text = text;
+                connection->sendCall(
+                    LanguageServerProtocol::DidOpenTextDocumentParams::methodName, &params);
+                docText = &(changedDocTexts[uri] = text);
+            }
+
+            List<UnownedStringSlice> docLines;
+            StringUtil::calcLines(docText->getUnownedSlice(), docLines);
+            if (linePos < 1 || linePos > docLines.getCount())
+                return TestResult::Fail;
+
+            LanguageServerProtocol::DidChangeTextDocumentParams params;
+            params.textDocument.uri = uri;
+            params.textDocument.version = 1;
+            LanguageServerProtocol::TextDocumentContentChangeEvent change;
+            change.range.start.line = int(linePos - 1);
+            change.range.start.character = 0;
+            change.range.end.line = int(linePos - 1);
+            change.range.end.character = int(docLines[linePos - 1].getLength());
+            change.text = newLineText;
+            params.contentChanges.add(change);
+            connection->sendCall(
+                LanguageServerProtocol::DidChangeTextDocumentParams::methodName, &params);
+
+            StringBuilder newText;
+            newText << docText->getUnownedSlice().head(docLines[linePos - 1].begin() - docText->begin());
+            newText << newLineText;
+            newText << docText->getUnownedSlice().tail(docLines[linePos - 1].end() - docText->begin());
+            *docText = newText.produceString();
+
+            // Only the diagnostics for the new contents are of interest.
+            diagnostics.clear();
+            diagnosticsReceived = false;
+        }
+        else if (line.startsWith("//REUSE"))
+        {
+            // After the response to the request that created a workspace version, the server logs
+            // how many of the modules of the previous version it reused.
+            const UnownedStringSlice prefix = UnownedStringSlice("Workspace version created");
+            String message;
+            for (;;)
+            {
+                for (const auto& logMessage : logMessages)
+                {
+                    if (logMessage.startsWith(prefix))
+                        message = logMessage;
+                }
+                if (message.getLength())
+                    break;
+                bool isCall = false;
+                if (SLANG_FAILED(readMessage(isCall)))
+                    return TestResult::Fail;
+            }
+            logMessages.clear();
+            actualOutputSB << "--------\n" << message << "\n";
+        }
+    }
+    for (const auto& [uri, _] : changedDocTexts)
+    {
+        LanguageServerProtocol::DidCloseTextDocumentParams params;
+        params.textDocument.uri = uri;
+        connection->sendCall(
+            LanguageServerProtocol::DidCloseTextDocumentParams::methodName, &params);
     }
     LanguageServerProtocol::DidCloseTextDocumentParams closeDocParams;
     closeDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
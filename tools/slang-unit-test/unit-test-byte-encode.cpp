@@ -25,6 +25,72 @@ static void checkUInt32(uint32_t value)
     SLANG_CHECK(readLen == writeLen && decode == value);
 }
 
+static uint32_t _nextEncodeValue(DefaultRandomGenerator& randGen)
+{
+    // Make each encoded length equally likely
+    const uint32_t masks[] = { 0x000000ff, 0x0000ffff, 0x00ffffff, 0xffffffff };
+    return uint32_t(randGen.nextInt32()) & masks[randGen.nextInt32UpTo(4)];
+}
+
+SLANG_UNIT_TEST(byteEncodeStream)
+{
+    DefaultRandomGenerator randGen(0x1f2e3d4c);
+
+    // Round trip random arrays of values, of sizes that cover partial control bytes, and encodings that are too short
+    // to decode any values with SIMD.
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Index count = randGen.nextInt32UpTo(300);
+
+        List<uint32_t> values;
+        values.setCount(count);
+        for (auto& value : values)
+        {
+            value = _nextEncodeValue(randGen);
+        }
+
+        List<uint8_t> encoded;
+        ByteEncodeUtil::encodeStreamUInt32(values.getBuffer(), size_t(count), encoded);
+        SLANG_CHECK(ByteEncodeUtil::calcEncodeStreamSizeUInt32(values.getBuffer(), size_t(count)) == size_t(encoded.getCount()));
+
+        // An extra value to check nothing is written past the end
+        const uint32_t guard = 0xcdcdcdcd;
+
+        List<uint32_t> decoded;
+        decoded.setCount(count + 1);
+        decoded[count] = guard;
+
+        // The SIMD decode must stop before reading past the end of the encoding
+        const size_t decodedSize = ByteEncodeUtil::decodeStreamUInt32(encoded.getBuffer(), size_t(encoded.getCount()), size_t(count), decoded.getBuffer());
+        SLANG_CHECK(decodedSize == size_t(encoded.getCount()));
+        SLANG_CHECK(decoded[count] == guard);
+        decoded.setCount(count);
+        SLANG_CHECK(decoded == values);
+
+        // The scalar decode must give the same result, even if SIMD is available
+        List<uint32_t> scalarDecoded;
+        scalarDecoded.setCount(count);
+        const size_t scalarDecodedSize = ByteEncodeUtil::decodeStreamUInt32Scalar(encoded.getBuffer(), size_t(count), scalarDecoded.getBuffer());
+        SLANG_CHECK(scalarDecodedSize == size_t(encoded.getCount()));
+        SLANG_CHECK(scalarDecoded == values);
+    }
+
+    // The smallest and largest values of each length
+    {
+        const uint32_t values[] = { 0, 0xff, 0x100, 0xffff, 0x10000, 0xffffff, 0x1000000, 0xffffffff, 0, 0xffffffff };
+        const size_t count = SLANG_COUNT_OF(values);
+
+        List<uint8_t> encoded;
+        ByteEncodeUtil::encodeStreamUInt32(values, count, encoded);
+        // 3 control bytes, and 2 values of each length
+        SLANG_CHECK(encoded.getCount() == 3 + 2 * (1 + 2 + 3 + 4) + 1 + 4);
+
+        uint32_t decoded[count];
+        SLANG_CHECK(ByteEncodeUtil::decodeStreamUInt32(encoded.getBuffer(), size_t(encoded.getCount()), count, decoded) == size_t(encoded.getCount()));
+        SLANG_CHECK(memcmp(decoded, values, sizeof(values)) == 0);
+    }
+}
+
 SLANG_UNIT_TEST(byteEncode)
 {
     DefaultRandomGenerator randGen(0x5346536a);
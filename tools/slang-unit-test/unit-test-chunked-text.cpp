@@ -0,0 +1,143 @@
+// unit-test-chunked-text.cpp
+
+#include "source/core/slang-basic.h"
+#include "source/core/slang-random-generator.h"
+#include "source/core/slang-string-util.h"
+#include "source/compiler-core/slang-chunked-text.h"
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <algorithm>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Append `lineCount` lines of random length, ending in a random mix of line breaks
+static void _appendRandomLines(RandomGenerator* randGen, Index lineCount, StringBuilder& out)
+{
+    static const char* const kLineBreaks[] = { "\n", "\r\n", "\r", "\n\r" };
+    for (Index i = 0; i < lineCount; ++i)
+    {
+        const Index length = randGen->nextInt32UpTo(80);
+        for (Index j = 0; j < length; ++j)
+        {
+            out.appendChar(char('a' + randGen->nextInt32UpTo(26)));
+        }
+        out << kLineBreaks[randGen->nextInt32UpTo(SLANG_COUNT_OF(kLineBreaks))];
+    }
+}
+
+    /// Check every query of `text` against the lines `StringUtil::calcLines` finds in `expected`
+static bool _isSameAsFlatText(ChunkedText& text, const String& expected, RandomGenerator* randGen)
+{
+    if (text.getText() != expected || text.getLength() != expected.getLength())
+    {
+        return false;
+    }
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(expected.getUnownedSlice(), lines);
+    if (lines.getCount() == 0)
+    {
+        // Empty text is a single empty line
+        lines.add(UnownedStringSlice());
+    }
+    if (text.getLineCount() != lines.getCount())
+    {
+        return false;
+    }
+
+    List<Index> lineStarts;
+    for (Index i = 0; i < lines.getCount(); ++i)
+    {
+        const Index lineStart = lines[i].begin() ? Index(lines[i].begin() - expected.getBuffer()) : 0;
+        lineStarts.add(lineStart);
+
+        if (text.getLineStart(i) != lineStart ||
+            StringUtil::trimEndOfLine(text.getLineWithEnd(i)) != lines[i])
+        {
+            return false;
+        }
+    }
+
+    // Offsets, including those within line breaks and the end of the text
+    for (Index i = 0; i < 64; ++i)
+    {
+        const Index offset = randGen->nextInt32UpTo(int32_t(expected.getLength() + 1));
+        const Index expectedLine = Index(std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - lineStarts.begin()) - 1;
+
+        Index lineStart = -1;
+        if (text.getLineForOffset(offset, lineStart) != expectedLine || lineStart != lineStarts[expectedLine])
+        {
+            return false;
+        }
+
+        if (offset < expected.getLength())
+        {
+            Index chunkStart = -1;
+            const UnownedStringSlice chunkText = text.getChunkText(offset, chunkStart);
+            if (chunkStart > offset || chunkStart + chunkText.getLength() <= offset ||
+                chunkText != expected.getUnownedSlice().subString(chunkStart, chunkText.getLength()))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // anonymous
+
+// Test that random edits of text held in chunks, with a mix of line breaks, give the same lines and
+// offsets as the same edits of a flat string.
+SLANG_UNIT_TEST(chunkedText)
+{
+    RefPtr<RandomGenerator> randGen = RandomGenerator::create(0x2b7e1516);
+
+    // Large enough to be held in several chunks
+    StringBuilder initialText;
+    _appendRandomLines(randGen, 600, initialText);
+
+    String expected = initialText.produceString();
+    ChunkedText text;
+    text.setText(expected);
+    SLANG_CHECK_ABORT(_isSameAsFlatText(text, expected, randGen));
+
+    for (Index i = 0; i < 500; ++i)
+    {
+        const Index length = expected.getLength();
+        Index startOffset = randGen->nextInt32UpTo(int32_t(length + 1));
+        // Line breaks are most likely to be split or joined wrongly at the boundaries of chunks,
+        // so often edit at, or just before, the start of a chunk
+        if (startOffset < length && randGen->nextInt32UpTo(2))
+        {
+            text.getChunkText(startOffset, startOffset);
+            startOffset = std::max(Index(0), startOffset - randGen->nextInt32UpTo(2));
+        }
+        // Mostly small edits, with some spanning several chunks
+        const Index maxRemoveCount = (i % 16) == 0 ? 10000 : 100;
+        const Index endOffset = std::min(length, startOffset + randGen->nextInt32UpTo(int32_t(maxRemoveCount)));
+
+        // Edits often insert or remove half of a "\r\n", or a line break next to one
+        StringBuilder newText;
+        switch (randGen->nextInt32UpTo(4))
+        {
+            case 0:     break;
+            case 1:     newText << (randGen->nextInt32UpTo(2) ? "\r" : "\n"); break;
+            case 2:     newText << "x"; break;
+            default:    _appendRandomLines(randGen, randGen->nextInt32UpTo(8), newText); break;
+        }
+
+        text.replaceText(startOffset, endOffset, newText.getUnownedSlice());
+
+        StringBuilder editedText;
+        editedText << expected.getUnownedSlice().head(startOffset) << newText << expected.getUnownedSlice().tail(endOffset);
+        expected = editedText.produceString();
+
+        SLANG_CHECK_ABORT(_isSameAsFlatText(text, expected, randGen));
+    }
+
+    // -1 replaces everything, including with nothing at all
+    text.replaceText(-1, -1, UnownedStringSlice());
+    SLANG_CHECK(_isSameAsFlatText(text, String(), randGen));
+}
@@ -0,0 +1,202 @@
+// unit-test-compile-result-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-com-object.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Forwards to another cache, counting the hits and misses
+class CountingCompileResultCache : public ComBaseObject, public slang::ICompileResultCache
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL readEntry(ISlangBlob* key, ISlangBlob** outCode) SLANG_OVERRIDE
+    {
+        const SlangResult res = m_cache->readEntry(key, outCode);
+        ++(SLANG_SUCCEEDED(res) ? m_hitCount : m_missCount);
+        return res;
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeEntry(ISlangBlob* key, ISlangBlob* code) SLANG_OVERRIDE
+    {
+        return m_cache->writeEntry(key, code);
+    }
+
+    CountingCompileResultCache(slang::ICompileResultCache* cache)
+        : m_cache(cache)
+    {
+    }
+
+    Count m_hitCount = 0;
+    Count m_missCount = 0;
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == slang::ICompileResultCache::getTypeGuid())
+        {
+            return static_cast<slang::ICompileResultCache*>(this);
+        }
+        return nullptr;
+    }
+
+    ComPtr<slang::ICompileResultCache> m_cache;
+};
+
+    /// Compile a compute shader returning `value` in a new session, returning the generated code
+static SlangResult _compile(slang::IGlobalSession* globalSession, int value, String& outCode)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    StringBuilder source;
+    source << R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = )" << value << R"(;
+        })";
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSource("compileResultCache", "compileResultCache.slang", StringBlob::create(source).get(), diagnostics.writeRef());
+    if (!module)
+    {
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(componentTypes, SLANG_COUNT_OF(componentTypes), composedProgram.writeRef(), diagnostics.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+
+    outCode = UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize());
+    return SLANG_OK;
+}
+
+    /// Compile the compute shader through a compile request with the command line `args`, returning the code
+    /// for the entry point from the request's program (which uses the cache). The request itself skips code
+    /// generation, otherwise the program would already hold the code.
+static SlangResult _compileRequest(slang::IGlobalSession* globalSession, const List<const char*>& args, String& outCode)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args.getBuffer(), int(args.getCount())));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "compileResultCacheOptions");
+    request->addTranslationUnitSourceString(translationUnitIndex, "compileResultCacheOptions.slang", R"(
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = int(sv_dispatchThreadID.x);
+        })");
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_RETURN_ON_FAIL(request->compile());
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(request->getProgramWithEntryPoints(program.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    ComPtr<slang::IBlob> diagnostics;
+    SLANG_RETURN_ON_FAIL(program->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+
+    outCode = UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize());
+    return SLANG_OK;
+}
+
+} // anonymous
+
+// Test that the code for an entry point is reused by later sessions, that a change to the source
+// isn't given the old code, and that the least recently used entries are discarded.
+SLANG_UNIT_TEST(compileResultCache)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::CompileResultCacheDesc cacheDesc;
+    cacheDesc.maxEntryCount = 1;
+    ComPtr<slang::ICompileResultCache> memoryCache;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileResultCache(cacheDesc, memoryCache.writeRef())));
+
+    ComPtr<CountingCompileResultCache> cache(new CountingCompileResultCache(memoryCache));
+    globalSession->setCompileResultCache(cache);
+
+    String code, cachedCode, changedCode, evictedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(globalSession, 5, code)));
+    SLANG_CHECK(cache->m_hitCount == 0 && cache->m_missCount == 1);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(globalSession, 5, cachedCode)));
+    SLANG_CHECK(cache->m_hitCount == 1 && cache->m_missCount == 1);
+    SLANG_CHECK(code.getLength() > 0 && code == cachedCode);
+
+    // The module has the same name and path, but different source
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(globalSession, 7, changedCode)));
+    SLANG_CHECK(cache->m_hitCount == 1 && cache->m_missCount == 2);
+    SLANG_CHECK(changedCode != code && changedCode.indexOf("7") >= 0);
+
+    // The cache only holds one entry, so the first has been discarded
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(globalSession, 5, evictedCode)));
+    SLANG_CHECK(cache->m_hitCount == 1 && cache->m_missCount == 3);
+    SLANG_CHECK(evictedCode == code);
+
+    globalSession->setCompileResultCache(nullptr);
+}
+
+// Test that changing an option that affects the generated code, but not the source, doesn't reuse
+// the code generated with the option unset.
+SLANG_UNIT_TEST(compileResultCacheOptions)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<slang::ICompileResultCache> memoryCache;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createCompileResultCache(slang::CompileResultCacheDesc(), memoryCache.writeRef())));
+
+    ComPtr<CountingCompileResultCache> cache(new CountingCompileResultCache(memoryCache));
+    globalSession->setCompileResultCache(cache);
+
+    List<const char*> args;
+    args.addRange({ "-target", "hlsl", "-profile", "sm_5_0", "-skip-codegen" });
+
+    String code, cachedCode, obfuscatedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileRequest(globalSession, args, code)));
+    SLANG_CHECK(cache->m_hitCount == 0 && cache->m_missCount == 1);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileRequest(globalSession, args, cachedCode)));
+    SLANG_CHECK(cache->m_hitCount == 1 && cache->m_missCount == 1);
+    SLANG_CHECK(code.getLength() > 0 && code == cachedCode);
+
+    // Obfuscation only changes the names in the generated code
+    args.add("-obfuscate");
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileRequest(globalSession, args, obfuscatedCode)));
+    SLANG_CHECK(cache->m_hitCount == 1 && cache->m_missCount == 2);
+
+    globalSession->setCompileResultCache(nullptr);
+}
@@ -0,0 +1,91 @@
+// unit-test-cpu-vectorize-width.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Compile the test kernel to C++ source with the `-cpu-vectorize-width` given by `laneCount` (or without it if nullptr)
+static String _compileToCPP(const char* laneCount)
+{
+    const char* testSource = R"(
+        RWStructuredBuffer<float> gOutput;
+
+        [numthreads(64, 2, 1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            float value = float(id.x);
+            if (id.x % 3 == 0)
+                value *= 2.0;
+            gOutput[id.y * 64 + id.x] = value;
+        })";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-target", "cpp", "-cpu-vectorize-width", laneCount };
+    const int argCount = laneCount ? 4 : 2;
+
+    String source;
+    if (SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, argCount)))
+    {
+        int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+        spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+        spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        if (SLANG_SUCCEEDED(spCompile(request)))
+        {
+            source = spGetEntryPointSource(request, 0);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return source;
+}
+
+} // anonymous
+
+// Test that `-cpu-vectorize-width` runs the threads of a group in gangs of that width, and marks the loop over a
+// gang with auto-vectorization hints
+SLANG_UNIT_TEST(cpuVectorizeWidth)
+{
+    const String gangSource = _compileToCPP("8");
+    SLANG_CHECK_ABORT(gangSource.getLength() > 0);
+
+    // The threads along x are run in 8 gangs of 8, with its own copy of the varying input for each thread
+    SLANG_CHECK(gangSource.indexOf(toSlice("for (uint32_t xGang = 0; xGang < 64; xGang += 8)")) >= 0);
+    SLANG_CHECK(gangSource.indexOf(toSlice("SLANG_VECTORIZE_THREAD_LOOP(8)")) >= 0);
+    SLANG_CHECK(gangSource.indexOf(toSlice("for (uint32_t lane = 0; lane < 8; ++lane)")) >= 0);
+    SLANG_CHECK(gangSource.indexOf(toSlice("laneInput.groupThreadID.x = xGang + lane;")) >= 0);
+    // There are no threads left over
+    SLANG_CHECK(gangSource.indexOf(toSlice("; x < 64; ++x)")) < 0);
+
+    // A width that doesn't divide the group size runs the threads left over one at a time
+    const String remainderSource = _compileToCPP("3");
+    SLANG_CHECK_ABORT(remainderSource.getLength() > 0);
+    SLANG_CHECK(remainderSource.indexOf(toSlice("for (uint32_t xGang = 0; xGang < 63; xGang += 3)")) >= 0);
+    SLANG_CHECK(remainderSource.indexOf(toSlice("for (uint32_t x = 63; x < 64; ++x)")) >= 0);
+
+    // A width larger than the group runs the threads one at a time
+    const String wideSource = _compileToCPP("128");
+    SLANG_CHECK_ABORT(wideSource.getLength() > 0);
+    SLANG_CHECK(wideSource.indexOf(toSlice("laneInput")) < 0);
+
+    // By default the threads are run one at a time
+    const String scalarSource = _compileToCPP(nullptr);
+    SLANG_CHECK_ABORT(scalarSource.getLength() > 0);
+    SLANG_CHECK(scalarSource.indexOf(toSlice("laneInput")) < 0);
+
+    // Lane counts less than 1 are rejected
+    SLANG_CHECK(_compileToCPP("0").getLength() == 0);
+    SLANG_CHECK(_compileToCPP("-4").getLength() == 0);
+}
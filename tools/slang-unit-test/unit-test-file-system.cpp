@@ -15,6 +15,8 @@
 
 #include "tools/unit-test/slang-unit-test.h"
 
+#include <thread>
+
 using namespace Slang;
 
 namespace { // anonymous
@@ -478,6 +480,28 @@ static SlangResult _test(FileSystemType type)
 
 		// Check the file systems contents are the same
 		SLANG_RETURN_ON_FAIL(_checkEqual(loadedFileSystem, fileSystem));
+
+		// Load it from a file, which for RIFF archives is memory mapped, and read-only
+		String archivePath;
+		SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-archive"), archivePath));
+		SLANG_RETURN_ON_FAIL(File::writeAllBytes(archivePath, archiveBlob->getBufferPointer(), archiveBlob->getBufferSize()));
+
+		ComPtr<ISlangFileSystemExt> mappedFileSystem;
+		const SlangResult loadResult = loadArchiveFileSystemFromFile(archivePath, mappedFileSystem);
+
+		// The file can be removed whilst it is mapped
+		File::remove(archivePath);
+		SLANG_RETURN_ON_FAIL(loadResult);
+
+		// The second check loads decompressed files from the cache
+		SLANG_RETURN_ON_FAIL(_checkEqual(mappedFileSystem, fileSystem));
+		SLANG_RETURN_ON_FAIL(_checkEqual(mappedFileSystem, fileSystem));
+
+		if (type != FileSystemType::Zip)
+		{
+			auto mutableFileSystem = as<ISlangMutableFileSystem>(mappedFileSystem);
+			SLANG_CHECK(mutableFileSystem && SLANG_FAILED(mutableFileSystem->saveFile("c", "c", 1)));
+		}
 	}
 
 	SLANG_RETURN_ON_FAIL(fileSystem->remove("d/a"));
@@ -528,3 +552,77 @@ SLANG_UNIT_TEST(fileSystem)
 	}
 }
 
+
+static ComPtr<ISlangBlob> _loadFile(ISlangFileSystem* fileSystem, const char* path)
+{
+	ComPtr<ISlangBlob> blob;
+	fileSystem->loadFile(path, blob.writeRef());
+	return blob;
+}
+
+// Test that the decompressed files of a read-only RIFF archive are cached, dropping the least recently
+// used first, and that they can be loaded from more than one thread at a time.
+SLANG_UNIT_TEST(riffFileSystemDecompressedCache)
+{
+	const size_t fileSize = 1000;
+	const char* const paths[] = { "a", "b", "c" };
+
+	ComPtr<ISlangMutableFileSystem> writeFileSystem(new RiffFileSystem(LZ4CompressionSystem::getSingleton()));
+	for (Index i = 0; i < SLANG_COUNT_OF(paths); ++i)
+	{
+		List<char> contents;
+		contents.setCount(fileSize);
+		::memset(contents.getBuffer(), 'a' + int(i), fileSize);
+		SLANG_CHECK_ABORT(SLANG_SUCCEEDED(writeFileSystem->saveFile(paths[i], contents.getBuffer(), fileSize)));
+	}
+
+	ComPtr<ISlangBlob> archiveBlob;
+	SLANG_CHECK_ABORT(SLANG_SUCCEEDED(as<IArchiveFileSystem>(writeFileSystem)->storeArchive(false, archiveBlob.writeRef())));
+
+	RiffFileSystem* riffFileSystem = new RiffFileSystem(nullptr);
+	ComPtr<ISlangFileSystemExt> fileSystem(riffFileSystem);
+	SLANG_CHECK_ABORT(SLANG_SUCCEEDED(riffFileSystem->loadArchiveBlob(archiveBlob)));
+
+	// Room for two of the files
+	riffFileSystem->setDecompressedCacheSize(fileSize * 2 + fileSize / 2);
+
+	ComPtr<ISlangBlob> a = _loadFile(fileSystem, "a");
+	ComPtr<ISlangBlob> b = _loadFile(fileSystem, "b");
+	SLANG_CHECK_ABORT(a && b && a->getBufferSize() == fileSize && ((const char*)b->getBufferPointer())[0] == 'b');
+
+	// Loading again returns the cached blob, and makes "a" the most recently used
+	SLANG_CHECK(_loadFile(fileSystem, "a") == a);
+
+	// So adding "c" drops "b"
+	SLANG_CHECK(_loadFile(fileSystem, "c") != nullptr);
+	SLANG_CHECK(_loadFile(fileSystem, "a") == a);
+	SLANG_CHECK(_loadFile(fileSystem, "b") != b);
+
+	// Every thread must see the same contents, whilst the cache is changed by the others
+	riffFileSystem->clearCache();
+	bool threadsSucceeded[4] = {};
+	List<std::thread> threads;
+	for (Index i = 0; i < SLANG_COUNT_OF(threadsSucceeded); ++i)
+	{
+		threads.add(std::thread([&, i]()
+			{
+				bool succeeded = true;
+				for (Index j = 0; j < 1000; ++j)
+				{
+					const Index pathIndex = (i + j) % SLANG_COUNT_OF(paths);
+					ComPtr<ISlangBlob> blob = _loadFile(fileSystem, paths[pathIndex]);
+					succeeded = succeeded && blob && blob->getBufferSize() == fileSize &&
+						((const char*)blob->getBufferPointer())[fileSize - 1] == 'a' + int(pathIndex);
+				}
+				threadsSucceeded[i] = succeeded;
+			}));
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	for (bool succeeded : threadsSucceeded)
+	{
+		SLANG_CHECK(succeeded);
+	}
+}
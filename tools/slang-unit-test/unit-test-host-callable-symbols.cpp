@@ -0,0 +1,85 @@
+// unit-test-host-callable-symbols.cpp
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../slang.h"
+#include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Compile a module that exports `getValue`, returning `value`, and `callGetValue`, which calls it,
+    /// into a host callable library
+static SlangResult _compileLibrary(slang::IGlobalSession* session, int value, ComPtr<ISlangSharedLibrary>& outLibrary)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+
+    const int targetIndex = request->addCodeGenTarget(SLANG_SHADER_HOST_CALLABLE);
+    request->setTargetFlags(targetIndex, SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM);
+    // Without optimization the call isn't inlined, so it goes through the exported symbol
+    request->setOptimizationLevel(SLANG_OPTIMIZATION_LEVEL_NONE);
+
+    StringBuilder source;
+    source << "export __extern_cpp int getValue() { return " << value << "; }\n";
+    source << "export __extern_cpp int callGetValue() { return getValue(); }\n";
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "host-callable-symbols.slang", source.getBuffer());
+
+    SLANG_RETURN_ON_FAIL(request->compile());
+    return request->getTargetHostCallable(0, outLibrary.writeRef());
+}
+
+static int _callGetValue(ISlangSharedLibrary* library)
+{
+    typedef int (*Func)();
+    const auto func = (Func)library->findFuncByName("callGetValue");
+    return func ? func() : -1;
+}
+
+} // anonymous
+
+// Test that host callable libraries that export the same names, and are loaded at the same time,
+// each call their own functions. The libraries are loaded with RTLD_GLOBAL on Linux, so without
+// -Bsymbolic the second library's `callGetValue` would call the first library's `getValue`.
+SLANG_UNIT_TEST(hostCallableSymbols)
+{
+    slang::IGlobalSession* session = unitTestContext->slangGlobalSession;
+
+    // Only the gcc family of compilers produce shared libraries that can interpose on each other
+    SlangPassThrough cppCompiler = SLANG_PASS_THROUGH_NONE;
+    for (const auto compiler : { SLANG_PASS_THROUGH_GCC, SLANG_PASS_THROUGH_CLANG })
+    {
+        if (SLANG_SUCCEEDED(session->checkPassThroughSupport(compiler)))
+        {
+            cppCompiler = compiler;
+            break;
+        }
+    }
+    if (cppCompiler == SLANG_PASS_THROUGH_NONE)
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    const SlangPassThrough previousCompiler =
+        session->getDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE);
+    session->setDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE, cppCompiler);
+
+    ComPtr<ISlangSharedLibrary> firstLibrary;
+    ComPtr<ISlangSharedLibrary> secondLibrary;
+    const SlangResult firstResult = _compileLibrary(session, 1, firstLibrary);
+    const SlangResult secondResult = _compileLibrary(session, 2, secondLibrary);
+
+    session->setDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE, previousCompiler);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(firstResult) && SLANG_SUCCEEDED(secondResult));
+
+    // Both are loaded, so the second's calls could be bound to the first's definitions
+    SLANG_CHECK(_callGetValue(firstLibrary) == 1);
+    SLANG_CHECK(_callGetValue(secondLibrary) == 2);
+}
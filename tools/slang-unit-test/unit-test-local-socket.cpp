@@ -0,0 +1,96 @@
+// unit-test-local-socket.cpp
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../source/compiler-core/slang-local-socket.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+#if !SLANG_WINDOWS_FAMILY
+#   include <sys/stat.h>
+#endif
+
+using namespace Slang;
+
+// The path of a socket is limited to around 100 characters, so keep the name short
+static String _getSocketPath()
+{
+    return Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/sock" + String(Process::getId()));
+}
+
+static SlangResult _readMessage(LocalSocketStream* stream, String& outMessage)
+{
+    outMessage = String();
+    char buffer[64];
+    size_t readBytes = 0;
+    while (readBytes == 0)
+    {
+        SLANG_RETURN_ON_FAIL(stream->waitForRead(1000));
+        SLANG_RETURN_ON_FAIL(stream->read(buffer, sizeof(buffer), readBytes));
+        if (stream->isEnd())
+        {
+            break;
+        }
+    }
+    outMessage = UnownedStringSlice(buffer, readBytes);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(localSocket)
+{
+    const String path = _getSocketPath();
+
+    RefPtr<LocalSocketServer> server;
+    if (SLANG_FAILED(LocalSocketServer::create(path, server)))
+    {
+        // Unix domain sockets aren't available on older versions of Windows
+        SLANG_IGNORE_TEST
+    }
+
+#if !SLANG_WINDOWS_FAMILY
+    // Only the user running the server can connect to it
+    {
+        struct stat info;
+        SLANG_CHECK(::stat(path.getBuffer(), &info) == 0);
+        SLANG_CHECK((info.st_mode & 0777) == 0600);
+    }
+#endif
+
+    // Nothing is waiting to connect
+    RefPtr<LocalSocketStream> serverStream;
+    SLANG_CHECK(SLANG_SUCCEEDED(server->accept(0, serverStream)));
+    SLANG_CHECK(serverStream == nullptr);
+
+    RefPtr<LocalSocketStream> clientStream;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(LocalSocketStream::connect(path, clientStream)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(server->accept(1000, serverStream)));
+    SLANG_CHECK_ABORT(serverStream);
+
+    // Messages go both ways
+    String message;
+    SLANG_CHECK(SLANG_SUCCEEDED(clientStream->write("request", 7)));
+    SLANG_CHECK(SLANG_SUCCEEDED(_readMessage(serverStream, message)));
+    SLANG_CHECK(message == "request");
+
+    SLANG_CHECK(SLANG_SUCCEEDED(serverStream->write("response", 8)));
+    SLANG_CHECK(SLANG_SUCCEEDED(_readMessage(clientStream, message)));
+    SLANG_CHECK(message == "response");
+
+    // The server sees the client go away
+    clientStream->close();
+    SLANG_CHECK(SLANG_SUCCEEDED(_readMessage(serverStream, message)));
+    SLANG_CHECK(message.getLength() == 0 && serverStream->isEnd());
+
+    // Closing the server removes its socket, after which there is nothing to connect to
+    server->close();
+    SLANG_CHECK(!File::exists(path));
+    SLANG_CHECK(SLANG_FAILED(LocalSocketStream::connect(path, clientStream)));
+
+#if !SLANG_WINDOWS_FAMILY
+    // A file that isn't a socket is never replaced
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllText(path, "not a socket")));
+    SLANG_CHECK(SLANG_FAILED(LocalSocketServer::create(path, server)));
+    SLANG_CHECK(File::exists(path));
+    File::remove(path);
+#endif
+}
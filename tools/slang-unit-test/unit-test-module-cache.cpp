@@ -0,0 +1,274 @@
+// unit-test-module-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-file-system.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CacheCounts
+{
+    SlangInt hitCount = 0;
+    SlangInt missCount = 0;
+};
+
+static const char* kMainSource = R"(
+    [shader("compute")]
+    [numthreads(4,1,1)]
+    void computeMain(
+        uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+        uniform RWStructuredBuffer<int> buffer)
+    {
+        buffer[sv_dispatchThreadID.x] = getValue();
+    })";
+
+struct ModuleCacheTest
+{
+    ModuleCacheTest(slang::IGlobalSession* globalSession)
+        : m_globalSession(globalSession)
+    {
+        // Everything is written to a new directory, rather than the working directory
+        if (SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-module-cache-test"), m_directory)))
+        {
+            File::remove(m_directory);
+            Path::createDirectory(m_directory);
+        }
+        m_cacheDirectory = Path::combine(m_directory, "cache");
+    }
+
+    ~ModuleCacheTest()
+    {
+        // Remove all the files the test and the cache created, and the directories
+        _removeDirectory(m_cacheDirectory);
+        _removeDirectory(m_directory);
+    }
+
+    static void _removeDirectory(const String& directory)
+    {
+        auto fileSystem = OSFileSystem::getMutableSingleton();
+
+        List<String> paths;
+        fileSystem->enumeratePathContents(
+            directory.getBuffer(),
+            [](SlangPathType type, const char* fileName, void* userData)
+            {
+                if (type == SLANG_PATH_TYPE_FILE)
+                {
+                    static_cast<List<String>*>(userData)->add(fileName);
+                }
+            },
+            &paths);
+        for (const auto& fileName : paths)
+        {
+            fileSystem->remove(Path::combine(directory, fileName).getBuffer());
+        }
+        fileSystem->remove(directory.getBuffer());
+    }
+
+    void writeModule(const char* moduleName, const String& source)
+    {
+        File::writeAllText(Path::combine(m_directory, String(moduleName) + ".slang"), source);
+    }
+
+    void removeModule(const char* moduleName)
+    {
+        File::remove(Path::combine(m_directory, String(moduleName) + ".slang"));
+    }
+
+        /// Write a main module that uses `getValue` from an imported module
+    void writeSources(int value, bool hasWarning = false)
+    {
+        StringBuilder importedSource;
+        importedSource << "public int getValue() { return " << value << "; }\n";
+        if (hasWarning)
+        {
+            // Warning 30081, implicit conversion from 'bool' to 'float' is not recommended
+            importedSource << "public float getWarningValue() { float f = true; return f; }\n";
+        }
+        writeModule("moduleCacheImported", importedSource);
+
+        StringBuilder mainSource;
+        mainSource << "import moduleCacheImported;\n" << kMainSource;
+        writeModule("moduleCacheMain", mainSource);
+    }
+
+        /// Compile the main module in a new session, returning the generated code
+    SlangResult compile(String& outCode)
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = m_globalSession->findProfile("sm_5_0");
+
+        const char* searchPaths[] = { m_directory.getBuffer() };
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.targetCount = 1;
+        sessionDesc.searchPaths = searchPaths;
+        sessionDesc.searchPathCount = SLANG_COUNT_OF(searchPaths);
+        sessionDesc.moduleCacheDirectory = m_cacheDirectory.getBuffer();
+
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(m_globalSession->createSession(sessionDesc, session.writeRef()));
+
+        ComPtr<slang::IBlob> diagnostics;
+        auto module = session->loadModule("moduleCacheMain", diagnostics.writeRef());
+        if (!module)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+        slang::IComponentType* componentTypes[] = { module, entryPoint };
+        ComPtr<slang::IComponentType> composedProgram;
+        SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(componentTypes, SLANG_COUNT_OF(componentTypes), composedProgram.writeRef(), diagnostics.writeRef()));
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+
+        ComPtr<slang::IBlob> code;
+        SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+
+        outCode = UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize());
+        return SLANG_OK;
+    }
+
+        /// Compile a translation unit that imports the main module (so every module comes through
+        /// the cache) as slangc would, returning the diagnostics
+    SlangResult compileRequest(bool warningsAsErrors, String& outDiagnostics)
+    {
+        List<const char*> args;
+        args.addRange({ "-target", "hlsl", "-profile", "sm_5_0" });
+        args.addRange({ "-I", m_directory.getBuffer(), "-module-cache-path", m_cacheDirectory.getBuffer() });
+        if (warningsAsErrors)
+        {
+            args.addRange({ "-warnings-as-errors", "all" });
+        }
+
+        auto request = spCreateCompileRequest(m_globalSession);
+        SlangResult result = spProcessCommandLineArguments(request, args.getBuffer(), int(args.getCount()));
+        if (SLANG_SUCCEEDED(result))
+        {
+            int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu");
+            spAddTranslationUnitSourceString(request, tuIndex, "tu.slang", "import moduleCacheMain;\n");
+            result = spCompile(request);
+        }
+        outDiagnostics = spGetDiagnosticOutput(request);
+        spDestroyCompileRequest(request);
+        return result;
+    }
+
+        /// Get the number of modules loaded from, and added to, the cache since the last call
+    CacheCounts takeCacheCounts()
+    {
+        CacheCounts counts;
+        m_globalSession->getModuleCacheCounts(&counts.hitCount, &counts.missCount);
+
+        CacheCounts delta;
+        delta.hitCount = counts.hitCount - m_cacheCounts.hitCount;
+        delta.missCount = counts.missCount - m_cacheCounts.missCount;
+        m_cacheCounts = counts;
+        return delta;
+    }
+
+    slang::IGlobalSession* m_globalSession;
+    CacheCounts m_cacheCounts;
+
+    String m_directory;
+    String m_cacheDirectory;
+};
+
+} // anonymous
+
+// Test that modules loaded from the module cache produce the same code as when compiled from source,
+// and that a change to an imported module is picked up.
+SLANG_UNIT_TEST(moduleCache)
+{
+    ModuleCacheTest test(unitTestContext->slangGlobalSession);
+    test.takeCacheCounts();
+
+    test.writeSources(5);
+
+    // The first compile populates the cache with both modules
+    String sourceCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile(sourceCode)));
+    CacheCounts counts = test.takeCacheCounts();
+    SLANG_CHECK(counts.hitCount == 0 && counts.missCount == 2);
+
+    // The second loads both of them from the cache
+    String cachedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile(cachedCode)));
+    counts = test.takeCacheCounts();
+    SLANG_CHECK(counts.hitCount == 2 && counts.missCount == 0);
+    SLANG_CHECK(sourceCode.getLength() > 0 && sourceCode == cachedCode);
+
+    // Changing the imported module must invalidate both cached modules
+    test.writeSources(7);
+
+    String changedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile(changedCode)));
+    counts = test.takeCacheCounts();
+    SLANG_CHECK(counts.hitCount == 0 && counts.missCount == 2);
+    SLANG_CHECK(changedCode != sourceCode);
+    SLANG_CHECK(changedCode.indexOf("7") >= 0);
+}
+
+// Test that the diagnostics of a module are reported again when it is loaded from the cache,
+// with the options of the compile that loads it.
+SLANG_UNIT_TEST(moduleCacheDiagnostics)
+{
+    ModuleCacheTest test(unitTestContext->slangGlobalSession);
+    test.takeCacheCounts();
+
+    test.writeSources(5, true);
+
+    String sourceDiagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compileRequest(false, sourceDiagnostics)));
+    SLANG_CHECK(test.takeCacheCounts().missCount == 2);
+    SLANG_CHECK(sourceDiagnostics.indexOf("warning 30081") >= 0);
+
+    String cachedDiagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compileRequest(false, cachedDiagnostics)));
+    SLANG_CHECK(test.takeCacheCounts().hitCount == 2);
+    SLANG_CHECK(cachedDiagnostics == sourceDiagnostics);
+
+    // The entries were written without -warnings-as-errors, which must still apply to them
+    String errorDiagnostics;
+    SLANG_CHECK(SLANG_FAILED(test.compileRequest(true, errorDiagnostics)));
+    SLANG_CHECK(errorDiagnostics.indexOf("error 30081") >= 0);
+}
+
+// Test that an entry listing an import that no longer exists falls back to compiling from source,
+// without reporting the failed import.
+SLANG_UNIT_TEST(moduleCacheStaleImport)
+{
+    ModuleCacheTest test(unitTestContext->slangGlobalSession);
+    test.takeCacheCounts();
+
+    // The main module depends on moduleCacheRemoved through moduleCacheImported
+    test.writeModule("moduleCacheRemoved", "public int getRemovedValue() { return 3; }\n");
+    test.writeModule("moduleCacheImported", "import moduleCacheRemoved;\npublic int getValue() { return getRemovedValue(); }\n");
+    test.writeModule("moduleCacheMain", String("import moduleCacheImported;\n") + kMainSource);
+
+    String diagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compileRequest(false, diagnostics)));
+    SLANG_CHECK(test.takeCacheCounts().missCount == 3);
+
+    // The main module is unchanged, so its entry is found, but the import it lists is gone
+    test.removeModule("moduleCacheRemoved");
+    test.writeModule("moduleCacheImported", "public int getValue() { return 4; }\n");
+
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compileRequest(false, diagnostics)));
+    SLANG_CHECK(diagnostics.getLength() == 0);
+    SLANG_CHECK(test.takeCacheCounts().missCount == 2);
+}
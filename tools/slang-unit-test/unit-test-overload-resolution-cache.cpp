@@ -0,0 +1,77 @@
+// unit-test-overload-resolution-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CacheCounts
+{
+    SlangInt hitCount = 0;
+    SlangInt missCount = 0;
+};
+
+static CacheCounts _getCacheCounts(slang::IGlobalSession* globalSession)
+{
+    CacheCounts counts;
+    globalSession->getOverloadResolutionCacheCounts(&counts.hitCount, &counts.missCount);
+    return counts;
+}
+
+    /// Load a module that calls overloaded stdlib functions in a new session
+static SlangResult _loadModule(slang::IGlobalSession* globalSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    // There are no operators, so all of the cached calls are to named functions
+    const char source[] = R"(
+        float3 f(float3 a, float3 b, float3 t) { return lerp(a, b, t); }
+        float g(float3 a, float3 b) { return dot(a, b); }
+        float3 h(float3 a) { return saturate(a); }
+        float3 k(float3 a, float3 b, float3 t) { return lerp(b, a, t); }
+        )";
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSource("overloadResolutionCache", "overloadResolutionCache.slang", StringBlob::create(source).get(), diagnostics.writeRef());
+    return module ? SLANG_OK : SLANG_FAIL;
+}
+
+} // anonymous
+
+// Test that resolving a call to an overloaded stdlib function is reused within a session,
+// and by later sessions of the same global session.
+SLANG_UNIT_TEST(overloadResolutionCache)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    const CacheCounts startCounts = _getCacheCounts(globalSession);
+
+    // Every call is cacheable. The second `lerp` call is always found in the cache.
+    SLANG_CHECK(SLANG_SUCCEEDED(_loadModule(globalSession)));
+    const CacheCounts firstCounts = _getCacheCounts(globalSession);
+    SLANG_CHECK(firstCounts.hitCount - startCounts.hitCount >= 1);
+    SLANG_CHECK((firstCounts.hitCount + firstCounts.missCount) - (startCounts.hitCount + startCounts.missCount) >= 4);
+
+    // A new session finds every call in the cache
+    SLANG_CHECK(SLANG_SUCCEEDED(_loadModule(globalSession)));
+    const CacheCounts secondCounts = _getCacheCounts(globalSession);
+    SLANG_CHECK(secondCounts.hitCount - firstCounts.hitCount >= 4);
+    SLANG_CHECK(secondCounts.missCount == firstCounts.missCount);
+}
@@ -0,0 +1,175 @@
+// unit-test-parallel-downstream-compile.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const char* kTestSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    float4 vertexMain(float4 position : POSITION) : SV_Position
+    {
+        return position;
+    }
+
+    float4 fragmentMain(float4 position : SV_Position) : SV_Target
+    {
+        return position * 2.0;
+    }
+
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        outputBuffer[dispatchThreadID.x] = float(dispatchThreadID.x);
+    }
+
+    [numthreads(4, 1, 1)]
+    void scaleMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        outputBuffer[dispatchThreadID.x] *= 2.0;
+    })";
+
+struct EntryPoint
+{
+    const char* name;
+    SlangStage stage;
+};
+
+struct CompileOutput
+{
+    SlangResult result = SLANG_FAIL;
+    String diagnostics;
+        /// The code for each entry point of each target, in target then entry point order
+    List<ComPtr<ISlangBlob>> codeBlobs;
+};
+
+    /// Compile `entryPoints` of the test source for every target in `targetArgs`, serially or with
+    /// `SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE`
+static CompileOutput _compile(SlangSession* session, const List<const char*>& targetArgs, Index targetCount, const List<EntryPoint>& entryPoints, bool parallel)
+{
+    CompileOutput output;
+    auto request = spCreateCompileRequest(session);
+    if (SLANG_SUCCEEDED(spProcessCommandLineArguments(request, targetArgs.getBuffer(), int(targetArgs.getCount()))))
+    {
+        if (parallel)
+        {
+            spSetCompileFlags(request, spGetCompileFlags(request) | SLANG_COMPILE_FLAG_PARALLEL_DOWNSTREAM_COMPILE);
+        }
+
+        int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+        spAddTranslationUnitSourceString(request, tuIndex, "internalFile", kTestSource);
+        for (const auto& entryPoint : entryPoints)
+        {
+            spAddEntryPoint(request, tuIndex, entryPoint.name, entryPoint.stage);
+        }
+
+        output.result = spCompile(request);
+        output.diagnostics = spGetDiagnosticOutput(request);
+
+        for (Index targetIndex = 0; SLANG_SUCCEEDED(output.result) && targetIndex < targetCount; ++targetIndex)
+        {
+            for (Index entryPointIndex = 0; entryPointIndex < entryPoints.getCount(); ++entryPointIndex)
+            {
+                ComPtr<ISlangBlob> blob;
+                spGetEntryPointCodeBlob(request, int(entryPointIndex), int(targetIndex), blob.writeRef());
+                output.codeBlobs.add(blob);
+            }
+        }
+    }
+    spDestroyCompileRequest(request);
+    return output;
+}
+
+static bool _isSameCode(ISlangBlob* a, ISlangBlob* b)
+{
+    return a && b &&
+        a->getBufferSize() == b->getBufferSize() &&
+        ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+    /// Check that compiling in parallel gives the same result and diagnostics as compiling serially. If `isCodeDeterministic`
+    /// the code must be the same too, otherwise it just has to be output for every target and entry point.
+static void _checkParallelMatchesSerial(SlangSession* session, const List<const char*>& targetArgs, Index targetCount, const List<EntryPoint>& entryPoints, bool isCodeDeterministic)
+{
+    const CompileOutput serial = _compile(session, targetArgs, targetCount, entryPoints, false);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(serial.result));
+
+    // Run it a few times, as the order the compiles complete in varies
+    for (Index i = 0; i < 4; ++i)
+    {
+        const CompileOutput parallel = _compile(session, targetArgs, targetCount, entryPoints, true);
+        SLANG_CHECK(SLANG_SUCCEEDED(parallel.result));
+        SLANG_CHECK(parallel.diagnostics == serial.diagnostics);
+        SLANG_CHECK_ABORT(parallel.codeBlobs.getCount() == serial.codeBlobs.getCount());
+        for (Index j = 0; j < serial.codeBlobs.getCount(); ++j)
+        {
+            if (isCodeDeterministic)
+            {
+                SLANG_CHECK(_isSameCode(parallel.codeBlobs[j], serial.codeBlobs[j]));
+            }
+            else
+            {
+                SLANG_CHECK(parallel.codeBlobs[j] && parallel.codeBlobs[j]->getBufferSize() > 0);
+            }
+        }
+    }
+}
+
+} // anonymous
+
+// Test that compiling with the downstream compiles run in parallel produces the same code and
+// diagnostics, for every target and entry point, as compiling serially.
+SLANG_UNIT_TEST(parallelDownstreamCompile)
+{
+    auto session = spCreateSession();
+    bool hasCompiler = false;
+
+    // Use every downstream compiler for a GPU target that is available
+    List<const char*> targetArgs;
+    Index targetCount = 0;
+    if (SLANG_SUCCEEDED(spSessionCheckPassThroughSupport(session, SLANG_PASS_THROUGH_GLSLANG)))
+    {
+        targetArgs.addRange({ "-target", "spirv", "-profile", "glsl_450", "-emit-spirv-via-glsl" });
+        ++targetCount;
+    }
+    if (SLANG_SUCCEEDED(spSessionCheckPassThroughSupport(session, SLANG_PASS_THROUGH_DXC)))
+    {
+        targetArgs.addRange({ "-target", "dxil", "-profile", "sm_6_0" });
+        ++targetCount;
+    }
+    if (targetCount > 0)
+    {
+        const EntryPoint entryPointArray[] = {
+            { "vertexMain", SLANG_STAGE_VERTEX }, { "fragmentMain", SLANG_STAGE_FRAGMENT }, { "computeMain", SLANG_STAGE_COMPUTE } };
+        List<EntryPoint> entryPoints;
+        entryPoints.addRange(entryPointArray, SLANG_COUNT_OF(entryPointArray));
+        _checkParallelMatchesSerial(session, targetArgs, targetCount, entryPoints, true);
+        hasCompiler = true;
+    }
+
+    // The C++ compiler is passed a temporary file, whose name may end up in the shared library,
+    // so only the result and diagnostics are compared
+    if (SLANG_SUCCEEDED(spSessionCheckPassThroughSupport(session, SLANG_PASS_THROUGH_GENERIC_C_CPP)))
+    {
+        List<const char*> cppTargetArgs;
+        cppTargetArgs.addRange({ "-target", "sharedlib" });
+        const EntryPoint entryPointArray[] = { { "computeMain", SLANG_STAGE_COMPUTE }, { "scaleMain", SLANG_STAGE_COMPUTE } };
+        List<EntryPoint> entryPoints;
+        entryPoints.addRange(entryPointArray, SLANG_COUNT_OF(entryPointArray));
+        _checkParallelMatchesSerial(session, cppTargetArgs, 1, entryPoints, false);
+        hasCompiler = true;
+    }
+
+    spDestroySession(session);
+    if (!hasCompiler)
+    {
+        SLANG_IGNORE_TEST
+    }
+}
@@ -0,0 +1,144 @@
+// unit-test-performance-profiler.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../source/core/slang-performance-profiler.h"
+#include "../../source/core/slang-string.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const char* kTestSource = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+    {
+        outputBuffer[dispatchThreadID.x] = float(dispatchThreadID.x);
+    })";
+
+static SlangResult _compile(SlangSession* session, bool reportPerfBenchmark)
+{
+    const char* args[] = { "-target", "hlsl", "-profile", "sm_5_0", "-report-perf-benchmark" };
+    const int argCount = reportPerfBenchmark ? SLANG_COUNT_OF(args) : SLANG_COUNT_OF(args) - 1;
+
+    auto request = spCreateCompileRequest(session);
+    SlangResult result = spProcessCommandLineArguments(request, args, argCount);
+    if (SLANG_SUCCEEDED(result))
+    {
+        int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+        spAddTranslationUnitSourceString(request, tuIndex, "internalFile", kTestSource);
+        spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+        result = spCompile(request);
+    }
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+    /// True if the profiler has recorded any sections
+static bool _hasRecordedSections(slang::IGlobalSession* session)
+{
+    ComPtr<ISlangBlob> trace;
+    if (SLANG_FAILED(session->getPerformanceTrace(trace.writeRef())))
+    {
+        return false;
+    }
+    const UnownedStringSlice text((const char*)trace->getBufferPointer(), trace->getBufferSize());
+    return text.indexOf(toSlice("\"ph\":\"X\"")) >= 0;
+}
+
+    /// True if the trace of `profiler` has a section called `name` that has been exited
+static bool _hasExitedSection(PerformanceProfiler* profiler, const char* name)
+{
+    StringBuilder trace;
+    profiler->writeChromeTrace(trace);
+    StringBuilder nameField;
+    nameField << "\"name\":\"" << name << "\"";
+    return trace.indexOf(nameField) >= 0;
+}
+
+} // anonymous
+
+// Test that -report-perf-benchmark only enables the profiler whilst its request is compiled,
+// and that the trace can be read whilst another thread is recording.
+SLANG_UNIT_TEST(performanceProfiler)
+{
+    auto session = spCreateSession();
+
+    session->setPerformanceProfilingEnabled(false);
+    session->clearPerformanceTrace();
+
+    // The request enables recording for its own compile
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, true)));
+    SLANG_CHECK(_hasRecordedSections(session));
+
+    // ... and disables it again afterwards
+    session->clearPerformanceTrace();
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, false)));
+    SLANG_CHECK(!_hasRecordedSections(session));
+
+    // If the application enabled it, it stays enabled
+    session->setPerformanceProfilingEnabled(true);
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, true)));
+    session->clearPerformanceTrace();
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, false)));
+    SLANG_CHECK(_hasRecordedSections(session));
+
+    // Read the trace whilst the compiles are recording
+    {
+        std::atomic<bool> isDone{ false };
+        std::thread reader([&]()
+            {
+                while (!isDone)
+                {
+                    ComPtr<ISlangBlob> trace;
+                    session->getPerformanceTrace(trace.writeRef());
+                }
+            });
+        for (Index i = 0; i < 4; ++i)
+        {
+            SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, false)));
+        }
+        isDone = true;
+        reader.join();
+    }
+
+    session->setPerformanceProfilingEnabled(false);
+    session->clearPerformanceTrace();
+    spDestroySession(session);
+}
+
+// Test that exiting a section that was entered before the profiler was cleared doesn't
+// end a section that was entered since.
+SLANG_UNIT_TEST(performanceProfilerClear)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+    profiler->clear();
+
+    const auto staleSection = profiler->enterSection("stale");
+    profiler->clear();
+    const auto section = profiler->enterSection("current");
+
+    profiler->exitSection(staleSection);
+    SLANG_CHECK(!_hasExitedSection(profiler, "current"));
+    SLANG_CHECK(!_hasExitedSection(profiler, "stale"));
+
+    // Sections entered since are still nested in the current one
+    const auto innerSection = profiler->enterSection("inner");
+    profiler->exitSection(innerSection);
+    profiler->exitSection(section);
+    SLANG_CHECK(_hasExitedSection(profiler, "current"));
+
+    StringBuilder summary;
+    profiler->getResult(summary);
+    SLANG_CHECK(summary.startsWith("current:"));
+    SLANG_CHECK(summary.indexOf("\n  inner:") >= 0);
+
+    profiler->clear();
+}
@@ -158,10 +158,10 @@ struct PersistentCacheTest
         return cache->getEntryFileName(entry.key);
     }
 
-    // Get the absolute filename of the cache index file.
-    String getIndexFilename()
+    // Get the absolute filename of the index file of the shard holding a cache entry.
+    String getIndexFilename(const Entry& entry)
     {
-        return cache->m_indexFileName;
+        return cache->getShard(entry.key).indexFileName;
     }
 };
 
@@ -225,6 +225,18 @@ struct BasicTest : public PersistentCacheTest
         SLANG_CHECK(cache->getStats().hitCount == 10);
         SLANG_CHECK(cache->getStats().missCount == 10);
 
+        // Check that the latency of every read and write was recorded.
+        Count readCount = 0;
+        Count writeCount = 0;
+        auto stats = cache->getStats();
+        for (Index bucket = 0; bucket < PersistentCache::kLatencyBucketCount; ++bucket)
+        {
+            readCount += stats.readLatencyHistogram[bucket];
+            writeCount += stats.writeLatencyHistogram[bucket];
+        }
+        SLANG_CHECK(readCount == 20);
+        SLANG_CHECK(writeCount == 10);
+
         // Clear the cache. Check that entry count is reset.
         SLANG_CHECK(cache->clear() == SLANG_OK);
         SLANG_CHECK(cache->getStats().entryCount == 0);
@@ -359,14 +371,14 @@ struct CorruptionTest : public PersistentCacheTest
         // Test behavior when the index file is removed before reading.
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
-        osFileSystem->remove(getIndexFilename().getBuffer());
+        osFileSystem->remove(getIndexFilename(entries[0]).getBuffer());
         // We expect a SLANG_E_NOT_FOUND because the cache has an empty index now.
         SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_NOT_FOUND);
 
         // Test behavior when the index file is removed before writing.
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
-        osFileSystem->remove(getIndexFilename().getBuffer());
+        osFileSystem->remove(getIndexFilename(entries[0]).getBuffer());
         writeEntry(entries[1]);
         SLANG_CHECK(readEntry(entries[1]) == true);
 
@@ -374,7 +386,7 @@ struct CorruptionTest : public PersistentCacheTest
         testIndexCorruption(
             [this]()
             {
-                osFileSystem->remove(getIndexFilename().getBuffer());
+                osFileSystem->remove(getIndexFilename(entries[0]).getBuffer());
             },
             SLANG_E_NOT_FOUND);
 
@@ -382,7 +394,7 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 FileStream fs;
-                fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
+                fs.init(getIndexFilename(entries[0]), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.write("x", 1);
             },
             SLANG_E_INTERNAL_FAIL);
@@ -391,7 +403,7 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 FileStream fs;
-                fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
+                fs.init(getIndexFilename(entries[0]), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::Start, 4);
                 uint32_t version = 0xffffffff;
                 fs.write(&version, sizeof(version));
@@ -402,7 +414,7 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 FileStream fs;
-                fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
+                fs.init(getIndexFilename(entries[0]), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::Start, 8);
                 uint32_t count = 0x7fffffff;
                 fs.write(&count, sizeof(count));
@@ -413,7 +425,7 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 FileStream fs;
-                fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
+                fs.init(getIndexFilename(entries[0]), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::Start, 8);
                 uint32_t count = 0;
                 fs.write(&count, sizeof(count));
@@ -424,7 +436,7 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 FileStream fs;
-                fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
+                fs.init(getIndexFilename(entries[0]), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::End, 0);
                 fs.write("x", 1);
             },
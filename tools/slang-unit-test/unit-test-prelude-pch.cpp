@@ -0,0 +1,241 @@
+// unit-test-prelude-pch.cpp
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../slang.h"
+#include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-prefix-header-util.h"
+
+#if !SLANG_WINDOWS_FAMILY
+#   include <sys/stat.h>
+#endif
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Compile a function returning `value` into a host callable library, using `cacheDirectory` for the precompiled
+    /// prelude. Returns the value the library's function returns, or -1 if it couldn't be compiled.
+static int _compileAndCall(slang::IGlobalSession* session, const String& cacheDirectory, int value, String& outDiagnostics)
+{
+    ComPtr<slang::ICompileRequest> request;
+    if (SLANG_FAILED(session->createCompileRequest(request.writeRef())))
+    {
+        return -1;
+    }
+
+    const char* args[] = { "-target", "host-callable", "-prelude-pch-cache-path", cacheDirectory.getBuffer() };
+    if (SLANG_FAILED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))))
+    {
+        return -1;
+    }
+
+    StringBuilder source;
+    source << "export __extern_cpp int getValue() { return " << value << "; }\n";
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "prelude-pch.slang", source.getBuffer());
+
+    const SlangResult result = request->compile();
+    outDiagnostics = request->getDiagnosticOutput();
+
+    ComPtr<ISlangSharedLibrary> library;
+    if (SLANG_FAILED(result) || SLANG_FAILED(request->getTargetHostCallable(0, library.writeRef())))
+    {
+        return -1;
+    }
+
+    typedef int (*Func)();
+    const auto func = (Func)library->findFuncByName("getValue");
+    return func ? func() : -1;
+}
+
+    /// Get the paths of the precompiled headers in `directory`
+static List<String> _findPrecompiledHeaders(const String& directory)
+{
+    List<String> fileNames;
+    OSFileSystem::getMutableSingleton()->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType type, const char* fileName, void* userData)
+        {
+            const UnownedStringSlice name(fileName);
+            if (type == SLANG_PATH_TYPE_FILE && (name.endsWith(".pch") || name.endsWith(".gch")))
+            {
+                static_cast<List<String>*>(userData)->add(fileName);
+            }
+        },
+        &fileNames);
+
+    List<String> paths;
+    for (const auto& fileName : fileNames)
+    {
+        paths.add(Path::combine(directory, fileName));
+    }
+    return paths;
+}
+
+static void _removeDirectory(const String& directory)
+{
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+
+    List<String> fileNames;
+    fileSystem->enumeratePathContents(
+        directory.getBuffer(),
+        [](SlangPathType type, const char* fileName, void* userData)
+        {
+            if (type == SLANG_PATH_TYPE_FILE)
+            {
+                static_cast<List<String>*>(userData)->add(fileName);
+            }
+        },
+        &fileNames);
+    for (const auto& fileName : fileNames)
+    {
+        fileSystem->remove(Path::combine(directory, fileName).getBuffer());
+    }
+    fileSystem->remove(directory.getBuffer());
+}
+
+    /// Select gcc or clang for host callable compiles for the life of the scope
+struct ScopedCPPCompiler
+{
+    ScopedCPPCompiler(slang::IGlobalSession* session)
+        : m_session(session)
+    {
+        for (const auto compiler : { SLANG_PASS_THROUGH_CLANG, SLANG_PASS_THROUGH_GCC })
+        {
+            if (SLANG_SUCCEEDED(session->checkPassThroughSupport(compiler)))
+            {
+                m_compiler = compiler;
+                break;
+            }
+        }
+
+        m_previousCompiler = session->getDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE);
+        if (m_compiler != SLANG_PASS_THROUGH_NONE)
+        {
+            session->setDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE, m_compiler);
+        }
+    }
+    ~ScopedCPPCompiler()
+    {
+        m_session->setDownstreamCompilerForTransition(SLANG_CPP_SOURCE, SLANG_SHADER_HOST_CALLABLE, m_previousCompiler);
+    }
+
+    slang::IGlobalSession* m_session;
+    SlangPassThrough m_compiler = SLANG_PASS_THROUGH_NONE;
+    SlangPassThrough m_previousCompiler = SLANG_PASS_THROUGH_NONE;
+};
+
+} // anonymous
+
+// Test that only failures caused by the cache are taken to be cache failures, which are compiled again with the
+// prelude as part of the source.
+SLANG_UNIT_TEST(preludePCHCacheFailure)
+{
+    DownstreamCompileOptions options;
+    options.precompiledHeaderDirectory = TerminatedCharSlice("/tmp/slang-prelude-pch-1000");
+
+    // A cache directory that can't be used
+    SLANG_CHECK(PrefixHeaderUtil::isCacheFailure(options, PrefixHeaderUtil::kCacheUnavailableResult, nullptr));
+    // Any other failure, without diagnostics that say otherwise, isn't
+    SLANG_CHECK(!PrefixHeaderUtil::isCacheFailure(options, SLANG_FAIL, nullptr));
+
+    auto createArtifact = [](const char* errorText, const char* filePath, const char* raw)
+    {
+        auto diagnostics = ArtifactDiagnostics::create();
+        if (errorText)
+        {
+            ArtifactDiagnostic diagnostic;
+            diagnostic.severity = ArtifactDiagnostic::Severity::Error;
+            diagnostic.text = TerminatedCharSlice(errorText);
+            diagnostic.filePath = TerminatedCharSlice(filePath);
+            diagnostics->add(diagnostic);
+        }
+        diagnostics->setRaw(CharSlice(raw));
+        diagnostics->setResult(SLANG_FAIL);
+
+        auto artifact = ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactKind::None, ArtifactPayload::None));
+        ArtifactUtil::addAssociated(artifact, diagnostics);
+        return artifact;
+    };
+
+    // Clang rejecting a stale precompiled header
+    {
+        auto artifact = createArtifact(
+            "file '/tmp/slang-prelude-pch-1000/slang-prefix-0.h' has been modified since the precompiled header "
+            "'/tmp/slang-prelude-pch-1000/slang-prefix-0.h.pch' was built",
+            "", "");
+        SLANG_CHECK(PrefixHeaderUtil::isCacheFailure(options, SLANG_OK, artifact));
+    }
+    // The same error, where the line couldn't be parsed into a diagnostic
+    {
+        auto artifact = createArtifact(nullptr, "",
+            "fatal error: malformed or corrupted AST file: '/tmp/slang-prelude-pch-1000/slang-prefix-0.h.pch'\n"
+            "1 error generated.\n");
+        SLANG_CHECK(PrefixHeaderUtil::isCacheFailure(options, SLANG_OK, artifact));
+    }
+    // An error in the source
+    {
+        auto artifact = createArtifact("use of undeclared identifier 'b'", "/tmp/slang-generated.cpp",
+            "/tmp/slang-generated.cpp:8:13: error: use of undeclared identifier 'b'\n");
+        SLANG_CHECK(!PrefixHeaderUtil::isCacheFailure(options, SLANG_OK, artifact));
+    }
+    // An error in the prefix header itself has its location in the cache, but isn't caused by it
+    {
+        auto artifact = createArtifact("unknown type name 'foo'", "/tmp/slang-prelude-pch-1000/slang-prefix-0.h",
+            "/tmp/slang-prelude-pch-1000/slang-prefix-0.h:4:1: error: unknown type name 'foo'\n");
+        SLANG_CHECK(!PrefixHeaderUtil::isCacheFailure(options, SLANG_OK, artifact));
+    }
+}
+
+// Test that host callable compiles succeed, and give the same results, with a cached precompiled prelude, with one
+// that has been corrupted, and with a cache directory that can't be used.
+SLANG_UNIT_TEST(preludePCH)
+{
+    slang::IGlobalSession* session = unitTestContext->slangGlobalSession;
+
+    ScopedCPPCompiler cppCompiler(session);
+    if (cppCompiler.m_compiler == SLANG_PASS_THROUGH_NONE)
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    String cacheDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-prelude-pch-test"), cacheDirectory)));
+    File::remove(cacheDirectory);
+
+    // The first compile creates the directory, and precompiles the prelude
+    String diagnostics;
+    SLANG_CHECK(_compileAndCall(session, cacheDirectory, 1, diagnostics) == 1);
+    List<String> precompiledPaths = _findPrecompiledHeaders(cacheDirectory);
+    SLANG_CHECK(precompiledPaths.getCount() == 1);
+
+    // The second uses the precompiled prelude
+    SLANG_CHECK(_compileAndCall(session, cacheDirectory, 2, diagnostics) == 2);
+    SLANG_CHECK(diagnostics.indexOf("104") < 0);
+
+    // A corrupt precompiled header is either ignored (gcc), or rejected (clang), in which case the compile is done again
+    // with the prelude inline
+    for (const auto& path : precompiledPaths)
+    {
+        File::writeAllText(path, "not a precompiled header");
+    }
+    SLANG_CHECK(_compileAndCall(session, cacheDirectory, 3, diagnostics) == 3);
+
+#if !SLANG_WINDOWS_FAMILY
+    // Other users can write to the directory, so it isn't used, and a warning says so
+    ::chmod(cacheDirectory.getBuffer(), 0777);
+    SLANG_CHECK(_compileAndCall(session, cacheDirectory, 4, diagnostics) == 4);
+    SLANG_CHECK(diagnostics.indexOf("warning 104") >= 0);
+    ::chmod(cacheDirectory.getBuffer(), 0700);
+#endif
+
+    _removeDirectory(cacheDirectory);
+}
@@ -0,0 +1,161 @@
+// unit-test-reflection-snapshot.cpp
+
+#include "../../slang.h"
+#include "../../slang-reflection-snapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static bool _isEqual(const char* a, const char* b)
+{
+    return strcmp(a ? a : "", b ? b : "") == 0;
+}
+
+    /// Check the snapshot of a variable layout (and its type, recursively) matches the reflection API
+static bool _isSame(const slang::ReflectionSnapshot& snapshot, const slang::ReflectionSnapshotVarLayout& snapshotVar, slang::VariableLayoutReflection* var, int depth)
+{
+    if (!_isEqual(snapshot.getString(snapshotVar.name), var->getName()) ||
+        snapshotVar.offsets.count != var->getCategoryCount())
+    {
+        return false;
+    }
+    for (unsigned i = 0; i < var->getCategoryCount(); ++i)
+    {
+        const auto category = SlangParameterCategory(var->getCategoryByIndex(i));
+        const auto offset = snapshot.findOffset(snapshotVar, category);
+        if (!offset ||
+            offset->offset != var->getOffset(category) ||
+            offset->space != var->getBindingSpace(category))
+        {
+            return false;
+        }
+    }
+
+    auto typeLayout = var->getTypeLayout();
+    const auto& snapshotType = snapshot.getTypeLayout(snapshotVar.typeLayout);
+    if (snapshotType.kind != uint32_t(typeLayout->getKind()) ||
+        !_isEqual(snapshot.getString(snapshotType.name), typeLayout->getName()) ||
+        snapshotType.fields.count != typeLayout->getFieldCount() ||
+        snapshot.getSize(snapshotType, SLANG_PARAMETER_CATEGORY_UNIFORM) != typeLayout->getSize(SLANG_PARAMETER_CATEGORY_UNIFORM))
+    {
+        return false;
+    }
+
+    // Types don't nest deeply in the test source
+    if (depth > 8)
+    {
+        return true;
+    }
+    for (unsigned i = 0; i < typeLayout->getFieldCount(); ++i)
+    {
+        if (!_isSame(snapshot, snapshot.getField(snapshotType, i), typeLayout->getFieldByIndex(i), depth + 1))
+        {
+            return false;
+        }
+    }
+    if (auto elementVar = typeLayout->getElementVarLayout())
+    {
+        if (snapshotType.elementVarLayout == slang::kReflectionSnapshotNone ||
+            !_isSame(snapshot, snapshot.getVarLayout(snapshotType.elementVarLayout), elementVar, depth + 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous
+
+// Test that a reflection snapshot holds the same information as the reflection API, and can be read from a copy
+SLANG_UNIT_TEST(reflectionSnapshot)
+{
+    const char* testSource = R"(
+        struct Material
+        {
+            float4 color;
+            Texture2D albedo;
+            SamplerState sampler;
+            float roughness[3];
+        };
+        struct Light
+        {
+            float3 direction;
+            float intensity;
+        };
+        ParameterBlock<Material> gMaterial;
+        ConstantBuffer<Light> gLight;
+        RWStructuredBuffer<float4> gOutput;
+
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 id : SV_DispatchThreadID, uniform float scale)
+        {
+            gOutput[id.x] = gMaterial.color * gLight.intensity * scale + gMaterial.roughness[id.y];
+        })";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    auto testBody = [&]()
+    {
+        auto reflection = slang::ShaderReflection::get(request);
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(reflection->getSnapshot(blob.writeRef())));
+
+        // The snapshot is only made once
+        ComPtr<ISlangBlob> secondBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(reflection->getSnapshot(secondBlob.writeRef())) && secondBlob == blob);
+
+        // Read from a copy, as if it had been stored
+        List<uint64_t> copy;
+        copy.setCount(Index((blob->getBufferSize() + 7) / 8));
+        memcpy(copy.getBuffer(), blob->getBufferPointer(), blob->getBufferSize());
+
+        slang::ReflectionSnapshot snapshot;
+        SLANG_CHECK_ABORT(snapshot.init(copy.getBuffer(), blob->getBufferSize()));
+
+        SLANG_CHECK_ABORT(snapshot.getParameterCount() == reflection->getParameterCount());
+        for (unsigned i = 0; i < reflection->getParameterCount(); ++i)
+        {
+            SLANG_CHECK(_isSame(snapshot, snapshot.getParameter(i), reflection->getParameterByIndex(i), 0));
+        }
+
+        SLANG_CHECK_ABORT(snapshot.getEntryPointCount() == 1);
+        auto entryPoint = snapshot.findEntryPointByName("computeMain");
+        SLANG_CHECK_ABORT(entryPoint != nullptr);
+        SLANG_CHECK(entryPoint->stage == SLANG_STAGE_COMPUTE);
+        SLANG_CHECK(entryPoint->threadGroupSize[0] == 8 && entryPoint->threadGroupSize[1] == 4 && entryPoint->threadGroupSize[2] == 1);
+
+        auto reflectionEntryPoint = reflection->getEntryPointByIndex(0);
+        SLANG_CHECK_ABORT(entryPoint->parameters.count == reflectionEntryPoint->getParameterCount());
+        for (unsigned i = 0; i < reflectionEntryPoint->getParameterCount(); ++i)
+        {
+            SLANG_CHECK(_isSame(snapshot, snapshot.getEntryPointParameter(*entryPoint, i), reflectionEntryPoint->getParameterByIndex(i), 0));
+        }
+
+        // A truncated or changed snapshot is rejected
+        slang::ReflectionSnapshot badSnapshot;
+        SLANG_CHECK(!badSnapshot.init(copy.getBuffer(), blob->getBufferSize() - 1));
+        ((uint32_t*)copy.getBuffer())[1] += 1;
+        SLANG_CHECK(!badSnapshot.init(copy.getBuffer(), blob->getBufferSize()));
+    };
+
+    testBody();
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
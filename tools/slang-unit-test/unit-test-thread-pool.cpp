@@ -0,0 +1,65 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <atomic>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(threadPool)
+{
+    for (Count threadCount : { 1, 2, 4, 7 })
+    {
+        RefPtr<ThreadPool> pool = new ThreadPool(threadCount);
+        SLANG_CHECK(pool->getThreadCount() == threadCount);
+
+        // Every task must be run exactly once, whatever the split between threads.
+        for (Index taskCount : { 0, 1, 3, 64, 1000 })
+        {
+            std::unique_ptr<std::atomic<int>[]> runCounts(new std::atomic<int>[taskCount]);
+            for (Index i = 0; i < taskCount; ++i)
+            {
+                runCounts[i] = 0;
+            }
+
+            pool->parallelFor(taskCount, [&](Index taskIndex) { runCounts[taskIndex]++; });
+
+            bool allRunOnce = true;
+            for (Index i = 0; i < taskCount; ++i)
+            {
+                allRunOnce = allRunOnce && runCounts[i] == 1;
+            }
+            SLANG_CHECK(allRunOnce);
+        }
+
+        // Tasks of very uneven cost, so that idle threads have to steal work.
+        {
+            std::atomic<int64_t> sum{ 0 };
+            const Index taskCount = 256;
+            pool->parallelFor(taskCount, [&](Index taskIndex)
+                {
+                    int64_t value = 0;
+                    const Index iterations = (taskIndex < taskCount / 8) ? 20000 : 10;
+                    for (Index i = 0; i < iterations; ++i)
+                    {
+                        value += (i ^ taskIndex) & 1;
+                    }
+                    sum += value + taskIndex;
+                });
+
+            int64_t expected = 0;
+            for (Index taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+            {
+                const Index iterations = (taskIndex < taskCount / 8) ? 20000 : 10;
+                for (Index i = 0; i < iterations; ++i)
+                {
+                    expected += (i ^ taskIndex) & 1;
+                }
+                expected += taskIndex;
+            }
+            SLANG_CHECK(sum == expected);
+        }
+    }
+}
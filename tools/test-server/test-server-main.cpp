@@ -324,6 +324,11 @@ SlangResult TestServer::_executeSingle()
                 m_quit = true;
                 return SLANG_OK;
             }
+            else if (call.method == TestServerProtocol::PingArgs::g_methodName)
+            {
+                TestServerProtocol::ExecutionResult result;
+                return m_connection->sendResult(&result, call.id);
+            }
             else if (call.method == TestServerProtocol::ExecuteUnitTestArgs::g_methodName)
             {
                 SLANG_RETURN_ON_FAIL(_executeUnitTest(call));